@@ -36,11 +36,12 @@
 
 extern void bsp_varichain_select   (samplechain_algorithm_t *_algorithm);
 extern void bsp_samplechain_select (samplechain_algorithm_t *_algorithm);
+extern void bsp_spanchain_select   (samplechain_algorithm_t *_algorithm);
 
 
 uint32_t samplechain_get_num_algorithms(void) {
    // (todo) increase this number when adding more algorithms
-   return 2;
+   return 3;
 }
 
 bool_t samplechain_select_algorithm(uint32_t _algorithmIdx, samplechain_algorithm_t *_retAlgorithm) {
@@ -63,6 +64,11 @@ bool_t samplechain_select_algorithm(uint32_t _algorithmIdx, samplechain_algorith
             ret = SC_TRUE;
             break;
 
+         case 2:
+            bsp_spanchain_select(_retAlgorithm);
+            ret = SC_TRUE;
+            break;
+
          // (todo) add more algorithms here
       }
    }
@@ -23,7 +23,7 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 23Mar2016
+ * ---- changed: 23Mar2016, 19Oct2026
  * ----
  * ----
  */
@@ -37,6 +37,7 @@
 typedef int32_t bool_t;
 
 typedef float float32_t;
+typedef double float64_t;
 
 #define SC_FALSE 0
 #define SC_TRUE  1
@@ -49,6 +50,18 @@ typedef float float32_t;
 // Opaque sample chain handle
 typedef void *samplechain_t;
 
+// Caller-provided layout arrays (see query_layout())
+//  - Each non-NULL array must provide room for (at least) 'maxElements' entries
+typedef struct {
+   size_t    *offsets;      // start offsets (number of sample frames)
+   size_t    *total_sizes;  // total (padded) sizes (number of sample frames)
+   size_t    *orig_sizes;   // original (waveform) sizes (number of sample frames)
+   size_t    *pad_sizes;    // number of padding frames
+   float32_t *sta;          // device STA values (0..numSlices)
+   float32_t *end;          // device END values (0..numSlices)
+   uint32_t  *source_indices; // index of the element whose chain region is used (own index unless deduplicated)
+} samplechain_layout_t;
+
 typedef struct {
    // Query the algorithm name
    const char *(*query_algorithm_name) (void);
@@ -64,16 +77,52 @@ typedef struct {
    bool_t (*set_parameter_i) (samplechain_t _sc, const char *_paramName, int32_t _paramValue);
    bool_t (*set_parameter_f) (samplechain_t _sc, const char *_paramName, float32_t _paramValue);
 
+   // Query algorithm-specific parameter value
+   //  - Returns true and stores the value in 'retParamValue' if the parameter is known, false otherwise
+   //  - Requires that init() has been called
+   bool_t (*get_parameter_i) (samplechain_t _sc, const char *_paramName, int32_t *_retParamValue);
+
    // Add a new element (waveform) to the chain
    //  - Invalidates the current output
    //  - May only be called after init() was called
+   //  - Thread-safe, i.e. may be called from multiple threads concurrently (but not concurrently with other fxns)
+   //  - Elements are ordered by arrival (see add_with_key())
    //  - Returns true if the element was added, false otherwise (e.g. max number of slices exceeded)
    bool_t (*add) (samplechain_t _sc, size_t _numSampleFrames, void *_userData);
 
+   // Add a new element with an ordering key (e.g. the file index)
+   //  - Same as add() but 'calc' (stable-)sorts the elements by 'sortKey' (add() uses the arrival order as key),
+   //     i.e. the chain order does not depend on which thread finished first
+   //  - Element indices passed to / returned by other fxns refer to the arrival order until 'calc' has been called
+   //  - 'query_num_elements' returns the number of completed add() calls (until 'calc' is called),
+   //     e.g. 'calc' can be called by the thread that added the last expected element
+   bool_t (*add_with_key) (samplechain_t _sc, size_t _numSampleFrames, void *_userData, uint32_t _sortKey);
+
+   // Mark an element as a duplicate of an earlier element (see analysis/dedup.h)
+   //  - 'calc' places the content only once, i.e. the duplicate shares the chain region (offset) of 'sourceElementIdx'
+   //  - Passing sourceElementIdx == elementIdx removes the mark
+   //  - Invalidates the current output
+   //  - Returns false if either index is invalid or 'sourceElementIdx' is not an earlier element
+   bool_t (*set_element_alias) (samplechain_t _sc, uint32_t _elementIdx, uint32_t _sourceElementIdx);
+
+   // Set algorithm-specific element attribute value (e.g. "lead_silence", see analysis/onset.h)
+   //  - Element indices refer to the arrival order until 'calc' has been called (see add_with_key())
+   //  - Invalidates the current output
+   //  - Returns true if the attribute was set successfully, false otherwise (unknown attribute, invalid index, ..)
+   bool_t (*set_element_attribute_i) (samplechain_t _sc, uint32_t _elementIdx, const char *_attrName, int32_t _attrValue);
+
    // Calculate sample chain
    //  - Layout sample chain elements and create new output state (for queries)
    void (*calc) (samplechain_t _sc);
 
+   // Calculate sample chain within a time budget (anytime variant of 'calc', e.g. for interactive editors)
+   //  - Checks the clock once per layout attempt; when 'budgetUs' microseconds have elapsed, the search stops
+   //     and the best valid layout found so far is committed (0=return the first valid layout)
+   //  - Returns true if the search completed, i.e. the output is identical to that of 'calc'
+   //  - Returns false if the search was cut short (the output is valid but not optimal, e.g. more padding
+   //     than necessary). Call 'calc' (e.g. in the background) to refine it.
+   bool_t (*calc_with_deadline) (samplechain_t _sc, uint32_t _budgetUs);
+
    // Query the current number of elements in the sample chain
    uint32_t (*query_num_elements) (samplechain_t _sc);
 
@@ -82,6 +131,11 @@ typedef struct {
    //  - Returns 0 if something went terribly wrong (tm)
    size_t (*query_total_size) (samplechain_t _sc);
 
+   // Query by how many bytes the smallest possible layout exceeds the "max_total_bytes" budget
+   //  - Returns 0 if the last 'calc' succeeded (or no budget was set)
+   //  - The byte size of a frame is determined by the "bytes_per_sample" and "num_channels" parameters
+   size_t (*query_bytes_over_budget) (samplechain_t _sc);
+
    // Query start offset of sample chain element (number of sample frames)
    //  - (note) this is just an utility fxn (could be implemented generically)
    //  - Requires that 'calc' has been called
@@ -95,6 +149,12 @@ typedef struct {
    //  - (note) the difference to the total size is the number of padding frames
    size_t (*query_element_original_size) (samplechain_t _sc, uint32_t _elementIdx);  
 
+   // Query the layout of all sample chain elements in a single pass
+   //  - Fills the non-NULL arrays in 'retLayout' (at most 'maxElements' entries)
+   //  - Requires that 'calc' has been called
+   //  - Returns the number of elements written (0 if the output is not valid)
+   uint32_t (*query_layout) (samplechain_t _sc, samplechain_layout_t *_retLayout, uint32_t _maxElements);
+
    // Return sample chain element user_data pointer
    void *(*query_element_user_data) (samplechain_t _sc, uint32_t _elementIdx);  
 
@@ -113,6 +173,20 @@ uint32_t samplechain_get_num_algorithms (void);
 bool_t samplechain_select_algorithm (uint32_t _algorithmIdx, samplechain_algorithm_t *_retAlgorithm);
 
 
+// Objectives of the "auto" algorithm (parameter "objective")
+#define SC_AUTO_OBJECTIVE_MIN_SIZE     0  // smallest total size (default)
+#define SC_AUTO_OBJECTIVE_MAX_PADDING  1  // largest minimum padding (accidental-trigger protection)
+#define SC_AUTO_OBJECTIVE_EVEN_STA     2  // fewest distinct STA steps (easiest to dial)
+
+// Select the "auto" (meta) algorithm
+//  - Creates one chain per registered algorithm (see samplechain_get_num_algorithms()) and forwards all inputs to each of them
+//  - 'calc' runs all algorithms concurrently and picks the winner by "objective" (SC_AUTO_OBJECTIVE_xxx),
+//     ties are resolved by the smaller total size, then by the lower algorithm index
+//  - All queries reflect the winning layout, "selected_algorithm" returns its index (-1 if no algorithm succeeded)
+//  - Parameters are forwarded to all algorithms (set_parameter_i() succeeds if at least one algorithm accepted the value)
+void samplechain_select_auto (samplechain_algorithm_t *_retAlgorithm);
+
+
 #if 0
 // Example usage:
 samplechain_algorithm_t alg;
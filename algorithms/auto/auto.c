@@ -0,0 +1,683 @@
+/* ----
+ * ---- file   : auto.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef SC_NO_THREADS
+#include <pthread.h>
+#endif
+
+#include "../../algorithm_interface_proposal.h"
+#include "../../util/thread.h"
+
+// Max. number of registered algorithms that are evaluated
+#define SC_AUTO_MAX_ALGORITHMS  8u
+
+#define SC_AUTO_NONE  (~0u)
+
+
+// Evaluation of a calculated candidate layout
+typedef struct {
+   bool_t   b_valid;
+   size_t   total_sz;
+   size_t   min_pad_sz;    // smallest padding of all chain regions
+   uint32_t num_sta_steps; // number of distinct STA distances between consecutive chain regions
+} score_t;
+
+
+typedef struct {
+
+   samplechain_algorithm_t algs[SC_AUTO_MAX_ALGORITHMS];
+   samplechain_t           scs[SC_AUTO_MAX_ALGORITHMS];
+   score_t                 scores[SC_AUTO_MAX_ALGORITHMS];
+
+   uint32_t num_algs;
+
+   int32_t objective; // SC_AUTO_OBJECTIVE_xxx
+
+   uint32_t sel_idx;  // winner of the last calc() (SC_AUTO_NONE=no valid output)
+
+   bool_t   b_deadline;  // true while calc_with_deadline() is running
+   uint64_t deadline_us; // see sc_get_time_us()
+   bool_t   b_optimal[SC_AUTO_MAX_ALGORITHMS];
+
+#ifndef SC_NO_THREADS
+   // (note) add() is serialized so that all candidates see the same arrival order (i.e. element indices)
+   pthread_mutex_t add_mutex;
+#endif
+
+} sc_t;
+
+#ifndef SC_NO_THREADS
+#define loc_lock(sc)    pthread_mutex_lock(&(sc)->add_mutex)
+#define loc_unlock(sc)  pthread_mutex_unlock(&(sc)->add_mutex)
+#else
+#define loc_lock(sc)    (void)0
+#define loc_unlock(sc)  (void)0
+#endif
+
+
+// Helper fxns:
+static void loc_score_candidate(sc_t *_sc, uint32_t _algIdx) {
+   const samplechain_algorithm_t *alg = &_sc->algs[_algIdx];
+   samplechain_t csc = _sc->scs[_algIdx];
+   score_t *score = &_sc->scores[_algIdx];
+   uint32_t n = alg->query_num_elements(csc);
+   size_t *padSizes = malloc(n * (2 * sizeof(size_t) + 2 * sizeof(float32_t) + sizeof(uint32_t)));
+
+   score->b_valid       = SC_FALSE;
+   score->total_sz      = alg->query_total_size(csc);
+   score->min_pad_sz    = 0;
+   score->num_sta_steps = 0;
+
+   if((NULL != padSizes) && (score->total_sz > 0u))
+   {
+      samplechain_layout_t layout;
+      size_t *origSizes = padSizes + n;
+      float32_t *sta = (float32_t*) (origSizes + n);
+      float32_t *steps = sta + n;
+      uint32_t *sourceIndices = (uint32_t*) (steps + n);
+      uint32_t elementIdx;
+      uint32_t numRegions = 0;
+      float32_t prevSta = 0.0f;
+
+      memset(&layout, 0, sizeof(layout));
+
+      layout.orig_sizes     = origSizes;
+      layout.pad_sizes      = padSizes;
+      layout.sta            = sta;
+      layout.source_indices = sourceIndices;
+
+      if(n == alg->query_layout(csc, &layout, n))
+      {
+         score->b_valid    = SC_TRUE;
+         score->min_pad_sz = score->total_sz;
+
+         for(elementIdx = 0; elementIdx < n; elementIdx++)
+         {
+            // (note) duplicates and pad elements do not start a chain region
+            if((sourceIndices[elementIdx] == elementIdx) && (origSizes[elementIdx] > 0u))
+            {
+               if(padSizes[elementIdx] < score->min_pad_sz)
+               {
+                  score->min_pad_sz = padSizes[elementIdx];
+               }
+
+               if(numRegions > 0u)
+               {
+                  // (note) STA steps are compared with a resolution of 1/100
+                  float32_t step = floorf((sta[elementIdx] - prevSta) * 100.0f + 0.5f);
+                  uint32_t stepIdx;
+
+                  for(stepIdx = 0; (stepIdx < score->num_sta_steps) && (steps[stepIdx] != step); stepIdx++)
+                  {
+                  }
+
+                  if(stepIdx == score->num_sta_steps)
+                  {
+                     steps[score->num_sta_steps++] = step;
+                  }
+               }
+
+               prevSta = sta[elementIdx];
+               numRegions++;
+            }
+         }
+      }
+   }
+
+   free(padSizes);
+}
+
+// Returns true if candidate 'a' beats candidate 'b' (lower index wins ties, i.e. 'a' must be strictly better)
+static bool_t loc_is_better(int32_t _objective, const score_t *_a, const score_t *_b) {
+   bool_t ret;
+
+   if(_a->b_valid != _b->b_valid)
+   {
+      ret = _a->b_valid;
+   }
+   else if((SC_AUTO_OBJECTIVE_MAX_PADDING == _objective) && (_a->min_pad_sz != _b->min_pad_sz))
+   {
+      ret = (_a->min_pad_sz > _b->min_pad_sz);
+   }
+   else if((SC_AUTO_OBJECTIVE_EVEN_STA == _objective) && (_a->num_sta_steps != _b->num_sta_steps))
+   {
+      ret = (_a->num_sta_steps < _b->num_sta_steps);
+   }
+   else
+   {
+      ret = (_a->total_sz < _b->total_sz);
+   }
+
+   return ret;
+}
+
+static void loc_calc_candidate_job(void *_sc, uint32_t _algIdx) {
+   sc_t *sc = (sc_t*)_sc;
+
+   if(sc->b_deadline)
+   {
+      // (note) jobs may start late when there are fewer threads than algorithms
+      uint64_t t = sc_get_time_us();
+      uint32_t budgetUs = (t < sc->deadline_us) ? (uint32_t)(sc->deadline_us - t) : 0u;
+
+      sc->b_optimal[_algIdx] = sc->algs[_algIdx].calc_with_deadline(sc->scs[_algIdx], budgetUs);
+   }
+   else
+   {
+      sc->algs[_algIdx].calc(sc->scs[_algIdx]);
+      sc->b_optimal[_algIdx] = SC_TRUE;
+   }
+
+   loc_score_candidate(sc, _algIdx);
+}
+
+// Candidate that answers queries (winner after calc(), first algorithm before)
+static uint32_t loc_get_query_idx(sc_t *_sc) {
+   return (SC_AUTO_NONE != _sc->sel_idx) ? _sc->sel_idx : 0u;
+}
+
+// Interface impl:
+static const char *loc_query_algorithm_name(void) {
+   return "Auto (best of all algorithms)";
+}
+
+static void loc_exit(samplechain_t *_sc);
+
+static void loc_init(samplechain_t *_retSc, uint32_t _numSlices/*120 for AR*/) {
+
+   if(NULL != _retSc)
+   {
+      sc_t *sc = malloc(sizeof(sc_t));
+
+      *_retSc = NULL;
+
+      if(NULL != sc)
+      {
+         uint32_t numAlgs = samplechain_get_num_algorithms();
+         bool_t bOk = SC_TRUE;
+
+         sc->num_algs    = 0;
+         sc->objective   = SC_AUTO_OBJECTIVE_MIN_SIZE;
+         sc->sel_idx     = SC_AUTO_NONE;
+         sc->b_deadline  = SC_FALSE;
+         sc->deadline_us = 0u;
+
+#ifndef SC_NO_THREADS
+         pthread_mutex_init(&sc->add_mutex, NULL);
+#endif
+
+         if(numAlgs > SC_AUTO_MAX_ALGORITHMS)
+         {
+            numAlgs = SC_AUTO_MAX_ALGORITHMS;
+         }
+
+         while(bOk && (sc->num_algs < numAlgs))
+         {
+            samplechain_algorithm_t *alg = &sc->algs[sc->num_algs];
+
+            bOk = samplechain_select_algorithm(sc->num_algs, alg);
+
+            if(bOk)
+            {
+               alg->init(&sc->scs[sc->num_algs], _numSlices);
+
+               bOk = (NULL != sc->scs[sc->num_algs]);
+            }
+
+            if(bOk)
+            {
+               sc->num_algs++;
+            }
+         }
+
+         *_retSc = sc;
+
+         if(!bOk || (0u == sc->num_algs))
+         {
+            loc_exit(_retSc);
+         }
+      }
+   }
+}
+
+static bool_t loc_set_parameter_i(samplechain_t _sc, const char *_paramName, int32_t _paramValue) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(0 == strcmp("objective", _paramName))
+      {
+         if((_paramValue >= SC_AUTO_OBJECTIVE_MIN_SIZE) && (_paramValue <= SC_AUTO_OBJECTIVE_EVEN_STA))
+         {
+            sc->objective = _paramValue;
+            sc->sel_idx   = SC_AUTO_NONE;
+            ret = SC_TRUE;
+         }
+      }
+      else
+      {
+         uint32_t algIdx;
+
+         for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+         {
+            if(sc->algs[algIdx].set_parameter_i(sc->scs[algIdx], _paramName, _paramValue))
+            {
+               ret = SC_TRUE;
+            }
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_parameter_f(samplechain_t _sc, const char *_paramName, float32_t _paramValue) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         if(sc->algs[algIdx].set_parameter_f(sc->scs[algIdx], _paramName, _paramValue))
+         {
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_get_parameter_i(samplechain_t _sc, const char *_paramName, int32_t *_retParamValue) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retParamValue))
+   {
+      if(0 == strcmp("objective", _paramName))
+      {
+         *_retParamValue = sc->objective;
+         ret = SC_TRUE;
+      }
+      else if(0 == strcmp("selected_algorithm", _paramName))
+      {
+         *_retParamValue = (SC_AUTO_NONE != sc->sel_idx) ? (int32_t)sc->sel_idx : -1;
+         ret = SC_TRUE;
+      }
+      else
+      {
+         uint32_t algIdx = loc_get_query_idx(sc);
+
+         ret = sc->algs[algIdx].get_parameter_i(sc->scs[algIdx], _paramName, _retParamValue);
+
+         // (note) algorithm-specific parameter (e.g. "chain_size")
+         for(algIdx = 0; !ret && (algIdx < sc->num_algs); algIdx++)
+         {
+            ret = sc->algs[algIdx].get_parameter_i(sc->scs[algIdx], _paramName, _retParamValue);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_add_with_key(samplechain_t _sc, size_t _numSampleFrames, void *_userData, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      loc_lock(sc);
+
+      ret = SC_TRUE;
+      sc->sel_idx = SC_AUTO_NONE;
+
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         ret = sc->algs[algIdx].add_with_key(sc->scs[algIdx], _numSampleFrames, _userData, _sortKey) && ret;
+      }
+
+      loc_unlock(sc);
+   }
+
+   return ret;
+}
+
+static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userData) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      loc_lock(sc);
+
+      ret = SC_TRUE;
+      sc->sel_idx = SC_AUTO_NONE;
+
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         ret = sc->algs[algIdx].add(sc->scs[algIdx], _numSampleFrames, _userData) && ret;
+      }
+
+      loc_unlock(sc);
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_element_alias(samplechain_t _sc, uint32_t _elementIdx, uint32_t _sourceElementIdx) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      ret = SC_TRUE;
+      sc->sel_idx = SC_AUTO_NONE;
+
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         ret = sc->algs[algIdx].set_element_alias(sc->scs[algIdx], _elementIdx, _sourceElementIdx) && ret;
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_element_attribute_i(samplechain_t _sc, uint32_t _elementIdx, const char *_attrName, int32_t _attrValue) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      sc->sel_idx = SC_AUTO_NONE;
+
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         if(sc->algs[algIdx].set_element_attribute_i(sc->scs[algIdx], _elementIdx, _attrName, _attrValue))
+         {
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+// Calculate all candidates and select the winner
+static void loc_calc_candidates(sc_t *_sc) {
+   uint32_t algIdx;
+
+   // (note) the candidates are independent, i.e. the wall-clock time is that of the slowest algorithm
+   sc_parallel_for(_sc->num_algs, &loc_calc_candidate_job, _sc, 0u);
+
+   _sc->sel_idx = 0u;
+
+   for(algIdx = 1u; algIdx < _sc->num_algs; algIdx++)
+   {
+      if(loc_is_better(_sc->objective, &_sc->scores[algIdx], &_sc->scores[_sc->sel_idx]))
+      {
+         _sc->sel_idx = algIdx;
+      }
+   }
+
+   if(!_sc->scores[_sc->sel_idx].b_valid)
+   {
+      _sc->sel_idx = SC_AUTO_NONE;
+   }
+
+   for(algIdx = 0u; algIdx < _sc->num_algs; algIdx++)
+   {
+      printf("[...] auto: %-30s %s total=%u min_pad=%u sta_steps=%u\n",
+             _sc->algs[algIdx].query_algorithm_name(),
+             (algIdx == _sc->sel_idx) ? "*" : " ",
+             (uint32_t)_sc->scores[algIdx].total_sz,
+             (uint32_t)_sc->scores[algIdx].min_pad_sz,
+             _sc->scores[algIdx].num_sta_steps
+             );
+   }
+}
+
+static void loc_calc(samplechain_t _sc) {
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      sc->b_deadline = SC_FALSE;
+
+      loc_calc_candidates(sc);
+   }
+}
+
+static bool_t loc_calc_with_deadline(samplechain_t _sc, uint32_t _budgetUs) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx;
+
+      sc->b_deadline  = SC_TRUE;
+      sc->deadline_us = sc_get_time_us() + _budgetUs;
+
+      loc_calc_candidates(sc);
+
+      sc->b_deadline = SC_FALSE;
+
+      // (note) the winner might differ if a cut-short candidate had completed its search
+      ret = SC_TRUE;
+
+      for(algIdx = 0u; algIdx < sc->num_algs; algIdx++)
+      {
+         ret = ret && sc->b_optimal[algIdx];
+      }
+   }
+
+   return ret;
+}
+
+static uint32_t loc_query_num_elements(samplechain_t _sc) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx = loc_get_query_idx(sc);
+
+      ret = sc->algs[algIdx].query_num_elements(sc->scs[algIdx]);
+   }
+
+   return ret;
+}
+
+static size_t loc_query_total_size(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (SC_AUTO_NONE != sc->sel_idx))
+   {
+      ret = sc->algs[sc->sel_idx].query_total_size(sc->scs[sc->sel_idx]);
+   }
+
+   return ret;
+}
+
+static size_t loc_query_bytes_over_budget(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (SC_AUTO_NONE == sc->sel_idx))
+   {
+      uint32_t algIdx;
+
+      // (note) the smallest excess of all candidates
+      for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+      {
+         size_t excess = sc->algs[algIdx].query_bytes_over_budget(sc->scs[algIdx]);
+
+         if((excess > 0u) && ((0u == ret) || (excess < ret)))
+         {
+            ret = excess;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (SC_AUTO_NONE != sc->sel_idx))
+   {
+      ret = sc->algs[sc->sel_idx].query_element_offset(sc->scs[sc->sel_idx], _elementIdx);
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_total_size(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (SC_AUTO_NONE != sc->sel_idx))
+   {
+      ret = sc->algs[sc->sel_idx].query_element_total_size(sc->scs[sc->sel_idx], _elementIdx);
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx = loc_get_query_idx(sc);
+
+      ret = sc->algs[algIdx].query_element_original_size(sc->scs[algIdx], _elementIdx);
+   }
+
+   return ret;
+}
+
+static uint32_t loc_query_layout(samplechain_t _sc, samplechain_layout_t *_retLayout, uint32_t _maxElements) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (SC_AUTO_NONE != sc->sel_idx))
+   {
+      ret = sc->algs[sc->sel_idx].query_layout(sc->scs[sc->sel_idx], _retLayout, _maxElements);
+   }
+
+   return ret;
+}
+
+static void *loc_query_element_user_data(samplechain_t _sc, uint32_t _elementIdx) {
+   void *ret = NULL;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      uint32_t algIdx = loc_get_query_idx(sc);
+
+      ret = sc->algs[algIdx].query_element_user_data(sc->scs[algIdx], _elementIdx);
+   }
+
+   return ret;
+}
+
+static void loc_exit(samplechain_t *_sc) {
+
+   if(NULL != _sc)
+   {
+      sc_t *sc = (sc_t*)*_sc;
+
+      if(NULL != sc)
+      {
+         uint32_t algIdx;
+
+         for(algIdx = 0; algIdx < sc->num_algs; algIdx++)
+         {
+            sc->algs[algIdx].exit(&sc->scs[algIdx]);
+         }
+
+#ifndef SC_NO_THREADS
+         pthread_mutex_destroy(&sc->add_mutex);
+#endif
+
+         free(sc);
+         *_sc = NULL;
+      }
+   }
+}
+
+void samplechain_select_auto(samplechain_algorithm_t *_algorithm) {
+
+   _algorithm->query_algorithm_name        = &loc_query_algorithm_name;
+   _algorithm->init                        = &loc_init;
+   _algorithm->set_parameter_i             = &loc_set_parameter_i;
+   _algorithm->set_parameter_f             = &loc_set_parameter_f;
+   _algorithm->get_parameter_i             = &loc_get_parameter_i;
+   _algorithm->add                         = &loc_add;
+   _algorithm->add_with_key                = &loc_add_with_key;
+   _algorithm->set_element_alias           = &loc_set_element_alias;
+   _algorithm->set_element_attribute_i     = &loc_set_element_attribute_i;
+   _algorithm->calc                        = &loc_calc;
+   _algorithm->calc_with_deadline          = &loc_calc_with_deadline;
+   _algorithm->query_num_elements          = &loc_query_num_elements;
+   _algorithm->query_total_size            = &loc_query_total_size;
+   _algorithm->query_bytes_over_budget     = &loc_query_bytes_over_budget;
+   _algorithm->query_element_offset        = &loc_query_element_offset;
+   _algorithm->query_element_total_size    = &loc_query_element_total_size;
+   _algorithm->query_element_original_size = &loc_query_element_original_size;
+   _algorithm->query_layout                = &loc_query_layout;
+   _algorithm->query_element_user_data     = &loc_query_element_user_data;
+   _algorithm->exit                        = &loc_exit;
+}
@@ -23,7 +23,7 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 25Mar2016
+ * ---- changed: 25Mar2016, 19Oct2026
  * ----
  * ----
  */
@@ -34,12 +34,18 @@
 #include <string.h>
 
 #include "../../algorithm_interface_proposal.h"
+#include "../../util/profile.h"
+#include "../../util/thread.h"
 
 
 typedef struct {
    int32_t orig_sz;
    int32_t cur_sz;
    int32_t pad_sz;
+   int32_t offset;
+
+   uint32_t source_idx; // != own index if this is a duplicate of an earlier element
+   uint32_t sort_key;   // final ordering key (see add_with_key())
 
    void *user_data;
 
@@ -50,13 +56,27 @@ typedef struct {
 
    element_t *elements;
 
-   uint32_t num_elements;
-   uint32_t max_elements;
+   uint32_t num_elements;       // number of elements in the current layout (incl. pad elements)
+   uint32_t max_elements;       // max. number of added elements
+   uint32_t max_alloc_elements; // size of 'elements' array (incl. pad elements)
+
+   uint32_t num_reserved;  // number of slots reserved by add() (atomic)
+   uint32_t num_added;     // number of elements written by add() (atomic)
+
+   uint32_t *tmp_indices;  // 2*max_alloc_elements (see loc_sort_elements())
 
    uint32_t num_slices; // 120 for AR
 
    int32_t param_chain_size;
    int32_t param_extra_padding;
+   int32_t param_bytes_per_sample; // 2 for AR
+   int32_t param_num_channels;     // 1 for AR
+   int32_t param_max_total_bytes;  // 0=unlimited
+
+   size_t bytes_over_budget; // set by calc() when the chain does not fit into max_total_bytes
+
+   uint32_t num_pad_elements;    // number of silent elements appended by calc()
+   uint32_t num_unique_elements; // number of elements that occupy a slice (i.e. no duplicates)
 
    float32_t cur_sta; // tmp when building output chain
 
@@ -99,6 +119,10 @@ static void loc_align_sizes_to(sc_t *_sc, int32_t _sz) {
 
    uint32_t elementIdx;
 
+   SC_PROFILE_BEGIN(ALIGN);
+
+   SC_PROFILE_COUNT(ALIGN_PASSES, 1);
+
    for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
    {
       element_t *el = &_sc->elements[elementIdx];
@@ -121,9 +145,83 @@ static void loc_align_sizes_to(sc_t *_sc, int32_t _sz) {
                 _sz
                 );
 
-         _sc->cur_sta += (((float32_t)chSz) / _sz) * (_sc->num_slices / _sc->num_elements);
+         _sc->cur_sta += (((float32_t)chSz) / _sz) * (_sc->num_slices / _sc->num_unique_elements);
+      }
+   }
+
+   SC_PROFILE_END(ALIGN);
+}
+
+static void loc_restore_orig_sizes(sc_t *_sc) {
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      // (note) duplicates do not occupy any space in the chain
+      el->cur_sz = (el->source_idx == elementIdx) ? el->orig_sz : 0;
+      el->pad_sz = 0;
+   }
+}
+
+static uint32_t loc_get_num_unique_elements(sc_t *_sc) {
+   uint32_t ret = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      if(_sc->elements[elementIdx].source_idx == elementIdx)
+      {
+         ret++;
       }
    }
+
+   return ret;
+}
+
+static void loc_update_offsets(sc_t *_sc) {
+   uint32_t elementIdx;
+   int32_t offset = 0;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      el->offset = (el->source_idx == elementIdx) ? offset : _sc->elements[el->source_idx].offset;
+
+      offset += el->cur_sz;
+   }
+}
+
+static size_t loc_get_frame_sz(sc_t *_sc) {
+   return (size_t) (_sc->param_bytes_per_sample * _sc->param_num_channels);
+}
+
+// Find the largest padding (<= 'extra_padding') that keeps the chain within 'max_total_bytes'
+//  - All slices are aligned to (maxSmpSz + padding), i.e. the chain size is known in advance
+//  - Returns false and sets 'bytes_over_budget' if even a single padding frame does not fit
+static bool_t loc_fit_padding_to_budget(sc_t *_sc, int32_t _maxSmpSz, int32_t *_retExtraPadding) {
+   size_t frameSz = loc_get_frame_sz(_sc);
+   size_t maxBytes = (size_t)_sc->param_max_total_bytes;
+   size_t maxSlcSz = (maxBytes / frameSz) / _sc->num_unique_elements;
+
+   if(maxSlcSz < (size_t)(_maxSmpSz + 1))
+   {
+      _sc->bytes_over_budget = ((size_t)_sc->num_unique_elements * (_maxSmpSz + 1) * frameSz) - maxBytes;
+      return SC_FALSE;
+   }
+
+   if((maxSlcSz - _maxSmpSz) < (size_t)_sc->param_extra_padding)
+   {
+      *_retExtraPadding = (int32_t) (maxSlcSz - _maxSmpSz);
+   }
+   else
+   {
+      *_retExtraPadding = _sc->param_extra_padding;
+   }
+
+   return SC_TRUE;
 }
 
 static float32_t loc_calc_average_slice_padding(sc_t *_sc) {
@@ -137,7 +235,7 @@ static float32_t loc_calc_average_slice_padding(sc_t *_sc) {
       padSum += el->pad_sz;
    }
 
-   return ((float32_t)padSum) / _sc->num_elements;
+   return ((float32_t)padSum) / loc_get_num_unique_elements(_sc);
 }
 
 // Interface impl:
@@ -146,24 +244,99 @@ static const char *loc_query_algorithm_name(void) {
    return "SampleChain (bsp)";
 }
 
+// Stable sort of the elements by their ordering key (see add_with_key())
+//  - Duplicate references are remapped so that each group refers to its first element in the new order
+static void loc_sort_elements(sc_t *_sc) {
+   uint32_t n = _sc->num_elements;
+   uint32_t *origIdx = _sc->tmp_indices;
+   uint32_t *newIdx = _sc->tmp_indices + _sc->max_alloc_elements;
+   bool_t bSorted = SC_TRUE;
+   uint32_t i;
+
+   for(i = 1u; bSorted && (i < n); i++)
+   {
+      bSorted = (_sc->elements[i - 1u].sort_key <= _sc->elements[i].sort_key);
+   }
+
+   if(!bSorted)
+   {
+      // Insertion sort (stable, the elements are usually (almost) sorted)
+      for(i = 0u; i < n; i++)
+      {
+         element_t el = _sc->elements[i];
+         uint32_t j = i;
+
+         while((j > 0u) && (_sc->elements[j - 1u].sort_key > el.sort_key))
+         {
+            _sc->elements[j] = _sc->elements[j - 1u];
+            origIdx[j]       = origIdx[j - 1u];
+            j--;
+         }
+
+         _sc->elements[j] = el;
+         origIdx[j]       = i;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         newIdx[origIdx[i]] = i;
+      }
+
+      // (note) 'origIdx' is reused to map each group (new index of its previous first element) to its new first element
+      for(i = 0u; i < n; i++)
+      {
+         origIdx[i] = ~0u;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         uint32_t groupIdx = newIdx[_sc->elements[i].source_idx];
+
+         if(~0u == origIdx[groupIdx])
+         {
+            origIdx[groupIdx] = i;
+         }
+
+         _sc->elements[i].source_idx = origIdx[groupIdx];
+      }
+   }
+}
+
+// Number of elements (incl. pad elements after calc(), or the number of added elements if the output is not valid)
+static uint32_t loc_get_num_elements(sc_t *_sc) {
+   return _sc->b_output_valid ? _sc->num_elements : SC_ATOMIC_LOAD(&_sc->num_added);
+}
+
 static void loc_init(samplechain_t *_retSc, uint32_t _numSlices/*120 for AR*/) {
    
    if(NULL != _retSc)
    {
       if(_numSlices > 0)
       {
-         sc_t *sc = malloc(sizeof(sc_t) + sizeof(element_t) * _numSlices);
+         // (note) calc() appends up to 'numSlices' silent elements (when duplicates have been removed)
+         uint32_t maxAllocElements = 2u * _numSlices;
+         sc_t *sc = malloc(sizeof(sc_t) + (sizeof(element_t) + 2u * sizeof(uint32_t)) * maxAllocElements);
          
          if(NULL != sc)
          {
-            sc->elements             = (element_t*) (sc + 1);
-            sc->num_elements         = 0;
-            sc->max_elements         = _numSlices;
-            sc->num_slices           = _numSlices;
-            sc->param_chain_size     = _numSlices;
-            sc->param_extra_padding  = 2000;
-            sc->cur_sta              = 0.0f;
-            sc->b_output_valid       = SC_FALSE;
+            sc->elements               = (element_t*) (sc + 1);
+            sc->tmp_indices            = (uint32_t*) (sc->elements + maxAllocElements);
+            sc->num_elements           = 0;
+            sc->max_elements           = _numSlices;
+            sc->max_alloc_elements     = maxAllocElements;
+            sc->num_reserved           = 0;
+            sc->num_added              = 0;
+            sc->num_slices             = _numSlices;
+            sc->param_chain_size       = _numSlices;
+            sc->param_extra_padding    = 2000;
+            sc->param_bytes_per_sample = 2;
+            sc->param_num_channels     = 1;
+            sc->param_max_total_bytes  = 0;
+            sc->bytes_over_budget      = 0;
+            sc->num_pad_elements       = 0;
+            sc->num_unique_elements    = 0;
+            sc->cur_sta                = 0.0f;
+            sc->b_output_valid         = SC_FALSE;
 
             *_retSc = sc;
          }
@@ -211,6 +384,68 @@ static bool_t loc_set_parameter_i(samplechain_t _sc, const char *_paramName, int
             }
          }
       }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 4))
+         {
+            sc->param_bytes_per_sample = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 8))
+         {
+            sc->param_num_channels = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         if(_paramValue >= 0)
+         {
+            sc->param_max_total_bytes = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_get_parameter_i(samplechain_t _sc, const char *_paramName, int32_t *_retParamValue) {
+   bool_t ret = SC_FALSE;
+
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retParamValue))
+   {
+      ret = SC_TRUE;
+
+      if(0 == strcmp("extra_padding", _paramName))
+      {
+         *_retParamValue = sc->param_extra_padding;
+      }
+      else if(0 == strcmp("chain_size", _paramName))
+      {
+         *_retParamValue = sc->param_chain_size;
+      }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         *_retParamValue = sc->param_bytes_per_sample;
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         *_retParamValue = sc->param_num_channels;
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         *_retParamValue = sc->param_max_total_bytes;
+      }
+      else
+      {
+         ret = SC_FALSE;
+      }
    }
 
    return ret;
@@ -222,22 +457,76 @@ static bool_t loc_set_parameter_f(samplechain_t _sc, const char *_paramName, flo
    return ret;
 }
 
+// Append element (thread-safe, lock-free slot reservation)
+static bool_t loc_append(sc_t *_sc, size_t _numSampleFrames, void *_userData, bool_t _bSlotKey, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   uint32_t slot = SC_ATOMIC_ADD(&_sc->num_reserved, 1u);
+
+   if(slot < _sc->max_elements)
+   {
+      element_t *el = &_sc->elements[slot];
+
+      el->orig_sz    = _numSampleFrames;
+      el->cur_sz     = _numSampleFrames;
+      el->pad_sz     = 0;
+      el->offset     = 0;
+      el->source_idx = slot;
+      el->sort_key   = _bSlotKey ? slot : _sortKey;
+      el->user_data  = _userData;
+
+      SC_ATOMIC_STORE(&_sc->b_output_valid, SC_FALSE);
+
+      // Publish element
+      SC_ATOMIC_ADD(&_sc->num_added, 1u);
+
+      // Succeeded
+      ret = SC_TRUE;
+   }
+   else
+   {
+      // (note) undo reservation so that num_reserved does not grow without bounds
+      SC_ATOMIC_SUB(&_sc->num_reserved, 1u);
+   }
+
+   return ret;
+}
+
 static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userData) {
    bool_t ret = SC_FALSE;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      if(sc->num_elements < sc->max_elements)
-      {
-         element_t *el = &sc->elements[sc->num_elements++];
+      // (note) the ordering key is the arrival order
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_TRUE, 0u);
+   }
+
+   return ret;
+}
+
+static bool_t loc_add_with_key(samplechain_t _sc, size_t _numSampleFrames, void *_userData, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_FALSE, _sortKey);
+   }
+
+   return ret;
+}
 
-         el->orig_sz   = _numSampleFrames;
-         el->cur_sz    = _numSampleFrames;
-         el->pad_sz    = 0;
-         el->user_data = _userData;
+static bool_t loc_set_element_alias(samplechain_t _sc, uint32_t _elementIdx, uint32_t _sourceElementIdx) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
 
-         // Succeeded
+   if(NULL != sc)
+   {
+      if((_elementIdx < loc_get_num_elements(sc)) && (_sourceElementIdx <= _elementIdx))
+      {
+         // (note) always refer to the first occurence
+         sc->elements[_elementIdx].source_idx = sc->elements[_sourceElementIdx].source_idx;
+         sc->b_output_valid = SC_FALSE;
          ret = SC_TRUE;
       }
    }
@@ -245,13 +534,31 @@ static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userDat
    return ret;
 }
 
-static void loc_calc(samplechain_t _sc) {
+static bool_t loc_set_element_attribute_i(samplechain_t _sc, uint32_t _elementIdx, const char *_attrName, int32_t _attrValue) {
+   bool_t ret = SC_FALSE;
+
+   // (note) fixed-size slices have no per-element attributes (yet)
+
+   return ret;
+}
+
+static void loc_calc_chain(samplechain_t _sc) {
 
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      sc->b_output_valid = SC_FALSE;
+      sc->b_output_valid    = SC_FALSE;
+      sc->bytes_over_budget = 0;
+
+      // Discard silent elements and padding from previous calc() call, take over elements added since then
+      //  - (note) must not be called while add() is still running on other threads
+      sc->num_elements     = SC_ATOMIC_LOAD(&sc->num_added);
+      sc->num_pad_elements = 0;
+
+      loc_sort_elements(sc);
+
+      loc_restore_orig_sizes(sc);
 
       if(sc->num_elements > 0)
       {
@@ -261,14 +568,19 @@ static void loc_calc(samplechain_t _sc) {
             int32_t totalSmpSz;
             int32_t origTotalSmpSz;
             int32_t maxSmpSz;
+            int32_t extraPadding = sc->param_extra_padding;
             float32_t slcSz;
 
             totalSmpSz = loc_get_total_smp_sz(sc);
             origTotalSmpSz = totalSmpSz;
 
-            if(sc->num_elements > (uint32_t)sc->param_chain_size)
+            sc->num_unique_elements = loc_get_num_unique_elements(sc);
+
+            // (note) duplicates (aliases) count towards the chain size, i.e. they share the slice of their source
+            //         element instead of being replaced by a silent slice
+            if(sc->num_unique_elements > (uint32_t)sc->param_chain_size)
             {
-               printf("[~~~] warning: number of elements (%u) exceeds the chain size (%d), some elements will be skipped!\n", sc->num_elements, sc->param_chain_size);
+               printf("[~~~] warning: number of elements (%u) exceeds the chain size (%d), some elements will be skipped!\n", sc->num_unique_elements, sc->param_chain_size);
             }
             else if(sc->num_elements < (uint32_t)(sc->param_chain_size))
             {
@@ -279,23 +591,51 @@ static void loc_calc(samplechain_t _sc) {
                for(elementIdx = 0; elementIdx < numSilentEn; elementIdx++)
                {
                   element_t *el = &sc->elements[sc->num_elements++];
-                  el->orig_sz   = 1;
-                  el->cur_sz    = 1;
-                  el->pad_sz    = 0;
-                  el->user_data = NULL;
+                  el->orig_sz    = 1;
+                  el->cur_sz     = 1;
+                  el->pad_sz     = 0;
+                  el->source_idx = sc->num_elements - 1u;
+                  el->user_data  = NULL;
                }
 
+               sc->num_pad_elements = numSilentEn;
+               sc->num_unique_elements += numSilentEn;
             }
 
             totalSmpSz = loc_get_total_smp_sz(sc);
 
             maxSmpSz = loc_get_max_smp_sz(sc);
 
+            if(sc->param_max_total_bytes > 0)
+            {
+               if(!loc_fit_padding_to_budget(sc, maxSmpSz, &extraPadding))
+               {
+                  printf("[---] error: chain exceeds max_total_bytes (%d) by %u bytes\n",
+                         sc->param_max_total_bytes,
+                         (uint32_t)sc->bytes_over_budget
+                         );
+                  return;
+               }
+
+               if(extraPadding != sc->param_extra_padding)
+               {
+                  printf("[...] reduced extra_padding from %d to %d to fit max_total_bytes (%d)\n",
+                         sc->param_extra_padding,
+                         extraPadding,
+                         sc->param_max_total_bytes
+                         );
+               }
+            }
+
+            SC_PROFILE_COUNT(ITERATIONS, 1);
+
             sc->cur_sta = 0.0f;
-            loc_align_sizes_to(sc, (int32_t)(maxSmpSz + sc->param_extra_padding));
+            loc_align_sizes_to(sc, (int32_t)(maxSmpSz + extraPadding));
+
+            loc_update_offsets(sc);
 
             totalSmpSz = loc_get_total_smp_sz(sc);
-            slcSz = ((float32_t)totalSmpSz) / sc->num_elements;
+            slcSz = ((float32_t)totalSmpSz) / sc->num_unique_elements;
 
             // Output some stats
             //  (todo) do this in the generic part of the source (?)
@@ -316,9 +656,9 @@ static void loc_calc(samplechain_t _sc) {
 
                printf("[...] avg slice padding=%f\n", loc_calc_average_slice_padding(sc));
 
-               printf("[...] totalSmpSz=%d  /%u=%f\n", totalSmpSz, sc->num_elements, (((float32_t)totalSmpSz)/sc->num_elements));
+               printf("[...] totalSmpSz=%d  /%u=%f\n", totalSmpSz, sc->num_unique_elements, (((float32_t)totalSmpSz)/sc->num_unique_elements));
 
-               printf("[...] (%d bytes)\n", (totalSmpSz*2));
+               printf("[...] (%u bytes)\n", (uint32_t)(totalSmpSz * loc_get_frame_sz(sc)));
             }
 
             sc->b_output_valid = SC_TRUE;
@@ -327,13 +667,30 @@ static void loc_calc(samplechain_t _sc) {
    } // if sc
 }
 
+static void loc_calc(samplechain_t _sc) {
+   SC_PROFILE_BEGIN(CALC);
+
+   loc_calc_chain(_sc);
+
+   SC_PROFILE_END(CALC);
+}
+
+static bool_t loc_calc_with_deadline(samplechain_t _sc, uint32_t _budgetUs) {
+   (void)_budgetUs;
+
+   // (note) the layout is calculated in a single pass (no search), i.e. it is always optimal
+   loc_calc(_sc);
+
+   return SC_TRUE;
+}
+
 static uint32_t loc_query_num_elements(samplechain_t _sc) {
    uint32_t ret = 0;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      ret = sc->num_elements;
+      ret = loc_get_num_elements(sc);
    }
 
    return ret;
@@ -359,6 +716,18 @@ static size_t loc_query_total_size(samplechain_t _sc) {
    return ret;
 }
 
+static size_t loc_query_bytes_over_budget(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = sc->bytes_over_budget;
+   }
+
+   return ret;
+}
+
 static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx) {
    size_t ret = 0;
    sc_t *sc = (sc_t*)_sc;
@@ -369,12 +738,7 @@ static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx)
       {
          if(_elementIdx < sc->num_elements)
          {
-            uint32_t elementIdx;
-            
-            for(elementIdx = 0; elementIdx < _elementIdx; elementIdx++)
-            {
-               ret += (size_t) (sc->elements[elementIdx].cur_sz);
-            }
+            ret = (size_t) (sc->elements[_elementIdx].offset);
          }
       }
    }
@@ -392,7 +756,7 @@ static size_t loc_query_element_total_size(samplechain_t _sc, uint32_t _elementI
       {
          if(_elementIdx < sc->num_elements)
          {
-            ret = (size_t) (sc->elements[_elementIdx].cur_sz);
+            ret = (size_t) (sc->elements[sc->elements[_elementIdx].source_idx].cur_sz);
          }
       }
    }
@@ -406,9 +770,9 @@ static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _eleme
 
    if(NULL != sc)
    {
-      if(_elementIdx < sc->num_elements)
+      if(_elementIdx < loc_get_num_elements(sc))
       {
-         if(_elementIdx < sc->num_elements)
+         if(_elementIdx < loc_get_num_elements(sc))
          {
             ret = (size_t) (sc->elements[_elementIdx].orig_sz);
          }
@@ -418,15 +782,75 @@ static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _eleme
    return ret;
 }
 
+static uint32_t loc_query_layout(samplechain_t _sc, samplechain_layout_t *_retLayout, uint32_t _maxElements) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retLayout))
+   {
+      if(sc->b_output_valid)
+      {
+         uint32_t elementIdx;
+         float64_t staScale = ((float64_t)sc->num_slices) / loc_get_total_smp_sz(sc);
+
+         ret = (sc->num_elements < _maxElements) ? sc->num_elements : _maxElements;
+
+         for(elementIdx = 0; elementIdx < ret; elementIdx++)
+         {
+            const element_t *el = &sc->elements[elementIdx];
+            const element_t *srcEl = &sc->elements[el->source_idx];
+            size_t offset = (size_t) el->offset;
+
+            if(NULL != _retLayout->offsets)
+            {
+               _retLayout->offsets[elementIdx] = offset;
+            }
+
+            if(NULL != _retLayout->total_sizes)
+            {
+               _retLayout->total_sizes[elementIdx] = (size_t) srcEl->cur_sz;
+            }
+
+            if(NULL != _retLayout->orig_sizes)
+            {
+               _retLayout->orig_sizes[elementIdx] = (size_t) el->orig_sz;
+            }
+
+            if(NULL != _retLayout->pad_sizes)
+            {
+               _retLayout->pad_sizes[elementIdx] = (size_t) (srcEl->cur_sz - el->orig_sz);
+            }
+
+            if(NULL != _retLayout->sta)
+            {
+               _retLayout->sta[elementIdx] = (float32_t) (offset * staScale);
+            }
+
+            if(NULL != _retLayout->end)
+            {
+               _retLayout->end[elementIdx] = (float32_t) ((offset + srcEl->cur_sz) * staScale);
+            }
+
+            if(NULL != _retLayout->source_indices)
+            {
+               _retLayout->source_indices[elementIdx] = el->source_idx;
+            }
+         }
+      }
+   }
+
+   return ret;
+}
+
 static void *loc_query_element_user_data(samplechain_t _sc, uint32_t _elementIdx) {
    void *ret = NULL;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      if(_elementIdx < sc->num_elements)
+      if(_elementIdx < loc_get_num_elements(sc))
       {
-         if(_elementIdx < sc->num_elements)
+         if(_elementIdx < loc_get_num_elements(sc))
          {
             ret = sc->elements[_elementIdx].user_data;
          }
@@ -456,13 +880,20 @@ void bsp_samplechain_select(samplechain_algorithm_t *_algorithm) {
    _algorithm->init                        = &loc_init;
    _algorithm->set_parameter_i             = &loc_set_parameter_i;
    _algorithm->set_parameter_f             = &loc_set_parameter_f;
+   _algorithm->get_parameter_i             = &loc_get_parameter_i;
    _algorithm->add                         = &loc_add;
+   _algorithm->add_with_key                = &loc_add_with_key;
+   _algorithm->set_element_alias           = &loc_set_element_alias;
+   _algorithm->set_element_attribute_i     = &loc_set_element_attribute_i;
    _algorithm->calc                        = &loc_calc;
+   _algorithm->calc_with_deadline          = &loc_calc_with_deadline;
    _algorithm->query_num_elements          = &loc_query_num_elements;
    _algorithm->query_total_size            = &loc_query_total_size;
+   _algorithm->query_bytes_over_budget     = &loc_query_bytes_over_budget;
    _algorithm->query_element_offset        = &loc_query_element_offset;
    _algorithm->query_element_total_size    = &loc_query_element_total_size;
    _algorithm->query_element_original_size = &loc_query_element_original_size;
+   _algorithm->query_layout                = &loc_query_layout;
    _algorithm->query_element_user_data     = &loc_query_element_user_data;
    _algorithm->exit                        = &loc_exit;
 }
@@ -0,0 +1,971 @@
+/* ----
+ * ---- file   : bsp_spanchain.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../algorithm_interface_proposal.h"
+#include "../../util/profile.h"
+#include "../../util/thread.h"
+
+
+typedef struct {
+   int32_t orig_sz;
+   int32_t cur_sz;
+   int32_t pad_sz;
+   int32_t offset;
+
+   uint32_t source_idx; // != own index if this is a duplicate of an earlier element
+   uint32_t sort_key;   // final ordering key (see add_with_key())
+
+   void *user_data;
+
+} element_t;
+
+
+typedef struct {
+
+   element_t *elements;
+
+   uint32_t num_elements;       // number of elements in the current layout (incl. pad element)
+   uint32_t max_elements;       // max. number of added elements
+   uint32_t max_alloc_elements; // size of 'elements' array (incl. pad element)
+
+   uint32_t num_reserved;  // number of slots reserved by add() (atomic)
+   uint32_t num_added;     // number of elements written by add() (atomic)
+
+   uint32_t *tmp_indices;  // 2*max_alloc_elements (see loc_sort_elements())
+
+   uint32_t num_slices; // 120 for AR
+
+   int32_t param_chain_size;       // number of grid cells (0=auto)
+   int32_t param_extra_padding;    // min. number of padding frames per element
+   int32_t param_bytes_per_sample; // 2 for AR
+   int32_t param_num_channels;     // 1 for AR
+   int32_t param_max_total_bytes;  // 0=unlimited
+
+   size_t bytes_over_budget; // set by calc() when the chain does not fit into max_total_bytes
+
+   uint32_t num_cells; // number of grid cells (divides num_slices)
+   int32_t  cell_sz;   // number of sample frames per grid cell
+
+   bool_t b_pad_element; // true if calc() appended the trailing pad element (unused cells)
+   bool_t b_output_valid;
+
+} sc_t;
+
+
+// Helper fxns:
+static int32_t loc_get_total_smp_sz(sc_t *_sc) {
+   int32_t ret = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
+   {
+      ret += _sc->elements[elementIdx].cur_sz;
+   }
+
+   return ret;
+}
+
+static uint32_t loc_get_num_unique_elements(sc_t *_sc) {
+   uint32_t ret = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      if(_sc->elements[elementIdx].source_idx == elementIdx)
+      {
+         ret++;
+      }
+   }
+
+   return ret;
+}
+
+static void loc_restore_orig_sizes(sc_t *_sc) {
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      // (note) duplicates do not occupy any space in the chain
+      el->cur_sz = (el->source_idx == elementIdx) ? el->orig_sz : 0;
+      el->pad_sz = 0;
+   }
+}
+
+static void loc_update_offsets(sc_t *_sc) {
+   uint32_t elementIdx;
+   int32_t offset = 0;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      el->offset = (el->source_idx == elementIdx) ? offset : _sc->elements[el->source_idx].offset;
+
+      offset += el->cur_sz;
+   }
+}
+
+static size_t loc_get_frame_sz(sc_t *_sc) {
+   return (size_t) (_sc->param_bytes_per_sample * _sc->param_num_channels);
+}
+
+// Number of grid cells spanned by an element (waveform + padding, at least one cell)
+static uint32_t loc_get_element_num_cells(const element_t *_el, int32_t _padding, int32_t _cellSz) {
+   int32_t sz = _el->orig_sz + _padding;
+   uint32_t ret = (uint32_t) ((sz + _cellSz - 1) / _cellSz);
+
+   return (ret > 0u) ? ret : 1u;
+}
+
+// Total number of grid cells spanned by all (non-duplicate) elements
+static uint32_t loc_get_num_cells(sc_t *_sc, int32_t _padding, int32_t _cellSz) {
+   uint32_t ret = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
+   {
+      const element_t *el = &_sc->elements[elementIdx];
+
+      if(el->source_idx == elementIdx)
+      {
+         ret += loc_get_element_num_cells(el, _padding, _cellSz);
+      }
+   }
+
+   return ret;
+}
+
+// Find the smallest cell size for which all elements fit into 'numCells' grid cells
+//  - (note) the number of spanned cells does not increase with the cell size, i.e. binary search
+//  - Returns 0 if there are more (unique) elements than cells
+static int32_t loc_find_cell_sz(sc_t *_sc, int32_t _padding, uint32_t _numCells, uint32_t _numUnique) {
+   int32_t ret = 0;
+
+   if(_numUnique <= _numCells)
+   {
+      int64_t totalSz = 0;
+      int32_t maxSz = 1;
+      int32_t lo;
+      int32_t hi;
+      uint32_t elementIdx;
+
+      for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
+      {
+         const element_t *el = &_sc->elements[elementIdx];
+
+         if(el->source_idx == elementIdx)
+         {
+            int32_t sz = el->orig_sz + _padding;
+
+            totalSz += sz;
+
+            if(sz > maxSz)
+            {
+               maxSz = sz;
+            }
+         }
+      }
+
+      // (note) each element fits into a single cell of 'maxSz' frames
+      lo = (int32_t) ((totalSz + _numCells - 1u) / _numCells);
+      hi = maxSz;
+
+      if(lo < 1)
+      {
+         lo = 1;
+      }
+
+      while(lo < hi)
+      {
+         int32_t mid = lo + ((hi - lo) / 2);
+
+         SC_PROFILE_COUNT(ITERATIONS, 1);
+
+         if(loc_get_num_cells(_sc, _padding, mid) <= _numCells)
+         {
+            hi = mid;
+         }
+         else
+         {
+            lo = mid + 1;
+         }
+      }
+
+      ret = lo;
+   }
+
+   return ret;
+}
+
+// Find the grid (number of cells, cell size) with the smallest total size for the given padding
+//  - The number of cells divides 'num_slices' so that each cell is the same (integer) number of STA steps
+//  - Ties are resolved by the smaller number of cells
+//  - Returns the total size (number of sample frames), or 0 if no grid fits
+static int64_t loc_find_grid(sc_t *_sc, int32_t _padding, uint32_t *_retNumCells, int32_t *_retCellSz) {
+   int64_t ret = 0;
+   uint32_t numUnique = loc_get_num_unique_elements(_sc);
+   uint32_t numCells;
+
+   SC_PROFILE_BEGIN(LAYOUT);
+
+   for(numCells = 1u; numCells <= _sc->num_slices; numCells++)
+   {
+      if( ((_sc->num_slices % numCells) == 0u) &&
+          ((0 == _sc->param_chain_size) || (numCells == (uint32_t)_sc->param_chain_size))
+          )
+      {
+         int32_t cellSz = loc_find_cell_sz(_sc, _padding, numCells, numUnique);
+
+         if(cellSz > 0)
+         {
+            int64_t totalSz = (int64_t)numCells * cellSz;
+
+            if((0 == ret) || (totalSz < ret))
+            {
+               ret           = totalSz;
+               *_retNumCells = numCells;
+               *_retCellSz   = cellSz;
+            }
+         }
+      }
+   }
+
+   SC_PROFILE_END(LAYOUT);
+
+   return ret;
+}
+
+// Find the largest padding (< 'extra_padding') that keeps the chain within 'max_total_bytes'
+//  - (note) the total size does not decrease with the padding, i.e. binary search
+//  - Returns false and sets 'bytes_over_budget' if the chain does not fit even without padding
+static bool_t loc_fit_padding_to_budget(sc_t *_sc, int32_t *_retPadding, uint32_t *_retNumCells, int32_t *_retCellSz) {
+   bool_t ret = SC_TRUE;
+   int64_t maxFrames = (int64_t) (((size_t)_sc->param_max_total_bytes) / loc_get_frame_sz(_sc));
+   int64_t totalSz = loc_find_grid(_sc, 0, _retNumCells, _retCellSz);
+
+   if(totalSz > maxFrames)
+   {
+      _sc->bytes_over_budget = (size_t) (totalSz * (int64_t)loc_get_frame_sz(_sc)) - (size_t)_sc->param_max_total_bytes;
+      ret = SC_FALSE;
+   }
+   else
+   {
+      int32_t lo = 0;
+      int32_t hi = _sc->param_extra_padding - 1;
+
+      while(lo < hi)
+      {
+         int32_t mid = lo + ((hi - lo + 1) / 2);
+         uint32_t numCells;
+         int32_t cellSz;
+
+         if(loc_find_grid(_sc, mid, &numCells, &cellSz) <= maxFrames)
+         {
+            lo = mid;
+         }
+         else
+         {
+            hi = mid - 1;
+         }
+      }
+
+      *_retPadding = lo;
+      loc_find_grid(_sc, lo, _retNumCells, _retCellSz);
+   }
+
+   return ret;
+}
+
+// Interface impl:
+
+static const char *loc_query_algorithm_name(void) {
+   return "SpanChain (bsp)";
+}
+
+// Stable sort of the elements by their ordering key (see add_with_key())
+//  - Duplicate references are remapped so that each group refers to its first element in the new order
+static void loc_sort_elements(sc_t *_sc) {
+   uint32_t n = _sc->num_elements;
+   uint32_t *origIdx = _sc->tmp_indices;
+   uint32_t *newIdx = _sc->tmp_indices + _sc->max_alloc_elements;
+   bool_t bSorted = SC_TRUE;
+   uint32_t i;
+
+   for(i = 1u; bSorted && (i < n); i++)
+   {
+      bSorted = (_sc->elements[i - 1u].sort_key <= _sc->elements[i].sort_key);
+   }
+
+   if(!bSorted)
+   {
+      // Insertion sort (stable, the elements are usually (almost) sorted)
+      for(i = 0u; i < n; i++)
+      {
+         element_t el = _sc->elements[i];
+         uint32_t j = i;
+
+         while((j > 0u) && (_sc->elements[j - 1u].sort_key > el.sort_key))
+         {
+            _sc->elements[j] = _sc->elements[j - 1u];
+            origIdx[j]       = origIdx[j - 1u];
+            j--;
+         }
+
+         _sc->elements[j] = el;
+         origIdx[j]       = i;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         newIdx[origIdx[i]] = i;
+      }
+
+      // (note) 'origIdx' is reused to map each group (new index of its previous first element) to its new first element
+      for(i = 0u; i < n; i++)
+      {
+         origIdx[i] = ~0u;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         uint32_t groupIdx = newIdx[_sc->elements[i].source_idx];
+
+         if(~0u == origIdx[groupIdx])
+         {
+            origIdx[groupIdx] = i;
+         }
+
+         _sc->elements[i].source_idx = origIdx[groupIdx];
+      }
+   }
+}
+
+
+// Number of elements (incl. pad element after calc(), or the number of added elements if the output is not valid)
+static uint32_t loc_get_num_elements(sc_t *_sc) {
+   return _sc->b_output_valid ? _sc->num_elements : SC_ATOMIC_LOAD(&_sc->num_added);
+}
+
+static void loc_init(samplechain_t *_retSc, uint32_t _numSlices/*120 for AR*/) {
+
+   if(NULL != _retSc)
+   {
+      if(_numSlices > 0)
+      {
+         // (note) each element spans at least one cell, calc() appends one pad element
+         uint32_t maxAllocElements = _numSlices + 1u;
+         sc_t *sc = malloc(sizeof(sc_t) + (sizeof(element_t) + 2u * sizeof(uint32_t)) * maxAllocElements);
+
+         if(NULL != sc)
+         {
+            sc->elements               = (element_t*) (sc + 1);
+            sc->tmp_indices            = (uint32_t*) (sc->elements + maxAllocElements);
+            sc->num_elements           = 0;
+            sc->max_elements           = _numSlices;
+            sc->max_alloc_elements     = maxAllocElements;
+            sc->num_reserved           = 0;
+            sc->num_added              = 0;
+            sc->num_slices             = _numSlices;
+            sc->param_chain_size       = 0;
+            sc->param_extra_padding    = 2000;
+            sc->param_bytes_per_sample = 2;
+            sc->param_num_channels     = 1;
+            sc->param_max_total_bytes  = 0;
+            sc->bytes_over_budget      = 0;
+            sc->num_cells              = 0;
+            sc->cell_sz                = 0;
+            sc->b_pad_element          = SC_FALSE;
+            sc->b_output_valid         = SC_FALSE;
+
+            *_retSc = sc;
+         }
+         else
+         {
+            *_retSc = NULL;
+         }
+      }
+      else
+      {
+         *_retSc = NULL;
+      }
+   }
+}
+
+static bool_t loc_set_parameter_i(samplechain_t _sc, const char *_paramName, int32_t _paramValue) {
+   bool_t ret = SC_FALSE;
+
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(0 == strcmp("extra_padding", _paramName))
+      {
+         if(_paramValue >= 0)
+         {
+            sc->param_extra_padding = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("chain_size", _paramName))
+      {
+         if(0 == _paramValue)
+         {
+            // (note) auto: pick the number of cells with the smallest total size
+            sc->param_chain_size = 0;
+            ret = SC_TRUE;
+         }
+         else if((_paramValue > 0) && ((uint32_t)_paramValue <= sc->num_slices))
+         {
+            // Align number of cells so that the cells are evenly spread
+            while(sc->num_slices != ((sc->num_slices / (uint32_t)_paramValue) * (uint32_t)_paramValue))
+            {
+               _paramValue++;
+            }
+
+            sc->param_chain_size = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 4))
+         {
+            sc->param_bytes_per_sample = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 8))
+         {
+            sc->param_num_channels = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         if(_paramValue >= 0)
+         {
+            sc->param_max_total_bytes = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_get_parameter_i(samplechain_t _sc, const char *_paramName, int32_t *_retParamValue) {
+   bool_t ret = SC_FALSE;
+
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retParamValue))
+   {
+      ret = SC_TRUE;
+
+      if(0 == strcmp("extra_padding", _paramName))
+      {
+         *_retParamValue = sc->param_extra_padding;
+      }
+      else if(0 == strcmp("chain_size", _paramName))
+      {
+         *_retParamValue = sc->param_chain_size;
+      }
+      else if(0 == strcmp("num_cells", _paramName))
+      {
+         // (note) read-only, number of grid cells of the last calc()
+         *_retParamValue = (int32_t)sc->num_cells;
+      }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         *_retParamValue = sc->param_bytes_per_sample;
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         *_retParamValue = sc->param_num_channels;
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         *_retParamValue = sc->param_max_total_bytes;
+      }
+      else
+      {
+         ret = SC_FALSE;
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_parameter_f(samplechain_t _sc, const char *_paramName, float32_t _paramValue) {
+   bool_t ret = SC_FALSE;
+
+   return ret;
+}
+
+// Append element (thread-safe, lock-free slot reservation)
+static bool_t loc_append(sc_t *_sc, size_t _numSampleFrames, void *_userData, bool_t _bSlotKey, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   uint32_t slot = SC_ATOMIC_ADD(&_sc->num_reserved, 1u);
+
+   if(slot < _sc->max_elements)
+   {
+      element_t *el = &_sc->elements[slot];
+
+      el->orig_sz    = _numSampleFrames;
+      el->cur_sz     = _numSampleFrames;
+      el->pad_sz     = 0;
+      el->offset     = 0;
+      el->source_idx = slot;
+      el->sort_key   = _bSlotKey ? slot : _sortKey;
+      el->user_data  = _userData;
+
+      SC_ATOMIC_STORE(&_sc->b_output_valid, SC_FALSE);
+
+      // Publish element
+      SC_ATOMIC_ADD(&_sc->num_added, 1u);
+
+      // Succeeded
+      ret = SC_TRUE;
+   }
+   else
+   {
+      // (note) undo reservation so that num_reserved does not grow without bounds
+      SC_ATOMIC_SUB(&_sc->num_reserved, 1u);
+   }
+
+   return ret;
+}
+
+static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userData) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      // (note) the ordering key is the arrival order
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_TRUE, 0u);
+   }
+
+   return ret;
+}
+
+static bool_t loc_add_with_key(samplechain_t _sc, size_t _numSampleFrames, void *_userData, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_FALSE, _sortKey);
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_element_alias(samplechain_t _sc, uint32_t _elementIdx, uint32_t _sourceElementIdx) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if((_elementIdx < loc_get_num_elements(sc)) && (_sourceElementIdx <= _elementIdx))
+      {
+         // (note) always refer to the first occurence
+         sc->elements[_elementIdx].source_idx = sc->elements[_sourceElementIdx].source_idx;
+         sc->b_output_valid = SC_FALSE;
+         ret = SC_TRUE;
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_set_element_attribute_i(samplechain_t _sc, uint32_t _elementIdx, const char *_attrName, int32_t _attrValue) {
+   bool_t ret = SC_FALSE;
+
+   // (note) grid cells have no per-element attributes (yet)
+
+   return ret;
+}
+
+static void loc_calc_chain(samplechain_t _sc) {
+
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      sc->b_output_valid    = SC_FALSE;
+      sc->bytes_over_budget = 0;
+
+      // Discard pad element and padding from previous calc() call, take over elements added since then
+      //  - (note) must not be called while add() is still running on other threads
+      sc->num_elements  = SC_ATOMIC_LOAD(&sc->num_added);
+      sc->b_pad_element = SC_FALSE;
+      sc->num_cells     = 0;
+      sc->cell_sz       = 0;
+
+      loc_sort_elements(sc);
+
+      loc_restore_orig_sizes(sc);
+
+      if(sc->num_elements > 0)
+      {
+         uint32_t elementIdx;
+         int32_t origTotalSmpSz = loc_get_total_smp_sz(sc);
+         int32_t totalSmpSz;
+         int32_t padding = sc->param_extra_padding;
+         uint32_t numCells = 0;
+         int32_t cellSz = 0;
+         uint32_t numUsedCells = 0;
+         int64_t gridSz = loc_find_grid(sc, padding, &numCells, &cellSz);
+         bool_t bOk = (gridSz > 0);
+
+         if(!bOk)
+         {
+            printf("[---] error: number of elements (%u) exceeds the chain size (%d)\n", loc_get_num_unique_elements(sc), sc->param_chain_size);
+         }
+         else if((sc->param_max_total_bytes > 0) && ((gridSz * (int64_t)loc_get_frame_sz(sc)) > sc->param_max_total_bytes))
+         {
+            bOk = loc_fit_padding_to_budget(sc, &padding, &numCells, &cellSz);
+
+            if(!bOk)
+            {
+               printf("[---] error: chain exceeds max_total_bytes (%d) by %u bytes\n",
+                      sc->param_max_total_bytes,
+                      (uint32_t)sc->bytes_over_budget
+                      );
+            }
+            else
+            {
+               printf("[...] reduced extra_padding from %d to %d to fit max_total_bytes (%d)\n",
+                      sc->param_extra_padding,
+                      padding,
+                      sc->param_max_total_bytes
+                      );
+            }
+         }
+
+         if(bOk)
+         {
+            // Let each (non-duplicate) element span an integer number of cells
+            for(elementIdx = 0; elementIdx < sc->num_elements; elementIdx++)
+            {
+               element_t *el = &sc->elements[elementIdx];
+
+               if(el->source_idx == elementIdx)
+               {
+                  uint32_t numElCells = loc_get_element_num_cells(el, padding, cellSz);
+
+                  el->cur_sz = (int32_t)numElCells * cellSz;
+                  el->pad_sz = el->cur_sz - el->orig_sz;
+
+                  numUsedCells += numElCells;
+               }
+            }
+
+            // Unused cells (no filler elements)
+            if(numUsedCells < numCells)
+            {
+               element_t *el = &sc->elements[sc->num_elements++];
+
+               el->orig_sz    = 0;
+               el->cur_sz     = (int32_t)(numCells - numUsedCells) * cellSz;
+               el->pad_sz     = el->cur_sz;
+               el->source_idx = sc->num_elements - 1u;
+               el->user_data  = NULL;
+
+               sc->b_pad_element = SC_TRUE;
+            }
+
+            loc_update_offsets(sc);
+
+            sc->num_cells = numCells;
+            sc->cell_sz   = cellSz;
+
+            // Output some stats
+            totalSmpSz = loc_get_total_smp_sz(sc);
+
+            printf("[...] numCells=%u (%u used) cellSz=%d staStep=%u\n", numCells, numUsedCells, cellSz, sc->num_slices / numCells);
+            printf("[...] origTotalSmpSz=%d\n", origTotalSmpSz);
+
+            printf("[...] total padding:%d ratio to unpadded orig=%f%%\n",
+                   (totalSmpSz - origTotalSmpSz),
+                   (((float32_t)(totalSmpSz)/origTotalSmpSz)*100.0f)
+                   );
+
+            printf("[...] totalSmpSz=%d  /%u=%f\n", totalSmpSz, numCells, (((float32_t)totalSmpSz)/numCells));
+
+            printf("[...] (%u bytes)\n", (uint32_t)(totalSmpSz * loc_get_frame_sz(sc)));
+
+            sc->b_output_valid = SC_TRUE;
+         }
+      }
+   }
+}
+
+static void loc_calc(samplechain_t _sc) {
+   SC_PROFILE_BEGIN(CALC);
+
+   loc_calc_chain(_sc);
+
+   SC_PROFILE_END(CALC);
+}
+
+static bool_t loc_calc_with_deadline(samplechain_t _sc, uint32_t _budgetUs) {
+   (void)_budgetUs;
+
+   // (note) the grid search is bounded (divisors of num_slices x binary search), i.e. it always completes
+   loc_calc(_sc);
+
+   return SC_TRUE;
+}
+
+static uint32_t loc_query_num_elements(samplechain_t _sc) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = loc_get_num_elements(sc);
+   }
+
+   return ret;
+}
+
+static size_t loc_query_total_size(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(sc->b_output_valid)
+      {
+         uint32_t elementIdx;
+
+         for(elementIdx = 0; elementIdx < sc->num_elements; elementIdx++)
+         {
+            ret += (size_t) (sc->elements[elementIdx].cur_sz);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static size_t loc_query_bytes_over_budget(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = sc->bytes_over_budget;
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(sc->b_output_valid)
+      {
+         if(_elementIdx < sc->num_elements)
+         {
+            ret = (size_t) (sc->elements[_elementIdx].offset);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_total_size(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(sc->b_output_valid)
+      {
+         if(_elementIdx < sc->num_elements)
+         {
+            ret = (size_t) (sc->elements[sc->elements[_elementIdx].source_idx].cur_sz);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _elementIdx) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(_elementIdx < loc_get_num_elements(sc))
+      {
+         if(_elementIdx < loc_get_num_elements(sc))
+         {
+            ret = (size_t) (sc->elements[_elementIdx].orig_sz);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static uint32_t loc_query_layout(samplechain_t _sc, samplechain_layout_t *_retLayout, uint32_t _maxElements) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retLayout))
+   {
+      if(sc->b_output_valid)
+      {
+         uint32_t elementIdx;
+         float64_t staScale = ((float64_t)sc->num_slices) / loc_get_total_smp_sz(sc);
+
+         ret = (sc->num_elements < _maxElements) ? sc->num_elements : _maxElements;
+
+         for(elementIdx = 0; elementIdx < ret; elementIdx++)
+         {
+            const element_t *el = &sc->elements[elementIdx];
+            const element_t *srcEl = &sc->elements[el->source_idx];
+            size_t offset = (size_t) el->offset;
+
+            if(NULL != _retLayout->offsets)
+            {
+               _retLayout->offsets[elementIdx] = offset;
+            }
+
+            if(NULL != _retLayout->total_sizes)
+            {
+               _retLayout->total_sizes[elementIdx] = (size_t) srcEl->cur_sz;
+            }
+
+            if(NULL != _retLayout->orig_sizes)
+            {
+               _retLayout->orig_sizes[elementIdx] = (size_t) el->orig_sz;
+            }
+
+            if(NULL != _retLayout->pad_sizes)
+            {
+               _retLayout->pad_sizes[elementIdx] = (size_t) (srcEl->cur_sz - el->orig_sz);
+            }
+
+            if(NULL != _retLayout->sta)
+            {
+               _retLayout->sta[elementIdx] = (float32_t) (offset * staScale);
+            }
+
+            if(NULL != _retLayout->end)
+            {
+               _retLayout->end[elementIdx] = (float32_t) ((offset + srcEl->cur_sz) * staScale);
+            }
+
+            if(NULL != _retLayout->source_indices)
+            {
+               _retLayout->source_indices[elementIdx] = el->source_idx;
+            }
+         }
+      }
+   }
+
+   return ret;
+}
+
+static void *loc_query_element_user_data(samplechain_t _sc, uint32_t _elementIdx) {
+   void *ret = NULL;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(_elementIdx < loc_get_num_elements(sc))
+      {
+         if(_elementIdx < loc_get_num_elements(sc))
+         {
+            ret = sc->elements[_elementIdx].user_data;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static void loc_exit(samplechain_t *_sc) {
+
+   if(NULL != _sc)
+   {
+      sc_t *sc = (sc_t*)*_sc;
+
+      if(NULL != sc)
+      {
+         free(sc);
+         *_sc = NULL;
+      }
+   }
+}
+
+
+void bsp_spanchain_select(samplechain_algorithm_t *_algorithm) {
+
+   _algorithm->query_algorithm_name        = &loc_query_algorithm_name;
+   _algorithm->init                        = &loc_init;
+   _algorithm->set_parameter_i             = &loc_set_parameter_i;
+   _algorithm->set_parameter_f             = &loc_set_parameter_f;
+   _algorithm->get_parameter_i             = &loc_get_parameter_i;
+   _algorithm->add                         = &loc_add;
+   _algorithm->add_with_key                = &loc_add_with_key;
+   _algorithm->set_element_alias           = &loc_set_element_alias;
+   _algorithm->set_element_attribute_i     = &loc_set_element_attribute_i;
+   _algorithm->calc                        = &loc_calc;
+   _algorithm->calc_with_deadline          = &loc_calc_with_deadline;
+   _algorithm->query_num_elements          = &loc_query_num_elements;
+   _algorithm->query_total_size            = &loc_query_total_size;
+   _algorithm->query_bytes_over_budget     = &loc_query_bytes_over_budget;
+   _algorithm->query_element_offset        = &loc_query_element_offset;
+   _algorithm->query_element_total_size    = &loc_query_element_total_size;
+   _algorithm->query_element_original_size = &loc_query_element_original_size;
+   _algorithm->query_layout                = &loc_query_layout;
+   _algorithm->query_element_user_data     = &loc_query_element_user_data;
+   _algorithm->exit                        = &loc_exit;
+}
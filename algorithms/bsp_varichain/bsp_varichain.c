@@ -23,7 +23,7 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 23Mar2016
+ * ---- changed: 23Mar2016, 19Oct2026
  * ----
  * ----
  */
@@ -34,12 +34,21 @@
 #include <string.h>
 
 #include "../../algorithm_interface_proposal.h"
+#include "../../util/profile.h"
+#include "../../util/thread.h"
 
 
 typedef struct {
    int32_t orig_sz;
    int32_t cur_sz;
    int32_t pad_sz;
+   int32_t offset;
+
+   int32_t lead_silence; // number of (near-)silent frames at the start of the waveform (see "use_lead_silence")
+   int32_t gap_credit;   // lead silence of the next element in the chain (if "use_lead_silence" is enabled)
+
+   uint32_t source_idx; // != own index if this is a duplicate of an earlier element
+   uint32_t sort_key;   // final ordering key (see add_with_key())
 
    void *user_data;
 
@@ -50,16 +59,35 @@ typedef struct {
 
    element_t *elements;
 
-   uint32_t num_elements;
-   uint32_t max_elements;
+   uint32_t num_elements;       // number of elements in the current layout (incl. pad elements)
+   uint32_t max_elements;       // max. number of added elements
+   uint32_t max_alloc_elements; // size of 'elements' array (incl. pad elements)
+
+   uint32_t num_reserved;  // number of slots reserved by add() (atomic)
+   uint32_t num_added;     // number of elements written by add() (atomic)
+
+   uint32_t *tmp_indices;  // 2*max_alloc_elements (see loc_sort_elements())
 
    uint32_t num_slices; // 120 for AR
 
    int32_t extra_padding;
    int32_t min_padding;
 
+   int32_t bytes_per_sample; // 2 for AR
+   int32_t num_channels;     // 1 for AR
+   int32_t max_total_bytes;  // 0=unlimited
+
+   bool_t b_use_lead_silence; // 1=the leading silence of the next element counts toward the padding
+
+   size_t bytes_over_budget; // set by calc() when the chain does not fit into max_total_bytes
+
+   bool_t   b_deadline;  // true while calc_with_deadline() is running
+   uint64_t deadline_us; // see sc_get_time_us()
+   bool_t   b_optimal;   // false if the last calc_with_deadline() search was cut short
+
    float32_t cur_sta; // tmp when building output chain
 
+   bool_t b_pad_element; // true if calc() appended the trailing pad element
    bool_t b_output_valid;
 
 } sc_t;
@@ -99,6 +127,10 @@ static void loc_align_sizes_to(sc_t *_sc, int32_t _sz) {
 
    uint32_t elementIdx;
 
+   SC_PROFILE_BEGIN(ALIGN);
+
+   SC_PROFILE_COUNT(ALIGN_PASSES, 1);
+
    for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
    {
       element_t *el = &_sc->elements[elementIdx];
@@ -124,12 +156,18 @@ static void loc_align_sizes_to(sc_t *_sc, int32_t _sz) {
          _sc->cur_sta += ((float32_t)chSz) / _sz;
       }
    }
+
+   SC_PROFILE_END(ALIGN);
 }
 
 static void loc_align_padded_sizes_to(sc_t *_sc, int32_t _sz) {
 
    uint32_t elementIdx;
 
+   SC_PROFILE_BEGIN(ALIGN);
+
+   SC_PROFILE_COUNT(ALIGN_PASSES, 1);
+
    for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
    {
       element_t *el = &_sc->elements[elementIdx];
@@ -155,6 +193,8 @@ static void loc_align_padded_sizes_to(sc_t *_sc, int32_t _sz) {
          _sc->cur_sta += ((float32_t)chSz) / _sz;
       }
    }
+
+   SC_PROFILE_END(ALIGN);
 }
 
 static bool_t loc_are_pad_sizes_greater_than(sc_t *_sc, int32_t _sz) {
@@ -166,7 +206,10 @@ static bool_t loc_are_pad_sizes_greater_than(sc_t *_sc, int32_t _sz) {
    {
       element_t *el = &_sc->elements[elementIdx];
 
-      ret = ret && (el->pad_sz >= _sz);
+      if(el->source_idx == elementIdx)
+      {
+         ret = ret && ((el->pad_sz + el->gap_credit) >= _sz);
+      }
    }
 
    return ret;
@@ -179,7 +222,278 @@ static void loc_restore_orig_sizes(sc_t *_sc) {
    {
       element_t *el = &_sc->elements[elementIdx];
 
-      el->cur_sz = el->orig_sz;
+      // (note) duplicates do not occupy any space in the chain
+      el->cur_sz = (el->source_idx == elementIdx) ? el->orig_sz : 0;
+      el->pad_sz = 0;
+   }
+}
+
+static uint32_t loc_get_num_unique_elements(sc_t *_sc) {
+   uint32_t ret = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      if(_sc->elements[elementIdx].source_idx == elementIdx)
+      {
+         ret++;
+      }
+   }
+
+   return ret;
+}
+
+static void loc_update_offsets(sc_t *_sc) {
+   uint32_t elementIdx;
+   int32_t offset = 0;
+
+   for(elementIdx = 0; (elementIdx < _sc->num_elements); elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      el->offset = (el->source_idx == elementIdx) ? offset : _sc->elements[el->source_idx].offset;
+
+      offset += el->cur_sz;
+   }
+}
+
+static size_t loc_get_frame_sz(sc_t *_sc) {
+   return (size_t) (_sc->bytes_per_sample * _sc->num_channels);
+}
+
+static int32_t loc_get_pad_element_sz(sc_t *_sc, float32_t _slcSz) {
+   float32_t padNewNumSlices = loc_get_total_smp_sz(_sc) / _slcSz;
+
+   return (int32_t) ((_sc->num_slices - (int32_t)padNewNumSlices) * _slcSz);
+}
+
+// Determine how much of each element's padding is already provided by the lead silence of its successor
+//  - Duplicates and the last (unique) element get no credit (the pad element / wrap-around is not analysed)
+//  - Must be called after the elements have been sorted
+static void loc_update_gap_credits(sc_t *_sc) {
+   uint32_t elementIdx = _sc->num_elements;
+   int32_t nextLead = 0;
+
+   while(elementIdx-- > 0u)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      if(el->source_idx == elementIdx)
+      {
+         el->gap_credit = _sc->b_use_lead_silence ? nextLead : 0;
+
+         nextLead = (el->lead_silence < el->orig_sz) ? el->lead_silence : el->orig_sz;
+      }
+      else
+      {
+         el->gap_credit = 0;
+      }
+   }
+}
+
+// Returns true if the time budget of calc_with_deadline() has been used up
+static bool_t loc_is_deadline_expired(sc_t *_sc) {
+   return _sc->b_deadline && (sc_get_time_us() >= _sc->deadline_us);
+}
+
+// Layout chain elements using the given nominal padding (single attempt)
+//  - The gap credit (lead silence of the next element) is subtracted from the padding of each element
+//  - Returns the final slice size (number of sample frames per STA step)
+static float32_t loc_layout_pass(sc_t *_sc, int32_t _extraPadding, int32_t *_retOrigPadTotalSmpSz) {
+   uint32_t elementIdx;
+   int32_t totalSmpSz;
+   int32_t maxSmpSz;
+   float32_t maxPct;
+   int32_t maxNumSlices;
+   float32_t slcSz;
+   float32_t newNumSlices;
+
+   SC_PROFILE_BEGIN(LAYOUT);
+
+   SC_PROFILE_COUNT(ITERATIONS, 1);
+
+   // Add padding to all (non-duplicate) chain elements
+   for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
+   {
+      element_t *el = &_sc->elements[elementIdx];
+
+      if(el->source_idx == elementIdx)
+      {
+         el->cur_sz += (_extraPadding > el->gap_credit) ? (_extraPadding - el->gap_credit) : 0;
+         el->pad_sz  = el->cur_sz - el->orig_sz;
+      }
+   }
+
+   totalSmpSz = loc_get_total_smp_sz(_sc);
+
+   *_retOrigPadTotalSmpSz = totalSmpSz;
+
+   maxSmpSz = loc_get_max_smp_sz(_sc);
+
+   maxPct = ((float32_t)maxSmpSz) / totalSmpSz;
+   maxNumSlices = (int32_t)((_sc->num_slices * maxPct) + 0.5f);
+
+   slcSz = (float32_t)maxSmpSz / maxNumSlices;
+
+   _sc->cur_sta = 0.0f;
+   loc_align_sizes_to(_sc, (int32_t)slcSz);
+
+   totalSmpSz = loc_get_total_smp_sz(_sc);
+
+   printf("[...] newTotalSmpSz=%d\n", totalSmpSz);
+   newNumSlices = totalSmpSz / slcSz;
+   printf("[...] newNumSlices=%f int=%d\n", newNumSlices, (int32_t)(newNumSlices+0.5f));
+
+   slcSz = totalSmpSz / 120.0f;
+   printf("[...] newSlcSz=%f int=%d\n", slcSz, (int32_t)(slcSz+0.5f));
+
+   slcSz = (float32_t)((int32_t)(slcSz+0.5f));
+
+   _sc->cur_sta = 0.0f;
+   loc_align_padded_sizes_to(_sc, (int32_t)slcSz);
+
+   SC_PROFILE_END(LAYOUT);
+
+   return slcSz;
+}
+
+// Layout chain elements using the given nominal padding
+//  - Increases the padding (in steps of 100 frames) until all elements satisfy 'min_padding'
+//  - With a deadline (see calc_with_deadline()), the padding is first increased in exponentially growing steps
+//     to find a valid (fallback) layout quickly, then the regular search refines it until the deadline expires
+//  - Returns the final slice size (number of sample frames per STA step)
+static float32_t loc_layout(sc_t *_sc, int32_t _extraPadding, int32_t *_retIter, int32_t *_retOrigPadTotalSmpSz) {
+   int32_t origPadTotalSmpSz;
+   float32_t slcSz;
+   int32_t iter = 1;
+   int32_t extraPadding = _extraPadding;
+   int32_t step = 100;
+   int32_t validPadding = -1; // smallest padding that produced a valid layout (deadline search)
+
+   for(;;)
+   {
+      slcSz = loc_layout_pass(_sc, extraPadding, &origPadTotalSmpSz);
+
+      if(loc_are_pad_sizes_greater_than(_sc, _sc->min_padding))
+      {
+         if(!_sc->b_deadline || (extraPadding == _extraPadding) || (validPadding >= 0))
+         {
+            // (note) first valid layout of the regular search (optimal)
+            break;
+         }
+
+         // Found fallback layout, restart regular search (unless the budget has been used up)
+         validPadding = extraPadding;
+
+         if(loc_is_deadline_expired(_sc))
+         {
+            _sc->b_optimal = SC_FALSE;
+            break;
+         }
+
+         step = 100;
+         extraPadding = _extraPadding;
+      }
+      else if((validPadding >= 0) && ((extraPadding + step) >= validPadding))
+      {
+         // (note) none of the smaller paddings is valid
+         loc_restore_orig_sizes(_sc);
+         slcSz = loc_layout_pass(_sc, validPadding, &origPadTotalSmpSz);
+         break;
+      }
+      else if((validPadding >= 0) && loc_is_deadline_expired(_sc))
+      {
+         // Commit fallback layout
+         _sc->b_optimal = SC_FALSE;
+         loc_restore_orig_sizes(_sc);
+         slcSz = loc_layout_pass(_sc, validPadding, &origPadTotalSmpSz);
+         break;
+      }
+
+      loc_restore_orig_sizes(_sc);
+      extraPadding += step;
+      iter++;
+
+      if(_sc->b_deadline && (validPadding < 0) && (step < (1 << 20)))
+      {
+         step *= 2;
+      }
+   }
+
+   if(NULL != _retIter)
+   {
+      *_retIter = iter;
+   }
+
+   if(NULL != _retOrigPadTotalSmpSz)
+   {
+      *_retOrigPadTotalSmpSz = origPadTotalSmpSz;
+   }
+
+   return slcSz;
+}
+
+// Find the largest nominal padding (<= 'extra_padding') that keeps the chain within 'max_total_bytes'
+//  - Fails fast (without running the layout) when even 'min_padding' cannot fit
+//  - Returns false and sets 'bytes_over_budget' if the chain does not fit
+static bool_t loc_fit_padding_to_budget(sc_t *_sc, int32_t *_retExtraPadding) {
+   size_t frameSz = loc_get_frame_sz(_sc);
+   size_t maxBytes = (size_t)_sc->max_total_bytes;
+   size_t minBytes = (size_t)loc_get_total_smp_sz(_sc);
+   int32_t extraPadding = _sc->extra_padding;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; elementIdx < _sc->num_elements; elementIdx++)
+   {
+      const element_t *el = &_sc->elements[elementIdx];
+
+      if((el->source_idx == elementIdx) && (_sc->min_padding > el->gap_credit))
+      {
+         minBytes += (size_t) (_sc->min_padding - el->gap_credit);
+      }
+   }
+
+   minBytes *= frameSz;
+
+   if(minBytes > maxBytes)
+   {
+      _sc->bytes_over_budget = minBytes - maxBytes;
+      return SC_FALSE;
+   }
+
+   for(;;)
+   {
+      float32_t slcSz = loc_layout(_sc, extraPadding, NULL, NULL);
+      size_t chainBytes = ((size_t)loc_get_total_smp_sz(_sc) + loc_get_pad_element_sz(_sc, slcSz)) * frameSz;
+
+      loc_restore_orig_sizes(_sc);
+
+      if(chainBytes <= maxBytes)
+      {
+         *_retExtraPadding = extraPadding;
+         return SC_TRUE;
+      }
+      else if(0 == extraPadding)
+      {
+         _sc->bytes_over_budget = chainBytes - maxBytes;
+         return SC_FALSE;
+      }
+
+      if(loc_is_deadline_expired(_sc))
+      {
+         // (note) skip to the smallest padding
+         extraPadding = 0;
+         _sc->b_optimal = SC_FALSE;
+      }
+      else
+      {
+         extraPadding -= 100;
+      }
+
+      if(extraPadding < 0)
+      {
+         extraPadding = 0;
+      }
    }
 }
 
@@ -194,11 +508,74 @@ static float32_t loc_calc_average_slice_padding(sc_t *_sc) {
       padSum += el->pad_sz;
    }
 
-   return ((float32_t)padSum) / _sc->num_elements;
+   return ((float32_t)padSum) / loc_get_num_unique_elements(_sc);
 }
 
 // Interface impl:
 
+// Stable sort of the elements by their ordering key (see add_with_key())
+//  - Duplicate references are remapped so that each group refers to its first element in the new order
+static void loc_sort_elements(sc_t *_sc) {
+   uint32_t n = _sc->num_elements;
+   uint32_t *origIdx = _sc->tmp_indices;
+   uint32_t *newIdx = _sc->tmp_indices + _sc->max_alloc_elements;
+   bool_t bSorted = SC_TRUE;
+   uint32_t i;
+
+   for(i = 1u; bSorted && (i < n); i++)
+   {
+      bSorted = (_sc->elements[i - 1u].sort_key <= _sc->elements[i].sort_key);
+   }
+
+   if(!bSorted)
+   {
+      // Insertion sort (stable, the elements are usually (almost) sorted)
+      for(i = 0u; i < n; i++)
+      {
+         element_t el = _sc->elements[i];
+         uint32_t j = i;
+
+         while((j > 0u) && (_sc->elements[j - 1u].sort_key > el.sort_key))
+         {
+            _sc->elements[j] = _sc->elements[j - 1u];
+            origIdx[j]       = origIdx[j - 1u];
+            j--;
+         }
+
+         _sc->elements[j] = el;
+         origIdx[j]       = i;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         newIdx[origIdx[i]] = i;
+      }
+
+      // (note) 'origIdx' is reused to map each group (new index of its previous first element) to its new first element
+      for(i = 0u; i < n; i++)
+      {
+         origIdx[i] = ~0u;
+      }
+
+      for(i = 0u; i < n; i++)
+      {
+         uint32_t groupIdx = newIdx[_sc->elements[i].source_idx];
+
+         if(~0u == origIdx[groupIdx])
+         {
+            origIdx[groupIdx] = i;
+         }
+
+         _sc->elements[i].source_idx = origIdx[groupIdx];
+      }
+   }
+}
+
+// Number of elements (incl. pad elements after calc(), or the number of added elements if the output is not valid)
+static uint32_t loc_get_num_elements(sc_t *_sc) {
+   return _sc->b_output_valid ? _sc->num_elements : SC_ATOMIC_LOAD(&_sc->num_added);
+}
+
 static const char *loc_query_algorithm_name(void) {
    return "VariChain (bsp)";
 }
@@ -209,18 +586,33 @@ static void loc_init(samplechain_t *_retSc, uint32_t _numSlices/*120 for AR*/) {
    {
       if(_numSlices > 0)
       {
-         sc_t *sc = malloc(sizeof(sc_t) + sizeof(element_t) * (_numSlices + 1));
+         // (note) +1 for the pad element appended by calc()
+         uint32_t maxAllocElements = _numSlices + 2u;
+         sc_t *sc = malloc(sizeof(sc_t) + (sizeof(element_t) + 2u * sizeof(uint32_t)) * maxAllocElements);
          
          if(NULL != sc)
          {
-            sc->elements       = (element_t*) (sc + 1);
-            sc->num_elements   = 0;
-            sc->max_elements   = _numSlices + 1;
-            sc->num_slices     = _numSlices;
-            sc->extra_padding  = 2000;
-            sc->min_padding    = 1000;
-            sc->cur_sta        = 0.0f;
-            sc->b_output_valid = SC_FALSE;
+            sc->elements           = (element_t*) (sc + 1);
+            sc->tmp_indices        = (uint32_t*) (sc->elements + maxAllocElements);
+            sc->num_elements       = 0;
+            sc->max_elements       = _numSlices + 1;
+            sc->max_alloc_elements = maxAllocElements;
+            sc->num_reserved       = 0;
+            sc->num_added          = 0;
+            sc->num_slices         = _numSlices;
+            sc->extra_padding      = 2000;
+            sc->min_padding        = 1000;
+            sc->bytes_per_sample   = 2;
+            sc->num_channels       = 1;
+            sc->max_total_bytes    = 0;
+            sc->b_use_lead_silence = SC_FALSE;
+            sc->bytes_over_budget  = 0;
+            sc->b_deadline         = SC_FALSE;
+            sc->deadline_us        = 0u;
+            sc->b_optimal          = SC_TRUE;
+            sc->cur_sta            = 0.0f;
+            sc->b_pad_element      = SC_FALSE;
+            sc->b_output_valid     = SC_FALSE;
 
             *_retSc = sc;
          }
@@ -259,6 +651,80 @@ static bool_t loc_set_parameter_i(samplechain_t _sc, const char *_paramName, int
             ret = SC_TRUE;
          }
       }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 4))
+         {
+            sc->bytes_per_sample = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         if((_paramValue > 0) && (_paramValue <= 8))
+         {
+            sc->num_channels = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         if(_paramValue >= 0)
+         {
+            sc->max_total_bytes = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+      else if(0 == strcmp("use_lead_silence", _paramName))
+      {
+         if((0 == _paramValue) || (1 == _paramValue))
+         {
+            sc->b_use_lead_silence = _paramValue;
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_get_parameter_i(samplechain_t _sc, const char *_paramName, int32_t *_retParamValue) {
+   bool_t ret = SC_FALSE;
+
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retParamValue))
+   {
+      ret = SC_TRUE;
+
+      if(0 == strcmp("extra_padding", _paramName))
+      {
+         *_retParamValue = sc->extra_padding;
+      }
+      else if(0 == strcmp("min_padding", _paramName))
+      {
+         *_retParamValue = sc->min_padding;
+      }
+      else if(0 == strcmp("bytes_per_sample", _paramName))
+      {
+         *_retParamValue = sc->bytes_per_sample;
+      }
+      else if(0 == strcmp("num_channels", _paramName))
+      {
+         *_retParamValue = sc->num_channels;
+      }
+      else if(0 == strcmp("max_total_bytes", _paramName))
+      {
+         *_retParamValue = sc->max_total_bytes;
+      }
+      else if(0 == strcmp("use_lead_silence", _paramName))
+      {
+         *_retParamValue = sc->b_use_lead_silence;
+      }
+      else
+      {
+         ret = SC_FALSE;
+      }
    }
 
    return ret;
@@ -270,22 +736,78 @@ static bool_t loc_set_parameter_f(samplechain_t _sc, const char *_paramName, flo
    return ret;
 }
 
+// Append element (thread-safe, lock-free slot reservation)
+static bool_t loc_append(sc_t *_sc, size_t _numSampleFrames, void *_userData, bool_t _bSlotKey, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   uint32_t slot = SC_ATOMIC_ADD(&_sc->num_reserved, 1u);
+
+   if(slot < _sc->max_elements)
+   {
+      element_t *el = &_sc->elements[slot];
+
+      el->orig_sz      = _numSampleFrames;
+      el->cur_sz       = _numSampleFrames;
+      el->pad_sz       = 0;
+      el->offset       = 0;
+      el->lead_silence = 0;
+      el->gap_credit   = 0;
+      el->source_idx   = slot;
+      el->sort_key     = _bSlotKey ? slot : _sortKey;
+      el->user_data    = _userData;
+
+      SC_ATOMIC_STORE(&_sc->b_output_valid, SC_FALSE);
+
+      // Publish element
+      SC_ATOMIC_ADD(&_sc->num_added, 1u);
+
+      // Succeeded
+      ret = SC_TRUE;
+   }
+   else
+   {
+      // (note) undo reservation so that num_reserved does not grow without bounds
+      SC_ATOMIC_SUB(&_sc->num_reserved, 1u);
+   }
+
+   return ret;
+}
+
 static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userData) {
    bool_t ret = SC_FALSE;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      if(sc->num_elements < sc->max_elements)
-      {
-         element_t *el = &sc->elements[sc->num_elements++];
+      // (note) the ordering key is the arrival order
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_TRUE, 0u);
+   }
+
+   return ret;
+}
+
+static bool_t loc_add_with_key(samplechain_t _sc, size_t _numSampleFrames, void *_userData, uint32_t _sortKey) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = loc_append(sc, _numSampleFrames, _userData, SC_FALSE, _sortKey);
+   }
 
-         el->orig_sz   = _numSampleFrames;
-         el->cur_sz    = _numSampleFrames;
-         el->pad_sz    = 0;
-         el->user_data = _userData;
+   return ret;
+}
+
+static bool_t loc_set_element_alias(samplechain_t _sc, uint32_t _elementIdx, uint32_t _sourceElementIdx) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
 
-         // Succeeded
+   if(NULL != sc)
+   {
+      if((_elementIdx < loc_get_num_elements(sc)) && (_sourceElementIdx <= _elementIdx))
+      {
+         // (note) always refer to the first occurence
+         sc->elements[_elementIdx].source_idx = sc->elements[_sourceElementIdx].source_idx;
+         sc->b_output_valid = SC_FALSE;
          ret = SC_TRUE;
       }
    }
@@ -293,26 +815,56 @@ static bool_t loc_add(samplechain_t _sc, size_t _numSampleFrames, void *_userDat
    return ret;
 }
 
-static void loc_calc(samplechain_t _sc) {
+static bool_t loc_set_element_attribute_i(samplechain_t _sc, uint32_t _elementIdx, const char *_attrName, int32_t _attrValue) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      if(_elementIdx < loc_get_num_elements(sc))
+      {
+         if(0 == strcmp("lead_silence", _attrName))
+         {
+            if(_attrValue >= 0)
+            {
+               sc->elements[_elementIdx].lead_silence = _attrValue;
+               sc->b_output_valid = SC_FALSE;
+               ret = SC_TRUE;
+            }
+         }
+      }
+   }
+
+   return ret;
+}
+
+static void loc_calc_chain(samplechain_t _sc) {
 
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      sc->b_output_valid = SC_FALSE;
+      sc->b_output_valid    = SC_FALSE;
+      sc->bytes_over_budget = 0;
+
+      // Discard pad entry and padding from previous calc() call, take over elements added since then
+      //  - (note) must not be called while add() is still running on other threads
+      sc->num_elements  = SC_ATOMIC_LOAD(&sc->num_added);
+      sc->b_pad_element = SC_FALSE;
+
+      loc_sort_elements(sc);
+
+      loc_restore_orig_sizes(sc);
+
+      loc_update_gap_credits(sc);
 
       if(sc->num_elements > 0)
       {
-         uint32_t elementIdx;
          int32_t totalSmpSz;
          int32_t origTotalSmpSz;
          int32_t origPadTotalSmpSz;
-         int32_t maxSmpSz;
-         float32_t maxPct;
-         int32_t maxNumSlices;
          float32_t slcSz;
          int32_t iter = 1;
-         float32_t newNumSlices;
          int32_t extraPadding = sc->extra_padding;
          float32_t padNewNumSlices;
 
@@ -320,70 +872,52 @@ static void loc_calc(samplechain_t _sc) {
 
          origTotalSmpSz = totalSmpSz;
 
-         for(;;)
+         if(sc->max_total_bytes > 0)
          {
-            // Add padding to all chain elements
-            for(elementIdx = 0; elementIdx < sc->num_elements; elementIdx++)
+            if(!loc_fit_padding_to_budget(sc, &extraPadding))
             {
-               sc->elements[elementIdx].cur_sz += extraPadding;
+               printf("[---] error: chain exceeds max_total_bytes (%d) by %u bytes\n",
+                      sc->max_total_bytes,
+                      (uint32_t)sc->bytes_over_budget
+                      );
+               return;
             }
 
-            totalSmpSz = loc_get_total_smp_sz(sc);
-
-            origPadTotalSmpSz = totalSmpSz;
-
-            maxSmpSz = loc_get_max_smp_sz(sc);
-
-            maxPct = ((float32_t)maxSmpSz) / totalSmpSz;
-            maxNumSlices = (int32_t)((sc->num_slices * maxPct) + 0.5f);
-
-            slcSz = (float32_t)maxSmpSz / maxNumSlices;
-
-            sc->cur_sta = 0.0f;
-            loc_align_sizes_to(sc, (int32_t)slcSz);
-
-            totalSmpSz = loc_get_total_smp_sz(sc);
-
-            printf("[...] newTotalSmpSz=%d\n", totalSmpSz);
-            newNumSlices = totalSmpSz / slcSz;
-            printf("[...] newNumSlices=%f int=%d\n", newNumSlices, (int32_t)(newNumSlices+0.5f));
-
-            slcSz = totalSmpSz / 120.0f;
-            printf("[...] newSlcSz=%f int=%d\n", slcSz, (int32_t)(slcSz+0.5f));
-
-            slcSz = (float32_t)((int32_t)(slcSz+0.5f));
-
-            sc->cur_sta = 0.0f;
-            loc_align_padded_sizes_to(sc, (int32_t)slcSz);
-
-            if(loc_are_pad_sizes_greater_than(sc, sc->min_padding))
-            {
-               break;
-            }
-            else
+            if(extraPadding != sc->extra_padding)
             {
-               loc_restore_orig_sizes(sc);
-               extraPadding += 100;
-               iter++;
+               printf("[...] reduced extra_padding from %d to %d to fit max_total_bytes (%d)\n",
+                      sc->extra_padding,
+                      extraPadding,
+                      sc->max_total_bytes
+                      );
             }
          }
 
+         slcSz = loc_layout(sc, extraPadding, &iter, &origPadTotalSmpSz);
+
          totalSmpSz = loc_get_total_smp_sz(sc);
          padNewNumSlices = totalSmpSz / slcSz;
          printf("[...] padNewNumSlices=%f int=%d\n", padNewNumSlices, (int32_t)(padNewNumSlices+0.5f));
 
          // Add pad entry
          {
+            int32_t padSz = loc_get_pad_element_sz(sc, slcSz);
+
             element_t *el = &sc->elements[sc->num_elements++];
 
-            int32_t padSz = (int32_t) ((sc->num_slices - (int32_t)padNewNumSlices) * slcSz);
+            el->orig_sz      = 0;
+            el->cur_sz       = padSz;
+            el->pad_sz       = padSz;
+            el->lead_silence = 0;
+            el->gap_credit   = 0;
+            el->source_idx   = sc->num_elements - 1u;
+            el->user_data    = NULL;
 
-            el->orig_sz   = 0;
-            el->cur_sz    = padSz;
-            el->pad_sz    = padSz;
-            el->user_data = NULL;
+            sc->b_pad_element = SC_TRUE;
          }
 
+         loc_update_offsets(sc);
+
          // Output some stats
          //  (todo) do this in the generic part of the source (?)
          {
@@ -406,7 +940,7 @@ static void loc_calc(samplechain_t _sc) {
 
             printf("[...] totalSmpSz=%d  /120=%f\n", totalSmpSz, ((float32_t)(totalSmpSz)/120.0f));
 
-            printf("[...] (%d bytes)\n", (totalSmpSz*2));
+            printf("[...] (%u bytes)\n", (uint32_t)(totalSmpSz * loc_get_frame_sz(sc)));
 
             printf("[dbg] num iterations=%d\n", iter);
          }
@@ -416,13 +950,58 @@ static void loc_calc(samplechain_t _sc) {
    }
 }
 
+static void loc_calc(samplechain_t _sc) {
+   sc_t *sc = (sc_t*)_sc;
+
+   SC_PROFILE_BEGIN(CALC);
+
+   if(NULL != sc)
+   {
+      sc->b_deadline = SC_FALSE;
+      sc->b_optimal  = SC_TRUE;
+   }
+
+   loc_calc_chain(_sc);
+
+   SC_PROFILE_END(CALC);
+}
+
+static bool_t loc_calc_with_deadline(samplechain_t _sc, uint32_t _budgetUs) {
+   bool_t ret = SC_FALSE;
+   sc_t *sc = (sc_t*)_sc;
+
+   SC_PROFILE_BEGIN(CALC);
+
+   if(NULL != sc)
+   {
+      sc->b_deadline  = SC_TRUE;
+      sc->deadline_us = sc_get_time_us() + _budgetUs;
+      sc->b_optimal   = SC_TRUE;
+
+      loc_calc_chain(_sc);
+
+      sc->b_deadline = SC_FALSE;
+
+      ret = sc->b_optimal;
+
+      if(!ret)
+      {
+         printf("[...] calc deadline (%u usec) expired, layout is not optimal\n", _budgetUs);
+      }
+   }
+
+   SC_PROFILE_END(CALC);
+
+   return ret;
+}
+
 static uint32_t loc_query_num_elements(samplechain_t _sc) {
    uint32_t ret = 0;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      ret = sc->num_elements;
+      ret = loc_get_num_elements(sc);
    }
 
    return ret;
@@ -448,6 +1027,18 @@ static size_t loc_query_total_size(samplechain_t _sc) {
    return ret;
 }
 
+static size_t loc_query_bytes_over_budget(samplechain_t _sc) {
+   size_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if(NULL != sc)
+   {
+      ret = sc->bytes_over_budget;
+   }
+
+   return ret;
+}
+
 static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx) {
    size_t ret = 0;
    sc_t *sc = (sc_t*)_sc;
@@ -458,12 +1049,7 @@ static size_t loc_query_element_offset(samplechain_t _sc, uint32_t _elementIdx)
       {
          if(_elementIdx < sc->num_elements)
          {
-            uint32_t elementIdx;
-            
-            for(elementIdx = 0; elementIdx < _elementIdx; elementIdx++)
-            {
-               ret += (size_t) (sc->elements[elementIdx].cur_sz);
-            }
+            ret = (size_t) (sc->elements[_elementIdx].offset);
          }
       }
    }
@@ -481,7 +1067,7 @@ static size_t loc_query_element_total_size(samplechain_t _sc, uint32_t _elementI
       {
          if(_elementIdx < sc->num_elements)
          {
-            ret = (size_t) (sc->elements[_elementIdx].cur_sz);
+            ret = (size_t) (sc->elements[sc->elements[_elementIdx].source_idx].cur_sz);
          }
       }
    }
@@ -495,9 +1081,9 @@ static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _eleme
 
    if(NULL != sc)
    {
-      if(_elementIdx < sc->num_elements)
+      if(_elementIdx < loc_get_num_elements(sc))
       {
-         if(_elementIdx < sc->num_elements)
+         if(_elementIdx < loc_get_num_elements(sc))
          {
             ret = (size_t) (sc->elements[_elementIdx].orig_sz);
          }
@@ -507,15 +1093,75 @@ static size_t loc_query_element_original_size(samplechain_t _sc, uint32_t _eleme
    return ret;
 }
 
+static uint32_t loc_query_layout(samplechain_t _sc, samplechain_layout_t *_retLayout, uint32_t _maxElements) {
+   uint32_t ret = 0;
+   sc_t *sc = (sc_t*)_sc;
+
+   if((NULL != sc) && (NULL != _retLayout))
+   {
+      if(sc->b_output_valid)
+      {
+         uint32_t elementIdx;
+         float64_t staScale = ((float64_t)sc->num_slices) / loc_get_total_smp_sz(sc);
+
+         ret = (sc->num_elements < _maxElements) ? sc->num_elements : _maxElements;
+
+         for(elementIdx = 0; elementIdx < ret; elementIdx++)
+         {
+            const element_t *el = &sc->elements[elementIdx];
+            const element_t *srcEl = &sc->elements[el->source_idx];
+            size_t offset = (size_t) el->offset;
+
+            if(NULL != _retLayout->offsets)
+            {
+               _retLayout->offsets[elementIdx] = offset;
+            }
+
+            if(NULL != _retLayout->total_sizes)
+            {
+               _retLayout->total_sizes[elementIdx] = (size_t) srcEl->cur_sz;
+            }
+
+            if(NULL != _retLayout->orig_sizes)
+            {
+               _retLayout->orig_sizes[elementIdx] = (size_t) el->orig_sz;
+            }
+
+            if(NULL != _retLayout->pad_sizes)
+            {
+               _retLayout->pad_sizes[elementIdx] = (size_t) (srcEl->cur_sz - el->orig_sz);
+            }
+
+            if(NULL != _retLayout->sta)
+            {
+               _retLayout->sta[elementIdx] = (float32_t) (offset * staScale);
+            }
+
+            if(NULL != _retLayout->end)
+            {
+               _retLayout->end[elementIdx] = (float32_t) ((offset + srcEl->cur_sz) * staScale);
+            }
+
+            if(NULL != _retLayout->source_indices)
+            {
+               _retLayout->source_indices[elementIdx] = el->source_idx;
+            }
+         }
+      }
+   }
+
+   return ret;
+}
+
 static void *loc_query_element_user_data(samplechain_t _sc, uint32_t _elementIdx) {
    void *ret = NULL;
    sc_t *sc = (sc_t*)_sc;
 
    if(NULL != sc)
    {
-      if(_elementIdx < sc->num_elements)
+      if(_elementIdx < loc_get_num_elements(sc))
       {
-         if(_elementIdx < sc->num_elements)
+         if(_elementIdx < loc_get_num_elements(sc))
          {
             ret = sc->elements[_elementIdx].user_data;
          }
@@ -545,13 +1191,20 @@ void bsp_varichain_select(samplechain_algorithm_t *_algorithm) {
    _algorithm->init                        = &loc_init;
    _algorithm->set_parameter_i             = &loc_set_parameter_i;
    _algorithm->set_parameter_f             = &loc_set_parameter_f;
+   _algorithm->get_parameter_i             = &loc_get_parameter_i;
    _algorithm->add                         = &loc_add;
+   _algorithm->add_with_key                = &loc_add_with_key;
+   _algorithm->set_element_alias           = &loc_set_element_alias;
+   _algorithm->set_element_attribute_i     = &loc_set_element_attribute_i;
    _algorithm->calc                        = &loc_calc;
+   _algorithm->calc_with_deadline          = &loc_calc_with_deadline;
    _algorithm->query_num_elements          = &loc_query_num_elements;
    _algorithm->query_total_size            = &loc_query_total_size;
+   _algorithm->query_bytes_over_budget     = &loc_query_bytes_over_budget;
    _algorithm->query_element_offset        = &loc_query_element_offset;
    _algorithm->query_element_total_size    = &loc_query_element_total_size;
    _algorithm->query_element_original_size = &loc_query_element_original_size;
+   _algorithm->query_layout                = &loc_query_layout;
    _algorithm->query_element_user_data     = &loc_query_element_user_data;
    _algorithm->exit                        = &loc_exit;
 }
@@ -0,0 +1,283 @@
+/* ----
+ * ---- file   : dedup.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "metadata.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "dedup.h"
+
+
+typedef struct {
+   const samplechain_algorithm_t *alg;
+   samplechain_t                  sc;
+
+   const samplechain_render_params_t *params;
+
+   uint32_t num_channels;
+
+   samplechain_source_t *sources;
+   uint64_t             *hashes;
+
+} dedup_t;
+
+
+static void loc_hash_element_job(void *_ctx, uint32_t _elementIdx) {
+   dedup_t *dd = (dedup_t*)_ctx;
+   samplechain_source_t *src = &dd->sources[_elementIdx];
+   void *userData = dd->alg->query_element_user_data(dd->sc, _elementIdx);
+   size_t origSz = dd->alg->query_element_original_size(dd->sc, _elementIdx);
+
+   src->frames     = NULL;
+   src->num_frames = 0;
+
+   dd->hashes[_elementIdx] = 0u;
+
+   // (note) derived elements are transformed while rendering, i.e. their source audio is not the element audio
+   if((NULL != userData) && (NULL != dd->params->derived))
+   {
+      if(NULL != dd->params->derived(dd->params->fetch_ctx, userData))
+      {
+         userData = NULL;
+      }
+   }
+
+   if((NULL != userData) && (origSz > 0))
+   {
+      if(NULL != dd->params->fetch)
+      {
+         if(!dd->params->fetch(dd->params->fetch_ctx, userData, origSz, src))
+         {
+            src->frames     = NULL;
+            src->num_frames = 0;
+         }
+      }
+      else
+      {
+         src->frames     = (const float32_t*)userData;
+         src->num_frames = origSz;
+      }
+
+      if(NULL != src->frames)
+      {
+         dd->hashes[_elementIdx] = sc_kernel_hash(src->frames, sizeof(float32_t) * src->num_frames * dd->num_channels, 0u);
+      }
+   }
+}
+
+uint32_t samplechain_dedup(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                           const samplechain_render_params_t *_params
+                           ) {
+   uint32_t ret = 0;
+
+   if((NULL != _alg) && (NULL != _params))
+   {
+      uint32_t n = _alg->query_num_elements(_sc);
+      dedup_t dd;
+
+      dd.sources = malloc(n * (sizeof(samplechain_source_t) + sizeof(uint64_t)));
+
+      if(NULL != dd.sources)
+      {
+         int32_t numChannels = 1;
+         uint32_t elementIdx;
+
+         _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+         dd.alg          = _alg;
+         dd.sc           = _sc;
+         dd.params       = _params;
+         dd.num_channels = (uint32_t)numChannels;
+         dd.hashes       = (uint64_t*) (dd.sources + n);
+
+         sc_parallel_for(n, &loc_hash_element_job, &dd, _params->num_threads);
+
+         for(elementIdx = 1; elementIdx < n; elementIdx++)
+         {
+            const samplechain_source_t *src = &dd.sources[elementIdx];
+            uint32_t cmpIdx;
+
+            if(NULL != src->frames)
+            {
+               for(cmpIdx = 0; cmpIdx < elementIdx; cmpIdx++)
+               {
+                  const samplechain_source_t *cmpSrc = &dd.sources[cmpIdx];
+
+                  // (note) full compare in case of hash collisions
+                  if( (dd.hashes[cmpIdx] == dd.hashes[elementIdx]) &&
+                      (cmpSrc->num_frames == src->num_frames)      &&
+                      (NULL != cmpSrc->frames)                     &&
+                      ( (cmpSrc->frames == src->frames) ||
+                        (0 == memcmp(cmpSrc->frames, src->frames, sizeof(float32_t) * src->num_frames * dd.num_channels)) )
+                      )
+                  {
+                     if(_alg->set_element_alias(_sc, elementIdx, cmpIdx))
+                     {
+                        ret++;
+                     }
+                     break;
+                  }
+               }
+            }
+         }
+
+         // Release the fetched element audio (e.g. unpin cache entries)
+         if((NULL != _params->fetch) && (NULL != _params->release))
+         {
+            for(elementIdx = 0; elementIdx < n; elementIdx++)
+            {
+               if(NULL != dd.sources[elementIdx].frames)
+               {
+                  _params->release(_params->fetch_ctx, _alg->query_element_user_data(_sc, elementIdx), &dd.sources[elementIdx]);
+               }
+            }
+         }
+
+         free(dd.sources);
+      }
+   }
+
+   return ret;
+}
+
+// Fetch element audio (once, see samplechain_dedup_metadata())
+//  - Returns NULL if the audio is not available (or shorter than the analyzed audio)
+static const float32_t *loc_fetch_metadata_element(const samplechain_element_metadata_t *_el, samplechain_source_t *_src, bool_t *_bFetched,
+                                                   const samplechain_render_params_t *_params
+                                                   ) {
+   if(!*_bFetched)
+   {
+      *_bFetched = SC_TRUE;
+
+      if(NULL != _params->fetch)
+      {
+         if(!_params->fetch(_params->fetch_ctx, _el->user_data, _el->num_frames, _src))
+         {
+            _src->frames     = NULL;
+            _src->num_frames = 0;
+         }
+      }
+      else
+      {
+         _src->frames     = (const float32_t*)_el->user_data;
+         _src->num_frames = _el->num_frames;
+      }
+   }
+
+   return (_src->num_frames >= _el->num_frames) ? _src->frames : NULL;
+}
+
+uint32_t samplechain_dedup_metadata(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                    const samplechain_metadata_t *_md,
+                                    const samplechain_render_params_t *_params
+                                    ) {
+   uint32_t ret = 0;
+
+   if((NULL != _alg) && (NULL != _md) && (NULL != _params) && (_md->num_elements == _alg->query_num_elements(_sc)))
+   {
+      uint32_t n = _md->num_elements;
+      samplechain_source_t *sources = malloc(n * (sizeof(samplechain_source_t) + sizeof(bool_t)));
+
+      if(NULL != sources)
+      {
+         bool_t *bFetched = (bool_t*) (sources + n);
+         int32_t numChannels = 1;
+         uint32_t elementIdx;
+
+         _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+         memset(bFetched, 0, sizeof(bool_t) * n);
+
+         for(elementIdx = 1; elementIdx < n; elementIdx++)
+         {
+            const samplechain_element_metadata_t *el = &_md->elements[elementIdx];
+            uint32_t cmpIdx;
+
+            if(el->b_valid && !el->b_derived && (el->user_data == _alg->query_element_user_data(_sc, elementIdx)))
+            {
+               for(cmpIdx = 0; cmpIdx < elementIdx; cmpIdx++)
+               {
+                  const samplechain_element_metadata_t *cmpEl = &_md->elements[cmpIdx];
+
+                  if( cmpEl->b_valid && !cmpEl->b_derived             &&
+                      (cmpEl->hash == el->hash)                       &&
+                      (cmpEl->num_frames == el->num_frames)           &&
+                      (cmpEl->user_data == _alg->query_element_user_data(_sc, cmpIdx))
+                      )
+                  {
+                     bool_t bEqual = (cmpEl->user_data == el->user_data);
+
+                     // (note) full compare in case of hash collisions
+                     if(!bEqual)
+                     {
+                        const float32_t *frames = loc_fetch_metadata_element(el, &sources[elementIdx], &bFetched[elementIdx], _params);
+                        const float32_t *cmpFrames = loc_fetch_metadata_element(cmpEl, &sources[cmpIdx], &bFetched[cmpIdx], _params);
+
+                        bEqual = (NULL != frames) && (NULL != cmpFrames) &&
+                           ( (frames == cmpFrames) ||
+                             (0 == memcmp(frames, cmpFrames, sizeof(float32_t) * el->num_frames * (uint32_t)numChannels)) );
+                     }
+
+                     if(bEqual)
+                     {
+                        if(_alg->set_element_alias(_sc, elementIdx, cmpIdx))
+                        {
+                           ret++;
+                        }
+                        break;
+                     }
+                  }
+               }
+            }
+         }
+
+         // Release the fetched element audio (e.g. unpin cache entries)
+         if((NULL != _params->fetch) && (NULL != _params->release))
+         {
+            for(elementIdx = 0; elementIdx < n; elementIdx++)
+            {
+               if(bFetched[elementIdx] && (NULL != sources[elementIdx].frames))
+               {
+                  _params->release(_params->fetch_ctx, _md->elements[elementIdx].user_data, &sources[elementIdx]);
+               }
+            }
+         }
+
+         free(sources);
+      }
+   }
+
+   return ret;
+}
@@ -0,0 +1,62 @@
+/* ----
+ * ---- file   : dedup.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_DEDUP_H_INCLUDED
+#define SAMPLECHAIN_DEDUP_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Find elements with identical audio content and mark them as duplicates (see set_element_alias())
+//  - Must be called after all elements have been added and before 'calc'
+//  - The element audio is resolved via the 'fetch' fxn of 'params' (NULL=user_data points to the interleaved float frames)
+//     and released (see samplechain_release_fxn_t) before the function returns
+//  - Derived elements (see samplechain_derived_t) are skipped, i.e. they are never marked as duplicates
+//  - Content hashes are calculated in parallel ('num_threads' of 'params'). Elements with equal hashes are compared sample by sample
+//  - Returns the number of duplicates
+uint32_t samplechain_dedup (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                            const samplechain_render_params_t *_params
+                            );
+
+// Same as samplechain_dedup() but uses the content hashes of precalculated element metadata (see analysis/metadata.h)
+//  - Only elements with equal hashes and sizes are fetched via 'params' (and compared sample by sample).
+//     The fetched elements are released before the function returns
+//  - Derived elements and elements whose user_data changed since the analysis are skipped
+//  - Returns the number of duplicates
+uint32_t samplechain_dedup_metadata (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                     const struct samplechain_metadata_s *_md,
+                                     const samplechain_render_params_t *_params
+                                     );
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_DEDUP_H_INCLUDED
@@ -0,0 +1,88 @@
+/* ----
+ * ---- file   : loudness.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+#include "loudness.h"
+
+
+void samplechain_loudness_analyze(const float32_t *_frames, size_t _numFrames, uint32_t _numChannels, samplechain_loudness_t *_retLoudness) {
+
+   if(NULL != _retLoudness)
+   {
+      size_t numSamples = _numFrames * _numChannels;
+
+      _retLoudness->peak = 0.0f;
+      _retLoudness->rms  = 0.0f;
+
+      if((NULL != _frames) && (numSamples > 0))
+      {
+         float32_t sumSq = sc_kernel_peak_sum_squares(_frames, numSamples, &_retLoudness->peak);
+
+         _retLoudness->rms = sqrtf(sumSq / numSamples);
+      }
+   }
+}
+
+float32_t samplechain_loudness_calc_gain(const samplechain_loudness_t *_loudness, uint32_t _normalizeMode, float32_t _levelDb) {
+   float32_t ret = 1.0f;
+
+   if(NULL != _loudness)
+   {
+      float32_t level = powf(10.0f, _levelDb / 20.0f);
+
+      switch(_normalizeMode)
+      {
+         default:
+         case SC_NORMALIZE_NONE:
+            break;
+
+         case SC_NORMALIZE_PEAK:
+            if(_loudness->peak > 0.0f)
+            {
+               ret = level / _loudness->peak;
+            }
+            break;
+
+         case SC_NORMALIZE_RMS:
+            if(_loudness->rms > 0.0f)
+            {
+               ret = level / _loudness->rms;
+            }
+            break;
+      }
+   }
+
+   return ret;
+}
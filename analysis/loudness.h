@@ -0,0 +1,60 @@
+/* ----
+ * ---- file   : loudness.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_LOUDNESS_H_INCLUDED
+#define SAMPLECHAIN_LOUDNESS_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Normalization modes
+#define SC_NORMALIZE_NONE  0
+#define SC_NORMALIZE_PEAK  1
+#define SC_NORMALIZE_RMS   2
+
+
+typedef struct {
+   float32_t peak;  // absolute peak sample value
+   float32_t rms;   // root mean square of all samples
+} samplechain_loudness_t;
+
+
+// Calculate peak and RMS level of 'numFrames' interleaved float sample frames
+void samplechain_loudness_analyze (const float32_t *_frames, size_t _numFrames, uint32_t _numChannels, samplechain_loudness_t *_retLoudness);
+
+// Calculate the gain factor that normalizes an element to the given peak / RMS level (dBFS)
+//  - Returns 1 for silent elements and SC_NORMALIZE_NONE
+float32_t samplechain_loudness_calc_gain (const samplechain_loudness_t *_loudness, uint32_t _normalizeMode, float32_t _levelDb);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_LOUDNESS_H_INCLUDED
@@ -0,0 +1,242 @@
+/* ----
+ * ---- file   : analysis/metadata.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "metadata.h"
+
+
+typedef struct {
+   const samplechain_algorithm_t     *alg;
+   samplechain_t                      sc;
+   const samplechain_render_params_t *params;
+
+   uint32_t  num_channels;
+   float32_t silence_db;
+
+   samplechain_metadata_t *md;
+
+} metadata_job_t;
+
+
+static void loc_analyze_element_job(void *_ctx, uint32_t _elementIdx) {
+   metadata_job_t *job = (metadata_job_t*)_ctx;
+   const samplechain_render_params_t *params = job->params;
+   samplechain_element_metadata_t *el = &job->md->elements[_elementIdx];
+   void *userData = job->alg->query_element_user_data(job->sc, _elementIdx);
+   size_t origSz = job->alg->query_element_original_size(job->sc, _elementIdx);
+   const samplechain_derived_t *derived = NULL;
+   samplechain_source_t src;
+
+   memset(el, 0, sizeof(samplechain_element_metadata_t));
+
+   el->user_data = userData;
+
+   if((NULL != userData) && (NULL != params->derived))
+   {
+      derived = params->derived(params->fetch_ctx, userData);
+
+      if(NULL != derived)
+      {
+         userData = derived->source_user_data;
+         origSz   = derived->source_num_frames;
+
+         el->b_derived = SC_TRUE;
+      }
+   }
+
+   if((NULL != userData) && (origSz > 0))
+   {
+      src.frames     = NULL;
+      src.num_frames = 0;
+
+      if(NULL != params->fetch)
+      {
+         if(!params->fetch(params->fetch_ctx, userData, origSz, &src))
+         {
+            src.frames     = NULL;
+            src.num_frames = 0;
+         }
+      }
+      else
+      {
+         src.frames     = (const float32_t*)userData;
+         src.num_frames = origSz;
+      }
+
+      if(NULL != src.frames)
+      {
+         const float32_t *frames = src.frames;
+         size_t numFrames = (src.num_frames < origSz) ? src.num_frames : origSz;
+
+         if(NULL != derived)
+         {
+            // (note) source sub-range, same as the render normalization
+            size_t start = (derived->start < numFrames) ? derived->start : numFrames;
+
+            numFrames -= start;
+            frames    += start * job->num_channels;
+
+            if((0 != derived->num_frames) && (derived->num_frames < numFrames))
+            {
+               numFrames = derived->num_frames;
+            }
+         }
+
+         samplechain_metadata_analyze(frames, numFrames, job->num_channels, job->silence_db, el);
+
+         if((NULL != params->fetch) && (NULL != params->release))
+         {
+            params->release(params->fetch_ctx, userData, &src);
+         }
+      }
+   }
+}
+
+void samplechain_metadata_analyze(const float32_t *_frames, size_t _numFrames, uint32_t _numChannels, float32_t _silenceDb,
+                                  samplechain_element_metadata_t *_retMetadata
+                                  ) {
+
+   if(NULL != _retMetadata)
+   {
+      samplechain_element_metadata_t *el = _retMetadata;
+
+      el->b_valid            = SC_FALSE;
+      el->num_frames         = 0;
+      el->peak               = 0.0f;
+      el->rms                = 0.0f;
+      el->lead_silence       = 0;
+      el->trail_silence      = 0;
+      el->last_zero_crossing = 0;
+      el->hash               = 0u;
+      el->peak_frames        = 0;
+      el->num_peaks          = 0;
+
+      if((NULL != _frames) && (_numFrames > 0) && (_numChannels > 0))
+      {
+         sc_kernel_analysis_t a;
+         size_t numSamples = _numFrames * _numChannels;
+         size_t peakFrames = (_numFrames + SC_METADATA_NUM_PEAKS - 1u) / SC_METADATA_NUM_PEAKS;
+
+         // (note) the kernel block size must be a multiple of 8 samples
+         peakFrames = (peakFrames + 7u) & ~(size_t)7u;
+
+         sc_kernel_analyze(_frames, numSamples, _numChannels,
+                           powf(10.0f, _silenceDb / 20.0f),
+                           peakFrames * _numChannels, el->peaks,
+                           &a
+                           );
+
+         el->b_valid            = SC_TRUE;
+         el->num_frames         = _numFrames;
+         el->peak               = a.peak;
+         el->rms                = sqrtf(a.sum_squares / numSamples);
+         el->lead_silence       = a.first_loud / _numChannels;
+         el->trail_silence      = _numFrames - ((a.end_loud + _numChannels - 1u) / _numChannels);
+         el->last_zero_crossing = a.last_zero_crossing / _numChannels;
+         el->hash               = a.hash;
+         el->peak_frames        = peakFrames;
+         el->num_peaks          = (uint32_t) ((_numFrames + peakFrames - 1u) / peakFrames);
+      }
+   }
+}
+
+samplechain_metadata_t *samplechain_metadata_create(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                    const samplechain_render_params_t *_params,
+                                                    float32_t _silenceDb
+                                                    ) {
+   samplechain_metadata_t *ret = NULL;
+
+   if((NULL != _alg) && (NULL != _params))
+   {
+      uint32_t n = _alg->query_num_elements(_sc);
+
+      ret = malloc(sizeof(samplechain_metadata_t) + (n * sizeof(samplechain_element_metadata_t)));
+
+      if(NULL != ret)
+      {
+         int32_t numChannels = 1;
+         metadata_job_t job;
+
+         _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+         ret->num_elements = n;
+         ret->elements     = (samplechain_element_metadata_t*) (ret + 1);
+
+         job.alg          = _alg;
+         job.sc           = _sc;
+         job.params       = _params;
+         job.num_channels = (uint32_t)numChannels;
+         job.silence_db   = _silenceDb;
+         job.md           = ret;
+
+         sc_parallel_for(n, &loc_analyze_element_job, &job, _params->num_threads);
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_metadata_destroy(samplechain_metadata_t *_md) {
+   free(_md);
+}
+
+uint32_t samplechain_metadata_set_lead_silence(const samplechain_algorithm_t *_alg, samplechain_t _sc, const samplechain_metadata_t *_md) {
+   uint32_t ret = 0;
+
+   if((NULL != _alg) && (NULL != _md) && (NULL != _alg->set_element_attribute_i))
+   {
+      uint32_t elementIdx;
+
+      for(elementIdx = 0; elementIdx < _md->num_elements; elementIdx++)
+      {
+         const samplechain_element_metadata_t *el = &_md->elements[elementIdx];
+
+         if(el->b_valid && !el->b_derived && (el->lead_silence <= INT32_MAX))
+         {
+            if(!_alg->set_element_attribute_i(_sc, elementIdx, "lead_silence", (int32_t)el->lead_silence))
+            {
+               break;
+            }
+
+            ret++;
+         }
+      }
+   }
+
+   return ret;
+}
@@ -0,0 +1,94 @@
+/* ----
+ * ---- file   : analysis/metadata.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_METADATA_H_INCLUDED
+#define SAMPLECHAIN_METADATA_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_METADATA_NUM_PEAKS  32u  // max. number of coarse peaks per element
+
+
+// Audio metadata of one element
+typedef struct {
+   void      *user_data;           // element user_data at analysis time
+   bool_t     b_valid;             // false if the element audio was not available (or empty)
+   bool_t     b_derived;           // true if the element is a derived element (the source sub-range was analyzed)
+   size_t     num_frames;          // number of analyzed sample frames
+   float32_t  peak;                // absolute peak sample value
+   float32_t  rms;                 // root mean square of all samples (see samplechain_loudness_analyze())
+   size_t     lead_silence;        // number of (near-)silent frames at the start ('num_frames' if the element is silent)
+   size_t     trail_silence;       // number of (near-)silent frames at the end ('num_frames' if the element is silent)
+   size_t     last_zero_crossing;  // last frame at which a channel changes its sign (0 if there is none)
+   uint64_t   hash;                // content hash (same as samplechain_dedup())
+   size_t     peak_frames;         // number of sample frames per coarse peak (multiple of 8)
+   uint32_t   num_peaks;           // number of coarse peaks (<= SC_METADATA_NUM_PEAKS)
+   float32_t  peaks[SC_METADATA_NUM_PEAKS];  // absolute peak of each 'peak_frames' block (e.g. for thumbnails)
+} samplechain_element_metadata_t;
+
+// Audio metadata of all elements of a chain
+typedef struct samplechain_metadata_s {
+   uint32_t                         num_elements;
+   samplechain_element_metadata_t  *elements;
+} samplechain_metadata_t;
+
+
+// Analyze 'numFrames' interleaved float sample frames in a single pass (see sc_kernel_analyze())
+//  - 'silenceDb' is the peak level (dBFS) below which a frame counts as silent (see samplechain_onset_find_lead_silence())
+//  - Does not touch 'user_data' / 'b_derived'
+void samplechain_metadata_analyze (const float32_t *_frames, size_t _numFrames, uint32_t _numChannels, float32_t _silenceDb,
+                                   samplechain_element_metadata_t *_retMetadata
+                                   );
+
+// Analyze all elements of a chain
+//  - The element audio is resolved like samplechain_render() does it (via the 'fetch' / 'release' / 'derived' fxns
+//     and 'num_threads' of 'params'), i.e. the metadata can be calculated before 'calc'
+//  - Each element is read once, elements are analyzed in parallel
+//  - Element indices refer to the arrival order until 'calc' has been called (see add_with_key())
+//  - Returns NULL if the metadata could not be allocated
+samplechain_metadata_t *samplechain_metadata_create (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                     const samplechain_render_params_t *_params,
+                                                     float32_t _silenceDb
+                                                     );
+
+// Free metadata
+void samplechain_metadata_destroy (samplechain_metadata_t *_md);
+
+// Set the "lead_silence" element attribute of all analyzed regular elements (see bsp_varichain "use_lead_silence")
+//  - Must be called before 'calc'
+//  - Returns the number of elements whose attribute was set (0 if the algorithm does not support the attribute)
+uint32_t samplechain_metadata_set_lead_silence (const samplechain_algorithm_t *_alg, samplechain_t _sc, const samplechain_metadata_t *_md);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_METADATA_H_INCLUDED
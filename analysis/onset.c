@@ -0,0 +1,204 @@
+/* ----
+ * ---- file   : onset.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "onset.h"
+
+// Number of analysis blocks per parallel job
+#define SC_ONSET_BLOCKS_PER_JOB  16384u
+
+
+typedef struct {
+   const samplechain_onset_params_t *params;
+
+   const float32_t *frames;
+   size_t num_frames;
+
+   float32_t *energies;
+   size_t num_blocks;
+
+} onset_job_t;
+
+
+static void loc_calc_block_energies(void *_ctx, uint32_t _jobIdx) {
+   onset_job_t *job = (onset_job_t*)_ctx;
+   size_t blockSz = job->params->block_size;
+   size_t numCh = job->params->num_channels;
+   size_t blockIdx = ((size_t)_jobIdx) * SC_ONSET_BLOCKS_PER_JOB;
+   size_t blockIdxEnd = blockIdx + SC_ONSET_BLOCKS_PER_JOB;
+
+   if(blockIdxEnd > job->num_blocks)
+   {
+      blockIdxEnd = job->num_blocks;
+   }
+
+   for(; blockIdx < blockIdxEnd; blockIdx++)
+   {
+      size_t frameOff = blockIdx * blockSz;
+      size_t numFrames = blockSz;
+
+      if((frameOff + numFrames) > job->num_frames)
+      {
+         numFrames = job->num_frames - frameOff;
+      }
+
+      job->energies[blockIdx] =
+         sc_kernel_sum_squares(job->frames + (frameOff * numCh), numFrames * numCh) / (float32_t)(numFrames * numCh);
+   }
+}
+
+void samplechain_onset_init_params(samplechain_onset_params_t *_params) {
+
+   if(NULL != _params)
+   {
+      _params->num_channels   = 1;
+      _params->block_size     = 256;
+      _params->rise_db        = 9.0f;
+      _params->silence_db     = -50.0f;
+      _params->min_slice_size = 4800;
+      _params->num_threads    = 0;
+   }
+}
+
+uint32_t samplechain_onset_detect(const samplechain_onset_params_t *_params,
+                                  const float32_t *_frames, size_t _numFrames,
+                                  size_t *_retOnsets, uint32_t _maxOnsets
+                                  ) {
+   uint32_t ret = 0;
+
+   if((NULL != _params) && (NULL != _frames) && (NULL != _retOnsets) && (_params->block_size > 0) && (_params->num_channels > 0))
+   {
+      onset_job_t job;
+
+      job.params     = _params;
+      job.frames     = _frames;
+      job.num_frames = _numFrames;
+      job.num_blocks = (_numFrames + _params->block_size - 1u) / _params->block_size;
+      job.energies   = malloc(sizeof(float32_t) * job.num_blocks);
+
+      if(NULL != job.energies)
+      {
+         // (note) energies are mean squares, i.e. dB thresholds are converted via 10^(dB/10)
+         float32_t riseRatio = powf(10.0f, _params->rise_db / 10.0f);
+         float32_t silenceLevel = powf(10.0f, _params->silence_db / 10.0f);
+         float32_t prevEnergy = 0.0f;
+         size_t lastOnset = 0;
+         size_t blockIdx;
+         uint32_t numJobs = (uint32_t) ((job.num_blocks + SC_ONSET_BLOCKS_PER_JOB - 1u) / SC_ONSET_BLOCKS_PER_JOB);
+
+         sc_parallel_for(numJobs, &loc_calc_block_energies, &job, _params->num_threads);
+
+         // Pick onsets
+         for(blockIdx = 0; (blockIdx < job.num_blocks) && (ret < _maxOnsets); blockIdx++)
+         {
+            float32_t energy = job.energies[blockIdx];
+
+            if( (energy >= silenceLevel) && (energy > (prevEnergy * riseRatio)) )
+            {
+               size_t onset = blockIdx * _params->block_size;
+
+               if( (0 == ret) || ((onset - lastOnset) >= _params->min_slice_size) )
+               {
+                  _retOnsets[ret++] = onset;
+                  lastOnset = onset;
+               }
+            }
+
+            prevEnergy = energy;
+         }
+
+         free(job.energies);
+      }
+   }
+
+   return ret;
+}
+
+size_t samplechain_onset_find_lead_silence(const samplechain_onset_params_t *_params,
+                                           const float32_t *_frames, size_t _numFrames
+                                           ) {
+   size_t ret = 0;
+
+   if((NULL != _params) && (NULL != _frames) && (_params->num_channels > 0))
+   {
+      // (note) peak threshold, i.e. 10^(dB/20)
+      float32_t silenceLevel = powf(10.0f, _params->silence_db / 20.0f);
+      size_t numSamples = _numFrames * _params->num_channels;
+      size_t i;
+
+      for(i = 0; i < numSamples; i++)
+      {
+         if(fabsf(_frames[i]) >= silenceLevel)
+         {
+            break;
+         }
+      }
+
+      ret = i / _params->num_channels;
+   }
+
+   return ret;
+}
+
+uint32_t samplechain_onset_add_slices(samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                      const float32_t *_frames, size_t _numFrames, uint32_t _numChannels,
+                                      const size_t *_onsets, uint32_t _numOnsets
+                                      ) {
+   uint32_t ret = 0;
+
+   if((NULL != _alg) && (NULL != _frames) && (NULL != _onsets))
+   {
+      uint32_t onsetIdx;
+
+      for(onsetIdx = 0; onsetIdx < _numOnsets; onsetIdx++)
+      {
+         size_t sliceStart = _onsets[onsetIdx];
+         size_t sliceEnd = ((onsetIdx + 1u) < _numOnsets) ? _onsets[onsetIdx + 1u] : _numFrames;
+
+         if(sliceEnd > sliceStart)
+         {
+            if(!_alg->add(_sc, sliceEnd - sliceStart, (void*)(_frames + (sliceStart * _numChannels))))
+            {
+               break;
+            }
+
+            ret++;
+         }
+      }
+   }
+
+   return ret;
+}
@@ -0,0 +1,83 @@
+/* ----
+ * ---- file   : onset.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_ONSET_H_INCLUDED
+#define SAMPLECHAIN_ONSET_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Onset detection parameters
+typedef struct {
+   uint32_t  num_channels;    // number of interleaved channels (default: 1)
+   uint32_t  block_size;      // analysis block size (number of sample frames, default: 256)
+   float32_t rise_db;         // minimum energy rise from the previous block (default: 9dB)
+   float32_t silence_db;      // blocks below this (mean square) level never start a slice (default: -50dB)
+   size_t    min_slice_size;  // minimum distance between two onsets (number of sample frames, default: 4800)
+   uint32_t  num_threads;     // 0=one thread per CPU core
+} samplechain_onset_params_t;
+
+
+// Initialize onset detection parameters with default values
+void samplechain_onset_init_params (samplechain_onset_params_t *_params);
+
+// Detect onsets (energy rise) in a (long) recording
+//  - 'frames' points to 'numFrames' interleaved float sample frames, e.g. a memory-mapped file
+//  - The block energies are calculated in parallel for long recordings
+//  - Writes up to 'maxOnsets' onset frame offsets to 'retOnsets' (in ascending order)
+//  - Returns the number of onsets
+uint32_t samplechain_onset_detect (const samplechain_onset_params_t *_params,
+                                   const float32_t *_frames, size_t _numFrames,
+                                   size_t *_retOnsets, uint32_t _maxOnsets
+                                   );
+
+// Find the number of leading (near-)silent sample frames of a waveform
+//  - A frame is silent if the magnitudes of all its samples are below 'silence_db' (peak level, dBFS)
+//  - Returns 'numFrames' if the waveform is entirely silent
+//  - (note) pass the result to the "lead_silence" element attribute of bsp_varichain (see "use_lead_silence")
+size_t samplechain_onset_find_lead_silence (const samplechain_onset_params_t *_params,
+                                            const float32_t *_frames, size_t _numFrames
+                                            );
+
+// Add the slices between consecutive onsets to a sample chain
+//  - The element user_data is a (zero-copy) pointer to the first slice frame within 'frames',
+//     i.e. the recording must remain valid (mapped) until the chain has been rendered
+//  - The last slice extends to the end of the recording
+//  - Returns the number of elements that have been added
+uint32_t samplechain_onset_add_slices (samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                       const float32_t *_frames, size_t _numFrames, uint32_t _numChannels,
+                                       const size_t *_onsets, uint32_t _numOnsets
+                                       );
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_ONSET_H_INCLUDED
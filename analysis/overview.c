@@ -0,0 +1,528 @@
+/* ----
+ * ---- file   : overview.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "overview.h"
+
+#define SC_OVERVIEW_FILE_MAGIC    0x564F4353u  // "SCOV"
+#define SC_OVERVIEW_FILE_VERSION  1u
+
+
+typedef struct {
+   int16_t min;
+   int16_t max;
+} bucket_t;
+
+typedef struct {
+   size_t   offset;
+   size_t   num_frames;
+   uint32_t element_idx;
+   uint32_t bucket_start[SC_OVERVIEW_NUM_LEVELS];  // index of the region's first bucket in each level
+} region_t;
+
+struct samplechain_overview_s {
+   uint32_t num_channels;
+   size_t   num_frames;
+
+   uint32_t  num_regions;
+   region_t *regions;  // sorted by offset
+
+   uint32_t  num_buckets[SC_OVERVIEW_NUM_LEVELS];
+   bucket_t *buckets[SC_OVERVIEW_NUM_LEVELS];  // (note) all levels are part of the buckets[0] allocation
+};
+
+typedef struct {
+   samplechain_overview_t *ov;
+   const int16_t          *frames;
+} build_ctx_t;
+
+
+static uint32_t loc_get_level_shift(uint32_t _level) {
+   return 8u + (_level * SC_OVERVIEW_LEVEL_SHIFT);  // (note) 1 << 8 == SC_OVERVIEW_BUCKET_FRAMES
+}
+
+static uint32_t loc_get_num_buckets(size_t _numFrames, uint32_t _level) {
+   uint32_t shift = loc_get_level_shift(_level);
+
+   return (uint32_t) ((_numFrames + (((size_t)1u << shift) - 1u)) >> shift);
+}
+
+static int loc_cmp_regions(const void *_a, const void *_b) {
+   const region_t *a = (const region_t*)_a;
+   const region_t *b = (const region_t*)_b;
+
+   return (a->offset < b->offset) ? -1 : (a->offset > b->offset) ? 1 : 0;
+}
+
+// Calculate bucket indices and allocate buckets (after the regions have been set up)
+static bool_t loc_alloc_buckets(samplechain_overview_t *_ov) {
+   uint32_t level;
+   uint32_t regionIdx;
+   size_t numBuckets = 0;
+
+   for(level = 0; level < SC_OVERVIEW_NUM_LEVELS; level++)
+   {
+      _ov->num_buckets[level] = 0;
+
+      for(regionIdx = 0; regionIdx < _ov->num_regions; regionIdx++)
+      {
+         region_t *r = &_ov->regions[regionIdx];
+
+         r->bucket_start[level]   = _ov->num_buckets[level];
+         _ov->num_buckets[level] += loc_get_num_buckets(r->num_frames, level);
+      }
+
+      numBuckets += _ov->num_buckets[level];
+   }
+
+   _ov->buckets[0] = malloc(sizeof(bucket_t) * numBuckets + 1u);
+
+   for(level = 1; level < SC_OVERVIEW_NUM_LEVELS; level++)
+   {
+      _ov->buckets[level] = (NULL != _ov->buckets[0]) ? (_ov->buckets[level - 1u] + _ov->num_buckets[level - 1u]) : NULL;
+   }
+
+   return (NULL != _ov->buckets[0]);
+}
+
+static void loc_build_region(samplechain_overview_t *_ov, const region_t *_r, const int16_t *_frames) {
+   bucket_t *d = _ov->buckets[0] + _r->bucket_start[0];
+   uint32_t numBuckets = loc_get_num_buckets(_r->num_frames, 0u);
+   uint32_t bucketIdx;
+   uint32_t level;
+
+   // Finest level: scan the chain frames
+   for(bucketIdx = 0; bucketIdx < numBuckets; bucketIdx++)
+   {
+      size_t off = (size_t)bucketIdx * SC_OVERVIEW_BUCKET_FRAMES;
+      size_t num = _r->num_frames - off;
+
+      if(num > SC_OVERVIEW_BUCKET_FRAMES)
+      {
+         num = SC_OVERVIEW_BUCKET_FRAMES;
+      }
+
+      sc_kernel_minmax_s16(_frames + ((_r->offset + off) * _ov->num_channels), num * _ov->num_channels, &d[bucketIdx].min, &d[bucketIdx].max);
+   }
+
+   // Coarser levels: reduce the buckets of the previous level
+   for(level = 1; level < SC_OVERVIEW_NUM_LEVELS; level++)
+   {
+      const bucket_t *s = _ov->buckets[level - 1u] + _r->bucket_start[level - 1u];
+      uint32_t numSrc = numBuckets;
+
+      d = _ov->buckets[level] + _r->bucket_start[level];
+      numBuckets = loc_get_num_buckets(_r->num_frames, level);
+
+      for(bucketIdx = 0; bucketIdx < numBuckets; bucketIdx++)
+      {
+         uint32_t srcIdx = bucketIdx << SC_OVERVIEW_LEVEL_SHIFT;
+         uint32_t srcEnd = srcIdx + (1u << SC_OVERVIEW_LEVEL_SHIFT);
+
+         srcEnd = (srcEnd > numSrc) ? numSrc : srcEnd;
+
+         d[bucketIdx] = s[srcIdx];
+
+         for(srcIdx++; srcIdx < srcEnd; srcIdx++)
+         {
+            d[bucketIdx].min = (s[srcIdx].min < d[bucketIdx].min) ? s[srcIdx].min : d[bucketIdx].min;
+            d[bucketIdx].max = (s[srcIdx].max > d[bucketIdx].max) ? s[srcIdx].max : d[bucketIdx].max;
+         }
+      }
+   }
+}
+
+static void loc_build_region_job(void *_ctx, uint32_t _regionIdx) {
+   build_ctx_t *ctx = (build_ctx_t*)_ctx;
+
+   loc_build_region(ctx->ov, &ctx->ov->regions[_regionIdx], ctx->frames);
+}
+
+// Query layout ('retSizes' must be freed with free())
+static uint32_t loc_query_layout(const samplechain_algorithm_t *_alg, samplechain_t _sc, samplechain_layout_t *_retLayout, size_t **_retSizes) {
+   uint32_t ret = 0;
+   uint32_t n = _alg->query_num_elements(_sc);
+   size_t *sizes = malloc(sizeof(size_t) * 2u * (n + 1u) + sizeof(uint32_t) * (n + 1u));
+
+   memset(_retLayout, 0, sizeof(samplechain_layout_t));
+
+   if(NULL != sizes)
+   {
+      _retLayout->offsets        = sizes;
+      _retLayout->total_sizes    = sizes + (n + 1u);
+      _retLayout->source_indices = (uint32_t*) (sizes + (2u * (n + 1u)));
+
+      ret = _alg->query_layout(_sc, _retLayout, n);
+   }
+
+   *_retSizes = sizes;
+
+   return ret;
+}
+
+samplechain_overview_t *samplechain_overview_create(const samplechain_algorithm_t *_alg, samplechain_t _sc, const int16_t *_frames) {
+   samplechain_overview_t *ret = NULL;
+
+   if((NULL != _alg) && (NULL != _frames) && (_alg->query_total_size(_sc) > 0))
+   {
+      samplechain_layout_t layout;
+      size_t *sizes;
+      uint32_t n = loc_query_layout(_alg, _sc, &layout, &sizes);
+
+      ret = calloc(1u, sizeof(samplechain_overview_t));
+
+      if((NULL != ret) && (NULL != sizes))
+      {
+         int32_t numChannels = 1;
+         uint32_t elementIdx;
+
+         _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+         ret->num_channels = (uint32_t)numChannels;
+         ret->num_frames   = _alg->query_total_size(_sc);
+         ret->regions      = malloc(sizeof(region_t) * n + 1u);
+
+         if(NULL != ret->regions)
+         {
+            for(elementIdx = 0; elementIdx < n; elementIdx++)
+            {
+               size_t offset = layout.offsets[elementIdx];
+               size_t numFrames = layout.total_sizes[elementIdx];
+
+               // (note) duplicates share the chain region of their source element
+               if((layout.source_indices[elementIdx] == elementIdx) && (numFrames > 0) && (offset < ret->num_frames))
+               {
+                  region_t *r = &ret->regions[ret->num_regions++];
+
+                  r->offset      = offset;
+                  r->num_frames  = ((offset + numFrames) > ret->num_frames) ? (ret->num_frames - offset) : numFrames;
+                  r->element_idx = elementIdx;
+               }
+            }
+
+            qsort(ret->regions, ret->num_regions, sizeof(region_t), &loc_cmp_regions);
+
+            if(loc_alloc_buckets(ret))
+            {
+               build_ctx_t ctx;
+
+               ctx.ov     = ret;
+               ctx.frames = _frames;
+
+               sc_parallel_for(ret->num_regions, &loc_build_region_job, &ctx, 0u);
+            }
+            else
+            {
+               samplechain_overview_destroy(ret);
+               ret = NULL;
+            }
+         }
+         else
+         {
+            free(ret);
+            ret = NULL;
+         }
+      }
+      else
+      {
+         free(ret);
+         ret = NULL;
+      }
+
+      free(sizes);
+   }
+
+   return ret;
+}
+
+void samplechain_overview_destroy(samplechain_overview_t *_ov) {
+
+   if(NULL != _ov)
+   {
+      free(_ov->buckets[0]);
+      free(_ov->regions);
+      free(_ov);
+   }
+}
+
+bool_t samplechain_overview_update_element(samplechain_overview_t *_ov,
+                                           const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                           uint32_t _elementIdx, const int16_t *_frames
+                                           ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _ov) && (NULL != _alg) && (NULL != _frames))
+   {
+      samplechain_layout_t layout;
+      size_t *sizes;
+      uint32_t n = loc_query_layout(_alg, _sc, &layout, &sizes);
+
+      if((NULL != sizes) && (_elementIdx < n))
+      {
+         uint32_t sourceIdx = layout.source_indices[_elementIdx];
+         uint32_t regionIdx;
+
+         for(regionIdx = 0; regionIdx < _ov->num_regions; regionIdx++)
+         {
+            region_t *r = &_ov->regions[regionIdx];
+
+            if(r->element_idx == sourceIdx)
+            {
+               if((r->offset == layout.offsets[sourceIdx]) && (r->num_frames == layout.total_sizes[sourceIdx]))
+               {
+                  loc_build_region(_ov, r, _frames);
+                  ret = SC_TRUE;
+               }
+
+               break;
+            }
+         }
+      }
+
+      free(sizes);
+   }
+
+   return ret;
+}
+
+void samplechain_overview_query(const samplechain_overview_t *_ov,
+                                const int16_t *_frames,
+                                size_t _startFrame, size_t _numFrames,
+                                uint32_t _numPixels,
+                                int16_t *_retMin, int16_t *_retMax
+                                ) {
+   size_t framesPerPixel = (_numPixels > 0) ? (_numFrames / _numPixels) : 0;
+   int32_t level = 0;  // -1=scan chain frames
+   uint32_t regionIdx = 0;
+   uint32_t pixelIdx;
+
+   if(NULL == _ov)
+   {
+      return;
+   }
+
+   if((NULL != _frames) && (framesPerPixel < SC_OVERVIEW_BUCKET_FRAMES))
+   {
+      level = -1;
+   }
+   else
+   {
+      while( ((uint32_t)(level + 1) < SC_OVERVIEW_NUM_LEVELS) &&
+             (((size_t)1u << loc_get_level_shift((uint32_t)(level + 1))) <= framesPerPixel)
+             )
+      {
+         level++;
+      }
+   }
+
+   for(pixelIdx = 0; pixelIdx < _numPixels; pixelIdx++)
+   {
+      size_t a = _startFrame + (_numFrames * pixelIdx) / _numPixels;
+      size_t b = _startFrame + (_numFrames * (pixelIdx + 1u)) / _numPixels;
+      int16_t mn = 32767;
+      int16_t mx = -32768;
+      uint32_t k;
+
+      b = (b > a) ? b : (a + 1u);
+
+      // (note) pixels are sorted, i.e. the first region that overlaps the pixel never moves backwards
+      while((regionIdx < _ov->num_regions) && ((_ov->regions[regionIdx].offset + _ov->regions[regionIdx].num_frames) <= a))
+      {
+         regionIdx++;
+      }
+
+      for(k = regionIdx; (k < _ov->num_regions) && (_ov->regions[k].offset < b); k++)
+      {
+         const region_t *r = &_ov->regions[k];
+         size_t la = ((a > r->offset) ? a : r->offset) - r->offset;
+         size_t lb = (((r->offset + r->num_frames) < b) ? (r->offset + r->num_frames) : b) - r->offset;
+
+         if(level < 0)
+         {
+            int16_t rMin;
+            int16_t rMax;
+
+            sc_kernel_minmax_s16(_frames + ((r->offset + la) * _ov->num_channels), (lb - la) * _ov->num_channels, &rMin, &rMax);
+
+            mn = (rMin < mn) ? rMin : mn;
+            mx = (rMax > mx) ? rMax : mx;
+         }
+         else
+         {
+            uint32_t shift = loc_get_level_shift((uint32_t)level);
+            const bucket_t *s = _ov->buckets[level] + r->bucket_start[level];
+            size_t bucketIdx;
+
+            for(bucketIdx = (la >> shift); bucketIdx <= ((lb - 1u) >> shift); bucketIdx++)
+            {
+               mn = (s[bucketIdx].min < mn) ? s[bucketIdx].min : mn;
+               mx = (s[bucketIdx].max > mx) ? s[bucketIdx].max : mx;
+            }
+         }
+      }
+
+      if(mn > mx)
+      {
+         // No region (outside of the chain)
+         mn = 0;
+         mx = 0;
+      }
+
+      _retMin[pixelIdx] = mn;
+      _retMax[pixelIdx] = mx;
+   }
+}
+
+size_t samplechain_overview_get_num_bytes(const samplechain_overview_t *_ov) {
+   size_t ret = 0;
+
+   if(NULL != _ov)
+   {
+      uint32_t level;
+
+      ret = sizeof(samplechain_overview_t) + sizeof(region_t) * _ov->num_regions;
+
+      for(level = 0; level < SC_OVERVIEW_NUM_LEVELS; level++)
+      {
+         ret += sizeof(bucket_t) * _ov->num_buckets[level];
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_overview_save(const samplechain_overview_t *_ov, const char *_pathName) {
+   bool_t ret = SC_FALSE;
+   FILE *fh;
+
+   if((NULL != _ov) && (NULL != (fh = fopen(_pathName, "wb"))))
+   {
+      uint32_t header[4];
+      uint64_t numFrames = _ov->num_frames;
+      uint32_t regionIdx;
+      uint32_t level;
+
+      header[0] = SC_OVERVIEW_FILE_MAGIC;
+      header[1] = SC_OVERVIEW_FILE_VERSION;
+      header[2] = _ov->num_channels;
+      header[3] = _ov->num_regions;
+
+      ret = (1 == fwrite(header, sizeof(header), 1, fh)) && (1 == fwrite(&numFrames, sizeof(numFrames), 1, fh));
+
+      for(regionIdx = 0; ret && (regionIdx < _ov->num_regions); regionIdx++)
+      {
+         const region_t *r = &_ov->regions[regionIdx];
+         uint64_t v[3];
+
+         v[0] = r->offset;
+         v[1] = r->num_frames;
+         v[2] = r->element_idx;
+
+         ret = (1 == fwrite(v, sizeof(v), 1, fh));
+      }
+
+      for(level = 0; ret && (level < SC_OVERVIEW_NUM_LEVELS); level++)
+      {
+         ret = (_ov->num_buckets[level] == fwrite(_ov->buckets[level], sizeof(bucket_t), _ov->num_buckets[level], fh));
+      }
+
+      ret = (0 == fclose(fh)) && ret;
+   }
+
+   return ret;
+}
+
+samplechain_overview_t *samplechain_overview_load(const char *_pathName) {
+   samplechain_overview_t *ret = NULL;
+   FILE *fh = fopen(_pathName, "rb");
+
+   if(NULL != fh)
+   {
+      uint32_t header[4];
+      uint64_t numFrames;
+
+      if( (1 == fread(header, sizeof(header), 1, fh)) && (1 == fread(&numFrames, sizeof(numFrames), 1, fh)) &&
+          (SC_OVERVIEW_FILE_MAGIC == header[0]) && (SC_OVERVIEW_FILE_VERSION == header[1]) && (header[2] > 0)
+          )
+      {
+         ret = calloc(1u, sizeof(samplechain_overview_t));
+
+         if(NULL != ret)
+         {
+            bool_t bOk;
+            uint32_t regionIdx;
+            uint32_t level;
+
+            ret->num_channels = header[2];
+            ret->num_frames   = (size_t)numFrames;
+            ret->num_regions  = header[3];
+            ret->regions      = malloc(sizeof(region_t) * ret->num_regions + 1u);
+
+            bOk = (NULL != ret->regions);
+
+            for(regionIdx = 0; bOk && (regionIdx < ret->num_regions); regionIdx++)
+            {
+               region_t *r = &ret->regions[regionIdx];
+               uint64_t v[3];
+
+               bOk = (1 == fread(v, sizeof(v), 1, fh)) && ((v[0] + v[1]) <= numFrames);
+
+               r->offset      = (size_t)v[0];
+               r->num_frames  = (size_t)v[1];
+               r->element_idx = (uint32_t)v[2];
+            }
+
+            bOk = bOk && loc_alloc_buckets(ret);
+
+            for(level = 0; bOk && (level < SC_OVERVIEW_NUM_LEVELS); level++)
+            {
+               bOk = (ret->num_buckets[level] == fread(ret->buckets[level], sizeof(bucket_t), ret->num_buckets[level], fh));
+            }
+
+            if(!bOk)
+            {
+               samplechain_overview_destroy(ret);
+               ret = NULL;
+            }
+         }
+      }
+
+      fclose(fh);
+   }
+
+   return ret;
+}
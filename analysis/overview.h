@@ -0,0 +1,92 @@
+/* ----
+ * ---- file   : overview.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_OVERVIEW_H_INCLUDED
+#define SAMPLECHAIN_OVERVIEW_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_OVERVIEW_NUM_LEVELS     3u
+#define SC_OVERVIEW_BUCKET_FRAMES  256u  // frames per bucket of the finest level
+#define SC_OVERVIEW_LEVEL_SHIFT    4u    // each level is 16 times coarser (256, 4096, 65536 frames per bucket)
+
+
+// Opaque waveform overview (min / max pyramid of a rendered chain)
+typedef struct samplechain_overview_s samplechain_overview_t;
+
+
+// Build overview of a rendered chain
+//  - 'frames' are the interleaved 16bit sample frames of the chain (see samplechain_render())
+//  - Each element region gets its own pyramid (buckets are aligned to the region start), i.e. an element can
+//     be updated without touching its neighbours. Duplicates that share a region are stored once
+//  - The min / max values are taken across all channels
+//  - Regions are processed in parallel
+//  - Returns NULL if the layout is invalid or the overview could not be allocated
+samplechain_overview_t *samplechain_overview_create (const samplechain_algorithm_t *_alg, samplechain_t _sc, const int16_t *_frames);
+
+// Free overview
+void samplechain_overview_destroy (samplechain_overview_t *_ov);
+
+// Rebuild the pyramid of one element after its audio changed
+//  - 'frames' are the (re-)rendered chain frames. The layout must not have changed
+//  - Returns false if the element index is invalid or the element's region size changed (create a new overview in that case)
+bool_t samplechain_overview_update_element (samplechain_overview_t *_ov,
+                                            const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                            uint32_t _elementIdx, const int16_t *_frames
+                                            );
+
+// Calculate per-pixel min / max values of chain frames [startFrame, startFrame+numFrames[
+//  - Uses the coarsest level whose buckets are not larger than one pixel, i.e. the cost is O(numPixels) at any zoom level
+//  - Pixels are extended to bucket boundaries (the result may include up to one bucket of neighbouring frames)
+//  - When zoomed in closer than the finest level, the chain 'frames' are scanned if available (NULL=use finest level)
+//  - Pixels outside of the chain are set to 0
+void samplechain_overview_query (const samplechain_overview_t *_ov,
+                                 const int16_t *_frames,
+                                 size_t _startFrame, size_t _numFrames,
+                                 uint32_t _numPixels,
+                                 int16_t *_retMin, int16_t *_retMax
+                                 );
+
+// Query the memory used by the pyramid (bytes)
+size_t samplechain_overview_get_num_bytes (const samplechain_overview_t *_ov);
+
+// Save overview to a (native byte order) cache file
+bool_t samplechain_overview_save (const samplechain_overview_t *_ov, const char *_pathName);
+
+// Load overview saved by samplechain_overview_save()
+//  - Returns NULL if the file cannot be opened or is not a valid overview file
+samplechain_overview_t *samplechain_overview_load (const char *_pathName);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_OVERVIEW_H_INCLUDED
@@ -0,0 +1,1186 @@
+/* ----
+ * ---- file   : archive.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../util/kernels.h"
+#include "../util/profile.h"
+#include "../util/thread.h"
+#include "archive.h"
+
+#define SC_ARCHIVE_VERSION  1u
+
+#define SC_ARCHIVE_MIN_ZERO_RUN     32u   // shorter runs of silent frames are coded like audio
+#define SC_ARCHIVE_PARTITION_SIZE  256u   // number of residuals per Rice parameter
+#define SC_ARCHIVE_MAX_RICE_PARAM   20u
+#define SC_ARCHIVE_RICE_ESCAPE      32u   // unary prefixes of this length are followed by the raw value
+#define SC_ARCHIVE_ESCAPE_BITS      24u
+#define SC_ARCHIVE_BATCH_BLOCKS     32u   // number of blocks that are compressed in parallel
+
+#define SC_ARCHIVE_SEGMENT_ZERO   0u
+#define SC_ARCHIVE_SEGMENT_CODED  1u
+
+#define SC_ARCHIVE_MAX_NAME_LEN  255u
+
+
+// Algorithm parameters that are stored in the archive (if the algorithm knows them)
+static const char *const loc_param_names[] = {
+   "extra_padding",
+   "min_padding",
+   "chain_size",
+   "bytes_per_sample",
+   "num_channels",
+   "max_total_bytes",
+   "use_lead_silence",
+   "objective",
+   "selected_algorithm",
+   NULL
+};
+
+
+typedef struct {
+   char    name[SC_ARCHIVE_MAX_NAME_LEN + 1];
+   int32_t value;
+} param_t;
+
+typedef struct {
+   uint32_t size;  // compressed size (bytes)
+   uint32_t crc;   // CRC32C of the decompressed 16bit frames
+   size_t   offset;
+} block_t;
+
+struct samplechain_archive_s {
+   int fd;
+
+   samplechain_archive_info_t info;
+   char algorithm_name[SC_ARCHIVE_MAX_NAME_LEN + 1];
+
+   uint32_t num_params;
+   param_t *params;
+
+   size_t    *offsets;      // num_elements*4 (offsets, total sizes, orig sizes, pad sizes)
+   uint32_t  *source_indices;
+   float32_t *sta;
+   float32_t *end;
+
+   block_t *blocks;
+
+   // Sequential read state (see samplechain_archive_read())
+   int16_t *cur_frames;
+   uint32_t cur_block_idx;
+   size_t   cur_num_frames;
+   size_t   cur_pos;
+};
+
+
+typedef struct {
+   uint8_t *d;
+   size_t   pos;
+   uint64_t acc;
+   uint32_t num_bits;
+} bit_writer_t;
+
+typedef struct {
+   const uint8_t *s;
+   size_t         size;
+   size_t         pos;
+   uint64_t       acc;
+   uint32_t       num_bits;
+   bool_t         b_overrun;
+} bit_reader_t;
+
+
+// Helper fxns:
+static void loc_put_u32(uint8_t *_d, uint32_t _v) {
+   _d[0] = (uint8_t) ( _v        & 255u);
+   _d[1] = (uint8_t) ((_v >>  8) & 255u);
+   _d[2] = (uint8_t) ((_v >> 16) & 255u);
+   _d[3] = (uint8_t) ((_v >> 24) & 255u);
+}
+
+static uint32_t loc_get_u32(const uint8_t *_s) {
+   return (uint32_t)_s[0] | ((uint32_t)_s[1] << 8) | ((uint32_t)_s[2] << 16) | ((uint32_t)_s[3] << 24);
+}
+
+static void loc_put_bits(bit_writer_t *_bw, uint32_t _v, uint32_t _numBits) {
+   // (note) 'numBits' <= 32, the accumulator never holds more than 7+32 bits
+   _bw->acc = (_bw->acc << _numBits) | (_v & (uint32_t)((1ull << _numBits) - 1u));
+   _bw->num_bits += _numBits;
+
+   while(_bw->num_bits >= 8u)
+   {
+      _bw->num_bits -= 8u;
+      _bw->d[_bw->pos++] = (uint8_t) (_bw->acc >> _bw->num_bits);
+   }
+}
+
+static void loc_flush_bits(bit_writer_t *_bw) {
+
+   if(_bw->num_bits > 0u)
+   {
+      loc_put_bits(_bw, 0u, 8u - _bw->num_bits);
+   }
+}
+
+static uint32_t loc_get_bits(bit_reader_t *_br, uint32_t _numBits) {
+
+   while(_br->num_bits < _numBits)
+   {
+      if(_br->pos < _br->size)
+      {
+         _br->acc = (_br->acc << 8) | _br->s[_br->pos++];
+      }
+      else
+      {
+         _br->acc = (_br->acc << 8);
+         _br->b_overrun = SC_TRUE;
+      }
+
+      _br->num_bits += 8u;
+   }
+
+   _br->num_bits -= _numBits;
+
+   return (uint32_t) ((_br->acc >> _br->num_bits) & ((1ull << _numBits) - 1u));
+}
+
+static void loc_put_rice(bit_writer_t *_bw, uint32_t _u, uint32_t _k) {
+   uint32_t q = _u >> _k;
+
+   if(q < SC_ARCHIVE_RICE_ESCAPE)
+   {
+      loc_put_bits(_bw, 1u, q + 1u);
+      loc_put_bits(_bw, _u, _k);
+   }
+   else
+   {
+      loc_put_bits(_bw, 0u, SC_ARCHIVE_RICE_ESCAPE);
+      loc_put_bits(_bw, _u, SC_ARCHIVE_ESCAPE_BITS);
+   }
+}
+
+static uint32_t loc_get_rice(bit_reader_t *_br, uint32_t _k) {
+   uint32_t q = 0u;
+   uint32_t ret;
+
+   while((q < SC_ARCHIVE_RICE_ESCAPE) && (0u == loc_get_bits(_br, 1u)) && !_br->b_overrun)
+   {
+      q++;
+   }
+
+   if(q < SC_ARCHIVE_RICE_ESCAPE)
+   {
+      ret = (q << _k) | loc_get_bits(_br, _k);
+   }
+   else
+   {
+      ret = loc_get_bits(_br, SC_ARCHIVE_ESCAPE_BITS);
+   }
+
+   return ret;
+}
+
+// Upper bound of the compressed size of a block
+static size_t loc_get_max_block_bytes(uint32_t _blockFrames, uint32_t _numChannels) {
+   // (note) <= 56 bits per escaped sample, 17 bits per segment (+2 / 48 / 5 bits order / warm-up / Rice parameter overhead per channel)
+   return ((size_t)_blockFrames * ((_numChannels * 8u) + 4u)) + 64u;
+}
+
+static bool_t loc_is_zero_frame(const int16_t *_s, uint32_t _numChannels) {
+   bool_t ret = SC_TRUE;
+   uint32_t chIdx;
+
+   for(chIdx = 0; ret && (chIdx < _numChannels); chIdx++)
+   {
+      ret = (0 == _s[chIdx]);
+   }
+
+   return ret;
+}
+
+// Encode 'numFrames' frames (one segment) with fixed linear prediction + partitioned Rice coding
+//  - 'tmp' provides room for numFrames+3 values, 'res' for numFrames values
+static void loc_encode_segment(bit_writer_t *_bw, const int16_t *_s, size_t _numFrames, uint32_t _numChannels, int32_t *_tmp, uint32_t *_res) {
+   int32_t *x = _tmp + 3;
+   uint32_t chIdx;
+
+   for(chIdx = 0; chIdx < _numChannels; chIdx++)
+   {
+      uint32_t order = 0u;
+      size_t i;
+
+      _tmp[0] = 0;
+      _tmp[1] = 0;
+      _tmp[2] = 0;
+
+      for(i = 0; i < _numFrames; i++)
+      {
+         x[i] = _s[i * _numChannels + chIdx];
+      }
+
+      // Pick the predictor order with the smallest residual sum
+      if(_numFrames > 3u)
+      {
+         uint64_t sums[4];
+         uint32_t o;
+
+         sc_kernel_fixed_residual_sums(x + 3, _numFrames - 3u, sums);
+
+         for(o = 1u; o < 4u; o++)
+         {
+            if(sums[o] < sums[order])
+            {
+               order = o;
+            }
+         }
+      }
+
+      loc_put_bits(_bw, order, 2u);
+
+      // Warm-up samples
+      for(i = 0; i < order; i++)
+      {
+         loc_put_bits(_bw, (uint16_t)x[i], 16u);
+      }
+
+      sc_kernel_fixed_residuals(x + order, _numFrames - order, order, _res);
+
+      for(i = 0; i < (_numFrames - order); i += SC_ARCHIVE_PARTITION_SIZE)
+      {
+         size_t numRes = (_numFrames - order) - i;
+         uint64_t sum = 0u;
+         uint32_t k = 0u;
+         size_t j;
+
+         if(numRes > SC_ARCHIVE_PARTITION_SIZE)
+         {
+            numRes = SC_ARCHIVE_PARTITION_SIZE;
+         }
+
+         for(j = 0; j < numRes; j++)
+         {
+            sum += _res[i + j];
+         }
+
+         // (note) 2^k ~= mean value
+         while((k < SC_ARCHIVE_MAX_RICE_PARAM) && (((uint64_t)numRes << (k + 1u)) < sum))
+         {
+            k++;
+         }
+
+         loc_put_bits(_bw, k, 5u);
+
+         for(j = 0; j < numRes; j++)
+         {
+            loc_put_rice(_bw, _res[i + j], k);
+         }
+      }
+   }
+}
+
+// Compress a block of chain frames
+//  - Returns the number of bytes written to 'd' (see loc_get_max_block_bytes())
+static size_t loc_encode_block(const int16_t *_s, size_t _numFrames, uint32_t _numChannels, int32_t *_tmp, uint32_t *_res, uint8_t *_d) {
+   bit_writer_t bw;
+   size_t i = 0;
+
+   bw.d        = _d;
+   bw.pos      = 0;
+   bw.acc      = 0u;
+   bw.num_bits = 0u;
+
+   while(i < _numFrames)
+   {
+      size_t runStart = _numFrames;
+      size_t runEnd = _numFrames;
+      size_t j = i;
+
+      // Find the next run of silent frames that is long enough
+      while(j < _numFrames)
+      {
+         if(loc_is_zero_frame(_s + (j * _numChannels), _numChannels))
+         {
+            size_t k = j + 1u;
+
+            while((k < _numFrames) && loc_is_zero_frame(_s + (k * _numChannels), _numChannels))
+            {
+               k++;
+            }
+
+            if((k - j) >= SC_ARCHIVE_MIN_ZERO_RUN)
+            {
+               runStart = j;
+               runEnd   = k;
+               break;
+            }
+
+            j = k;
+         }
+         else
+         {
+            j++;
+         }
+      }
+
+      if(runStart > i)
+      {
+         loc_put_bits(&bw, SC_ARCHIVE_SEGMENT_CODED, 1u);
+         loc_put_bits(&bw, (uint32_t)(runStart - i - 1u), 16u);
+
+         loc_encode_segment(&bw, _s + (i * _numChannels), runStart - i, _numChannels, _tmp, _res);
+      }
+
+      if(runStart < _numFrames)
+      {
+         loc_put_bits(&bw, SC_ARCHIVE_SEGMENT_ZERO, 1u);
+         loc_put_bits(&bw, (uint32_t)(runEnd - runStart - 1u), 16u);
+      }
+
+      i = runEnd;
+   }
+
+   loc_flush_bits(&bw);
+
+   return bw.pos;
+}
+
+// Decompress a block of 'numFrames' chain frames
+//  - Returns false if the compressed data is corrupt
+static bool_t loc_decode_block(const uint8_t *_s, size_t _numBytes, size_t _numFrames, uint32_t _numChannels, int16_t *_d) {
+   bit_reader_t br;
+   size_t pos = 0;
+
+   br.s         = _s;
+   br.size      = _numBytes;
+   br.pos       = 0;
+   br.acc       = 0u;
+   br.num_bits  = 0u;
+   br.b_overrun = SC_FALSE;
+
+   while((pos < _numFrames) && !br.b_overrun)
+   {
+      uint32_t type = loc_get_bits(&br, 1u);
+      size_t numFrames = (size_t)loc_get_bits(&br, 16u) + 1u;
+
+      if((pos + numFrames) > _numFrames)
+      {
+         return SC_FALSE;
+      }
+
+      if(SC_ARCHIVE_SEGMENT_ZERO == type)
+      {
+         memset(_d + (pos * _numChannels), 0, sizeof(int16_t) * numFrames * _numChannels);
+      }
+      else
+      {
+         uint32_t chIdx;
+
+         for(chIdx = 0; chIdx < _numChannels; chIdx++)
+         {
+            int16_t *d = _d + (pos * _numChannels) + chIdx;
+            uint32_t order = loc_get_bits(&br, 2u);
+            int32_t x1 = 0;
+            int32_t x2 = 0;
+            int32_t x3 = 0;
+            size_t i;
+
+            if(order > numFrames)
+            {
+               return SC_FALSE;
+            }
+
+            for(i = 0; i < order; i++)
+            {
+               x3 = x2;
+               x2 = x1;
+               x1 = (int16_t)loc_get_bits(&br, 16u);
+               d[i * _numChannels] = (int16_t)x1;
+            }
+
+            while((i < numFrames) && !br.b_overrun)
+            {
+               size_t partEnd = i + SC_ARCHIVE_PARTITION_SIZE;
+               uint32_t k = loc_get_bits(&br, 5u);
+
+               if(partEnd > numFrames)
+               {
+                  partEnd = numFrames;
+               }
+
+               for(; i < partEnd; i++)
+               {
+                  uint32_t u = loc_get_rice(&br, k);
+                  int32_t r = (int32_t)(u >> 1) ^ -(int32_t)(u & 1u);
+                  int32_t x;
+
+                  switch(order)
+                  {
+                     default:
+                     case 0: x = r;                                   break;
+                     case 1: x = r + x1;                              break;
+                     case 2: x = r + (2 * x1) - x2;                   break;
+                     case 3: x = r + (3 * x1) - (3 * x2) + x3;        break;
+                  }
+
+                  x3 = x2;
+                  x2 = x1;
+                  x1 = x;
+                  d[i * _numChannels] = (int16_t)x;
+               }
+            }
+         }
+      }
+
+      pos += numFrames;
+   }
+
+   return !br.b_overrun;
+}
+
+static bool_t loc_pread_all(int _fd, void *_d, size_t _numBytes, size_t _fileOff) {
+   uint8_t *d = (uint8_t*)_d;
+   bool_t ret = SC_TRUE;
+
+   while(ret && (_numBytes > 0u))
+   {
+      ssize_t numRead = pread(_fd, d, _numBytes, (off_t)_fileOff);
+
+      ret = (numRead > 0);
+
+      if(ret)
+      {
+         d         += numRead;
+         _fileOff  += (size_t)numRead;
+         _numBytes -= (size_t)numRead;
+      }
+   }
+
+   return ret;
+}
+
+// Frame source for loc_save()
+//  - Returns the number of frames written to 'retFrames'
+typedef size_t (*read_fxn_t) (void *_ctx, int16_t *_retFrames, size_t _maxFrames);
+
+typedef struct {
+   const int16_t *frames;
+   size_t         num_frames;
+   size_t         pos;
+   uint32_t       num_channels;
+} frames_reader_t;
+
+static size_t loc_read_frames(void *_ctx, int16_t *_retFrames, size_t _maxFrames) {
+   frames_reader_t *r = (frames_reader_t*)_ctx;
+   size_t ret = r->num_frames - r->pos;
+
+   if(ret > _maxFrames)
+   {
+      ret = _maxFrames;
+   }
+
+   memcpy(_retFrames, r->frames + (r->pos * r->num_channels), sizeof(int16_t) * ret * r->num_channels);
+   r->pos += ret;
+
+   return ret;
+}
+
+static size_t loc_read_stream(void *_ctx, int16_t *_retFrames, size_t _maxFrames) {
+   return samplechain_render_stream_read((samplechain_render_stream_t*)_ctx, _retFrames, _maxFrames);
+}
+
+// Batch of blocks that are compressed in parallel
+typedef struct {
+   uint32_t num_channels;
+   uint32_t block_frames;
+   size_t   max_block_bytes;
+   size_t   num_frames;     // number of frames in the batch
+
+   int16_t  *frames;
+   uint8_t  *out;
+   int32_t  *tmp;
+   uint32_t *res;
+   uint32_t  sizes[SC_ARCHIVE_BATCH_BLOCKS];
+   uint32_t  crcs[SC_ARCHIVE_BATCH_BLOCKS];
+} batch_t;
+
+static void loc_encode_block_job(void *_batch, uint32_t _jobIdx) {
+   batch_t *b = (batch_t*)_batch;
+   size_t off = (size_t)_jobIdx * b->block_frames;
+   size_t numFrames = b->num_frames - off;
+   const int16_t *s = b->frames + (off * b->num_channels);
+
+   if(numFrames > b->block_frames)
+   {
+      numFrames = b->block_frames;
+   }
+
+   b->sizes[_jobIdx] = (uint32_t) loc_encode_block(s,
+                                                    numFrames,
+                                                    b->num_channels,
+                                                    b->tmp + ((size_t)_jobIdx * (b->block_frames + 3u)),
+                                                    b->res + ((size_t)_jobIdx * b->block_frames),
+                                                    b->out + ((size_t)_jobIdx * b->max_block_bytes)
+                                                    );
+
+   // (note) assumes a little endian host
+   b->crcs[_jobIdx] = sc_kernel_crc32c(s, sizeof(int16_t) * numFrames * b->num_channels, 0u);
+}
+
+// Write header (magic, format, algorithm name, parameters, layout)
+//  - Returns the file offset of the block table, or 0 if the header could not be written
+static size_t loc_write_header(FILE *_fh, const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                               uint32_t _numChannels, uint32_t _sampleRate, size_t _numFrames, uint32_t _blockFrames, uint32_t _numBlocks
+                               ) {
+   size_t ret = 0;
+   uint32_t n = _alg->query_num_elements(_sc);
+   size_t *sizes = malloc(sizeof(size_t) * 4u * (n + 1u));
+   float32_t *sta = malloc(sizeof(float32_t) * 2u * (n + 1u));
+   uint32_t *sourceIndices = malloc(sizeof(uint32_t) * (n + 1u));
+   uint8_t buf[SC_ARCHIVE_MAX_NAME_LEN + 8u];
+
+   if((NULL != sizes) && (NULL != sta) && (NULL != sourceIndices))
+   {
+      samplechain_layout_t layout;
+      const char *name = _alg->query_algorithm_name();
+      size_t nameLen = strlen(name);
+      uint32_t numParams = 0;
+      uint32_t paramIdx;
+      uint32_t elementIdx;
+      int32_t value;
+      bool_t bOk;
+
+      layout.offsets        = sizes;
+      layout.total_sizes    = sizes + (n + 1u);
+      layout.orig_sizes     = sizes + 2u * (n + 1u);
+      layout.pad_sizes      = sizes + 3u * (n + 1u);
+      layout.sta            = sta;
+      layout.end            = sta + (n + 1u);
+      layout.source_indices = sourceIndices;
+
+      n = _alg->query_layout(_sc, &layout, n);
+
+      if(nameLen > SC_ARCHIVE_MAX_NAME_LEN)
+      {
+         nameLen = SC_ARCHIVE_MAX_NAME_LEN;
+      }
+
+      for(paramIdx = 0; NULL != loc_param_names[paramIdx]; paramIdx++)
+      {
+         numParams += _alg->get_parameter_i(_sc, loc_param_names[paramIdx], &value);
+      }
+
+      memcpy(buf, "SCAR", 4);
+      loc_put_u32(buf + 4, SC_ARCHIVE_VERSION);
+      bOk = (8u == fwrite(buf, 1, 8u, _fh));
+
+      loc_put_u32(buf +  0, _numChannels);
+      loc_put_u32(buf +  4, _sampleRate);
+      loc_put_u32(buf +  8, (uint32_t)_numFrames);
+      loc_put_u32(buf + 12, _blockFrames);
+      loc_put_u32(buf + 16, _numBlocks);
+      loc_put_u32(buf + 20, n);
+      loc_put_u32(buf + 24, numParams);
+      loc_put_u32(buf + 28, (uint32_t)nameLen);
+      bOk = bOk && (32u == fwrite(buf, 1, 32u, _fh)) && (nameLen == fwrite(name, 1, nameLen, _fh));
+
+      for(paramIdx = 0; bOk && (NULL != loc_param_names[paramIdx]); paramIdx++)
+      {
+         if(_alg->get_parameter_i(_sc, loc_param_names[paramIdx], &value))
+         {
+            size_t len = strlen(loc_param_names[paramIdx]);
+
+            buf[0] = (uint8_t)len;
+            memcpy(buf + 1, loc_param_names[paramIdx], len);
+            loc_put_u32(buf + 1 + len, (uint32_t)value);
+
+            bOk = ((len + 5u) == fwrite(buf, 1, len + 5u, _fh));
+         }
+      }
+
+      for(elementIdx = 0; bOk && (elementIdx < n); elementIdx++)
+      {
+         uint32_t u;
+
+         loc_put_u32(buf +  0, (uint32_t)layout.offsets[elementIdx]);
+         loc_put_u32(buf +  4, (uint32_t)layout.total_sizes[elementIdx]);
+         loc_put_u32(buf +  8, (uint32_t)layout.orig_sizes[elementIdx]);
+         loc_put_u32(buf + 12, (uint32_t)layout.pad_sizes[elementIdx]);
+         loc_put_u32(buf + 16, layout.source_indices[elementIdx]);
+         memcpy(&u, &layout.sta[elementIdx], sizeof(u));
+         loc_put_u32(buf + 20, u);
+         memcpy(&u, &layout.end[elementIdx], sizeof(u));
+         loc_put_u32(buf + 24, u);
+
+         bOk = (28u == fwrite(buf, 1, 28u, _fh));
+      }
+
+      if(bOk)
+      {
+         long off = ftell(_fh);
+
+         // Block table placeholder (see loc_save())
+         memset(buf, 0, 8u);
+
+         for(elementIdx = 0; bOk && (elementIdx < _numBlocks); elementIdx++)
+         {
+            bOk = (8u == fwrite(buf, 1, 8u, _fh));
+         }
+
+         if(bOk && (off > 0))
+         {
+            ret = (size_t)off;
+         }
+      }
+   }
+
+   free(sourceIndices);
+   free(sta);
+   free(sizes);
+
+   return ret;
+}
+
+static bool_t loc_save(const char *_pathName,
+                       const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                       uint32_t _sampleRate, uint32_t _blockFrames,
+                       read_fxn_t _read, void *_readCtx
+                       ) {
+   bool_t ret = SC_FALSE;
+   int32_t bytesPerSample = 2;
+   int32_t numChannels = 1;
+   size_t numFrames = _alg->query_total_size(_sc);
+   uint32_t blockFrames = (0u != _blockFrames) ? _blockFrames : SC_ARCHIVE_DEFAULT_BLOCK_FRAMES;
+
+   _alg->get_parameter_i(_sc, "bytes_per_sample", &bytesPerSample);
+   _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+   if((2 == bytesPerSample) && (numFrames > 0u) && (numFrames <= 0xFFFFFFFFu) && (blockFrames <= SC_ARCHIVE_MAX_BLOCK_FRAMES))
+   {
+      uint32_t numBlocks = (uint32_t) ((numFrames + blockFrames - 1u) / blockFrames);
+      uint32_t *table = malloc(sizeof(uint32_t) * 2u * numBlocks);
+      batch_t b;
+      FILE *fh;
+
+      b.num_channels    = (uint32_t)numChannels;
+      b.block_frames    = blockFrames;
+      b.max_block_bytes = loc_get_max_block_bytes(blockFrames, (uint32_t)numChannels);
+      b.frames          = malloc(sizeof(int16_t) * SC_ARCHIVE_BATCH_BLOCKS * blockFrames * (uint32_t)numChannels);
+      b.out             = malloc(b.max_block_bytes * SC_ARCHIVE_BATCH_BLOCKS);
+      b.tmp             = malloc(sizeof(int32_t) * SC_ARCHIVE_BATCH_BLOCKS * (blockFrames + 3u));
+      b.res             = malloc(sizeof(uint32_t) * SC_ARCHIVE_BATCH_BLOCKS * blockFrames);
+
+      fh = fopen(_pathName, "wb");
+
+      if((NULL != fh) && (NULL != table) && (NULL != b.frames) && (NULL != b.out) && (NULL != b.tmp) && (NULL != b.res))
+      {
+         size_t tableOff = loc_write_header(fh, _alg, _sc, (uint32_t)numChannels, _sampleRate, numFrames, blockFrames, numBlocks);
+         size_t numFramesDone = 0u;
+         uint32_t blockIdx = 0u;
+
+         ret = (0u != tableOff);
+
+         while(ret && (numFramesDone < numFrames))
+         {
+            size_t maxFrames = (size_t)SC_ARCHIVE_BATCH_BLOCKS * blockFrames;
+            uint32_t numBatchBlocks;
+            uint32_t i;
+
+            b.num_frames = 0u;
+
+            while(b.num_frames < maxFrames)
+            {
+               size_t num = _read(_readCtx, b.frames + (b.num_frames * b.num_channels), maxFrames - b.num_frames);
+
+               if(0u == num)
+               {
+                  break;
+               }
+
+               b.num_frames += num;
+            }
+
+            if((0u == b.num_frames) || ((numFramesDone + b.num_frames) > numFrames))
+            {
+               ret = SC_FALSE;
+               break;
+            }
+
+            numBatchBlocks = (uint32_t) ((b.num_frames + blockFrames - 1u) / blockFrames);
+
+            sc_parallel_for(numBatchBlocks, &loc_encode_block_job, &b, 0u);
+
+            SC_PROFILE_BEGIN(IO);
+
+            for(i = 0; ret && (i < numBatchBlocks); i++)
+            {
+               ret = (b.sizes[i] == fwrite(b.out + ((size_t)i * b.max_block_bytes), 1, b.sizes[i], fh));
+
+               SC_PROFILE_COUNT(BYTES_WRITTEN, b.sizes[i]);
+
+               table[2u * blockIdx + 0u] = b.sizes[i];
+               table[2u * blockIdx + 1u] = b.crcs[i];
+               blockIdx++;
+            }
+
+            SC_PROFILE_END(IO);
+
+            numFramesDone += b.num_frames;
+         }
+
+         // Patch block table
+         if(ret && (0 == fseek(fh, (long)tableOff, SEEK_SET)))
+         {
+            uint32_t i;
+
+            for(i = 0; ret && (i < numBlocks); i++)
+            {
+               uint8_t buf[8];
+
+               loc_put_u32(buf + 0, table[2u * i + 0u]);
+               loc_put_u32(buf + 4, table[2u * i + 1u]);
+
+               ret = (8u == fwrite(buf, 1, 8u, fh));
+            }
+         }
+         else
+         {
+            ret = SC_FALSE;
+         }
+      }
+
+      if(NULL != fh)
+      {
+         ret = (0 == fclose(fh)) && ret;
+
+         if(!ret)
+         {
+            remove(_pathName);
+         }
+      }
+
+      free(b.res);
+      free(b.tmp);
+      free(b.out);
+      free(b.frames);
+      free(table);
+   }
+
+   return ret;
+}
+
+bool_t samplechain_archive_save(const char *_pathName,
+                                const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                const samplechain_render_params_t *_renderParams,
+                                uint32_t _sampleRate, uint32_t _blockFrames
+                                ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _pathName) && (NULL != _alg) && (NULL != _renderParams))
+   {
+      samplechain_render_stream_t *stream = samplechain_render_stream_open(_alg, _sc, _renderParams);
+
+      if(NULL != stream)
+      {
+         ret = loc_save(_pathName, _alg, _sc, _sampleRate, _blockFrames, &loc_read_stream, stream);
+
+         samplechain_render_stream_close(stream);
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_archive_save_frames(const char *_pathName,
+                                       const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                       const int16_t *_frames,
+                                       uint32_t _sampleRate, uint32_t _blockFrames
+                                       ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _pathName) && (NULL != _alg) && (NULL != _frames))
+   {
+      frames_reader_t r;
+      int32_t numChannels = 1;
+
+      _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+      r.frames       = _frames;
+      r.num_frames   = _alg->query_total_size(_sc);
+      r.pos          = 0u;
+      r.num_channels = (uint32_t)numChannels;
+
+      ret = loc_save(_pathName, _alg, _sc, _sampleRate, _blockFrames, &loc_read_frames, &r);
+   }
+
+   return ret;
+}
+
+// Read the header of an archive (see loc_write_header())
+static bool_t loc_read_header(samplechain_archive_t *_ar) {
+   uint8_t buf[SC_ARCHIVE_MAX_NAME_LEN + 8u];
+   size_t off = 40u;
+   uint32_t nameLen;
+   uint32_t n;
+   uint32_t i;
+
+   if( !loc_pread_all(_ar->fd, buf, 40u, 0u) ||
+       (0 != memcmp(buf, "SCAR", 4)) || (SC_ARCHIVE_VERSION != loc_get_u32(buf + 4))
+       )
+   {
+      return SC_FALSE;
+   }
+
+   _ar->info.num_channels = loc_get_u32(buf +  8);
+   _ar->info.sample_rate  = loc_get_u32(buf + 12);
+   _ar->info.num_frames   = loc_get_u32(buf + 16);
+   _ar->info.block_frames = loc_get_u32(buf + 20);
+   _ar->info.num_blocks   = loc_get_u32(buf + 24);
+   _ar->info.num_elements = loc_get_u32(buf + 28);
+   _ar->num_params        = loc_get_u32(buf + 32);
+   nameLen                = loc_get_u32(buf + 36);
+
+   n = _ar->info.num_elements;
+
+   if( (0u == _ar->info.num_channels) || (_ar->info.num_channels > 8u) ||
+       (0u == _ar->info.block_frames) || (_ar->info.block_frames > SC_ARCHIVE_MAX_BLOCK_FRAMES) ||
+       (_ar->info.num_blocks != ((_ar->info.num_frames + _ar->info.block_frames - 1u) / _ar->info.block_frames)) ||
+       (nameLen > SC_ARCHIVE_MAX_NAME_LEN) ||
+       !loc_pread_all(_ar->fd, _ar->algorithm_name, nameLen, off)
+       )
+   {
+      return SC_FALSE;
+   }
+
+   _ar->algorithm_name[nameLen] = '\0';
+   off += nameLen;
+
+   _ar->params         = malloc(sizeof(param_t) * (_ar->num_params + 1u));
+   _ar->offsets        = malloc(sizeof(size_t) * 4u * (n + 1u));
+   _ar->source_indices = malloc(sizeof(uint32_t) * (n + 1u));
+   _ar->sta            = malloc(sizeof(float32_t) * 2u * (n + 1u));
+   _ar->blocks         = malloc(sizeof(block_t) * (_ar->info.num_blocks + 1u));
+
+   if((NULL == _ar->params) || (NULL == _ar->offsets) || (NULL == _ar->source_indices) || (NULL == _ar->sta) || (NULL == _ar->blocks))
+   {
+      return SC_FALSE;
+   }
+
+   _ar->end = _ar->sta + (n + 1u);
+
+   for(i = 0; i < _ar->num_params; i++)
+   {
+      uint32_t len;
+
+      if(!loc_pread_all(_ar->fd, buf, 1u, off))
+      {
+         return SC_FALSE;
+      }
+
+      len = buf[0];
+
+      if(!loc_pread_all(_ar->fd, buf, len + 4u, off + 1u))
+      {
+         return SC_FALSE;
+      }
+
+      memcpy(_ar->params[i].name, buf, len);
+      _ar->params[i].name[len] = '\0';
+      _ar->params[i].value = (int32_t)loc_get_u32(buf + len);
+
+      off += len + 5u;
+   }
+
+   for(i = 0; i < n; i++)
+   {
+      uint32_t u;
+
+      if(!loc_pread_all(_ar->fd, buf, 28u, off))
+      {
+         return SC_FALSE;
+      }
+
+      _ar->offsets[i]                  = loc_get_u32(buf +  0);
+      _ar->offsets[(n + 1u) + i]       = loc_get_u32(buf +  4);
+      _ar->offsets[2u * (n + 1u) + i]  = loc_get_u32(buf +  8);
+      _ar->offsets[3u * (n + 1u) + i]  = loc_get_u32(buf + 12);
+      _ar->source_indices[i]           = loc_get_u32(buf + 16);
+      u = loc_get_u32(buf + 20);
+      memcpy(&_ar->sta[i], &u, sizeof(u));
+      u = loc_get_u32(buf + 24);
+      memcpy(&_ar->end[i], &u, sizeof(u));
+
+      off += 28u;
+   }
+
+   // Block table (compressed sizes + checksums), the block data follows the table
+   {
+      size_t dataOff = off + (8u * (size_t)_ar->info.num_blocks);
+
+      for(i = 0; i < _ar->info.num_blocks; i++)
+      {
+         if(!loc_pread_all(_ar->fd, buf, 8u, off))
+         {
+            return SC_FALSE;
+         }
+
+         _ar->blocks[i].size   = loc_get_u32(buf + 0);
+         _ar->blocks[i].crc    = loc_get_u32(buf + 4);
+         _ar->blocks[i].offset = dataOff;
+
+         dataOff += _ar->blocks[i].size;
+         off += 8u;
+      }
+
+      _ar->info.num_bytes = dataOff;
+   }
+
+   return SC_TRUE;
+}
+
+samplechain_archive_t *samplechain_archive_open(const char *_pathName) {
+   samplechain_archive_t *ret = NULL;
+
+   if(NULL != _pathName)
+   {
+      int fd = open(_pathName, O_RDONLY);
+
+      if(fd >= 0)
+      {
+         ret = malloc(sizeof(samplechain_archive_t));
+
+         if(NULL != ret)
+         {
+            memset(ret, 0, sizeof(samplechain_archive_t));
+
+            ret->fd = fd;
+            ret->info.algorithm_name = ret->algorithm_name;
+
+            if(loc_read_header(ret))
+            {
+               ret->cur_frames = malloc(sizeof(int16_t) * ret->info.block_frames * ret->info.num_channels);
+            }
+
+            if(NULL == ret->cur_frames)
+            {
+               samplechain_archive_close(ret);
+               ret = NULL;
+            }
+         }
+         else
+         {
+            close(fd);
+         }
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_archive_get_info(const samplechain_archive_t *_ar, samplechain_archive_info_t *_retInfo) {
+
+   if((NULL != _ar) && (NULL != _retInfo))
+   {
+      *_retInfo = _ar->info;
+   }
+}
+
+uint32_t samplechain_archive_get_layout(const samplechain_archive_t *_ar, samplechain_layout_t *_retLayout, uint32_t _maxElements) {
+   uint32_t ret = 0;
+
+   if((NULL != _ar) && (NULL != _retLayout))
+   {
+      uint32_t n = _ar->info.num_elements;
+      uint32_t elementIdx;
+
+      ret = (n < _maxElements) ? n : _maxElements;
+
+      for(elementIdx = 0; elementIdx < ret; elementIdx++)
+      {
+         if(NULL != _retLayout->offsets)
+         {
+            _retLayout->offsets[elementIdx] = _ar->offsets[elementIdx];
+         }
+
+         if(NULL != _retLayout->total_sizes)
+         {
+            _retLayout->total_sizes[elementIdx] = _ar->offsets[(n + 1u) + elementIdx];
+         }
+
+         if(NULL != _retLayout->orig_sizes)
+         {
+            _retLayout->orig_sizes[elementIdx] = _ar->offsets[2u * (n + 1u) + elementIdx];
+         }
+
+         if(NULL != _retLayout->pad_sizes)
+         {
+            _retLayout->pad_sizes[elementIdx] = _ar->offsets[3u * (n + 1u) + elementIdx];
+         }
+
+         if(NULL != _retLayout->sta)
+         {
+            _retLayout->sta[elementIdx] = _ar->sta[elementIdx];
+         }
+
+         if(NULL != _retLayout->end)
+         {
+            _retLayout->end[elementIdx] = _ar->end[elementIdx];
+         }
+
+         if(NULL != _retLayout->source_indices)
+         {
+            _retLayout->source_indices[elementIdx] = _ar->source_indices[elementIdx];
+         }
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_archive_get_parameter_i(const samplechain_archive_t *_ar, const char *_paramName, int32_t *_retParamValue) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _ar) && (NULL != _paramName) && (NULL != _retParamValue))
+   {
+      uint32_t paramIdx;
+
+      for(paramIdx = 0; !ret && (paramIdx < _ar->num_params); paramIdx++)
+      {
+         if(0 == strcmp(_ar->params[paramIdx].name, _paramName))
+         {
+            *_retParamValue = _ar->params[paramIdx].value;
+            ret = SC_TRUE;
+         }
+      }
+   }
+
+   return ret;
+}
+
+size_t samplechain_archive_decode_block(const samplechain_archive_t *_ar, uint32_t _blockIdx, int16_t *_retFrames) {
+   size_t ret = 0;
+
+   if((NULL != _ar) && (NULL != _retFrames) && (_blockIdx < _ar->info.num_blocks))
+   {
+      const block_t *block = &_ar->blocks[_blockIdx];
+      size_t numFrames = _ar->info.num_frames - ((size_t)_blockIdx * _ar->info.block_frames);
+      uint8_t *buf = malloc((size_t)block->size + 1u);
+
+      if(numFrames > _ar->info.block_frames)
+      {
+         numFrames = _ar->info.block_frames;
+      }
+
+      if( (NULL != buf) &&
+          (block->size <= loc_get_max_block_bytes(_ar->info.block_frames, _ar->info.num_channels)) &&
+          loc_pread_all(_ar->fd, buf, block->size, block->offset) &&
+          loc_decode_block(buf, block->size, numFrames, _ar->info.num_channels, _retFrames) &&
+          (block->crc == sc_kernel_crc32c(_retFrames, sizeof(int16_t) * numFrames * _ar->info.num_channels, 0u))
+          )
+      {
+         ret = numFrames;
+      }
+
+      free(buf);
+   }
+
+   return ret;
+}
+
+size_t samplechain_archive_read(samplechain_archive_t *_ar, int16_t *_retFrames, size_t _maxFrames) {
+   size_t ret = 0;
+
+   if((NULL != _ar) && (NULL != _retFrames))
+   {
+      uint32_t numCh = _ar->info.num_channels;
+
+      while(ret < _maxFrames)
+      {
+         size_t num;
+
+         if(_ar->cur_pos == _ar->cur_num_frames)
+         {
+            // Decompress next block
+            if(_ar->cur_block_idx >= _ar->info.num_blocks)
+            {
+               break;
+            }
+
+            _ar->cur_num_frames = samplechain_archive_decode_block(_ar, _ar->cur_block_idx, _ar->cur_frames);
+            _ar->cur_pos = 0u;
+
+            if(0u == _ar->cur_num_frames)
+            {
+               // (note) corrupt block, stop the stream
+               _ar->cur_block_idx = _ar->info.num_blocks;
+               break;
+            }
+
+            _ar->cur_block_idx++;
+         }
+
+         num = _ar->cur_num_frames - _ar->cur_pos;
+
+         if(num > (_maxFrames - ret))
+         {
+            num = _maxFrames - ret;
+         }
+
+         memcpy(_retFrames + (ret * numCh), _ar->cur_frames + (_ar->cur_pos * numCh), sizeof(int16_t) * num * numCh);
+
+         ret          += num;
+         _ar->cur_pos += num;
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_archive_close(samplechain_archive_t *_ar) {
+
+   if(NULL != _ar)
+   {
+      close(_ar->fd);
+
+      free(_ar->cur_frames);
+      free(_ar->blocks);
+      free(_ar->sta);
+      free(_ar->source_indices);
+      free(_ar->offsets);
+      free(_ar->params);
+      free(_ar);
+   }
+}
@@ -0,0 +1,109 @@
+/* ----
+ * ---- file   : archive.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_ARCHIVE_H_INCLUDED
+#define SAMPLECHAIN_ARCHIVE_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_ARCHIVE_DEFAULT_BLOCK_FRAMES  4096u
+#define SC_ARCHIVE_MAX_BLOCK_FRAMES      65536u
+
+
+// Opaque (read-only) chain archive
+typedef struct samplechain_archive_s samplechain_archive_t;
+
+typedef struct {
+   uint32_t    num_channels;
+   uint32_t    sample_rate;
+   size_t      num_frames;      // chain size
+   uint32_t    block_frames;    // number of chain frames per compressed block (the last block may be shorter)
+   uint32_t    num_blocks;
+   uint32_t    num_elements;
+   size_t      num_bytes;       // archive file size
+   const char *algorithm_name;
+} samplechain_archive_info_t;
+
+
+// Write a calculated chain (layout, parameters and 16bit audio) to a compressed archive file
+//  - The chain is rendered block by block via a render stream (see samplechain_render_stream_open())
+//  - Runs of silent frames (e.g. padding) are stored as run lengths, all other frames are
+//     coded losslessly (fixed linear prediction + Rice coding)
+//  - Blocks of 'blockFrames' frames (0=SC_ARCHIVE_DEFAULT_BLOCK_FRAMES) are compressed in parallel
+//  - Returns false if the chain cannot be rendered or the file cannot be written
+bool_t samplechain_archive_save (const char *_pathName,
+                                 const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                 const samplechain_render_params_t *_renderParams,
+                                 uint32_t _sampleRate, uint32_t _blockFrames
+                                 );
+
+// Same as samplechain_archive_save() but compresses already rendered (interleaved 16bit) sample frames
+//  - 'frames' must contain query_total_size() frames
+bool_t samplechain_archive_save_frames (const char *_pathName,
+                                        const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                        const int16_t *_frames,
+                                        uint32_t _sampleRate, uint32_t _blockFrames
+                                        );
+
+// Open an archive file
+//  - Reads the layout / parameters, the audio is decompressed on demand
+//  - Returns NULL if the file cannot be opened or is not a (supported) archive
+samplechain_archive_t *samplechain_archive_open (const char *_pathName);
+
+// Query archive info
+//  - 'algorithm_name' remains valid until the archive is closed
+void samplechain_archive_get_info (const samplechain_archive_t *_ar, samplechain_archive_info_t *_retInfo);
+
+// Query the stored chain layout (see query_layout())
+//  - Returns the number of elements written
+uint32_t samplechain_archive_get_layout (const samplechain_archive_t *_ar, samplechain_layout_t *_retLayout, uint32_t _maxElements);
+
+// Query a stored algorithm parameter value
+//  - Returns false if the parameter was not stored
+bool_t samplechain_archive_get_parameter_i (const samplechain_archive_t *_ar, const char *_paramName, int32_t *_retParamValue);
+
+// Decompress block 'blockIdx' to 'retFrames' (room for 'block_frames' interleaved 16bit frames)
+//  - Thread-safe (positioned reads), i.e. blocks can be decompressed in parallel
+//  - Returns the number of frames, or 0 if the block is invalid or corrupt (checksum mismatch)
+size_t samplechain_archive_decode_block (const samplechain_archive_t *_ar, uint32_t _blockIdx, int16_t *_retFrames);
+
+// Decompress the next (up to) 'maxFrames' chain frames (sequential stream, not thread-safe)
+//  - Returns the number of frames written to 'retFrames' (0 at the end of the chain or on error)
+size_t samplechain_archive_read (samplechain_archive_t *_ar, int16_t *_retFrames, size_t _maxFrames);
+
+// Close archive
+void samplechain_archive_close (samplechain_archive_t *_ar);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_ARCHIVE_H_INCLUDED
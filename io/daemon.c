@@ -0,0 +1,1190 @@
+/* ----
+ * ---- file   : daemon.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#if !defined(SC_NO_THREADS) && !defined(SC_NO_MMAP)
+#define SC_DAEMON_ENABLED
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../render/cache.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "wav.h"
+#include "daemon.h"
+
+#define SC_DAEMON_MAGIC_REQUEST  0x51444353u  // "SCDQ"
+#define SC_DAEMON_MAGIC_RESULT   0x52444353u  // "SCDR"
+#define SC_DAEMON_MAGIC_SEGMENT  0x53444353u  // "SCDS"
+
+#define SC_DAEMON_MAX_REQUEST_BYTES  (SC_DAEMON_MAX_FILES * (PATH_MAX + 4u) + 4096u)
+#define SC_DAEMON_SHM_NAME_LEN       64u
+
+#define SC_DAEMON_STATUS_OK      0u
+#define SC_DAEMON_STATUS_FAILED  1u
+#define SC_DAEMON_STATUS_BUSY    2u  // all result slots are used by in-flight builds
+
+
+void samplechain_daemon_init_request(samplechain_daemon_request_t *_req) {
+
+   if(NULL != _req)
+   {
+      memset(_req, 0, sizeof(samplechain_daemon_request_t));
+
+      _req->num_slices         = 120u;
+      _req->normalize_level_db = -1.0f;
+   }
+}
+
+
+#ifdef SC_DAEMON_ENABLED
+
+// Shared memory segment header
+//  - Followed by the layout arrays (offsets, total sizes, orig sizes, pad sizes, STA, END, source indices) and the sample frames
+typedef struct {
+   uint32_t magic;
+   uint32_t num_elements;
+   uint32_t num_channels;
+   uint32_t sample_rate;
+   uint64_t num_frames;
+   uint64_t frames_offset;
+} segment_header_t;
+
+typedef struct {
+   uint32_t magic;
+   uint32_t status;   // SC_DAEMON_STATUS_xxx
+   uint32_t b_shared;
+   uint32_t reserved;
+   char     shm_name[SC_DAEMON_SHM_NAME_LEN];
+} response_t;
+
+
+#define JOB_RUNNING  0u
+#define JOB_DONE     1u
+#define JOB_FAILED   2u
+
+typedef struct job_s {
+   uint8_t  *key;          // serialized request
+   size_t    key_size;
+   uint64_t  hash;
+   uint32_t  state;        // JOB_xxx
+   uint32_t  num_waiters;  // connections waiting for the in-flight build (the job must not be dropped)
+   uint64_t  last_use;
+   char      shm_name[SC_DAEMON_SHM_NAME_LEN];
+
+   struct job_s *next;
+} job_t;
+
+struct samplechain_daemon_s {
+   int  listen_fd;
+   char socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+
+   uint32_t max_jobs;
+   uint32_t num_jobs;
+   job_t   *jobs;
+
+   uint32_t num_segments;    // used to create unique shared memory names
+   uint64_t use_counter;
+   uint32_t num_connections; // connection threads that are still running
+   bool_t   b_stop;          // atomic
+
+   samplechain_daemon_stats_t stats;
+
+   pthread_mutex_t mutex;
+   pthread_cond_t  cond;     // signaled when a job or a connection has finished
+};
+
+typedef struct {
+   samplechain_daemon_t *daemon;
+   int fd;
+} connection_t;
+
+// Parsed request (points into the serialized request)
+typedef struct {
+   uint32_t    algorithm_idx;
+   uint32_t    num_slices;
+   uint32_t    num_channels;
+   uint32_t    normalize_mode;
+   float32_t   normalize_level_db;
+   uint32_t    num_params;
+   char        param_names[SC_DAEMON_MAX_PARAMS][64];
+   int32_t     param_values[SC_DAEMON_MAX_PARAMS];
+   uint32_t    num_files;
+   char      **path_names;
+   uint64_t   *file_versions;  // see samplechain_cache_get_file_version()
+} parsed_request_t;
+
+
+// Helper fxns:
+static bool_t loc_write_all(int _fd, const void *_s, size_t _numBytes) {
+   const uint8_t *s = (const uint8_t*)_s;
+   bool_t ret = SC_TRUE;
+
+   while(ret && (_numBytes > 0u))
+   {
+      ssize_t num = send(_fd, s, _numBytes, MSG_NOSIGNAL);
+
+      if(num > 0)
+      {
+         s         += num;
+         _numBytes -= (size_t)num;
+      }
+      else
+      {
+         ret = (num < 0) && (EINTR == errno);
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_read_all(int _fd, void *_d, size_t _numBytes) {
+   uint8_t *d = (uint8_t*)_d;
+   bool_t ret = SC_TRUE;
+
+   while(ret && (_numBytes > 0u))
+   {
+      ssize_t num = recv(_fd, d, _numBytes, 0);
+
+      if(num > 0)
+      {
+         d         += num;
+         _numBytes -= (size_t)num;
+      }
+      else
+      {
+         ret = (num < 0) && (EINTR == errno);
+      }
+   }
+
+   return ret;
+}
+
+// Byte offsets of the layout arrays / sample frames in a shared memory segment
+static size_t loc_get_segment_frames_offset(uint32_t _numElements) {
+   size_t ret = sizeof(segment_header_t);
+
+   ret += sizeof(size_t) * 4u * _numElements;
+   ret += sizeof(float32_t) * 2u * _numElements;
+   ret += sizeof(uint32_t) * _numElements;
+
+   return (ret + 15u) & ~(size_t)15u;
+}
+
+static void loc_get_segment_layout(uint8_t *_seg, uint32_t _numElements, samplechain_layout_t *_retLayout) {
+   size_t *sizes = (size_t*) (_seg + sizeof(segment_header_t));
+   float32_t *sta = (float32_t*) (sizes + 4u * _numElements);
+
+   _retLayout->offsets        = sizes;
+   _retLayout->total_sizes    = sizes + _numElements;
+   _retLayout->orig_sizes     = sizes + 2u * _numElements;
+   _retLayout->pad_sizes      = sizes + 3u * _numElements;
+   _retLayout->sta            = sta;
+   _retLayout->end            = sta + _numElements;
+   _retLayout->source_indices = (uint32_t*) (sta + 2u * _numElements);
+}
+
+// Request (de-)serialization
+static void loc_put_u32(uint8_t **_d, uint32_t _v) {
+   memcpy(*_d, &_v, sizeof(uint32_t));
+   *_d += sizeof(uint32_t);
+}
+
+static void loc_put_string(uint8_t **_d, const char *_s) {
+   uint32_t len = (uint32_t)strlen(_s);
+
+   loc_put_u32(_d, len);
+   memcpy(*_d, _s, len);
+   *_d += len;
+}
+
+static bool_t loc_get_u32(const uint8_t **_s, const uint8_t *_e, uint32_t *_retV) {
+   bool_t ret = ((size_t)(_e - *_s) >= sizeof(uint32_t));
+
+   if(ret)
+   {
+      memcpy(_retV, *_s, sizeof(uint32_t));
+      *_s += sizeof(uint32_t);
+   }
+
+   return ret;
+}
+
+static bool_t loc_get_string(const uint8_t **_s, const uint8_t *_e, char *_d, size_t _maxLen) {
+   uint32_t len;
+   bool_t ret = loc_get_u32(_s, _e, &len) && (len < _maxLen) && ((size_t)(_e - *_s) >= len);
+
+   if(ret)
+   {
+      memcpy(_d, *_s, len);
+      _d[len] = '\0';
+      *_s += len;
+   }
+
+   return ret;
+}
+
+// Parse serialized request
+//  - 'retReq->path_names' must be freed by the caller (also when parsing failed)
+static bool_t loc_parse_request(const uint8_t *_s, size_t _numBytes, parsed_request_t *_retReq) {
+   const uint8_t *e = _s + _numBytes;
+   uint32_t levelBits = 0u;
+   uint32_t i;
+   bool_t ret;
+
+   memset(_retReq, 0, sizeof(parsed_request_t));
+
+   ret = loc_get_u32(&_s, e, &_retReq->algorithm_idx) &&
+         loc_get_u32(&_s, e, &_retReq->num_slices) &&
+         loc_get_u32(&_s, e, &_retReq->num_channels) &&
+         loc_get_u32(&_s, e, &_retReq->normalize_mode) &&
+         loc_get_u32(&_s, e, &levelBits) &&
+         loc_get_u32(&_s, e, &_retReq->num_params) &&
+         loc_get_u32(&_s, e, &_retReq->num_files) &&
+         (_retReq->num_params <= SC_DAEMON_MAX_PARAMS) &&
+         (_retReq->num_files > 0u) && (_retReq->num_files <= SC_DAEMON_MAX_FILES) &&
+         (_retReq->num_channels <= 8u);
+
+   memcpy(&_retReq->normalize_level_db, &levelBits, sizeof(float32_t));
+
+   for(i = 0; ret && (i < _retReq->num_params); i++)
+   {
+      ret = loc_get_string(&_s, e, _retReq->param_names[i], sizeof(_retReq->param_names[i])) &&
+            loc_get_u32(&_s, e, (uint32_t*)&_retReq->param_values[i]);
+   }
+
+   if(ret)
+   {
+      _retReq->path_names = calloc(_retReq->num_files, sizeof(char*));
+      ret = (NULL != _retReq->path_names);
+   }
+
+   for(i = 0; ret && (i < _retReq->num_files); i++)
+   {
+      _retReq->path_names[i] = malloc(PATH_MAX);
+
+      ret = (NULL != _retReq->path_names[i]) && loc_get_string(&_s, e, _retReq->path_names[i], PATH_MAX);
+   }
+
+   return ret && (_s == e);
+}
+
+static void loc_free_request(parsed_request_t *_req) {
+
+   if(NULL != _req->path_names)
+   {
+      uint32_t i;
+
+      for(i = 0; i < _req->num_files; i++)
+      {
+         free(_req->path_names[i]);
+      }
+
+      free(_req->path_names);
+      _req->path_names = NULL;
+   }
+
+   free(_req->file_versions);
+   _req->file_versions = NULL;
+}
+
+// Append the current identities (inode, size, modification time) of the request files to the serialized request
+//  - The job key then changes when a file is edited in place, i.e. a stale result is not reused
+//  - Reallocates 'key' (the original key stays valid when this fails)
+static bool_t loc_add_file_versions(parsed_request_t *_req, uint8_t **_key, size_t *_keySize) {
+   uint8_t *key;
+   uint32_t i;
+   bool_t ret;
+
+   _req->file_versions = malloc(sizeof(uint64_t) * _req->num_files);
+   key = (NULL != _req->file_versions) ? realloc(*_key, *_keySize + sizeof(uint64_t) * _req->num_files) : NULL;
+   ret = (NULL != key);
+
+   if(ret)
+   {
+      for(i = 0; i < _req->num_files; i++)
+      {
+         _req->file_versions[i] = samplechain_cache_get_file_version(_req->path_names[i]);
+      }
+
+      memcpy(key + *_keySize, _req->file_versions, sizeof(uint64_t) * _req->num_files);
+
+      *_key      = key;
+      *_keySize += sizeof(uint64_t) * _req->num_files;
+   }
+
+   return ret;
+}
+
+static float32_t *loc_load_wav(void *_loadCtx, const char *_pathName, uint32_t _numChannels, size_t *_retNumFrames) {
+   samplechain_wav_info_t info;
+   float32_t *ret = samplechain_wav_load(_pathName, _numChannels, &info);
+   (void)_loadCtx;
+
+   *_retNumFrames = (NULL != ret) ? info.num_frames : 0u;
+
+   return ret;
+}
+
+static bool_t loc_fetch_element(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   (void)_fetchCtx;
+   (void)_numFrames;
+
+   _retSource->frames = samplechain_cache_entry_get_frames((const samplechain_cache_entry_t*)_userData, &_retSource->num_frames);
+
+   return (NULL != _retSource->frames);
+}
+
+// Calculate + render chain into a new shared memory segment
+//  - Returns false if the chain could not be built
+static bool_t loc_build(samplechain_daemon_t *_daemon, const parsed_request_t *_req, char *_retShmName) {
+   bool_t ret = SC_FALSE;
+   samplechain_wav_info_t info;
+   samplechain_cache_entry_t **entries = calloc(_req->num_files, sizeof(samplechain_cache_entry_t*));
+   samplechain_algorithm_t alg;
+   samplechain_t sc = NULL;
+   uint32_t numChannels = _req->num_channels;
+   uint32_t i;
+   bool_t bOk;
+
+   bOk = (NULL != entries) && samplechain_wav_read_info(_req->path_names[0], &info);
+
+   if(bOk)
+   {
+      if(0u == numChannels)
+      {
+         numChannels = (info.num_channels > 8u) ? 8u : info.num_channels;
+      }
+
+      if(SC_DAEMON_ALGORITHM_AUTO == _req->algorithm_idx)
+      {
+         samplechain_select_auto(&alg);
+      }
+      else
+      {
+         bOk = samplechain_select_algorithm(_req->algorithm_idx, &alg);
+      }
+   }
+
+   if(bOk)
+   {
+      alg.init(&sc, (0u != _req->num_slices) ? _req->num_slices : 120u);
+      bOk = (NULL != sc);
+   }
+
+   if(bOk)
+   {
+      alg.set_parameter_i(sc, "bytes_per_sample", 2);
+      alg.set_parameter_i(sc, "num_channels", (int32_t)numChannels);
+
+      for(i = 0; i < _req->num_params; i++)
+      {
+         if(!alg.set_parameter_i(sc, _req->param_names[i], _req->param_values[i]))
+         {
+            printf("[~~~] warning: daemon: failed to set parameter \"%s\" to %d\n", _req->param_names[i], _req->param_values[i]);
+         }
+      }
+
+      // (note) each source is decoded once per host (process-wide cache)
+      for(i = 0; bOk && (i < _req->num_files); i++)
+      {
+         entries[i] = samplechain_cache_acquire(_req->path_names[i], _req->file_versions[i], numChannels, &loc_load_wav, NULL);
+
+         if(NULL != entries[i])
+         {
+            size_t numFrames;
+
+            samplechain_cache_entry_get_frames(entries[i], &numFrames);
+
+            bOk = alg.add(sc, numFrames, entries[i]);
+         }
+         else
+         {
+            printf("[---] daemon: failed to load \"%s\"\n", _req->path_names[i]);
+            bOk = SC_FALSE;
+         }
+      }
+   }
+
+   if(bOk)
+   {
+      size_t numFrames;
+      uint32_t numElements;
+
+      alg.calc(sc);
+
+      numFrames   = alg.query_total_size(sc);
+      numElements = alg.query_num_elements(sc);
+
+      if(numFrames > 0u)
+      {
+         size_t framesOffset = loc_get_segment_frames_offset(numElements);
+         size_t segSize = framesOffset + (sizeof(int16_t) * numFrames * numChannels);
+         int fd;
+
+         pthread_mutex_lock(&_daemon->mutex);
+         snprintf(_retShmName, SC_DAEMON_SHM_NAME_LEN, "/samplechain-%d-%u", (int)getpid(), ++_daemon->num_segments);
+         pthread_mutex_unlock(&_daemon->mutex);
+
+         // (note) clients map the segment read-only
+         // (note) only accessible by the daemon user (results may contain private audio)
+         fd = shm_open(_retShmName, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+         if(fd >= 0)
+         {
+            uint8_t *seg = NULL;
+
+            if(0 == ftruncate(fd, (off_t)segSize))
+            {
+               seg = mmap(NULL, segSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+
+            if((NULL != seg) && (MAP_FAILED != (void*)seg))
+            {
+               segment_header_t *hdr = (segment_header_t*)seg;
+               samplechain_render_params_t params;
+               samplechain_layout_t layout;
+
+               loc_get_segment_layout(seg, numElements, &layout);
+
+               samplechain_render_init_params(&params);
+               params.fetch              = &loc_fetch_element;
+               params.normalize_mode     = _req->normalize_mode;
+               params.normalize_level_db = _req->normalize_level_db;
+
+               ret = (numElements == alg.query_layout(sc, &layout, numElements)) &&
+                     samplechain_render(&alg, sc, &params, (int16_t*)(seg + framesOffset), numFrames);
+
+               hdr->magic         = SC_DAEMON_MAGIC_SEGMENT;
+               hdr->num_elements  = numElements;
+               hdr->num_channels  = numChannels;
+               hdr->sample_rate   = info.sample_rate;
+               hdr->num_frames    = numFrames;
+               hdr->frames_offset = framesOffset;
+
+               munmap(seg, segSize);
+            }
+
+            close(fd);
+
+            if(!ret)
+            {
+               shm_unlink(_retShmName);
+            }
+         }
+      }
+   }
+
+   if(NULL != sc)
+   {
+      alg.exit(&sc);
+   }
+
+   for(i = 0; (NULL != entries) && (i < _req->num_files); i++)
+   {
+      samplechain_cache_release(entries[i]);
+   }
+
+   free(entries);
+
+   return ret;
+}
+
+static void loc_free_job(job_t *_job) {
+
+   if(JOB_DONE == _job->state)
+   {
+      shm_unlink(_job->shm_name);
+   }
+
+   free(_job->key);
+   free(_job);
+}
+
+// Unlink job from the job table (mutex must be locked)
+static void loc_remove_job(samplechain_daemon_t *_daemon, job_t *_job) {
+   job_t **pp = &_daemon->jobs;
+
+   while(*pp != _job)
+   {
+      pp = &(*pp)->next;
+   }
+
+   *pp = _job->next;
+   _daemon->num_jobs--;
+
+   loc_free_job(_job);
+}
+
+// Remove the least recently used job that nobody waits for (mutex must be locked)
+//  - Returns false if all jobs are in use
+static bool_t loc_drop_job(samplechain_daemon_t *_daemon) {
+   job_t **lru = NULL;
+   job_t **pp;
+   bool_t ret = SC_FALSE;
+
+   for(pp = &_daemon->jobs; NULL != *pp; pp = &(*pp)->next)
+   {
+      const job_t *job = *pp;
+
+      if((JOB_RUNNING != job->state) && (0u == job->num_waiters))
+      {
+         // (note) failed jobs are dropped first
+         if( (NULL == lru) ||
+             ((JOB_FAILED == job->state) && (JOB_FAILED != (*lru)->state)) ||
+             ((job->state == (*lru)->state) && (job->last_use < (*lru)->last_use))
+             )
+         {
+            lru = pp;
+         }
+      }
+   }
+
+   if(NULL != lru)
+   {
+      loc_remove_job(_daemon, *lru);
+
+      ret = SC_TRUE;
+   }
+
+   return ret;
+}
+
+static job_t *loc_find_job(samplechain_daemon_t *_daemon, uint64_t _hash, const uint8_t *_key, size_t _keySize) {
+   job_t *ret = _daemon->jobs;
+
+   while( (NULL != ret) &&
+          ( (JOB_FAILED == ret->state) || (ret->hash != _hash) || (ret->key_size != _keySize) || (0 != memcmp(ret->key, _key, _keySize)) )
+          )
+   {
+      ret = ret->next;
+   }
+
+   return ret;
+}
+
+// Look up (or build) the result of a serialized request
+//  - Takes ownership of 'key'
+//  - Jobs are keyed on the serialized request and the file identities (see loc_add_file_versions())
+static void loc_handle_request(samplechain_daemon_t *_daemon, uint8_t *_key, size_t _keySize, response_t *_retResponse) {
+   parsed_request_t req;
+   bool_t bParsed;
+   uint64_t hash;
+   job_t *job;
+
+   _retResponse->status = SC_DAEMON_STATUS_FAILED;
+
+   bParsed = loc_parse_request(_key, _keySize, &req) && loc_add_file_versions(&req, &_key, &_keySize);
+   hash    = sc_kernel_hash(_key, _keySize, 0u);
+
+   pthread_mutex_lock(&_daemon->mutex);
+
+   _daemon->stats.num_requests++;
+
+   job = bParsed ? loc_find_job(_daemon, hash, _key, _keySize) : NULL;
+
+   if(NULL != job)
+   {
+      // Identical request: wait for the in-flight build or reuse the completed result
+      if(JOB_RUNNING == job->state)
+      {
+         _daemon->stats.num_joins++;
+
+         job->num_waiters++;
+
+         while(JOB_RUNNING == job->state)
+         {
+            pthread_cond_wait(&_daemon->cond, &_daemon->mutex);
+         }
+
+         job->num_waiters--;
+      }
+      else
+      {
+         _daemon->stats.num_hits++;
+      }
+
+      if(JOB_DONE == job->state)
+      {
+         job->last_use = ++_daemon->use_counter;
+
+         memcpy(_retResponse->shm_name, job->shm_name, SC_DAEMON_SHM_NAME_LEN);
+         _retResponse->status   = SC_DAEMON_STATUS_OK;
+         _retResponse->b_shared = SC_TRUE;
+      }
+      else if(0u == job->num_waiters)
+      {
+         // (note) the last joiner of a failed build removes it (a later request retries the build)
+         loc_remove_job(_daemon, job);
+      }
+
+      free(_key);
+   }
+   else
+   {
+      while(bParsed && (_daemon->num_jobs >= _daemon->max_jobs) && loc_drop_job(_daemon))
+      {
+      }
+
+      if(!bParsed)
+      {
+         printf("[---] daemon: invalid request\n");
+      }
+      else if(_daemon->num_jobs >= _daemon->max_jobs)
+      {
+         _retResponse->status = SC_DAEMON_STATUS_BUSY;
+      }
+      else
+      {
+         job = malloc(sizeof(job_t));
+
+         if(NULL != job)
+         {
+            bool_t bOk;
+
+            job->key         = _key;
+            job->key_size    = _keySize;
+            job->hash        = hash;
+            job->state       = JOB_RUNNING;
+            job->num_waiters = 0u;
+            job->last_use    = ++_daemon->use_counter;
+            job->next        = _daemon->jobs;
+
+            _daemon->jobs = job;
+            _daemon->num_jobs++;
+
+            pthread_mutex_unlock(&_daemon->mutex);
+
+            bOk = loc_build(_daemon, &req, job->shm_name);
+
+            pthread_mutex_lock(&_daemon->mutex);
+
+            if(bOk)
+            {
+               job->state = JOB_DONE;
+               _daemon->stats.num_builds++;
+
+               memcpy(_retResponse->shm_name, job->shm_name, SC_DAEMON_SHM_NAME_LEN);
+               _retResponse->status = SC_DAEMON_STATUS_OK;
+            }
+            else
+            {
+               job->state = JOB_FAILED;
+
+               if(0u == job->num_waiters)
+               {
+                  loc_remove_job(_daemon, job);
+               }
+            }
+
+            pthread_cond_broadcast(&_daemon->cond);
+
+            // (note) the key is owned by the job
+            _key = NULL;
+         }
+      }
+
+      free(_key);
+   }
+
+   loc_free_request(&req);
+
+   if(SC_DAEMON_STATUS_OK != _retResponse->status)
+   {
+      _daemon->stats.num_failed++;
+   }
+
+   pthread_mutex_unlock(&_daemon->mutex);
+}
+
+static void *loc_connection_thread(void *_conn) {
+   connection_t *conn = (connection_t*)_conn;
+   samplechain_daemon_t *daemon = conn->daemon;
+   uint32_t hdr[2];
+   response_t response;
+
+   memset(&response, 0, sizeof(response));
+   response.magic  = SC_DAEMON_MAGIC_RESULT;
+   response.status = SC_DAEMON_STATUS_FAILED;
+
+   if( loc_read_all(conn->fd, hdr, sizeof(hdr)) &&
+       (SC_DAEMON_MAGIC_REQUEST == hdr[0]) && (hdr[1] > 0u) && (hdr[1] <= SC_DAEMON_MAX_REQUEST_BYTES)
+       )
+   {
+      uint8_t *key = malloc(hdr[1]);
+
+      if((NULL != key) && loc_read_all(conn->fd, key, hdr[1]))
+      {
+         loc_handle_request(daemon, key, hdr[1], &response);
+      }
+      else
+      {
+         free(key);
+      }
+   }
+
+   loc_write_all(conn->fd, &response, sizeof(response));
+
+   close(conn->fd);
+   free(conn);
+
+   pthread_mutex_lock(&daemon->mutex);
+   daemon->num_connections--;
+   pthread_cond_broadcast(&daemon->cond);
+   pthread_mutex_unlock(&daemon->mutex);
+
+   return NULL;
+}
+
+samplechain_daemon_t *samplechain_daemon_create(const char *_socketPath, uint32_t _maxJobs) {
+   samplechain_daemon_t *ret = NULL;
+
+   if((NULL != _socketPath) && (strlen(_socketPath) < sizeof(((struct sockaddr_un*)0)->sun_path)))
+   {
+      ret = malloc(sizeof(samplechain_daemon_t));
+
+      if(NULL != ret)
+      {
+         struct sockaddr_un addr;
+
+         memset(ret, 0, sizeof(samplechain_daemon_t));
+
+         ret->max_jobs = (0u != _maxJobs) ? _maxJobs : SC_DAEMON_DEFAULT_MAX_JOBS;
+         snprintf(ret->socket_path, sizeof(ret->socket_path), "%s", _socketPath);
+
+         pthread_mutex_init(&ret->mutex, NULL);
+         pthread_cond_init(&ret->cond, NULL);
+
+         memset(&addr, 0, sizeof(addr));
+         addr.sun_family = AF_UNIX;
+         snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", _socketPath);
+
+         // (note) remove stale socket of a previous daemon
+         unlink(_socketPath);
+
+         ret->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+         if( (ret->listen_fd < 0) ||
+             (0 != bind(ret->listen_fd, (const struct sockaddr*)&addr, sizeof(addr))) ||
+             (0 != listen(ret->listen_fd, 64))
+             )
+         {
+            printf("[---] daemon: failed to listen on \"%s\"\n", _socketPath);
+
+            if(ret->listen_fd >= 0)
+            {
+               close(ret->listen_fd);
+            }
+
+            pthread_cond_destroy(&ret->cond);
+            pthread_mutex_destroy(&ret->mutex);
+            free(ret);
+            ret = NULL;
+         }
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_daemon_run(samplechain_daemon_t *_daemon) {
+
+   if(NULL != _daemon)
+   {
+      while(!SC_ATOMIC_LOAD(&_daemon->b_stop))
+      {
+         int fd = accept(_daemon->listen_fd, NULL, NULL);
+
+         if(fd >= 0)
+         {
+            connection_t *conn = malloc(sizeof(connection_t));
+            pthread_attr_t attr;
+            pthread_t thread;
+            bool_t bOk = SC_FALSE;
+
+            if(NULL != conn)
+            {
+               conn->daemon = _daemon;
+               conn->fd     = fd;
+
+               pthread_mutex_lock(&_daemon->mutex);
+               _daemon->num_connections++;
+               pthread_mutex_unlock(&_daemon->mutex);
+
+               pthread_attr_init(&attr);
+               pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+               bOk = (0 == pthread_create(&thread, &attr, &loc_connection_thread, conn));
+
+               pthread_attr_destroy(&attr);
+
+               if(!bOk)
+               {
+                  pthread_mutex_lock(&_daemon->mutex);
+                  _daemon->num_connections--;
+                  pthread_mutex_unlock(&_daemon->mutex);
+
+                  free(conn);
+               }
+            }
+
+            if(!bOk)
+            {
+               close(fd);
+            }
+         }
+         else if((EINTR != errno) && (ECONNABORTED != errno))
+         {
+            // (note) samplechain_daemon_stop() shuts down the socket
+            break;
+         }
+      }
+   }
+}
+
+void samplechain_daemon_stop(samplechain_daemon_t *_daemon) {
+
+   if(NULL != _daemon)
+   {
+      SC_ATOMIC_STORE(&_daemon->b_stop, SC_TRUE);
+
+      // (note) wakes up accept()
+      shutdown(_daemon->listen_fd, SHUT_RDWR);
+   }
+}
+
+void samplechain_daemon_get_stats(samplechain_daemon_t *_daemon, samplechain_daemon_stats_t *_retStats) {
+
+   if((NULL != _daemon) && (NULL != _retStats))
+   {
+      pthread_mutex_lock(&_daemon->mutex);
+
+      *_retStats = _daemon->stats;
+      _retStats->num_jobs = _daemon->num_jobs;
+
+      pthread_mutex_unlock(&_daemon->mutex);
+   }
+}
+
+void samplechain_daemon_destroy(samplechain_daemon_t *_daemon) {
+
+   if(NULL != _daemon)
+   {
+      samplechain_daemon_stop(_daemon);
+
+      pthread_mutex_lock(&_daemon->mutex);
+
+      while(_daemon->num_connections > 0u)
+      {
+         pthread_cond_wait(&_daemon->cond, &_daemon->mutex);
+      }
+
+      pthread_mutex_unlock(&_daemon->mutex);
+
+      while(NULL != _daemon->jobs)
+      {
+         job_t *job = _daemon->jobs;
+
+         _daemon->jobs = job->next;
+         loc_free_job(job);
+      }
+
+      close(_daemon->listen_fd);
+      unlink(_daemon->socket_path);
+
+      pthread_cond_destroy(&_daemon->cond);
+      pthread_mutex_destroy(&_daemon->mutex);
+
+      free(_daemon);
+   }
+}
+
+
+// Client:
+typedef struct {
+   samplechain_daemon_result_t pub;  // (note) must be the first field
+
+   void  *map;
+   size_t map_size;
+} result_t;
+
+// Serialize request (see loc_parse_request())
+//  - Returns NULL if a file does not exist or the request is invalid
+static uint8_t *loc_serialize_request(const samplechain_daemon_request_t *_req, uint32_t *_retNumBytes) {
+   uint8_t *ret = NULL;
+
+   if( (NULL != _req->path_names) && (_req->num_files > 0u) && (_req->num_files <= SC_DAEMON_MAX_FILES) &&
+       (_req->num_params <= SC_DAEMON_MAX_PARAMS)
+       )
+   {
+      size_t maxBytes = 8u + (7u * sizeof(uint32_t)) + (_req->num_params * (64u + 8u)) + (_req->num_files * (PATH_MAX + 4u));
+
+      ret = malloc(maxBytes);
+
+      if(NULL != ret)
+      {
+         uint8_t *d = ret + 8u;
+         char path[PATH_MAX];
+         uint32_t levelBits;
+         bool_t bOk = SC_TRUE;
+         uint32_t i;
+
+         memcpy(&levelBits, &_req->normalize_level_db, sizeof(uint32_t));
+
+         loc_put_u32(&d, _req->algorithm_idx);
+         loc_put_u32(&d, _req->num_slices);
+         loc_put_u32(&d, _req->num_channels);
+         loc_put_u32(&d, _req->normalize_mode);
+         loc_put_u32(&d, levelBits);
+         loc_put_u32(&d, _req->num_params);
+         loc_put_u32(&d, _req->num_files);
+
+         for(i = 0; bOk && (i < _req->num_params); i++)
+         {
+            bOk = (NULL != _req->param_names[i]) && (strlen(_req->param_names[i]) < 64u);
+
+            if(bOk)
+            {
+               loc_put_string(&d, _req->param_names[i]);
+               loc_put_u32(&d, (uint32_t)_req->param_values[i]);
+            }
+         }
+
+         // (note) the daemon runs in a different working directory, and the real path is the cache key
+         for(i = 0; bOk && (i < _req->num_files); i++)
+         {
+            bOk = (NULL != _req->path_names[i]) && (NULL != realpath(_req->path_names[i], path));
+
+            if(bOk)
+            {
+               loc_put_string(&d, path);
+            }
+         }
+
+         if(bOk)
+         {
+            *_retNumBytes = (uint32_t) (d - ret);
+
+            d = ret;
+            loc_put_u32(&d, SC_DAEMON_MAGIC_REQUEST);
+            loc_put_u32(&d, *_retNumBytes - 8u);
+         }
+         else
+         {
+            free(ret);
+            ret = NULL;
+         }
+      }
+   }
+
+   return ret;
+}
+
+// Send request and wait for the response
+static bool_t loc_send_request(const char *_socketPath, const uint8_t *_msg, uint32_t _numBytes, response_t *_retResponse) {
+   bool_t ret = SC_FALSE;
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+   if(fd >= 0)
+   {
+      struct sockaddr_un addr;
+
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", _socketPath);
+
+      ret = (0 == connect(fd, (const struct sockaddr*)&addr, sizeof(addr))) &&
+            loc_write_all(fd, _msg, _numBytes) &&
+            loc_read_all(fd, _retResponse, sizeof(response_t)) &&
+            (SC_DAEMON_MAGIC_RESULT == _retResponse->magic);
+
+      close(fd);
+   }
+
+   return ret;
+}
+
+// Map a result segment (read-only)
+static result_t *loc_map_result(const char *_shmName) {
+   result_t *ret = NULL;
+   int fd = shm_open(_shmName, O_RDONLY, 0);
+
+   if(fd >= 0)
+   {
+      struct stat st;
+
+      if((0 == fstat(fd, &st)) && ((size_t)st.st_size >= sizeof(segment_header_t)))
+      {
+         size_t mapSize = (size_t)st.st_size;
+         uint8_t *seg = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+
+         if(MAP_FAILED != (void*)seg)
+         {
+            const segment_header_t *hdr = (const segment_header_t*)seg;
+
+            if( (SC_DAEMON_MAGIC_SEGMENT == hdr->magic) &&
+                (hdr->frames_offset == loc_get_segment_frames_offset(hdr->num_elements)) &&
+                (mapSize == (hdr->frames_offset + (sizeof(int16_t) * hdr->num_frames * hdr->num_channels)))
+                )
+            {
+               ret = malloc(sizeof(result_t));
+            }
+
+            if(NULL != ret)
+            {
+               ret->map      = seg;
+               ret->map_size = mapSize;
+
+               ret->pub.num_elements = hdr->num_elements;
+               ret->pub.num_channels = hdr->num_channels;
+               ret->pub.sample_rate  = hdr->sample_rate;
+               ret->pub.num_frames   = (size_t)hdr->num_frames;
+               ret->pub.frames       = (const int16_t*) (seg + hdr->frames_offset);
+               ret->pub.b_shared     = SC_FALSE;
+
+               loc_get_segment_layout(seg, hdr->num_elements, &ret->pub.layout);
+            }
+            else
+            {
+               munmap(seg, mapSize);
+            }
+         }
+      }
+
+      close(fd);
+   }
+
+   return ret;
+}
+
+samplechain_daemon_result_t *samplechain_daemon_build(const char *_socketPath, const samplechain_daemon_request_t *_req) {
+   result_t *ret = NULL;
+
+   if((NULL != _socketPath) && (NULL != _req))
+   {
+      uint32_t numBytes;
+      uint8_t *msg = loc_serialize_request(_req, &numBytes);
+      uint32_t numTries;
+
+      // (note) retry once if the daemon dropped the result before it could be mapped
+      for(numTries = 0; (NULL != msg) && (NULL == ret) && (numTries < 2u); numTries++)
+      {
+         response_t response;
+
+         if(!loc_send_request(_socketPath, msg, numBytes, &response) || (SC_DAEMON_STATUS_OK != response.status))
+         {
+            break;
+         }
+
+         response.shm_name[SC_DAEMON_SHM_NAME_LEN - 1u] = '\0';
+
+         ret = loc_map_result(response.shm_name);
+
+         if(NULL != ret)
+         {
+            ret->pub.b_shared = response.b_shared;
+         }
+      }
+
+      free(msg);
+   }
+
+   return (samplechain_daemon_result_t*)ret;
+}
+
+void samplechain_daemon_result_free(samplechain_daemon_result_t *_result) {
+
+   if(NULL != _result)
+   {
+      result_t *result = (result_t*)_result;
+
+      munmap(result->map, result->map_size);
+
+      free(result);
+   }
+}
+
+#else
+
+// (note) the daemon requires threads and shared memory
+samplechain_daemon_t *samplechain_daemon_create(const char *_socketPath, uint32_t _maxJobs) {
+   (void)_socketPath;
+   (void)_maxJobs;
+
+   return NULL;
+}
+
+void samplechain_daemon_run(samplechain_daemon_t *_daemon) {
+   (void)_daemon;
+}
+
+void samplechain_daemon_stop(samplechain_daemon_t *_daemon) {
+   (void)_daemon;
+}
+
+void samplechain_daemon_get_stats(samplechain_daemon_t *_daemon, samplechain_daemon_stats_t *_retStats) {
+   (void)_daemon;
+
+   if(NULL != _retStats)
+   {
+      memset(_retStats, 0, sizeof(samplechain_daemon_stats_t));
+   }
+}
+
+void samplechain_daemon_destroy(samplechain_daemon_t *_daemon) {
+   (void)_daemon;
+}
+
+samplechain_daemon_result_t *samplechain_daemon_build(const char *_socketPath, const samplechain_daemon_request_t *_req) {
+   (void)_socketPath;
+   (void)_req;
+
+   return NULL;
+}
+
+void samplechain_daemon_result_free(samplechain_daemon_result_t *_result) {
+   (void)_result;
+}
+
+#endif // SC_DAEMON_ENABLED
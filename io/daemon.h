@@ -0,0 +1,122 @@
+/* ----
+ * ---- file   : daemon.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_DAEMON_H_INCLUDED
+#define SAMPLECHAIN_DAEMON_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_DAEMON_MAX_PARAMS      16u
+#define SC_DAEMON_MAX_FILES     1024u
+#define SC_DAEMON_DEFAULT_MAX_JOBS  64u  // number of completed results kept by the daemon
+
+#define SC_DAEMON_ALGORITHM_AUTO  (~0u)  // see samplechain_select_auto()
+
+
+// Chain build request
+typedef struct {
+   uint32_t           algorithm_idx;       // see samplechain_select_algorithm() (or SC_DAEMON_ALGORITHM_AUTO)
+   uint32_t           num_slices;          // 0=120
+   uint32_t           num_channels;        // 0=number of channels of the first file
+   uint32_t           normalize_mode;      // SC_NORMALIZE_xxx (see analysis/loudness.h)
+   float32_t          normalize_level_db;
+   uint32_t           num_params;          // algorithm parameters (see set_parameter_i())
+   const char        *param_names[SC_DAEMON_MAX_PARAMS];
+   int32_t            param_values[SC_DAEMON_MAX_PARAMS];
+   uint32_t           num_files;           // chain elements (in chain order)
+   const char *const *path_names;          // WAV files
+} samplechain_daemon_request_t;
+
+// Chain build result (read-only shared memory)
+typedef struct {
+   uint32_t             num_elements;   // number of layout entries (incl. pad elements)
+   uint32_t             num_channels;
+   uint32_t             sample_rate;
+   size_t               num_frames;     // chain size
+   const int16_t       *frames;         // rendered chain (interleaved 16bit sample frames)
+   samplechain_layout_t layout;         // (note) the arrays must not be modified
+   bool_t               b_shared;       // true if the result was built for (or while building) an earlier identical request
+} samplechain_daemon_result_t;
+
+typedef struct {
+   uint64_t num_requests;
+   uint64_t num_builds;     // number of chains that were calculated + rendered
+   uint64_t num_hits;       // requests answered with a completed result
+   uint64_t num_joins;      // requests that waited for an identical in-flight build
+   uint64_t num_failed;
+   uint32_t num_jobs;       // number of results held by the daemon
+} samplechain_daemon_stats_t;
+
+
+// Opaque daemon (server) handle
+typedef struct samplechain_daemon_s samplechain_daemon_t;
+
+
+// Initialize request with default values
+void samplechain_daemon_init_request (samplechain_daemon_request_t *_req);
+
+// Create daemon listening on a Unix domain socket
+//  - Removes a stale socket file at 'socketPath'
+//  - Keeps (at most) 'maxJobs' completed results (0=SC_DAEMON_DEFAULT_MAX_JOBS), the least recently used result is dropped first
+//  - Returns NULL if the socket cannot be created, or when compiled with SC_NO_THREADS / SC_NO_MMAP
+samplechain_daemon_t *samplechain_daemon_create (const char *_socketPath, uint32_t _maxJobs);
+
+// Serve requests until samplechain_daemon_stop() is called
+//  - Each connection is handled by its own thread. Identical requests (same parameters and unchanged files) are built once:
+//     concurrent requests wait for the in-flight build, later requests get the completed result
+//  - Results are handed over as POSIX shared memory segments (layout + rendered audio), i.e. the audio is not copied through the socket
+//  - Element audio is decoded via the decoded sample cache (see render/cache.h)
+void samplechain_daemon_run (samplechain_daemon_t *_daemon);
+
+// Stop serving requests (thread-safe, e.g. called from another thread)
+void samplechain_daemon_stop (samplechain_daemon_t *_daemon);
+
+// Query statistics
+void samplechain_daemon_get_stats (samplechain_daemon_t *_daemon, samplechain_daemon_stats_t *_retStats);
+
+// Wait for pending connections, remove all shared memory segments and the socket file, free daemon
+void samplechain_daemon_destroy (samplechain_daemon_t *_daemon);
+
+
+// Send build request to a daemon and map the result
+//  - Relative file paths are resolved by the client
+//  - Returns NULL if the daemon is not reachable or the build failed
+samplechain_daemon_result_t *samplechain_daemon_build (const char *_socketPath, const samplechain_daemon_request_t *_req);
+
+// Unmap result
+//  - (note) the daemon may drop the result (shared memory segment) at any time, mapped results stay valid until they are freed
+void samplechain_daemon_result_free (samplechain_daemon_result_t *_result);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_DAEMON_H_INCLUDED
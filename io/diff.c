@@ -0,0 +1,422 @@
+/* ----
+ * ---- file   : diff.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+#include "diff.h"
+
+#define SC_DIFF_BLOCKS_PER_JOB  64u
+
+
+typedef struct {
+   const uint8_t               *data;
+   size_t                       bytes_per_frame;
+   samplechain_diff_manifest_t *m;
+} checksum_ctx_t;
+
+typedef struct {
+   samplechain_diff_range_t *ranges;
+   uint32_t                  max_ranges;
+   uint32_t                  num_ranges;
+   size_t                    end;  // end of the last range
+} range_list_t;
+
+
+static int loc_cmp_slices(const void *_a, const void *_b) {
+   const samplechain_diff_slice_t *a = (const samplechain_diff_slice_t*)_a;
+   const samplechain_diff_slice_t *b = (const samplechain_diff_slice_t*)_b;
+
+   return (a->offset < b->offset) ? -1 : (a->offset > b->offset) ? 1 : 0;
+}
+
+static void loc_checksum_slice_job(void *_ctx, uint32_t _sliceIdx) {
+   checksum_ctx_t *ctx = (checksum_ctx_t*)_ctx;
+   samplechain_diff_slice_t *slice = &ctx->m->slices[_sliceIdx];
+
+   slice->crc = sc_kernel_crc32c(ctx->data + (slice->offset * ctx->bytes_per_frame),
+                                 slice->num_frames * ctx->bytes_per_frame,
+                                 0u
+                                 );
+}
+
+static void loc_checksum_blocks_job(void *_ctx, uint32_t _jobIdx) {
+   checksum_ctx_t *ctx = (checksum_ctx_t*)_ctx;
+   size_t blockBytes = ctx->m->block_frames * ctx->bytes_per_frame;
+   size_t off = (size_t)_jobIdx * SC_DIFF_BLOCKS_PER_JOB * blockBytes;
+   size_t totalBytes = ctx->m->num_frames * ctx->bytes_per_frame;
+   size_t numBytes = totalBytes - off;
+
+   if(numBytes > (SC_DIFF_BLOCKS_PER_JOB * blockBytes))
+   {
+      numBytes = SC_DIFF_BLOCKS_PER_JOB * blockBytes;
+   }
+
+   sc_kernel_crc32c_blocks(ctx->data + off, numBytes, blockBytes, ctx->m->block_crcs + (_jobIdx * SC_DIFF_BLOCKS_PER_JOB));
+}
+
+static bool_t loc_manifest_alloc(samplechain_diff_manifest_t *_m, uint32_t _numSlices, uint32_t _numBlocks) {
+   _m->num_slices = _numSlices;
+   _m->num_blocks = _numBlocks;
+   _m->slices     = malloc(sizeof(samplechain_diff_slice_t) * _numSlices + sizeof(uint32_t) * _numBlocks + 1u);
+   _m->block_crcs = (NULL != _m->slices) ? (uint32_t*) (_m->slices + _numSlices) : NULL;
+
+   return (NULL != _m->slices);
+}
+
+bool_t samplechain_diff_manifest_calc(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                      const int16_t *_frames, uint32_t _blockFrames,
+                                      samplechain_diff_manifest_t *_retManifest
+                                      ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _alg) && (NULL != _frames) && (NULL != _retManifest))
+   {
+      uint32_t n = _alg->query_num_elements(_sc);
+      size_t *sizes = malloc(sizeof(size_t) * 2u * (n + 1u) + sizeof(uint32_t) * (n + 1u));
+      int32_t numChannels = 1;
+
+      _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+      memset(_retManifest, 0, sizeof(samplechain_diff_manifest_t));
+
+      if(NULL != sizes)
+      {
+         samplechain_layout_t layout;
+         uint32_t *sourceIndices = (uint32_t*) (sizes + (2u * (n + 1u)));
+         uint32_t elementIdx;
+         uint32_t numSlices = 0;
+
+         memset(&layout, 0, sizeof(layout));
+
+         layout.offsets        = sizes;
+         layout.total_sizes    = sizes + (n + 1u);
+         layout.source_indices = sourceIndices;
+
+         n = _alg->query_layout(_sc, &layout, n);
+
+         _retManifest->num_channels = (uint32_t)numChannels;
+         _retManifest->num_frames   = _alg->query_total_size(_sc);
+         _retManifest->block_frames = (0u == _blockFrames) ? SC_DIFF_DEFAULT_BLOCK_FRAMES : _blockFrames;
+
+         for(elementIdx = 0; elementIdx < n; elementIdx++)
+         {
+            // (note) duplicates share the chain region of their source element
+            numSlices += (sourceIndices[elementIdx] == elementIdx) && (layout.total_sizes[elementIdx] > 0);
+         }
+
+         if(loc_manifest_alloc(_retManifest,
+                               numSlices,
+                               (uint32_t) ((_retManifest->num_frames + _retManifest->block_frames - 1u) / _retManifest->block_frames)
+                               )
+            )
+         {
+            checksum_ctx_t ctx;
+            uint32_t sliceIdx = 0;
+
+            for(elementIdx = 0; elementIdx < n; elementIdx++)
+            {
+               if((sourceIndices[elementIdx] == elementIdx) && (layout.total_sizes[elementIdx] > 0))
+               {
+                  samplechain_diff_slice_t *slice = &_retManifest->slices[sliceIdx++];
+
+                  slice->offset     = layout.offsets[elementIdx];
+                  slice->num_frames = layout.total_sizes[elementIdx];
+
+                  if((slice->offset + slice->num_frames) > _retManifest->num_frames)
+                  {
+                     // (note) invalid layout
+                     slice->num_frames = (slice->offset < _retManifest->num_frames) ? (_retManifest->num_frames - slice->offset) : 0u;
+                  }
+               }
+            }
+
+            qsort(_retManifest->slices, numSlices, sizeof(samplechain_diff_slice_t), &loc_cmp_slices);
+
+            ctx.data            = (const uint8_t*)_frames;
+            ctx.bytes_per_frame = sizeof(int16_t) * (size_t)numChannels;
+            ctx.m               = _retManifest;
+
+            sc_parallel_for(numSlices, &loc_checksum_slice_job, &ctx, 0u);
+            sc_parallel_for((_retManifest->num_blocks + SC_DIFF_BLOCKS_PER_JOB - 1u) / SC_DIFF_BLOCKS_PER_JOB, &loc_checksum_blocks_job, &ctx, 0u);
+
+            ret = SC_TRUE;
+         }
+
+         free(sizes);
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_diff_manifest_free(samplechain_diff_manifest_t *_manifest) {
+
+   if(NULL != _manifest)
+   {
+      // (note) 'block_crcs' is part of the 'slices' allocation
+      free(_manifest->slices);
+      _manifest->slices     = NULL;
+      _manifest->block_crcs = NULL;
+      _manifest->num_slices = 0;
+      _manifest->num_blocks = 0;
+   }
+}
+
+bool_t samplechain_diff_manifest_save(const samplechain_diff_manifest_t *_manifest, const char *_pathName) {
+   bool_t ret = SC_FALSE;
+   FILE *fh;
+
+   if((NULL != _manifest) && (NULL != (fh = fopen(_pathName, "w"))))
+   {
+      uint32_t idx;
+
+      fprintf(fh, "samplechain_diff 1\n");
+      fprintf(fh, "channels %u frames %llu block_frames %u slices %u blocks %u\n",
+              _manifest->num_channels,
+              (unsigned long long)_manifest->num_frames,
+              _manifest->block_frames,
+              _manifest->num_slices,
+              _manifest->num_blocks
+              );
+
+      for(idx = 0; idx < _manifest->num_slices; idx++)
+      {
+         const samplechain_diff_slice_t *slice = &_manifest->slices[idx];
+
+         fprintf(fh, "%llu %llu %08x\n", (unsigned long long)slice->offset, (unsigned long long)slice->num_frames, slice->crc);
+      }
+
+      for(idx = 0; idx < _manifest->num_blocks; idx++)
+      {
+         fprintf(fh, "%08x\n", _manifest->block_crcs[idx]);
+      }
+
+      ret = (0 == ferror(fh));
+      ret = (0 == fclose(fh)) && ret;
+   }
+
+   return ret;
+}
+
+bool_t samplechain_diff_manifest_load(const char *_pathName, samplechain_diff_manifest_t *_retManifest) {
+   bool_t ret = SC_FALSE;
+   FILE *fh;
+
+   memset(_retManifest, 0, sizeof(samplechain_diff_manifest_t));
+
+   if(NULL != (fh = fopen(_pathName, "r")))
+   {
+      unsigned long long numFrames;
+      uint32_t numSlices;
+      uint32_t numBlocks;
+      uint32_t version;
+
+      if( (1 == fscanf(fh, "samplechain_diff %u", &version)) && (1 == version) &&
+          (5 == fscanf(fh, " channels %u frames %llu block_frames %u slices %u blocks %u",
+                       &_retManifest->num_channels, &numFrames, &_retManifest->block_frames, &numSlices, &numBlocks
+                       )) &&
+          (_retManifest->block_frames > 0u) &&
+          (numBlocks == ((numFrames + _retManifest->block_frames - 1u) / _retManifest->block_frames)) &&
+          loc_manifest_alloc(_retManifest, numSlices, numBlocks)
+          )
+      {
+         uint32_t idx;
+
+         ret = SC_TRUE;
+         _retManifest->num_frames = (size_t)numFrames;
+
+         for(idx = 0; ret && (idx < numSlices); idx++)
+         {
+            unsigned long long offset;
+            unsigned long long sliceFrames;
+
+            ret = (3 == fscanf(fh, "%llu %llu %x", &offset, &sliceFrames, &_retManifest->slices[idx].crc));
+
+            _retManifest->slices[idx].offset     = (size_t)offset;
+            _retManifest->slices[idx].num_frames = (size_t)sliceFrames;
+         }
+
+         for(idx = 0; ret && (idx < numBlocks); idx++)
+         {
+            ret = (1 == fscanf(fh, "%x", &_retManifest->block_crcs[idx]));
+         }
+
+         if(!ret)
+         {
+            samplechain_diff_manifest_free(_retManifest);
+         }
+      }
+
+      fclose(fh);
+   }
+
+   return ret;
+}
+
+static void loc_add_range(range_list_t *_list, size_t _offset, size_t _end) {
+
+   if((_list->num_ranges > 0) && (_list->end == _offset))
+   {
+      // Merge with the previous range
+      if(_list->num_ranges <= _list->max_ranges)
+      {
+         _list->ranges[_list->num_ranges - 1u].num_frames += _end - _offset;
+      }
+   }
+   else
+   {
+      if(_list->num_ranges < _list->max_ranges)
+      {
+         _list->ranges[_list->num_ranges].offset     = _offset;
+         _list->ranges[_list->num_ranges].num_frames = _end - _offset;
+      }
+
+      _list->num_ranges++;
+   }
+
+   _list->end = _end;
+}
+
+static bool_t loc_is_block_changed(const samplechain_diff_manifest_t *_old, const samplechain_diff_manifest_t *_new, uint32_t _blockIdx) {
+   size_t blockOff = (size_t)_blockIdx * _new->block_frames;
+   size_t oldEnd = blockOff + _new->block_frames;
+   size_t newEnd = oldEnd;
+
+   if(_blockIdx >= _old->num_blocks)
+   {
+      return SC_TRUE;
+   }
+
+   // (note) the last block may be shorter
+   oldEnd = (oldEnd > _old->num_frames) ? _old->num_frames : oldEnd;
+   newEnd = (newEnd > _new->num_frames) ? _new->num_frames : newEnd;
+
+   return (oldEnd != newEnd) || (_old->block_crcs[_blockIdx] != _new->block_crcs[_blockIdx]);
+}
+
+// Add the changed blocks of chain range [offset, end[
+static void loc_add_changed_blocks(range_list_t *_list, const samplechain_diff_manifest_t *_old, const samplechain_diff_manifest_t *_new, size_t _offset, size_t _end) {
+   uint32_t blockIdx = (uint32_t) (_offset / _new->block_frames);
+
+   while(_offset < _end)
+   {
+      size_t blockEnd = ((size_t)blockIdx + 1u) * _new->block_frames;
+
+      if(blockEnd > _end)
+      {
+         blockEnd = _end;
+      }
+
+      if(loc_is_block_changed(_old, _new, blockIdx))
+      {
+         loc_add_range(_list, _offset, blockEnd);
+      }
+
+      _offset = blockEnd;
+      blockIdx++;
+   }
+}
+
+uint32_t samplechain_diff_calc(const samplechain_diff_manifest_t *_old, const samplechain_diff_manifest_t *_new,
+                               samplechain_diff_range_t *_retRanges, uint32_t _maxRanges
+                               ) {
+   range_list_t list;
+
+   list.ranges     = _retRanges;
+   list.max_ranges = (NULL != _retRanges) ? _maxRanges : 0u;
+   list.num_ranges = 0;
+   list.end        = 0;
+
+   if(NULL == _new)
+   {
+      return 0;
+   }
+
+   if( (NULL == _old) || (_old->num_channels != _new->num_channels) || (_old->block_frames != _new->block_frames) )
+   {
+      if(_new->num_frames > 0)
+      {
+         loc_add_range(&list, 0, _new->num_frames);
+      }
+   }
+   else
+   {
+      uint32_t sliceIdx;
+      uint32_t oldSliceIdx = 0;
+      size_t pos = 0;
+
+      for(sliceIdx = 0; sliceIdx < _new->num_slices; sliceIdx++)
+      {
+         const samplechain_diff_slice_t *slice = &_new->slices[sliceIdx];
+         size_t start = (slice->offset > pos) ? slice->offset : pos;
+         size_t end = slice->offset + slice->num_frames;
+         bool_t bChanged = SC_TRUE;
+
+         // Gap (not covered by any slice)
+         if(slice->offset > pos)
+         {
+            loc_add_changed_blocks(&list, _old, _new, pos, slice->offset);
+         }
+
+         // (note) both slice lists are sorted by offset
+         while((oldSliceIdx < _old->num_slices) && (_old->slices[oldSliceIdx].offset < slice->offset))
+         {
+            oldSliceIdx++;
+         }
+
+         if(oldSliceIdx < _old->num_slices)
+         {
+            const samplechain_diff_slice_t *oldSlice = &_old->slices[oldSliceIdx];
+
+            bChanged = (oldSlice->offset != slice->offset) || (oldSlice->num_frames != slice->num_frames) || (oldSlice->crc != slice->crc);
+         }
+
+         if(bChanged && (end > start))
+         {
+            loc_add_changed_blocks(&list, _old, _new, start, end);
+         }
+
+         pos = (end > pos) ? end : pos;
+      }
+
+      if(pos < _new->num_frames)
+      {
+         loc_add_changed_blocks(&list, _old, _new, pos, _new->num_frames);
+      }
+   }
+
+   return list.num_ranges;
+}
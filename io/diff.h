@@ -0,0 +1,103 @@
+/* ----
+ * ---- file   : diff.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_DIFF_H_INCLUDED
+#define SAMPLECHAIN_DIFF_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_DIFF_DEFAULT_BLOCK_FRAMES  1024u
+
+
+typedef struct {
+   size_t   offset;      // chain frame offset
+   size_t   num_frames;  // size of the slice region (incl. padding)
+   uint32_t crc;         // CRC32C of the region's 16bit sample frames
+} samplechain_diff_slice_t;
+
+// Checksums of a rendered chain (e.g. as transferred to the device)
+typedef struct {
+   uint32_t num_channels;
+   size_t   num_frames;    // chain size
+   uint32_t block_frames;
+
+   uint32_t                  num_slices;
+   samplechain_diff_slice_t *slices;      // sorted by offset (duplicates that share a region are listed once)
+
+   uint32_t  num_blocks;
+   uint32_t *block_crcs;   // CRC32C of each 'block_frames' block (the last block may be shorter)
+} samplechain_diff_manifest_t;
+
+// Changed frame range
+typedef struct {
+   size_t offset;
+   size_t num_frames;
+} samplechain_diff_range_t;
+
+
+// Calculate per-slice and per-block checksums of a rendered chain
+//  - 'frames' are the interleaved 16bit sample frames of the chain (see samplechain_render())
+//  - 'blockFrames' is the block size (0=SC_DIFF_DEFAULT_BLOCK_FRAMES)
+//  - Slices and blocks are checksummed in parallel (see sc_kernel_crc32c())
+//  - Returns false if the layout is invalid or the manifest could not be allocated
+bool_t samplechain_diff_manifest_calc (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                       const int16_t *_frames, uint32_t _blockFrames,
+                                       samplechain_diff_manifest_t *_retManifest
+                                       );
+
+// Free manifest arrays
+void samplechain_diff_manifest_free (samplechain_diff_manifest_t *_manifest);
+
+// Save manifest to a text file
+bool_t samplechain_diff_manifest_save (const samplechain_diff_manifest_t *_manifest, const char *_pathName);
+
+// Load manifest saved by samplechain_diff_manifest_save()
+//  - Returns false if the file cannot be opened or is not a valid manifest
+bool_t samplechain_diff_manifest_load (const char *_pathName, samplechain_diff_manifest_t *_retManifest);
+
+// Calculate the frame ranges that changed between two transfers
+//  - A range is changed if it belongs to a slice whose offset, size or checksum changed (or to no slice),
+//     and to a block whose checksum changed. I.e. unchanged slices are skipped even if they share a block with
+//     a changed slice, and only the changed blocks of a changed slice are included
+//  - 'old' is the manifest of the previous transfer (NULL=none). The whole chain is changed if the
+//     number of channels or the block size differ
+//  - Ranges are sorted and adjacent ranges are merged
+//  - Writes up to 'maxRanges' ranges to 'retRanges' (may be NULL)
+//  - Returns the total number of changed ranges (at most new.num_slices + new.num_blocks + 1)
+uint32_t samplechain_diff_calc (const samplechain_diff_manifest_t *_old, const samplechain_diff_manifest_t *_new,
+                                samplechain_diff_range_t *_retRanges, uint32_t _maxRanges
+                                );
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_DIFF_H_INCLUDED
@@ -0,0 +1,214 @@
+/* ----
+ * ---- file   : sds.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../util/kernels.h"
+#include "../util/profile.h"
+#include "sds.h"
+
+
+static void loc_write_u21(uint8_t *_d, uint32_t _v) {
+   // (note) 21bit values are sent LSB first
+   _d[0] = (uint8_t) ( _v        & 127u);
+   _d[1] = (uint8_t) ((_v >>  7) & 127u);
+   _d[2] = (uint8_t) ((_v >> 14) & 127u);
+}
+
+static void loc_build_header(uint8_t *_d, const samplechain_sds_params_t *_sdsParams, uint32_t _numSamples) {
+   uint32_t periodNs = 1000000000u / _sdsParams->sample_rate;
+
+   _d[0] = 0xF0u;
+   _d[1] = 0x7Eu;
+   _d[2] = (uint8_t) (_sdsParams->device_channel & 127u);
+   _d[3] = 0x01u;  // dump header
+   _d[4] = (uint8_t) ( _sdsParams->sample_number       & 127u);
+   _d[5] = (uint8_t) ((_sdsParams->sample_number >> 7) & 127u);
+   _d[6] = 16u;    // bits per sample
+   loc_write_u21(_d + 7, periodNs);
+   loc_write_u21(_d + 10, _numSamples);
+   loc_write_u21(_d + 13, 0u);                // loop start
+   loc_write_u21(_d + 16, _numSamples - 1u);  // loop end
+   _d[19] = 0x7Fu; // loop off
+   _d[20] = 0xF7u;
+}
+
+static void loc_build_packet(uint8_t *_d, uint32_t _deviceChannel, uint32_t _packetNr, const int16_t *_s, uint32_t _numSamples) {
+   uint8_t chk;
+
+   _d[0] = 0xF0u;
+   _d[1] = 0x7Eu;
+   _d[2] = (uint8_t) (_deviceChannel & 127u);
+   _d[3] = 0x02u;  // data packet
+   _d[4] = (uint8_t) (_packetNr & 127u);
+
+   sc_kernel_sds_pack_s16(_d + 5, _s, _numSamples);
+
+   // Unused bytes in the last packet
+   memset(_d + 5 + (3u * _numSamples), 0, SC_SDS_PACKET_DATA_SIZE - (3u * _numSamples));
+
+   chk = (uint8_t) (_d[1] ^ _d[2] ^ _d[3] ^ _d[4]);
+   chk ^= sc_kernel_xor_u8(_d + 5, SC_SDS_PACKET_DATA_SIZE);
+
+   _d[5 + SC_SDS_PACKET_DATA_SIZE]      = (uint8_t) (chk & 127u);
+   _d[5 + SC_SDS_PACKET_DATA_SIZE + 1u] = 0xF7u;
+}
+
+static bool_t loc_write_file(void *_fh, const void *_data, size_t _numBytes) {
+   return (_numBytes == fwrite(_data, 1, _numBytes, (FILE*)_fh));
+}
+
+static bool_t loc_write(samplechain_write_fxn_t _write, void *_writeCtx, const void *_data, size_t _numBytes) {
+   bool_t ret;
+
+   SC_PROFILE_BEGIN(IO);
+
+   ret = _write(_writeCtx, _data, _numBytes);
+
+   SC_PROFILE_COUNT(BYTES_WRITTEN, _numBytes);
+
+   SC_PROFILE_END(IO);
+
+   return ret;
+}
+
+void samplechain_sds_init_params(samplechain_sds_params_t *_params) {
+
+   if(NULL != _params)
+   {
+      _params->device_channel    = 0;
+      _params->sample_number     = 0;
+      _params->sample_rate       = 48000;
+      _params->packets_per_block = 64;
+   }
+}
+
+bool_t samplechain_sds_encode(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                              const samplechain_render_params_t *_renderParams,
+                              const samplechain_sds_params_t *_sdsParams,
+                              samplechain_write_fxn_t _write, void *_writeCtx
+                              ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _alg) && (NULL != _sdsParams) && (NULL != _write) && (_sdsParams->sample_rate > 0) && (_sdsParams->packets_per_block > 0))
+   {
+      int32_t numChannels = 1;
+      size_t totalSz = _alg->query_total_size(_sc);
+
+      _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+      if((1 == numChannels) && (totalSz > 0) && (totalSz <= SC_SDS_MAX_SAMPLE_LENGTH))
+      {
+         samplechain_render_stream_t *stream = samplechain_render_stream_open(_alg, _sc, _renderParams);
+
+         if(NULL != stream)
+         {
+            size_t blockSz = SC_SDS_SAMPLES_PER_PACKET * _sdsParams->packets_per_block;
+            int16_t *smpBuf = malloc(sizeof(int16_t) * blockSz + SC_SDS_PACKET_SIZE * _sdsParams->packets_per_block);
+
+            if(NULL != smpBuf)
+            {
+               uint8_t *packetBuf = (uint8_t*) (smpBuf + blockSz);
+               uint8_t header[SC_SDS_HEADER_SIZE];
+               uint32_t packetNr = 0;
+
+               loc_build_header(header, _sdsParams, (uint32_t)totalSz);
+
+               ret = loc_write(_write, _writeCtx, header, SC_SDS_HEADER_SIZE);
+
+               while(ret)
+               {
+                  size_t numFrames = samplechain_render_stream_read(stream, smpBuf, blockSz);
+                  size_t frameOff;
+                  uint32_t numPackets = 0;
+
+                  if(0 == numFrames)
+                  {
+                     break;
+                  }
+
+                  for(frameOff = 0; frameOff < numFrames; frameOff += SC_SDS_SAMPLES_PER_PACKET)
+                  {
+                     size_t numSamples = numFrames - frameOff;
+
+                     if(numSamples > SC_SDS_SAMPLES_PER_PACKET)
+                     {
+                        numSamples = SC_SDS_SAMPLES_PER_PACKET;
+                     }
+
+                     loc_build_packet(packetBuf + (numPackets * SC_SDS_PACKET_SIZE),
+                                      _sdsParams->device_channel,
+                                      packetNr++,
+                                      smpBuf + frameOff,
+                                      (uint32_t)numSamples
+                                      );
+                     numPackets++;
+                  }
+
+                  ret = loc_write(_write, _writeCtx, packetBuf, numPackets * SC_SDS_PACKET_SIZE);
+               }
+
+               free(smpBuf);
+            }
+
+            samplechain_render_stream_close(stream);
+         }
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_sds_encode_file(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                   const samplechain_render_params_t *_renderParams,
+                                   const samplechain_sds_params_t *_sdsParams,
+                                   const char *_pathName
+                                   ) {
+   bool_t ret = SC_FALSE;
+
+   if(NULL != _pathName)
+   {
+      FILE *fh = fopen(_pathName, "wb");
+
+      if(NULL != fh)
+      {
+         ret = samplechain_sds_encode(_alg, _sc, _renderParams, _sdsParams, &loc_write_file, fh);
+
+         ret = (0 == fclose(fh)) && ret;
+      }
+   }
+
+   return ret;
+}
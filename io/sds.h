@@ -0,0 +1,83 @@
+/* ----
+ * ---- file   : sds.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_SDS_H_INCLUDED
+#define SAMPLECHAIN_SDS_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// MIDI Sample Dump Standard (SDS) constants
+#define SC_SDS_HEADER_SIZE          21u
+#define SC_SDS_PACKET_SIZE         127u
+#define SC_SDS_PACKET_DATA_SIZE    120u
+#define SC_SDS_SAMPLES_PER_PACKET   40u  // 16bit samples are sent as 3 7bit data bytes
+#define SC_SDS_MAX_SAMPLE_LENGTH   0x1FFFFFu
+
+
+// Output callback
+//  - Returns false to abort the transfer
+typedef bool_t (*samplechain_write_fxn_t) (void *_writeCtx, const void *_data, size_t _numBytes);
+
+
+typedef struct {
+   uint32_t device_channel;     // SysEx channel (0..127, default: 0)
+   uint32_t sample_number;      // target sample number (0..16383, default: 0)
+   uint32_t sample_rate;        // sample rate in Hz (default: 48000)
+   uint32_t packets_per_block;  // number of data packets that are rendered / written at once (default: 64)
+} samplechain_sds_params_t;
+
+
+// Initialize SDS parameters with default values
+void samplechain_sds_init_params (samplechain_sds_params_t *_params);
+
+// Encode a (mono, 16bit) sample chain as an SDS dump (header + data packets)
+//  - The chain is rendered block by block via samplechain_render_stream_read(), i.e.
+//     the memory requirements do not depend on the chain size
+//  - Returns false if the chain cannot be rendered, is not mono, exceeds the maximum SDS length,
+//     or if 'write' failed
+bool_t samplechain_sds_encode (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                               const samplechain_render_params_t *_renderParams,
+                               const samplechain_sds_params_t *_sdsParams,
+                               samplechain_write_fxn_t _write, void *_writeCtx
+                               );
+
+// Encode SDS dump to a (.syx) file
+bool_t samplechain_sds_encode_file (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                    const samplechain_render_params_t *_renderParams,
+                                    const samplechain_sds_params_t *_sdsParams,
+                                    const char *_pathName
+                                    );
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_SDS_H_INCLUDED
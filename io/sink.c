@@ -0,0 +1,463 @@
+/* ----
+ * ---- file   : sink.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#ifndef SC_NO_MMAP
+#include <sys/mman.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../util/profile.h"
+#include "../util/thread.h"
+#include "wav.h"
+#include "sink.h"
+
+// Number of sample frames per positioned write when the file is not mapped
+#define SC_SINK_BLOCK_FRAMES  65536u
+
+// Size of a "cue " chunk point entry
+#define SC_SINK_CUE_POINT_SIZE  24u
+
+
+struct samplechain_wav_sink_s {
+   int fd;
+
+   uint32_t num_channels;
+   size_t   num_frames;
+   size_t   data_offset;  // file offset of the first sample frame
+   size_t   file_size;
+
+   uint8_t *map;  // shared mapping of the entire file (NULL=not mapped)
+
+   uint32_t num_errors;  // failed writes (atomic)
+};
+
+
+static void loc_put_u16(uint8_t *_d, uint32_t _v) {
+   _d[0] = (uint8_t) ( _v       & 255u);
+   _d[1] = (uint8_t) ((_v >> 8) & 255u);
+}
+
+static void loc_put_u32(uint8_t *_d, uint32_t _v) {
+   _d[0] = (uint8_t) ( _v        & 255u);
+   _d[1] = (uint8_t) ((_v >>  8) & 255u);
+   _d[2] = (uint8_t) ((_v >> 16) & 255u);
+   _d[3] = (uint8_t) ((_v >> 24) & 255u);
+}
+
+static bool_t loc_pwrite_all(int _fd, const uint8_t *_s, size_t _numBytes, off_t _fileOff) {
+   bool_t ret = SC_TRUE;
+
+   while(ret && (_numBytes > 0u))
+   {
+      ssize_t numWritten = pwrite(_fd, _s, _numBytes, _fileOff);
+
+      ret = (numWritten > 0);
+
+      if(ret)
+      {
+         SC_PROFILE_COUNT(BYTES_WRITTEN, numWritten);
+
+         _s        += numWritten;
+         _fileOff  += numWritten;
+         _numBytes -= (size_t)numWritten;
+      }
+   }
+
+   return ret;
+}
+
+// File offset of the first sample frame (RIFF/WAVE header, "fmt " chunk, "cue " chunk, "data" chunk header)
+static size_t loc_get_data_offset(uint32_t _numCues) {
+   return 36u + 12u + (_numCues * SC_SINK_CUE_POINT_SIZE) + 8u;
+}
+
+// Build RIFF/WAVE header, "fmt " chunk, "cue " chunk and the "data" chunk header
+//  - 'd' must provide room for 'dataOffset' bytes
+static void loc_build_header(uint8_t *_d, size_t _dataOffset, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate,
+                             const size_t *_cueOffsets, uint32_t _numCues
+                             ) {
+   uint32_t dataSz = (uint32_t) (_numFrames * _numChannels * sizeof(int16_t));
+   uint8_t *d = _d;
+   uint32_t cueIdx;
+
+   memcpy(d, "RIFF", 4);
+   loc_put_u32(d + 4, (uint32_t)(_dataOffset - 8u) + dataSz);
+   memcpy(d + 8, "WAVEfmt ", 8);
+   loc_put_u32(d + 16, 16u);
+   loc_put_u16(d + 20, 1u/*PCM*/);
+   loc_put_u16(d + 22, _numChannels);
+   loc_put_u32(d + 24, _sampleRate);
+   loc_put_u32(d + 28, _sampleRate * _numChannels * (uint32_t)sizeof(int16_t));
+   loc_put_u16(d + 32, _numChannels * (uint32_t)sizeof(int16_t));
+   loc_put_u16(d + 34, 16u);
+   d += 36;
+
+   memcpy(d, "cue ", 4);
+   loc_put_u32(d + 4, 4u + (_numCues * SC_SINK_CUE_POINT_SIZE));
+   loc_put_u32(d + 8, _numCues);
+   d += 12;
+
+   for(cueIdx = 0; cueIdx < _numCues; cueIdx++)
+   {
+      loc_put_u32(d, cueIdx + 1u);                          // cue point id
+      loc_put_u32(d + 4, (uint32_t)_cueOffsets[cueIdx]);    // play order position
+      memcpy(d + 8, "data", 4);
+      loc_put_u32(d + 12, 0u);                              // chunk start
+      loc_put_u32(d + 16, 0u);                              // block start
+      loc_put_u32(d + 20, (uint32_t)_cueOffsets[cueIdx]);   // sample frame offset
+      d += SC_SINK_CUE_POINT_SIZE;
+   }
+
+   memcpy(d, "data", 4);
+   loc_put_u32(d + 4, dataSz);
+}
+
+// Query the start offsets of all chain regions (no duplicates, no pad elements)
+//  - Returns the number of regions, or ~0u if the layout could not be queried
+static uint32_t loc_query_cue_offsets(const samplechain_algorithm_t *_alg, samplechain_t _sc, size_t **_retOffsets) {
+   uint32_t ret = ~0u;
+   uint32_t n = _alg->query_num_elements(_sc);
+   size_t *offsets = malloc(sizeof(size_t) * 2u * (n + 1u));
+   uint32_t *sourceIndices = malloc(sizeof(uint32_t) * (n + 1u));
+
+   if((NULL != offsets) && (NULL != sourceIndices))
+   {
+      samplechain_layout_t layout;
+      size_t *origSizes = offsets + (n + 1u);
+
+      memset(&layout, 0, sizeof(layout));
+
+      layout.offsets        = offsets;
+      layout.orig_sizes     = origSizes;
+      layout.source_indices = sourceIndices;
+
+      if(n == _alg->query_layout(_sc, &layout, n))
+      {
+         uint32_t elementIdx;
+
+         ret = 0;
+
+         for(elementIdx = 0; elementIdx < n; elementIdx++)
+         {
+            if((sourceIndices[elementIdx] == elementIdx) && (origSizes[elementIdx] > 0u))
+            {
+               offsets[ret++] = offsets[elementIdx];
+            }
+         }
+      }
+   }
+
+   free(sourceIndices);
+
+   if(~0u == ret)
+   {
+      free(offsets);
+      offsets = NULL;
+   }
+
+   *_retOffsets = offsets;
+
+   return ret;
+}
+
+samplechain_wav_sink_t *samplechain_wav_sink_open(const char *_pathName,
+                                                  const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                  uint32_t _sampleRate
+                                                  ) {
+   samplechain_wav_sink_t *ret = NULL;
+   int32_t bytesPerSample = 2;
+   int32_t numChannels = 1;
+
+   if((NULL != _pathName) && (NULL != _alg))
+   {
+      _alg->get_parameter_i(_sc, "bytes_per_sample", &bytesPerSample);
+      _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+   }
+
+   if((NULL != _pathName) && (NULL != _alg) && (2 == bytesPerSample) && (_alg->query_total_size(_sc) > 0))
+   {
+      size_t *cueOffsets;
+      uint32_t numCues = loc_query_cue_offsets(_alg, _sc, &cueOffsets);
+      size_t numFrames = _alg->query_total_size(_sc);
+      size_t dataOffset = loc_get_data_offset(numCues);
+      size_t dataSz = numFrames * (size_t)numChannels * sizeof(int16_t);
+
+      // (note) RIFF sizes are 32bit
+      if((~0u != numCues) && (dataSz <= (0xFFFFFFFFu - dataOffset)))
+      {
+         uint8_t *header = malloc(dataOffset);
+         int fd = open(_pathName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+         ret = malloc(sizeof(samplechain_wav_sink_t));
+
+         if((NULL != header) && (NULL != ret) && (fd >= 0))
+         {
+            int err;
+
+            SC_PROFILE_BEGIN(IO);
+
+            ret->fd           = fd;
+            ret->num_channels = (uint32_t)numChannels;
+            ret->num_frames   = numFrames;
+            ret->data_offset  = dataOffset;
+            ret->file_size    = dataOffset + dataSz;
+            ret->map          = NULL;
+            ret->num_errors   = 0;
+
+            loc_build_header(header, dataOffset, numFrames, (uint32_t)numChannels, _sampleRate, cueOffsets, numCues);
+
+            // (note) filesystems that do not support preallocation only get the final size (sparse file)
+            err = posix_fallocate(fd, 0, (off_t)ret->file_size);
+
+            if( ((0 == err) || (EOPNOTSUPP == err) || (EINVAL == err)) &&
+                (0 == ftruncate(fd, (off_t)ret->file_size)) &&
+                loc_pwrite_all(fd, header, dataOffset, 0)
+                )
+            {
+#ifndef SC_NO_MMAP
+               void *map = mmap(NULL, ret->file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+               if(MAP_FAILED != map)
+               {
+                  ret->map = (uint8_t*)map;
+               }
+#endif
+            }
+            else
+            {
+               close(fd);
+               free(ret);
+               ret = NULL;
+            }
+
+            SC_PROFILE_END(IO);
+         }
+         else
+         {
+            if(fd >= 0)
+            {
+               close(fd);
+            }
+
+            free(ret);
+            ret = NULL;
+         }
+
+         free(header);
+      }
+
+      free(cueOffsets);
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_sink_update_header(const char *_pathName,
+                                          const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                          uint32_t _sampleRate
+                                          ) {
+   bool_t ret = SC_FALSE;
+   int32_t bytesPerSample = 2;
+   int32_t numChannels = 1;
+
+   if((NULL != _pathName) && (NULL != _alg))
+   {
+      _alg->get_parameter_i(_sc, "bytes_per_sample", &bytesPerSample);
+      _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+   }
+
+   if((NULL != _pathName) && (NULL != _alg) && (2 == bytesPerSample) && (_alg->query_total_size(_sc) > 0))
+   {
+      samplechain_wav_info_t info;
+      size_t *cueOffsets;
+      uint32_t numCues = loc_query_cue_offsets(_alg, _sc, &cueOffsets);
+      size_t numFrames = _alg->query_total_size(_sc);
+      size_t dataOffset = loc_get_data_offset(numCues);
+
+      // (note) the header size depends on the number of cue points, i.e. the sample frames must not move
+      if( (~0u != numCues) &&
+          samplechain_wav_read_info(_pathName, &info) &&
+          (1u/*PCM*/ == info.format) && (16u == info.bits_per_sample) &&
+          ((uint32_t)numChannels == info.num_channels) && (_sampleRate == info.sample_rate) &&
+          (numFrames == info.num_frames) && (dataOffset == info.data_offset)
+          )
+      {
+         uint8_t *header = malloc(dataOffset);
+         int fd = open(_pathName, O_WRONLY);
+
+         if((NULL != header) && (fd >= 0))
+         {
+            SC_PROFILE_BEGIN(IO);
+
+            loc_build_header(header, dataOffset, numFrames, (uint32_t)numChannels, _sampleRate, cueOffsets, numCues);
+
+            ret = loc_pwrite_all(fd, header, dataOffset, 0);
+
+            SC_PROFILE_END(IO);
+         }
+
+         if(fd >= 0)
+         {
+            ret = (0 == close(fd)) && ret;
+         }
+
+         free(header);
+      }
+
+      free(cueOffsets);
+   }
+
+   return ret;
+}
+
+int16_t *samplechain_wav_sink_get_frames(samplechain_wav_sink_t *_sink) {
+   int16_t *ret = NULL;
+
+   if((NULL != _sink) && (NULL != _sink->map))
+   {
+      ret = (int16_t*) (_sink->map + _sink->data_offset);
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_sink_write(samplechain_wav_sink_t *_sink, const int16_t *_frames, size_t _offset, size_t _numFrames) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _sink) && (NULL != _frames))
+   {
+      size_t frameSz = _sink->num_channels * sizeof(int16_t);
+
+      if((_offset <= _sink->num_frames) && (_numFrames <= (_sink->num_frames - _offset)))
+      {
+         SC_PROFILE_BEGIN(IO);
+
+         // (note) assumes a little endian host
+         ret = loc_pwrite_all(_sink->fd,
+                              (const uint8_t*)_frames,
+                              _numFrames * frameSz,
+                              (off_t) (_sink->data_offset + (_offset * frameSz))
+                              );
+
+         SC_PROFILE_END(IO);
+      }
+
+      if(!ret)
+      {
+         SC_ATOMIC_ADD(&_sink->num_errors, 1u);
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_sink_render(samplechain_wav_sink_t *_sink,
+                                   const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                   const samplechain_render_params_t *_params
+                                   ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _sink) && (NULL != _alg) && (NULL != _params) && (_alg->query_total_size(_sc) == _sink->num_frames))
+   {
+      if(NULL != _sink->map)
+      {
+         // (note) workers convert their element regions straight into the page cache, i.e. there is no final copy
+         ret = samplechain_render(_alg, _sc, _params, samplechain_wav_sink_get_frames(_sink), _sink->num_frames);
+
+         SC_PROFILE_COUNT(BYTES_WRITTEN, _sink->num_frames * _sink->num_channels * sizeof(int16_t));
+      }
+      else
+      {
+         samplechain_render_stream_t *stream = samplechain_render_stream_open(_alg, _sc, _params);
+
+         if(NULL != stream)
+         {
+            int16_t *buf = malloc(sizeof(int16_t) * SC_SINK_BLOCK_FRAMES * _sink->num_channels);
+
+            if(NULL != buf)
+            {
+               size_t pos = 0;
+               size_t numFrames;
+
+               ret = SC_TRUE;
+
+               while(ret && (numFrames = samplechain_render_stream_read(stream, buf, SC_SINK_BLOCK_FRAMES)) > 0u)
+               {
+                  ret = samplechain_wav_sink_write(_sink, buf, pos, numFrames);
+                  pos += numFrames;
+               }
+
+               ret = ret && (pos == _sink->num_frames);
+
+               free(buf);
+            }
+
+            samplechain_render_stream_close(stream);
+         }
+      }
+
+      if(!ret)
+      {
+         SC_ATOMIC_ADD(&_sink->num_errors, 1u);
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_sink_close(samplechain_wav_sink_t *_sink) {
+   bool_t ret = SC_FALSE;
+
+   if(NULL != _sink)
+   {
+      ret = (0 == SC_ATOMIC_LOAD(&_sink->num_errors));
+
+#ifndef SC_NO_MMAP
+      if(NULL != _sink->map)
+      {
+         ret = (0 == munmap(_sink->map, _sink->file_size)) && ret;
+      }
+#endif
+
+      ret = (0 == close(_sink->fd)) && ret;
+
+      free(_sink);
+   }
+
+   return ret;
+}
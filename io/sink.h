@@ -0,0 +1,87 @@
+/* ----
+ * ---- file   : sink.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_SINK_H_INCLUDED
+#define SAMPLECHAIN_SINK_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Opaque chain WAV file writer
+typedef struct samplechain_wav_sink_s samplechain_wav_sink_t;
+
+
+// Create the WAV file for a calculated chain
+//  - Requires that 'calc' has been called and that "bytes_per_sample" is 2
+//  - The final file size (header, "cue " chunk, sample frames) is computed up front and the file is preallocated
+//  - Writes one cue point (slice marker) per chain region (duplicates and pad elements are skipped)
+//  - Maps the sample data (shared, writable) when the platform supports it
+//  - Returns NULL if the file cannot be created or the chain exceeds the 4GB RIFF limit
+samplechain_wav_sink_t *samplechain_wav_sink_open (const char *_pathName,
+                                                   const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                   uint32_t _sampleRate
+                                                   );
+
+// Rewrite the header ("cue " chunk) of an existing chain file in place
+//  - Used after the sample frames of a changed chain were updated in place (see samplechain_wav_update_s16())
+//  - Fails if the file does not match the chain (format, number of sample frames, number of cue points),
+//     i.e. the file must be rewritten from scratch (see samplechain_wav_sink_open())
+bool_t samplechain_wav_sink_update_header (const char *_pathName,
+                                           const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                           uint32_t _sampleRate
+                                           );
+
+// Query the mapped sample frames of the data chunk
+//  - Returns NULL if the file could not be mapped (use samplechain_wav_sink_write() instead)
+int16_t *samplechain_wav_sink_get_frames (samplechain_wav_sink_t *_sink);
+
+// Write interleaved 16bit sample frames at the given chain frame offset (positioned write)
+//  - Thread-safe as long as concurrent writes do not overlap, e.g. one thread per element region
+//  - Returns false if the range exceeds the chain or the write failed
+bool_t samplechain_wav_sink_write (samplechain_wav_sink_t *_sink, const int16_t *_frames, size_t _offset, size_t _numFrames);
+
+// Render the chain into the file
+//  - Renders directly into the mapped file (elements in parallel, see samplechain_render()), or
+//     block by block via a render stream and positioned writes when the file is not mapped
+//  - Returns false if rendering or writing failed
+bool_t samplechain_wav_sink_render (samplechain_wav_sink_t *_sink,
+                                    const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                    const samplechain_render_params_t *_params
+                                    );
+
+// Unmap and close the file
+//  - Returns false if any write failed (the file is incomplete)
+bool_t samplechain_wav_sink_close (samplechain_wav_sink_t *_sink);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_SINK_H_INCLUDED
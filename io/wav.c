@@ -0,0 +1,382 @@
+/* ----
+ * ---- file   : wav.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/profile.h"
+#include "wav.h"
+
+#define SC_WAV_FORMAT_PCM         1u
+#define SC_WAV_FORMAT_FLOAT       3u
+#define SC_WAV_FORMAT_EXTENSIBLE  0xFFFEu
+
+
+static uint32_t loc_get_u16(const uint8_t *_s) {
+   return (uint32_t)_s[0] | ((uint32_t)_s[1] << 8);
+}
+
+static uint32_t loc_get_u32(const uint8_t *_s) {
+   return (uint32_t)_s[0] | ((uint32_t)_s[1] << 8) | ((uint32_t)_s[2] << 16) | ((uint32_t)_s[3] << 24);
+}
+
+static void loc_put_u16(uint8_t *_d, uint32_t _v) {
+   _d[0] = (uint8_t) ( _v       & 255u);
+   _d[1] = (uint8_t) ((_v >> 8) & 255u);
+}
+
+static void loc_put_u32(uint8_t *_d, uint32_t _v) {
+   _d[0] = (uint8_t) ( _v        & 255u);
+   _d[1] = (uint8_t) ((_v >>  8) & 255u);
+   _d[2] = (uint8_t) ((_v >> 16) & 255u);
+   _d[3] = (uint8_t) ((_v >> 24) & 255u);
+}
+
+static bool_t loc_parse_header(FILE *_fh, samplechain_wav_info_t *_retInfo) {
+   uint8_t buf[40];
+   bool_t bHaveFmt = SC_FALSE;
+   size_t off = 12;
+
+   if(12 != fread(buf, 1, 12, _fh))
+   {
+      return SC_FALSE;
+   }
+
+   if((0 != memcmp(buf, "RIFF", 4)) || (0 != memcmp(buf + 8, "WAVE", 4)))
+   {
+      return SC_FALSE;
+   }
+
+   // Iterate chunks
+   for(;;)
+   {
+      uint32_t chunkSz;
+
+      if(8 != fread(buf, 1, 8, _fh))
+      {
+         return SC_FALSE;
+      }
+
+      off += 8;
+      chunkSz = loc_get_u32(buf + 4);
+
+      if(0 == memcmp(buf, "fmt ", 4))
+      {
+         uint32_t numRead = (chunkSz < sizeof(buf)) ? chunkSz : (uint32_t)sizeof(buf);
+
+         if((chunkSz < 16) || (numRead != fread(buf, 1, numRead, _fh)))
+         {
+            return SC_FALSE;
+         }
+
+         _retInfo->format          = loc_get_u16(buf);
+         _retInfo->num_channels    = loc_get_u16(buf + 2);
+         _retInfo->sample_rate     = loc_get_u32(buf + 4);
+         _retInfo->bits_per_sample = loc_get_u16(buf + 14);
+
+         if((SC_WAV_FORMAT_EXTENSIBLE == _retInfo->format) && (numRead >= 26))
+         {
+            // (note) first two bytes of the sub format GUID
+            _retInfo->format = loc_get_u16(buf + 24);
+         }
+
+         if(numRead < chunkSz)
+         {
+            fseek(_fh, (long)(chunkSz - numRead), SEEK_CUR);
+         }
+
+         bHaveFmt = SC_TRUE;
+      }
+      else if(0 == memcmp(buf, "data", 4))
+      {
+         uint32_t frameSz;
+
+         if(!bHaveFmt || (0 == _retInfo->num_channels))
+         {
+            return SC_FALSE;
+         }
+
+         if( !((SC_WAV_FORMAT_PCM == _retInfo->format) && ((8 == _retInfo->bits_per_sample) ||
+                                                            (16 == _retInfo->bits_per_sample) ||
+                                                            (24 == _retInfo->bits_per_sample) ||
+                                                            (32 == _retInfo->bits_per_sample))) &&
+             !((SC_WAV_FORMAT_FLOAT == _retInfo->format) && (32 == _retInfo->bits_per_sample))
+             )
+         {
+            return SC_FALSE;
+         }
+
+         frameSz = (_retInfo->bits_per_sample / 8u) * _retInfo->num_channels;
+
+         _retInfo->num_frames  = chunkSz / frameSz;
+         _retInfo->data_offset = off;
+
+         return SC_TRUE;
+      }
+      else
+      {
+         fseek(_fh, (long)(chunkSz + (chunkSz & 1u)), SEEK_CUR);
+      }
+
+      off += chunkSz + (chunkSz & 1u);
+   }
+}
+
+static float32_t loc_get_sample(const uint8_t *_s, const samplechain_wav_info_t *_info) {
+   float32_t ret;
+
+   switch(_info->bits_per_sample)
+   {
+      case 8:
+         ret = ((int32_t)_s[0] - 128) / 128.0f;
+         break;
+
+      case 16:
+         ret = ((int16_t)loc_get_u16(_s)) / 32768.0f;
+         break;
+
+      case 24:
+         ret = ((int32_t)(loc_get_u32(_s - 1) & 0xFFFFFF00u)) / 2147483648.0f;
+         break;
+
+      default:
+      case 32:
+         if(SC_WAV_FORMAT_FLOAT == _info->format)
+         {
+            uint32_t u = loc_get_u32(_s);
+            memcpy(&ret, &u, sizeof(ret));
+         }
+         else
+         {
+            ret = ((int32_t)loc_get_u32(_s)) / 2147483648.0f;
+         }
+         break;
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_read_info(const char *_pathName, samplechain_wav_info_t *_retInfo) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _pathName) && (NULL != _retInfo))
+   {
+      FILE *fh = fopen(_pathName, "rb");
+
+      if(NULL != fh)
+      {
+         ret = loc_parse_header(fh, _retInfo);
+
+         fclose(fh);
+      }
+   }
+
+   return ret;
+}
+
+float32_t *samplechain_wav_load(const char *_pathName, uint32_t _numChannels, samplechain_wav_info_t *_retInfo) {
+   float32_t *ret = NULL;
+
+   if((NULL != _pathName) && (NULL != _retInfo) && (_numChannels > 0))
+   {
+      FILE *fh = fopen(_pathName, "rb");
+
+      if(NULL != fh)
+      {
+         if(loc_parse_header(fh, _retInfo))
+         {
+            uint32_t bytesPerSample = _retInfo->bits_per_sample / 8u;
+            size_t frameSz = bytesPerSample * _retInfo->num_channels;
+            size_t numBytes = frameSz * _retInfo->num_frames;
+            uint8_t *raw = malloc(numBytes + 1u/*24bit read guard*/);
+
+            ret = malloc(sizeof(float32_t) * _numChannels * (_retInfo->num_frames + 1u));
+
+            if( (NULL != raw) && (NULL != ret) &&
+                (0 == fseek(fh, (long)_retInfo->data_offset, SEEK_SET)) &&
+                (numBytes == fread(raw + 1, 1, numBytes, fh))
+                )
+            {
+               size_t frameIdx;
+               uint32_t chIdx;
+
+               for(frameIdx = 0; frameIdx < _retInfo->num_frames; frameIdx++)
+               {
+                  const uint8_t *s = raw + 1 + (frameIdx * frameSz);
+                  float32_t *d = ret + (frameIdx * _numChannels);
+
+                  if(1u == _retInfo->num_channels)
+                  {
+                     float32_t f = loc_get_sample(s, _retInfo);
+
+                     for(chIdx = 0; chIdx < _numChannels; chIdx++)
+                     {
+                        d[chIdx] = f;
+                     }
+                  }
+                  else if((1u == _numChannels) && (2u == _retInfo->num_channels))
+                  {
+                     d[0] = 0.5f * (loc_get_sample(s, _retInfo) + loc_get_sample(s + bytesPerSample, _retInfo));
+                  }
+                  else
+                  {
+                     for(chIdx = 0; chIdx < _numChannels; chIdx++)
+                     {
+                        d[chIdx] = (chIdx < _retInfo->num_channels) ? loc_get_sample(s + (chIdx * bytesPerSample), _retInfo) : 0.0f;
+                     }
+                  }
+               }
+            }
+            else
+            {
+               free(ret);
+               ret = NULL;
+            }
+
+            free(raw);
+         }
+
+         fclose(fh);
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_wav_build_header(uint8_t *_d, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate) {
+   uint32_t dataSz = (uint32_t) (_numFrames * _numChannels * sizeof(int16_t));
+
+   memcpy(_d, "RIFF", 4);
+   loc_put_u32(_d + 4, (SC_WAV_HEADER_SIZE - 8u) + dataSz);
+   memcpy(_d + 8, "WAVEfmt ", 8);
+   loc_put_u32(_d + 16, 16u);
+   loc_put_u16(_d + 20, SC_WAV_FORMAT_PCM);
+   loc_put_u16(_d + 22, _numChannels);
+   loc_put_u32(_d + 24, _sampleRate);
+   loc_put_u32(_d + 28, _sampleRate * _numChannels * (uint32_t)sizeof(int16_t));
+   loc_put_u16(_d + 32, _numChannels * (uint32_t)sizeof(int16_t));
+   loc_put_u16(_d + 34, 16u);
+   memcpy(_d + 36, "data", 4);
+   loc_put_u32(_d + 40, dataSz);
+}
+
+bool_t samplechain_wav_save_s16(const char *_pathName, const int16_t *_frames, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _pathName) && (NULL != _frames))
+   {
+      FILE *fh = fopen(_pathName, "wb");
+
+      if(NULL != fh)
+      {
+         uint8_t header[SC_WAV_HEADER_SIZE];
+         size_t numSamples = _numFrames * _numChannels;
+
+         SC_PROFILE_BEGIN(IO);
+
+         samplechain_wav_build_header(header, _numFrames, _numChannels, _sampleRate);
+
+         // (note) assumes a little endian host
+         ret = (SC_WAV_HEADER_SIZE == fwrite(header, 1, SC_WAV_HEADER_SIZE, fh)) &&
+               (numSamples == fwrite(_frames, sizeof(int16_t), numSamples, fh));
+
+         ret = (0 == fclose(fh)) && ret;
+
+         SC_PROFILE_COUNT(BYTES_WRITTEN, SC_WAV_HEADER_SIZE + (numSamples * sizeof(int16_t)));
+
+         SC_PROFILE_END(IO);
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_wav_update_s16(const char *_pathName, const int16_t *_frames, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate, const size_t *_regions, uint32_t _numRegions) {
+   bool_t ret = SC_FALSE;
+   samplechain_wav_info_t info;
+
+   if( (NULL != _frames) &&
+       samplechain_wav_read_info(_pathName, &info) &&
+       (SC_WAV_FORMAT_PCM == info.format) && (16u == info.bits_per_sample) &&
+       (_numChannels == info.num_channels) && (_sampleRate == info.sample_rate) &&
+       (_numFrames == info.num_frames)
+       )
+   {
+      int fd = open(_pathName, O_WRONLY);
+
+      if(fd >= 0)
+      {
+         size_t frameSz = _numChannels * sizeof(int16_t);
+         uint32_t regionIdx;
+
+         SC_PROFILE_BEGIN(IO);
+
+         ret = SC_TRUE;
+
+         for(regionIdx = 0; ret && (regionIdx < _numRegions); regionIdx++)
+         {
+            size_t off = _regions[2 * regionIdx + 0];
+            size_t numBytes = _regions[2 * regionIdx + 1] * frameSz;
+            const uint8_t *s = (const uint8_t*) (_frames + (off * _numChannels));
+            off_t fileOff = (off_t) (info.data_offset + (off * frameSz));
+
+            ret = ((off + _regions[2 * regionIdx + 1]) <= _numFrames);
+
+            // (note) assumes a little endian host
+            while(ret && (numBytes > 0u))
+            {
+               ssize_t numWritten = pwrite(fd, s, numBytes, fileOff);
+
+               ret = (numWritten > 0);
+
+               if(ret)
+               {
+                  SC_PROFILE_COUNT(BYTES_WRITTEN, numWritten);
+
+                  s        += numWritten;
+                  fileOff  += numWritten;
+                  numBytes -= (size_t)numWritten;
+               }
+            }
+         }
+
+         ret = (0 == close(fd)) && ret;
+
+         SC_PROFILE_END(IO);
+      }
+   }
+
+   return ret;
+}
@@ -0,0 +1,75 @@
+/* ----
+ * ---- file   : wav.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_WAV_H_INCLUDED
+#define SAMPLECHAIN_WAV_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_WAV_HEADER_SIZE  44u  // canonical RIFF/WAVE header (fmt + data chunk headers)
+
+
+typedef struct {
+   uint32_t format;           // 1=PCM, 3=IEEE float
+   uint32_t num_channels;
+   uint32_t sample_rate;
+   uint32_t bits_per_sample;
+   size_t   num_frames;
+   size_t   data_offset;      // file offset of the first sample frame
+} samplechain_wav_info_t;
+
+
+// Parse the header of a WAV file (does not read the sample data)
+//  - Supports 8/16/24/32bit PCM and 32bit float files (incl. WAVE_FORMAT_EXTENSIBLE)
+//  - Returns false if the file cannot be opened or is not a supported WAV file
+bool_t samplechain_wav_read_info (const char *_pathName, samplechain_wav_info_t *_retInfo);
+
+// Load WAV file and convert it to interleaved float sample frames
+//  - Converts to 'numChannels' channels (mono files are duplicated, other files are downmixed / truncated)
+//  - Returns the sample frames (must be freed with free()), or NULL if the file could not be loaded
+float32_t *samplechain_wav_load (const char *_pathName, uint32_t _numChannels, samplechain_wav_info_t *_retInfo);
+
+// Write canonical 16bit PCM WAV header to 'd' (SC_WAV_HEADER_SIZE bytes)
+void samplechain_wav_build_header (uint8_t *_d, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate);
+
+// Save interleaved 16bit sample frames to a WAV file
+bool_t samplechain_wav_save_s16 (const char *_pathName, const int16_t *_frames, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate);
+
+// Rewrite sample frame regions of an existing 16bit WAV file in place (positioned writes, the rest of the file is not touched)
+//  - 'regions' are (offset, numFrames) pairs (in sample frames)
+//  - Fails if the file format / size does not match
+bool_t samplechain_wav_update_s16 (const char *_pathName, const int16_t *_frames, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate, const size_t *_regions, uint32_t _numRegions);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_WAV_H_INCLUDED
@@ -0,0 +1,452 @@
+/* ----
+ * ---- file   : audition.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/thread.h"
+#include "audition.h"
+
+#define SC_AUDITION_QUEUE_MASK  (SC_AUDITION_QUEUE_SIZE - 1u)
+
+#define CMD_SET_CHAIN    1u
+#define CMD_TRIGGER      2u
+#define CMD_TRIGGER_STA  3u
+#define CMD_STOP_ALL     4u
+
+
+struct samplechain_audition_chain_s {
+   int16_t   *frames;
+   size_t     num_frames;
+   uint32_t   num_channels;
+   uint32_t   num_elements;
+   size_t    *offsets;
+   size_t    *orig_sizes;
+   float32_t *sta;
+   uint32_t  *sta_index;    // element indices sorted by STA (deduplicated elements may be out of order)
+};
+
+typedef struct {
+   uint32_t   type;
+   uint32_t   element_idx;
+   float32_t  sta;
+   float32_t  gain;
+   samplechain_audition_chain_t *chain;
+} cmd_t;
+
+typedef struct {
+   const int16_t *frames;   // first sample frame of the element
+   size_t         num_frames;
+   size_t         pos;
+   float32_t      gain;
+   uint32_t       serial;   // trigger order (for voice stealing)
+   bool_t         b_active;
+} voice_t;
+
+struct samplechain_audition_s {
+   // Editor -> audio thread
+   cmd_t    cmds[SC_AUDITION_QUEUE_SIZE];
+   uint32_t cmd_head;        // written by editor thread
+   uint32_t cmd_tail;        // written by audio thread
+
+   // Audio -> editor thread
+   samplechain_audition_chain_t *retired[SC_AUDITION_QUEUE_SIZE];
+   uint32_t retired_head;    // written by audio thread
+   uint32_t retired_tail;    // written by editor thread
+
+   uint32_t num_owned_chains; // chains in queue / in use / retired (editor thread)
+
+   // Audio thread state
+   samplechain_audition_chain_t *chain;
+   voice_t  *voices;
+   uint32_t  num_voices;
+   uint32_t  num_out_channels;
+   uint32_t  next_serial;
+   uint32_t  num_active_voices;
+};
+
+
+samplechain_audition_chain_t *samplechain_audition_chain_create(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                                const int16_t *_frames, size_t _numFrames
+                                                                ) {
+   samplechain_audition_chain_t *ret = NULL;
+   uint32_t n = _alg->query_num_elements(_sc);
+   size_t totalSz = _alg->query_total_size(_sc);
+   int32_t numChannels = 1;
+
+   _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+   if((n > 0u) && (totalSz > 0u) && (totalSz <= _numFrames) && (NULL != _frames) && (numChannels > 0))
+   {
+      size_t frameSz = sizeof(int16_t) * (uint32_t)numChannels;
+      size_t arraySz = n * (2 * sizeof(size_t) + sizeof(float32_t) + sizeof(uint32_t));
+
+      ret = malloc(sizeof(samplechain_audition_chain_t) + arraySz + (totalSz * frameSz));
+
+      if(NULL != ret)
+      {
+         samplechain_layout_t layout;
+         uint32_t i;
+
+         ret->num_frames   = totalSz;
+         ret->num_channels = (uint32_t)numChannels;
+         ret->offsets      = (size_t*) (ret + 1);
+         ret->orig_sizes   = ret->offsets + n;
+         ret->sta          = (float32_t*) (ret->orig_sizes + n);
+         ret->sta_index    = (uint32_t*) (ret->sta + n);
+         ret->frames       = (int16_t*) (ret->sta_index + n);
+
+         memset(&layout, 0, sizeof(layout));
+         layout.offsets    = ret->offsets;
+         layout.orig_sizes = ret->orig_sizes;
+         layout.sta        = ret->sta;
+
+         ret->num_elements = _alg->query_layout(_sc, &layout, n);
+
+         if(0u == ret->num_elements)
+         {
+            free(ret);
+            return NULL;
+         }
+
+         memcpy(ret->frames, _frames, totalSz * frameSz);
+
+         // Sort element indices by STA (insertion sort, input is (almost) sorted)
+         for(i = 0; i < ret->num_elements; i++)
+         {
+            uint32_t j = i;
+
+            while((j > 0u) && (ret->sta[ret->sta_index[j - 1u]] > ret->sta[i]))
+            {
+               ret->sta_index[j] = ret->sta_index[j - 1u];
+               j--;
+            }
+
+            ret->sta_index[j] = i;
+         }
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_audition_chain_destroy(samplechain_audition_chain_t *_chain) {
+   free(_chain);
+}
+
+samplechain_audition_t *samplechain_audition_create(uint32_t _numVoices, uint32_t _numOutChannels) {
+   samplechain_audition_t *ret = NULL;
+
+   if((_numVoices > 0u) && (_numOutChannels > 0u))
+   {
+      ret = malloc(sizeof(samplechain_audition_t) + sizeof(voice_t) * _numVoices);
+
+      if(NULL != ret)
+      {
+         memset(ret, 0, sizeof(samplechain_audition_t) + sizeof(voice_t) * _numVoices);
+
+         ret->voices           = (voice_t*) (ret + 1);
+         ret->num_voices       = _numVoices;
+         ret->num_out_channels = _numOutChannels;
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_audition_destroy(samplechain_audition_t *_a) {
+
+   if(NULL != _a)
+   {
+      uint32_t idx;
+
+      // Chains that have not been consumed by the audio thread
+      for(idx = _a->cmd_tail; idx != _a->cmd_head; idx++)
+      {
+         if(CMD_SET_CHAIN == _a->cmds[idx & SC_AUDITION_QUEUE_MASK].type)
+         {
+            free(_a->cmds[idx & SC_AUDITION_QUEUE_MASK].chain);
+         }
+      }
+
+      samplechain_audition_collect(_a);
+
+      free(_a->chain);
+      free(_a);
+   }
+}
+
+static bool_t loc_push_cmd(samplechain_audition_t *_a, uint32_t _type, uint32_t _elementIdx, float32_t _sta, float32_t _gain, samplechain_audition_chain_t *_chain) {
+   uint32_t head = _a->cmd_head;
+
+   if((head - SC_ATOMIC_LOAD(&_a->cmd_tail)) < SC_AUDITION_QUEUE_SIZE)
+   {
+      cmd_t *cmd = &_a->cmds[head & SC_AUDITION_QUEUE_MASK];
+
+      cmd->type        = _type;
+      cmd->element_idx = _elementIdx;
+      cmd->sta         = _sta;
+      cmd->gain        = _gain;
+      cmd->chain       = _chain;
+
+      // Publish command
+      SC_ATOMIC_STORE(&_a->cmd_head, head + 1u);
+
+      return SC_TRUE;
+   }
+
+   return SC_FALSE;
+}
+
+bool_t samplechain_audition_set_chain(samplechain_audition_t *_a, samplechain_audition_chain_t *_chain) {
+   bool_t ret = SC_FALSE;
+
+   // (note) limit number of owned chains so that the retired queue can never overflow
+   if((NULL != _chain) && (_a->num_owned_chains < SC_AUDITION_QUEUE_SIZE))
+   {
+      ret = loc_push_cmd(_a, CMD_SET_CHAIN, 0u, 0.0f, 0.0f, _chain);
+
+      if(ret)
+      {
+         _a->num_owned_chains++;
+      }
+   }
+
+   return ret;
+}
+
+bool_t samplechain_audition_trigger(samplechain_audition_t *_a, uint32_t _elementIdx, float32_t _gain) {
+   return loc_push_cmd(_a, CMD_TRIGGER, _elementIdx, 0.0f, _gain, NULL);
+}
+
+bool_t samplechain_audition_trigger_sta(samplechain_audition_t *_a, float32_t _sta, float32_t _gain) {
+   return loc_push_cmd(_a, CMD_TRIGGER_STA, 0u, _sta, _gain, NULL);
+}
+
+bool_t samplechain_audition_stop_all(samplechain_audition_t *_a) {
+   return loc_push_cmd(_a, CMD_STOP_ALL, 0u, 0.0f, 0.0f, NULL);
+}
+
+void samplechain_audition_collect(samplechain_audition_t *_a) {
+   uint32_t tail = _a->retired_tail;
+   uint32_t head = SC_ATOMIC_LOAD(&_a->retired_head);
+
+   while(tail != head)
+   {
+      free(_a->retired[tail & SC_AUDITION_QUEUE_MASK]);
+      _a->num_owned_chains--;
+      tail++;
+   }
+
+   SC_ATOMIC_STORE(&_a->retired_tail, tail);
+}
+
+// Find the element that starts at (or right before) the given STA value
+static uint32_t loc_find_element_by_sta(const samplechain_audition_chain_t *_chain, float32_t _sta) {
+   uint32_t lo = 0u;
+   uint32_t hi = _chain->num_elements;
+
+   // (note) tolerate rounding errors in the STA values entered by the user
+   _sta += 0.001f;
+
+   while((hi - lo) > 1u)
+   {
+      uint32_t mid = (lo + hi) >> 1;
+
+      if(_chain->sta[_chain->sta_index[mid]] <= _sta)
+      {
+         lo = mid;
+      }
+      else
+      {
+         hi = mid;
+      }
+   }
+
+   return _chain->sta_index[lo];
+}
+
+static void loc_start_voice(samplechain_audition_t *_a, uint32_t _elementIdx, float32_t _gain) {
+   const samplechain_audition_chain_t *chain = _a->chain;
+
+   if( (NULL != chain) && (_elementIdx < chain->num_elements) && (chain->orig_sizes[_elementIdx] > 0u) &&
+       ((chain->offsets[_elementIdx] + chain->orig_sizes[_elementIdx]) <= chain->num_frames)
+       )
+   {
+      voice_t *voice = NULL;
+      uint32_t voiceIdx;
+
+      // Find free voice, or steal the oldest one
+      for(voiceIdx = 0; voiceIdx < _a->num_voices; voiceIdx++)
+      {
+         voice_t *v = &_a->voices[voiceIdx];
+
+         if(!v->b_active)
+         {
+            voice = v;
+            break;
+         }
+
+         if((NULL == voice) || ((int32_t)(v->serial - voice->serial) < 0))
+         {
+            voice = v;
+         }
+      }
+
+      voice->frames     = chain->frames + (chain->offsets[_elementIdx] * chain->num_channels);
+      voice->num_frames = chain->orig_sizes[_elementIdx];
+      voice->pos        = 0u;
+      voice->gain       = _gain * (1.0f / 32768.0f);
+      voice->serial     = _a->next_serial++;
+      voice->b_active   = SC_TRUE;
+   }
+}
+
+static void loc_stop_all_voices(samplechain_audition_t *_a) {
+   uint32_t voiceIdx;
+
+   for(voiceIdx = 0; voiceIdx < _a->num_voices; voiceIdx++)
+   {
+      _a->voices[voiceIdx].b_active = SC_FALSE;
+   }
+}
+
+static void loc_process_commands(samplechain_audition_t *_a) {
+   uint32_t tail = _a->cmd_tail;
+   uint32_t head = SC_ATOMIC_LOAD(&_a->cmd_head);
+
+   while(tail != head)
+   {
+      const cmd_t *cmd = &_a->cmds[tail & SC_AUDITION_QUEUE_MASK];
+
+      switch(cmd->type)
+      {
+         case CMD_SET_CHAIN:
+            loc_stop_all_voices(_a);
+
+            if(NULL != _a->chain)
+            {
+               // Hand previous chain back to the editor thread (see samplechain_audition_collect())
+               _a->retired[_a->retired_head & SC_AUDITION_QUEUE_MASK] = _a->chain;
+               SC_ATOMIC_STORE(&_a->retired_head, _a->retired_head + 1u);
+            }
+
+            _a->chain = cmd->chain;
+            break;
+
+         case CMD_TRIGGER:
+            loc_start_voice(_a, cmd->element_idx, cmd->gain);
+            break;
+
+         case CMD_TRIGGER_STA:
+            if(NULL != _a->chain)
+            {
+               loc_start_voice(_a, loc_find_element_by_sta(_a->chain, cmd->sta), cmd->gain);
+            }
+            break;
+
+         case CMD_STOP_ALL:
+            loc_stop_all_voices(_a);
+            break;
+      }
+
+      tail++;
+   }
+
+   SC_ATOMIC_STORE(&_a->cmd_tail, tail);
+}
+
+void samplechain_audition_process(samplechain_audition_t *_a, float32_t *_retFrames, uint32_t _numFrames) {
+   uint32_t numOutCh = _a->num_out_channels;
+   uint32_t numActive = 0u;
+   uint32_t voiceIdx;
+
+   loc_process_commands(_a);
+
+   memset(_retFrames, 0, sizeof(float32_t) * _numFrames * numOutCh);
+
+   for(voiceIdx = 0; voiceIdx < _a->num_voices; voiceIdx++)
+   {
+      voice_t *v = &_a->voices[voiceIdx];
+
+      if(v->b_active)
+      {
+         uint32_t numCh = _a->chain->num_channels;
+         size_t numLeft = v->num_frames - v->pos;
+         uint32_t num = (numLeft < _numFrames) ? (uint32_t)numLeft : _numFrames;
+         const int16_t *s = v->frames + (v->pos * numCh);
+         float32_t *d = _retFrames;
+         uint32_t i;
+
+         if(numCh == numOutCh)
+         {
+            for(i = 0; i < (num * numCh); i++)
+            {
+               d[i] += s[i] * v->gain;
+            }
+         }
+         else
+         {
+            // (note) output channel N plays chain channel (N % numCh), e.g. mono chains on all channels
+            for(i = 0; i < num; i++)
+            {
+               uint32_t chIdx;
+
+               for(chIdx = 0; chIdx < numOutCh; chIdx++)
+               {
+                  d[chIdx] += s[chIdx % numCh] * v->gain;
+               }
+
+               s += numCh;
+               d += numOutCh;
+            }
+         }
+
+         v->pos += num;
+
+         if(v->pos >= v->num_frames)
+         {
+            v->b_active = SC_FALSE;
+         }
+         else
+         {
+            numActive++;
+         }
+      }
+   }
+
+   SC_ATOMIC_STORE(&_a->num_active_voices, numActive);
+}
+
+uint32_t samplechain_audition_get_num_active_voices(samplechain_audition_t *_a) {
+   return SC_ATOMIC_LOAD(&_a->num_active_voices);
+}
@@ -0,0 +1,100 @@
+/* ----
+ * ---- file   : audition.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_AUDITION_H_INCLUDED
+#define SAMPLECHAIN_AUDITION_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_AUDITION_QUEUE_SIZE  256u  // max. number of pending commands (power of two)
+
+
+// Rendered chain + layout index (immutable once it has been passed to the engine)
+typedef struct samplechain_audition_chain_s samplechain_audition_chain_t;
+
+// Opaque playback engine
+typedef struct samplechain_audition_s samplechain_audition_t;
+
+
+// Create chain snapshot from a calculated chain and its rendered (interleaved 16bit) sample frames
+//  - The sample frames are copied, i.e. the caller may rebuild / free them afterwards
+//  - Returns NULL if the chain output is invalid or 'numFrames' is smaller than the chain size
+samplechain_audition_chain_t *samplechain_audition_chain_create (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                                 const int16_t *_frames, size_t _numFrames
+                                                                 );
+
+// Free chain snapshot (only for chains that have not been passed to samplechain_audition_set_chain())
+void samplechain_audition_chain_destroy (samplechain_audition_chain_t *_chain);
+
+
+// Create playback engine
+//  - 'numVoices' is the max. number of simultaneously playing slices (the oldest voice is stolen)
+//  - 'numOutChannels' is the number of output channels written by samplechain_audition_process()
+samplechain_audition_t *samplechain_audition_create (uint32_t _numVoices, uint32_t _numOutChannels);
+
+// Free engine and all chains owned by it (audio thread must not call process() anymore)
+void samplechain_audition_destroy (samplechain_audition_t *_a);
+
+
+// Editor thread (single producer):
+//  - Commands are passed to the audio thread via a lock-free SPSC queue and never block
+//  - All functions return false if the queue is full (the command is dropped)
+
+// Replace the current chain (voices playing the previous chain are stopped)
+//  - The engine takes ownership of 'chain' (if the call succeeds)
+bool_t samplechain_audition_set_chain (samplechain_audition_t *_a, samplechain_audition_chain_t *_chain);
+
+// Play element
+bool_t samplechain_audition_trigger (samplechain_audition_t *_a, uint32_t _elementIdx, float32_t _gain);
+
+// Play the element that starts at (or right before) the given device STA value
+bool_t samplechain_audition_trigger_sta (samplechain_audition_t *_a, float32_t _sta, float32_t _gain);
+
+// Stop all voices
+bool_t samplechain_audition_stop_all (samplechain_audition_t *_a);
+
+// Free chains that have been retired by the audio thread
+void samplechain_audition_collect (samplechain_audition_t *_a);
+
+
+// Audio thread (single consumer):
+//  - Processes pending commands and mixes all active voices into 'retFrames' (interleaved float)
+//  - Realtime-safe: no locks, no allocations, no system calls
+void samplechain_audition_process (samplechain_audition_t *_a, float32_t *_retFrames, uint32_t _numFrames);
+
+// Query number of currently playing voices (updated by process())
+uint32_t samplechain_audition_get_num_active_voices (samplechain_audition_t *_a);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_AUDITION_H_INCLUDED
@@ -0,0 +1,443 @@
+/* ----
+ * ---- file   : cache.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef SC_NO_THREADS
+#include <pthread.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+#include "../util/profile.h"
+#include "cache.h"
+
+#define SC_CACHE_NUM_BUCKETS  1024u  // power of two
+
+#define SC_CACHE_STATE_LOADING  0u
+#define SC_CACHE_STATE_READY    1u
+#define SC_CACHE_STATE_FAILED   2u
+
+
+struct samplechain_cache_entry_s {
+   struct samplechain_cache_entry_s *hash_next;
+   struct samplechain_cache_entry_s *lru_prev;  // unpinned entries (least recently used first)
+   struct samplechain_cache_entry_s *lru_next;
+
+   uint64_t hash;
+   char    *key;
+   uint64_t version;
+   uint32_t num_channels;
+
+   uint32_t num_refs;  // number of pins
+   uint32_t state;     // SC_CACHE_STATE_xxx
+   bool_t   b_cached;  // true while the entry is in the hash table
+
+   float32_t *frames;
+   size_t     num_frames;
+   size_t     num_bytes;
+};
+
+typedef struct {
+   size_t max_bytes;
+   size_t num_bytes;
+
+   samplechain_cache_entry_t *buckets[SC_CACHE_NUM_BUCKETS];
+   samplechain_cache_entry_t *lru_head;
+   samplechain_cache_entry_t *lru_tail;
+
+   uint32_t num_entries;
+   uint32_t num_pinned;
+   uint64_t num_hits;
+   uint64_t num_misses;
+   uint64_t num_evictions;
+   uint64_t num_stale;
+} cache_t;
+
+
+// (note) all cache state is guarded by 'loc_mutex'
+static cache_t loc_cache = { SC_CACHE_DEFAULT_MAX_BYTES };
+
+#ifndef SC_NO_THREADS
+static pthread_mutex_t loc_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  loc_cond  = PTHREAD_COND_INITIALIZER;  // signaled when a decode has finished
+
+#define loc_lock()       pthread_mutex_lock(&loc_mutex)
+#define loc_unlock()     pthread_mutex_unlock(&loc_mutex)
+#define loc_wait()       pthread_cond_wait(&loc_cond, &loc_mutex)
+#define loc_broadcast()  pthread_cond_broadcast(&loc_cond)
+#else
+#define loc_lock()       (void)0
+#define loc_unlock()     (void)0
+#define loc_wait()       (void)0
+#define loc_broadcast()  (void)0
+#endif
+
+
+static void loc_lru_unlink(samplechain_cache_entry_t *_e) {
+
+   if(NULL != _e->lru_prev)
+   {
+      _e->lru_prev->lru_next = _e->lru_next;
+   }
+   else
+   {
+      loc_cache.lru_head = _e->lru_next;
+   }
+
+   if(NULL != _e->lru_next)
+   {
+      _e->lru_next->lru_prev = _e->lru_prev;
+   }
+   else
+   {
+      loc_cache.lru_tail = _e->lru_prev;
+   }
+
+   _e->lru_prev = NULL;
+   _e->lru_next = NULL;
+}
+
+static void loc_lru_append(samplechain_cache_entry_t *_e) {
+   _e->lru_prev = loc_cache.lru_tail;
+   _e->lru_next = NULL;
+
+   if(NULL != loc_cache.lru_tail)
+   {
+      loc_cache.lru_tail->lru_next = _e;
+   }
+   else
+   {
+      loc_cache.lru_head = _e;
+   }
+
+   loc_cache.lru_tail = _e;
+}
+
+static samplechain_cache_entry_t *loc_find(uint64_t _hash, const char *_key, uint32_t _numChannels) {
+   samplechain_cache_entry_t *e = loc_cache.buckets[_hash & (SC_CACHE_NUM_BUCKETS - 1u)];
+
+   while( (NULL != e) &&
+          !((e->hash == _hash) && (e->num_channels == _numChannels) && (0 == strcmp(e->key, _key)))
+          )
+   {
+      e = e->hash_next;
+   }
+
+   return e;
+}
+
+static void loc_remove(samplechain_cache_entry_t *_e) {
+   samplechain_cache_entry_t **pp = &loc_cache.buckets[_e->hash & (SC_CACHE_NUM_BUCKETS - 1u)];
+
+   while(*pp != _e)
+   {
+      pp = &(*pp)->hash_next;
+   }
+
+   *pp = _e->hash_next;
+
+   _e->hash_next = NULL;
+   _e->b_cached  = SC_FALSE;
+
+   loc_cache.num_bytes -= _e->num_bytes;
+   loc_cache.num_entries--;
+}
+
+static void loc_free_entry(samplechain_cache_entry_t *_e) {
+   free(_e->frames);
+   free(_e);
+}
+
+// Evict least recently used (unpinned) entries until the cache fits into 'maxBytes'
+static void loc_evict(size_t _maxBytes) {
+
+   while((loc_cache.num_bytes > _maxBytes) && (NULL != loc_cache.lru_head))
+   {
+      samplechain_cache_entry_t *e = loc_cache.lru_head;
+
+      loc_lru_unlink(e);
+      loc_remove(e);
+      loc_free_entry(e);
+
+      loc_cache.num_evictions++;
+   }
+}
+
+static void loc_unpin(samplechain_cache_entry_t *_e) {
+
+   if(0u == --_e->num_refs)
+   {
+      loc_cache.num_pinned--;
+
+      if(_e->b_cached)
+      {
+         // Most recently used
+         loc_lru_append(_e);
+         loc_evict(loc_cache.max_bytes);
+      }
+      else
+      {
+         // (note) failed decode or stale entry
+         loc_free_entry(_e);
+      }
+   }
+}
+
+void samplechain_cache_set_max_bytes(size_t _maxBytes) {
+   loc_lock();
+
+   loc_cache.max_bytes = _maxBytes;
+   loc_evict(_maxBytes);
+
+   loc_unlock();
+}
+
+size_t samplechain_cache_get_max_bytes(void) {
+   size_t ret;
+
+   loc_lock();
+   ret = loc_cache.max_bytes;
+   loc_unlock();
+
+   return ret;
+}
+
+uint64_t samplechain_cache_get_file_version(const char *_pathName) {
+   uint64_t ret = 0u;
+   struct stat st;
+
+   if((NULL != _pathName) && (0 == stat(_pathName, &st)))
+   {
+      uint64_t id[5];
+
+      id[0] = (uint64_t)st.st_dev;
+      id[1] = (uint64_t)st.st_ino;
+      id[2] = (uint64_t)st.st_size;
+      id[3] = (uint64_t)st.st_mtime;
+#if defined(__APPLE__)
+      id[4] = (uint64_t)st.st_mtimespec.tv_nsec;
+#else
+      id[4] = (uint64_t)st.st_mtim.tv_nsec;
+#endif
+
+      ret = sc_kernel_hash(id, sizeof(id), 0u);
+
+      // (note) 0 is reserved for missing files
+      ret += (0u == ret);
+   }
+
+   return ret;
+}
+
+samplechain_cache_entry_t *samplechain_cache_acquire(const char *_key, uint64_t _version, uint32_t _numChannels,
+                                                     samplechain_cache_load_fxn_t _load, void *_loadCtx
+                                                     ) {
+   samplechain_cache_entry_t *ret = NULL;
+
+   if((NULL != _key) && (NULL != _load) && (_numChannels > 0u))
+   {
+      size_t keyLen = strlen(_key);
+      uint64_t hash = sc_kernel_hash(_key, keyLen, _numChannels);
+      samplechain_cache_entry_t *e;
+
+      loc_lock();
+
+      e = loc_find(hash, _key, _numChannels);
+
+      if((NULL != e) && (e->version != _version))
+      {
+         // (note) the source changed since it was decoded. Pinned users keep the stale audio until they release it
+         if(0u == e->num_refs)
+         {
+            loc_lru_unlink(e);
+            loc_remove(e);
+            loc_free_entry(e);
+         }
+         else
+         {
+            loc_remove(e);
+         }
+
+         loc_cache.num_stale++;
+
+         e = NULL;
+      }
+
+      if(NULL != e)
+      {
+         if(0u == e->num_refs++)
+         {
+            loc_lru_unlink(e);
+            loc_cache.num_pinned++;
+         }
+
+         loc_cache.num_hits++;
+         SC_PROFILE_COUNT(CACHE_HITS, 1u);
+
+         while(SC_CACHE_STATE_LOADING == e->state)
+         {
+            loc_wait();
+         }
+      }
+      else
+      {
+         e = malloc(sizeof(samplechain_cache_entry_t) + keyLen + 1u);
+
+         if(NULL != e)
+         {
+            samplechain_cache_entry_t **bucket = &loc_cache.buckets[hash & (SC_CACHE_NUM_BUCKETS - 1u)];
+            size_t numFrames = 0u;
+            float32_t *frames;
+
+            memset(e, 0, sizeof(samplechain_cache_entry_t));
+
+            e->hash         = hash;
+            e->key          = (char*) (e + 1);
+            e->version      = _version;
+            e->num_channels = _numChannels;
+            e->num_refs     = 1u;
+            e->state        = SC_CACHE_STATE_LOADING;
+            e->b_cached     = SC_TRUE;
+            e->hash_next    = *bucket;
+
+            memcpy(e->key, _key, keyLen + 1u);
+
+            *bucket = e;
+
+            loc_cache.num_entries++;
+            loc_cache.num_pinned++;
+            loc_cache.num_misses++;
+
+            // Decode (other lookups of this entry wait, lookups of other entries proceed)
+            loc_unlock();
+
+            frames = _load(_loadCtx, _key, _numChannels, &numFrames);
+
+            loc_lock();
+
+            if(NULL != frames)
+            {
+               e->frames     = frames;
+               e->num_frames = numFrames;
+               e->num_bytes  = sizeof(float32_t) * numFrames * _numChannels;
+               e->state      = SC_CACHE_STATE_READY;
+
+               // (note) a newer version may have replaced the entry while it was being decoded
+               if(e->b_cached)
+               {
+                  loc_cache.num_bytes += e->num_bytes;
+                  loc_evict(loc_cache.max_bytes);
+               }
+            }
+            else
+            {
+               // (note) not cached, i.e. the next lookup retries
+               e->state = SC_CACHE_STATE_FAILED;
+
+               if(e->b_cached)
+               {
+                  loc_remove(e);
+               }
+            }
+
+            loc_broadcast();
+         }
+      }
+
+      if(NULL != e)
+      {
+         if(SC_CACHE_STATE_READY == e->state)
+         {
+            ret = e;
+         }
+         else
+         {
+            loc_unpin(e);
+         }
+      }
+
+      loc_unlock();
+   }
+
+   return ret;
+}
+
+const float32_t *samplechain_cache_entry_get_frames(const samplechain_cache_entry_t *_entry, size_t *_retNumFrames) {
+   const float32_t *ret = NULL;
+   size_t numFrames = 0u;
+
+   if(NULL != _entry)
+   {
+      // (note) immutable while the entry is pinned
+      ret       = _entry->frames;
+      numFrames = _entry->num_frames;
+   }
+
+   if(NULL != _retNumFrames)
+   {
+      *_retNumFrames = numFrames;
+   }
+
+   return ret;
+}
+
+void samplechain_cache_release(samplechain_cache_entry_t *_entry) {
+
+   if(NULL != _entry)
+   {
+      loc_lock();
+      loc_unpin(_entry);
+      loc_unlock();
+   }
+}
+
+void samplechain_cache_clear(void) {
+   loc_lock();
+   loc_evict(0u);
+   loc_unlock();
+}
+
+void samplechain_cache_get_stats(samplechain_cache_stats_t *_retStats) {
+   loc_lock();
+
+   _retStats->num_entries   = loc_cache.num_entries;
+   _retStats->num_pinned    = loc_cache.num_pinned;
+   _retStats->num_bytes     = loc_cache.num_bytes;
+   _retStats->num_hits      = loc_cache.num_hits;
+   _retStats->num_misses    = loc_cache.num_misses;
+   _retStats->num_evictions = loc_cache.num_evictions;
+   _retStats->num_stale     = loc_cache.num_stale;
+
+   loc_unlock();
+}
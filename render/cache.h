@@ -0,0 +1,102 @@
+/* ----
+ * ---- file   : cache.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_CACHE_H_INCLUDED
+#define SAMPLECHAIN_CACHE_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+#define SC_CACHE_DEFAULT_MAX_BYTES  (256u << 20)
+
+
+// Opaque cache entry (decoded element audio)
+typedef struct samplechain_cache_entry_s samplechain_cache_entry_t;
+
+// Decode callback
+//  - Returns interleaved float sample frames with 'numChannels' channels (allocated with malloc(), owned by the cache),
+//     or NULL if the source could not be decoded
+typedef float32_t *(*samplechain_cache_load_fxn_t) (void *_loadCtx, const char *_key, uint32_t _numChannels, size_t *_retNumFrames);
+
+typedef struct {
+   uint32_t num_entries;
+   uint32_t num_pinned;     // entries that are currently acquired
+   size_t   num_bytes;      // decoded audio held by the cache
+   uint64_t num_hits;
+   uint64_t num_misses;     // number of decodes
+   uint64_t num_evictions;
+   uint64_t num_stale;      // entries that were dropped because the source changed (see 'version')
+} samplechain_cache_stats_t;
+
+
+// Set the cache size cap (default: SC_CACHE_DEFAULT_MAX_BYTES)
+//  - Least recently used entries are evicted when the cap is exceeded. Acquired (pinned) entries are never
+//     evicted, i.e. the cache may temporarily exceed the cap
+void samplechain_cache_set_max_bytes (size_t _maxBytes);
+
+// Query the cache size cap
+size_t samplechain_cache_get_max_bytes (void);
+
+// Query the identity of a file (device, inode, size and modification time)
+//  - Pass the result as the 'version' of a file source to samplechain_cache_acquire()
+//  - Returns 0 if the file does not exist
+uint64_t samplechain_cache_get_file_version (const char *_pathName);
+
+// Look up (or decode) element audio and pin it
+//  - 'key' identifies the source (e.g. the real path of a WAV file), 'numChannels' the target format.
+//     The same source in a different format is a separate entry
+//  - 'version' identifies the source content (e.g. samplechain_cache_get_file_version()). An entry whose version
+//     differs is stale, i.e. it is dropped (pinned users keep its audio until they release it) and the source is decoded again
+//  - Decodes the source via 'load' on a miss. Concurrent lookups of an entry that is being decoded
+//     wait for the decode, i.e. each source is decoded once
+//  - Process-wide and thread-safe
+//  - Returns the pinned entry (must be released with samplechain_cache_release()), or NULL if the source could not be decoded
+samplechain_cache_entry_t *samplechain_cache_acquire (const char *_key, uint64_t _version, uint32_t _numChannels,
+                                                      samplechain_cache_load_fxn_t _load, void *_loadCtx
+                                                      );
+
+// Query the audio of a pinned entry
+const float32_t *samplechain_cache_entry_get_frames (const samplechain_cache_entry_t *_entry, size_t *_retNumFrames);
+
+// Unpin entry
+//  - The entry stays cached (and may be evicted when the cache exceeds its size cap)
+void samplechain_cache_release (samplechain_cache_entry_t *_entry);
+
+// Free all entries that are not pinned
+void samplechain_cache_clear (void);
+
+// Query statistics
+void samplechain_cache_get_stats (samplechain_cache_stats_t *_retStats);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_CACHE_H_INCLUDED
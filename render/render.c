@@ -0,0 +1,628 @@
+/* ----
+ * ---- file   : render.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../analysis/loudness.h"
+#include "../util/kernels.h"
+#include "../util/profile.h"
+#include "../util/thread.h"
+#include "render.h"
+#include "../analysis/metadata.h"  // (note) requires samplechain_render_params_t
+
+#define SC_RENDER_RESAMPLE_SAMPLES  2048  // size of the pitch-shift buffer (number of samples)
+
+
+typedef struct {
+   const samplechain_algorithm_t     *alg;
+   samplechain_t                      sc;
+   const samplechain_render_params_t *params;
+
+   uint32_t num_channels;
+   uint32_t num_elements;
+
+   size_t *offsets;
+   size_t *total_sizes;
+   size_t *orig_sizes;
+
+   uint32_t *source_indices;
+
+   samplechain_source_t         *sources;
+   const samplechain_derived_t **derived;  // NULL=regular element
+   float32_t                    *gains;
+
+   int16_t *out;
+
+   uint32_t num_errors;
+
+} render_t;
+
+
+struct samplechain_render_stream_s {
+   render_t r;
+
+   size_t   total_sz;
+   size_t   pos;          // current chain frame
+   uint32_t element_idx;  // element that contains 'pos'
+};
+
+
+// Clip the sub-range of a derived element to the source audio
+static size_t loc_get_derived_range(const samplechain_derived_t *_derived, size_t _sourceNumFrames, size_t *_retStart) {
+   size_t start = (_derived->start < _sourceNumFrames) ? _derived->start : _sourceNumFrames;
+   size_t ret = _sourceNumFrames - start;
+
+   if((0 != _derived->num_frames) && (_derived->num_frames < ret))
+   {
+      ret = _derived->num_frames;
+   }
+
+   *_retStart = start;
+
+   return ret;
+}
+
+static size_t loc_calc_derived_num_frames(const samplechain_derived_t *_derived, size_t _rangeNumFrames) {
+   size_t ret = _rangeNumFrames;
+
+   if((_derived->pitch > 0.0f) && (1.0f != _derived->pitch) && (_rangeNumFrames > 0))
+   {
+      ret = (size_t)ceil((float64_t)_rangeNumFrames / _derived->pitch);
+   }
+
+   return ret;
+}
+
+void samplechain_derived_init(samplechain_derived_t *_derived, void *_sourceUserData, size_t _sourceNumFrames) {
+
+   if(NULL != _derived)
+   {
+      _derived->source_user_data  = _sourceUserData;
+      _derived->source_num_frames = _sourceNumFrames;
+      _derived->start             = 0;
+      _derived->num_frames        = 0;
+      _derived->gain              = 1.0f;
+      _derived->pitch             = 1.0f;
+      _derived->flags             = 0u;
+   }
+}
+
+size_t samplechain_derived_calc_num_frames(const samplechain_derived_t *_derived) {
+   size_t ret = 0;
+
+   if(NULL != _derived)
+   {
+      size_t start;
+
+      ret = loc_calc_derived_num_frames(_derived, loc_get_derived_range(_derived, _derived->source_num_frames, &start));
+   }
+
+   return ret;
+}
+
+static void loc_resolve_element(render_t *_r, uint32_t _elementIdx) {
+   samplechain_source_t *src = &_r->sources[_elementIdx];
+   void *userData = _r->alg->query_element_user_data(_r->sc, _elementIdx);
+   size_t origSz = _r->orig_sizes[_elementIdx];
+
+   const samplechain_derived_t *derived = NULL;
+
+   src->frames     = NULL;
+   src->num_frames = 0;
+
+   _r->gains[_elementIdx] = 1.0f;
+
+   if((NULL != userData) && (NULL != _r->params->derived))
+   {
+      derived = _r->params->derived(_r->params->fetch_ctx, userData);
+
+      if(NULL != derived)
+      {
+         // (note) fetch the source audio (the transform is applied while rendering)
+         userData = derived->source_user_data;
+         origSz   = derived->source_num_frames;
+      }
+   }
+
+   _r->derived[_elementIdx] = derived;
+
+   // (note) duplicates share the chain region of their source element
+   if((NULL != userData) && (origSz > 0) && (_r->source_indices[_elementIdx] == _elementIdx))
+   {
+      if(NULL != _r->params->fetch)
+      {
+         SC_PROFILE_BEGIN(FETCH);
+
+         if(!_r->params->fetch(_r->params->fetch_ctx, userData, origSz, src))
+         {
+            src->frames     = NULL;
+            src->num_frames = 0;
+
+            SC_ATOMIC_ADD(&_r->num_errors, 1u);
+         }
+
+         SC_PROFILE_END(FETCH);
+      }
+      else
+      {
+         src->frames     = (const float32_t*)userData;
+         src->num_frames = origSz;
+      }
+
+      if(src->num_frames > origSz)
+      {
+         src->num_frames = origSz;
+      }
+
+      if((SC_NORMALIZE_NONE != _r->params->normalize_mode) && (src->num_frames > 0))
+      {
+         samplechain_loudness_t loudness;
+         const float32_t *frames = src->frames;
+         size_t numFrames = src->num_frames;
+         const samplechain_element_metadata_t *md = NULL;
+
+         if(NULL != derived)
+         {
+            size_t start;
+
+            numFrames = loc_get_derived_range(derived, numFrames, &start);
+            frames   += start * _r->num_channels;
+         }
+
+         if((NULL != _r->params->metadata) && (_elementIdx < _r->params->metadata->num_elements))
+         {
+            md = &_r->params->metadata->elements[_elementIdx];
+
+            // (note) ignore stale metadata (e.g. the element was replaced or reordered by add_with_key())
+            if(!md->b_valid || (md->user_data != _r->alg->query_element_user_data(_r->sc, _elementIdx)) || (md->num_frames != numFrames))
+            {
+               md = NULL;
+            }
+         }
+
+         if(NULL != md)
+         {
+            loudness.peak = md->peak;
+            loudness.rms  = md->rms;
+         }
+         else
+         {
+            SC_PROFILE_BEGIN(ANALYZE);
+
+            samplechain_loudness_analyze(frames, numFrames, _r->num_channels, &loudness);
+
+            SC_PROFILE_END(ANALYZE);
+         }
+
+         _r->gains[_elementIdx] = samplechain_loudness_calc_gain(&loudness,
+                                                                 _r->params->normalize_mode,
+                                                                 _r->params->normalize_level_db
+                                                                 );
+      }
+
+      if(NULL != derived)
+      {
+         _r->gains[_elementIdx] *= derived->gain;
+      }
+   }
+}
+
+// Render frames [off, off+numFrames[ of a derived element (see loc_render_element_range())
+//  - Returns the number of frames written (the remaining frames are padding)
+static size_t loc_render_derived_range(render_t *_r, uint32_t _elementIdx, size_t _off, size_t _numFrames, int16_t *_d) {
+   const samplechain_derived_t *derived = _r->derived[_elementIdx];
+   const samplechain_source_t *src = &_r->sources[_elementIdx];
+   size_t numCh = _r->num_channels;
+   float32_t gain = _r->gains[_elementIdx];
+   bool_t bReverse = (0u != (derived->flags & SC_DERIVED_REVERSE));
+   size_t start;
+   size_t len = loc_get_derived_range(derived, src->num_frames, &start);
+   size_t numOut = loc_calc_derived_num_frames(derived, len);
+   size_t ret = 0;
+
+   if(numOut > _r->orig_sizes[_elementIdx])
+   {
+      numOut = _r->orig_sizes[_elementIdx];
+   }
+
+   if(_off < numOut)
+   {
+      const float32_t *s = src->frames + (start * numCh);
+
+      ret = numOut - _off;
+
+      if(ret > _numFrames)
+      {
+         ret = _numFrames;
+      }
+
+      if(numOut == len)
+      {
+         // Sub-range / reverse: plain (reversed) copy
+         if(bReverse)
+         {
+            sc_kernel_convert_f32_s16_reverse(_d, s + ((len - 1u - _off) * numCh), ret, (uint32_t)numCh, gain);
+         }
+         else
+         {
+            sc_kernel_convert_f32_s16(_d, s + (_off * numCh), ret * numCh, gain);
+         }
+      }
+      else if(numCh <= SC_RENDER_RESAMPLE_SAMPLES)
+      {
+         // Pitch: linear interpolation into a small buffer, then convert
+         float32_t buf[SC_RENDER_RESAMPLE_SAMPLES];
+         size_t bufFrames = SC_RENDER_RESAMPLE_SAMPLES / numCh;
+         size_t i = 0;
+
+         while(i < ret)
+         {
+            size_t num = ((ret - i) < bufFrames) ? (ret - i) : bufFrames;
+            size_t j;
+
+            for(j = 0; j < num; j++)
+            {
+               float64_t pos = (float64_t)(_off + i + j) * derived->pitch;
+               size_t k0 = (size_t)pos;
+               size_t k1 = k0 + 1u;
+               float32_t frac = (float32_t)(pos - (float64_t)k0);
+               const float32_t *f0;
+               const float32_t *f1;
+               size_t ch;
+
+               k0 = (k0 < len) ? k0 : (len - 1u);
+               k1 = (k1 < len) ? k1 : (len - 1u);
+
+               if(bReverse)
+               {
+                  k0 = len - 1u - k0;
+                  k1 = len - 1u - k1;
+               }
+
+               f0 = s + (k0 * numCh);
+               f1 = s + (k1 * numCh);
+
+               for(ch = 0; ch < numCh; ch++)
+               {
+                  buf[(j * numCh) + ch] = f0[ch] + ((f1[ch] - f0[ch]) * frac);
+               }
+            }
+
+            sc_kernel_convert_f32_s16(_d + (i * numCh), buf, num * numCh, gain);
+
+            i += num;
+         }
+      }
+      else
+      {
+         ret = 0;
+      }
+   }
+
+   return ret;
+}
+
+// Render frames [regionOff, regionOff+numFrames[ of the element's chain region to 'd'
+static void loc_render_element_range(render_t *_r, uint32_t _elementIdx, size_t _regionOff, size_t _numFrames, int16_t *_d) {
+   const samplechain_source_t *src = &_r->sources[_elementIdx];
+   size_t numCh = _r->num_channels;
+   size_t numCopy = 0;
+
+   SC_PROFILE_BEGIN(CONVERT);
+
+   if(NULL != _r->derived[_elementIdx])
+   {
+      if(NULL != src->frames)
+      {
+         numCopy = loc_render_derived_range(_r, _elementIdx, _regionOff, _numFrames, _d);
+      }
+   }
+   else if(_regionOff < src->num_frames)
+   {
+      numCopy = src->num_frames - _regionOff;
+
+      if(numCopy > _numFrames)
+      {
+         numCopy = _numFrames;
+      }
+
+      sc_kernel_convert_f32_s16(_d, src->frames + (_regionOff * numCh), numCopy * numCh, _r->gains[_elementIdx]);
+   }
+
+   // Zero-fill padding (and missing frames)
+   memset(_d + (numCopy * numCh), 0, sizeof(int16_t) * (_numFrames - numCopy) * numCh);
+
+   SC_PROFILE_COUNT(BYTES_COPIED, sizeof(int16_t) * numCopy * numCh);
+   SC_PROFILE_COUNT(BYTES_ZEROED, sizeof(int16_t) * (_numFrames - numCopy) * numCh);
+
+   SC_PROFILE_END(CONVERT);
+}
+
+static void loc_render_element(render_t *_r, uint32_t _elementIdx) {
+
+   // (note) duplicates share the chain region of their source element
+   if(_r->source_indices[_elementIdx] == _elementIdx)
+   {
+      loc_render_element_range(_r,
+                               _elementIdx,
+                               0u,
+                               _r->total_sizes[_elementIdx],
+                               _r->out + (_r->offsets[_elementIdx] * _r->num_channels)
+                               );
+   }
+}
+
+static void loc_resolve_element_job(void *_r, uint32_t _elementIdx) {
+   loc_resolve_element((render_t*)_r, _elementIdx);
+}
+
+static void loc_render_element_job(void *_r, uint32_t _elementIdx) {
+   loc_render_element((render_t*)_r, _elementIdx);
+}
+
+static void loc_resolve_and_render_element_job(void *_r, uint32_t _elementIdx) {
+   loc_resolve_element((render_t*)_r, _elementIdx);
+   loc_render_element((render_t*)_r, _elementIdx);
+}
+
+void samplechain_render_init_params(samplechain_render_params_t *_params) {
+
+   if(NULL != _params)
+   {
+      _params->fetch              = NULL;
+      _params->fetch_ctx          = NULL;
+      _params->release            = NULL;
+      _params->derived            = NULL;
+      _params->normalize_mode     = SC_NORMALIZE_NONE;
+      _params->normalize_level_db = -1.0f;
+      _params->metadata           = NULL;
+      _params->num_threads        = 0;
+   }
+}
+
+// Allocate element arrays and query layout
+//  - Does not resolve the element audio
+static bool_t loc_render_prepare(render_t *_r,
+                                 const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                 const samplechain_render_params_t *_params
+                                 ) {
+   bool_t ret = SC_FALSE;
+   int32_t bytesPerSample = 2;
+   int32_t numChannels = 1;
+
+   _r->offsets = NULL;
+
+   _alg->get_parameter_i(_sc, "bytes_per_sample", &bytesPerSample);
+   _alg->get_parameter_i(_sc, "num_channels", &numChannels);
+
+   if((2 == bytesPerSample) && (_alg->query_total_size(_sc) > 0))
+   {
+      uint32_t n = _alg->query_num_elements(_sc);
+      size_t elementSz = (3 * sizeof(size_t)) + sizeof(samplechain_source_t) + sizeof(samplechain_derived_t*) +
+                         sizeof(float32_t) + sizeof(uint32_t);
+      size_t *sizes = malloc(n * elementSz);
+
+      if(NULL != sizes)
+      {
+         samplechain_layout_t layout;
+
+         memset(&layout, 0, sizeof(layout));
+
+         _r->alg            = _alg;
+         _r->sc             = _sc;
+         _r->params         = _params;
+         _r->num_channels   = (uint32_t)numChannels;
+         _r->num_elements   = n;
+         _r->offsets        = sizes;
+         _r->total_sizes    = sizes + n;
+         _r->orig_sizes     = sizes + (2 * n);
+         _r->sources        = (samplechain_source_t*) (sizes + (3 * n));
+         _r->derived        = (const samplechain_derived_t**) (_r->sources + n);
+         _r->gains          = (float32_t*) (_r->derived + n);
+         _r->source_indices = (uint32_t*) (_r->gains + n);
+         _r->out            = NULL;
+         _r->num_errors     = 0;
+
+         layout.offsets        = _r->offsets;
+         layout.total_sizes    = _r->total_sizes;
+         layout.orig_sizes     = _r->orig_sizes;
+         layout.source_indices = _r->source_indices;
+
+         if(n == _alg->query_layout(_sc, &layout, n))
+         {
+            ret = SC_TRUE;
+         }
+         else
+         {
+            free(sizes);
+            _r->offsets = NULL;
+         }
+      }
+   }
+
+   return ret;
+}
+
+static void loc_render_free(render_t *_r) {
+
+   if((NULL != _r->params->fetch) && (NULL != _r->params->release))
+   {
+      uint32_t elementIdx;
+
+      for(elementIdx = 0; elementIdx < _r->num_elements; elementIdx++)
+      {
+         if(NULL != _r->sources[elementIdx].frames)
+         {
+            const samplechain_derived_t *derived = _r->derived[elementIdx];
+
+            _r->params->release(_r->params->fetch_ctx,
+                                (NULL != derived) ? derived->source_user_data : _r->alg->query_element_user_data(_r->sc, elementIdx),
+                                &_r->sources[elementIdx]
+                                );
+         }
+      }
+   }
+
+   // (note) all arrays are part of the 'offsets' allocation
+   free(_r->offsets);
+   _r->offsets = NULL;
+}
+
+bool_t samplechain_render(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                          const samplechain_render_params_t *_params,
+                          int16_t *_retFrames, size_t _maxFrames
+                          ) {
+   bool_t ret = SC_FALSE;
+
+   if((NULL != _alg) && (NULL != _params) && (NULL != _retFrames))
+   {
+      render_t r;
+
+      SC_PROFILE_BEGIN(RENDER);
+
+      if(_alg->query_total_size(_sc) <= _maxFrames)
+      {
+         if(loc_render_prepare(&r, _alg, _sc, _params))
+         {
+            r.out = _retFrames;
+
+            if(SC_NORMALIZE_NONE != _params->normalize_mode)
+            {
+               // Analyze all elements first, then convert + apply gain in a single copy
+               sc_parallel_for(r.num_elements, &loc_resolve_element_job, &r, _params->num_threads);
+               sc_parallel_for(r.num_elements, &loc_render_element_job, &r, _params->num_threads);
+            }
+            else
+            {
+               sc_parallel_for(r.num_elements, &loc_resolve_and_render_element_job, &r, _params->num_threads);
+            }
+
+            ret = (0 == r.num_errors);
+
+            loc_render_free(&r);
+         }
+      }
+
+      SC_PROFILE_END(RENDER);
+   }
+
+   return ret;
+}
+
+samplechain_render_stream_t *samplechain_render_stream_open(const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                            const samplechain_render_params_t *_params
+                                                            ) {
+   samplechain_render_stream_t *ret = NULL;
+
+   if((NULL != _alg) && (NULL != _params))
+   {
+      ret = malloc(sizeof(samplechain_render_stream_t));
+
+      if(NULL != ret)
+      {
+         if(loc_render_prepare(&ret->r, _alg, _sc, _params))
+         {
+            // (note) only resolves the element audio (pointers) and gains, no sample frames are copied
+            sc_parallel_for(ret->r.num_elements, &loc_resolve_element_job, &ret->r, _params->num_threads);
+
+            ret->total_sz    = _alg->query_total_size(_sc);
+            ret->pos         = 0;
+            ret->element_idx = 0;
+
+            if(0 != ret->r.num_errors)
+            {
+               loc_render_free(&ret->r);
+               free(ret);
+               ret = NULL;
+            }
+         }
+         else
+         {
+            free(ret);
+            ret = NULL;
+         }
+      }
+   }
+
+   return ret;
+}
+
+size_t samplechain_render_stream_read(samplechain_render_stream_t *_stream, int16_t *_retFrames, size_t _maxFrames) {
+   size_t ret = 0;
+
+   if((NULL != _stream) && (NULL != _retFrames))
+   {
+      render_t *r = &_stream->r;
+
+      while((ret < _maxFrames) && (_stream->pos < _stream->total_sz) && (_stream->element_idx < r->num_elements))
+      {
+         uint32_t elementIdx = _stream->element_idx;
+
+         if(r->source_indices[elementIdx] == elementIdx)
+         {
+            size_t regionOff = _stream->pos - r->offsets[elementIdx];
+            size_t numFrames = r->total_sizes[elementIdx] - regionOff;
+
+            if(numFrames > (_maxFrames - ret))
+            {
+               numFrames = (_maxFrames - ret);
+            }
+
+            loc_render_element_range(r, elementIdx, regionOff, numFrames, _retFrames + (ret * r->num_channels));
+
+            ret          += numFrames;
+            _stream->pos += numFrames;
+
+            if((regionOff + numFrames) < r->total_sizes[elementIdx])
+            {
+               // Output buffer is full
+               break;
+            }
+         }
+
+         _stream->element_idx++;
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_render_stream_close(samplechain_render_stream_t *_stream) {
+
+   if(NULL != _stream)
+   {
+      loc_render_free(&_stream->r);
+      free(_stream);
+   }
+}
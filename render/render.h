@@ -0,0 +1,138 @@
+/* ----
+ * ---- file   : render.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_RENDER_H_INCLUDED
+#define SAMPLECHAIN_RENDER_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Element audio
+typedef struct {
+   const float32_t *frames;      // interleaved float sample frames
+   size_t           num_frames;
+} samplechain_source_t;
+
+// Resolve element user_data to the element audio
+//  - Returns false if the audio is not available
+typedef bool_t (*samplechain_fetch_fxn_t) (void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource);
+
+// Called when a fetched element audio is no longer used (e.g. to unpin a cache entry, see render/cache.h)
+typedef void (*samplechain_release_fxn_t) (void *_fetchCtx, void *_userData, const samplechain_source_t *_source);
+
+
+// Derived element flags
+#define SC_DERIVED_REVERSE  (1u << 0)  // play backwards
+
+// Derived element: transformed view of a source audio (e.g. the reversed or attenuated variant of another element)
+//  - The transform is applied while rendering, i.e. no copy of the variant is stored
+//  - Each derived element fetches its source separately, i.e. a source shared by N variants is fetched N times
+//     (use a 'fetch' fxn that shares the decoded audio, e.g. via render/cache.h)
+//  - The transforms are applied in this order: sub-range, reverse, pitch
+typedef struct {
+   void      *source_user_data;   // source audio (resolved like element user_data, i.e. via 'fetch' or pointer to float frames)
+   size_t     source_num_frames;
+   size_t     start;              // first source frame of the sub-range
+   size_t     num_frames;         // number of source frames (0=until the end of the source)
+   float32_t  gain;               // linear gain (applied after normalization)
+   float32_t  pitch;              // playback rate (1=original, 2=one octave up), linear interpolation
+   uint32_t   flags;              // SC_DERIVED_xxx
+} samplechain_derived_t;
+
+// Resolve element user_data to a derived element descriptor
+//  - Returns NULL for regular elements
+typedef const samplechain_derived_t *(*samplechain_derived_fxn_t) (void *_fetchCtx, void *_userData);
+
+// Initialize derived element descriptor (whole source, no transform)
+void samplechain_derived_init (samplechain_derived_t *_derived, void *_sourceUserData, size_t _sourceNumFrames);
+
+// Calculate the number of sample frames of a derived element
+//  - Pass the result to add() (the layout sizes derived elements from their source)
+size_t samplechain_derived_calc_num_frames (const samplechain_derived_t *_derived);
+
+
+typedef struct {
+   samplechain_fetch_fxn_t   fetch;               // NULL=user_data points to the element's interleaved float sample frames
+   void                     *fetch_ctx;
+   samplechain_release_fxn_t release;             // NULL=fetched audio does not need to be released
+   samplechain_derived_fxn_t derived;             // NULL=no derived elements
+   uint32_t                  normalize_mode;      // SC_NORMALIZE_xxx (see analysis/loudness.h)
+   float32_t                 normalize_level_db;  // target peak / RMS level (dBFS)
+   const struct samplechain_metadata_s *metadata; // NULL=analyze elements while rendering (see analysis/metadata.h)
+   uint32_t                  num_threads;         // 0=one thread per CPU core
+} samplechain_render_params_t;
+
+
+// Initialize render parameters with default values (no normalization)
+void samplechain_render_init_params (samplechain_render_params_t *_params);
+
+// Render sample chain to interleaved signed 16bit sample frames
+//  - Requires that 'calc' has been called and that "bytes_per_sample" is 2
+//  - The number of channels is determined by the "num_channels" parameter
+//  - 'retFrames' must provide room for at least query_total_size() frames ('maxFrames')
+//  - Elements are resolved, analyzed and copied in parallel. Normalization gain is
+//     applied while converting the element audio into its chain region
+//  - Elements with NULL user_data are rendered as silence
+//  - Derived elements (see samplechain_derived_t) fetch their source audio and transform it on the fly.
+//     Normalization analyzes the source sub-range
+//  - The normalization gain is calculated from the element's 'metadata' (when its user_data still matches),
+//     i.e. the element audio is only read once (while converting it)
+//  - Fetched elements are released (see samplechain_render_params_t) before the function returns
+//  - Returns false if the output is invalid or an element could not be fetched
+bool_t samplechain_render (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                           const samplechain_render_params_t *_params,
+                           int16_t *_retFrames, size_t _maxFrames
+                           );
+
+
+// Opaque block-wise render stream
+typedef struct samplechain_render_stream_s samplechain_render_stream_t;
+
+// Open a render stream that renders the chain block by block (bounded memory)
+//  - Same requirements as samplechain_render()
+//  - Resolves all elements (and calculates the normalization gains) up front
+//  - Returns NULL if the output is invalid or an element could not be fetched
+samplechain_render_stream_t *samplechain_render_stream_open (const samplechain_algorithm_t *_alg, samplechain_t _sc,
+                                                             const samplechain_render_params_t *_params
+                                                             );
+
+// Render the next (up to) 'maxFrames' chain frames
+//  - Returns the number of frames written to 'retFrames' (0 at the end of the chain)
+size_t samplechain_render_stream_read (samplechain_render_stream_t *_stream, int16_t *_retFrames, size_t _maxFrames);
+
+// Close render stream
+//  - Releases the fetched elements
+void samplechain_render_stream_close (samplechain_render_stream_t *_stream);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_RENDER_H_INCLUDED
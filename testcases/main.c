@@ -23,7 +23,7 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 23Mar2016, 25Mar2016
+ * ---- changed: 23Mar2016, 25Mar2016, 19Oct2026
  * ----
  * ----
  */
@@ -33,6 +33,25 @@
 
 extern void test_bsp_varichain (void);
 extern void test_bsp_samplechain (void);
+extern void test_bsp_spanchain (void);
+extern void test_onset (void);
+extern void test_render (void);
+extern void test_dedup (void);
+extern void test_sds (void);
+extern void test_wav (void);
+extern void test_audition (void);
+extern void test_profile (void);
+extern void test_add (void);
+extern void test_sched (void);
+extern void test_cache (void);
+extern void test_diff (void);
+extern void test_overview (void);
+extern void test_sink (void);
+extern void test_auto (void);
+extern void test_archive (void);
+extern void test_daemon (void);
+extern void test_kernels (void);
+extern void test_metadata (void);
 
 
 int main(int argc, char**argv) {
@@ -41,5 +60,43 @@ int main(int argc, char**argv) {
 
    test_bsp_samplechain();
 
+   test_bsp_spanchain();
+
+   test_onset();
+
+   test_render();
+
+   test_dedup();
+
+   test_sds();
+
+   test_wav();
+
+   test_audition();
+
+   test_profile();
+
+   test_add();
+
+   test_sched();
+
+   test_cache();
+
+   test_diff();
+
+   test_overview();
+
+   test_sink();
+
+   test_auto();
+
+   test_archive();
+
+   test_daemon();
+
+   test_kernels();
+
+   test_metadata();
+
    return 0;
 }
@@ -0,0 +1,129 @@
+/* ----
+ * ---- file   : test_add.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/thread.h"
+
+#define NUM_ELEMENTS  40
+
+
+typedef struct {
+   samplechain_algorithm_t *alg;
+   samplechain_t            sc;
+} add_ctx_t;
+
+
+static size_t loc_get_element_size(uint32_t _idx) {
+   return 1000u + ((_idx * 7919u) % 5000u);
+}
+
+// Decoder thread: add element as soon as its size is known
+static void loc_add_job(void *_ctx, uint32_t _jobIdx) {
+   add_ctx_t *ctx = (add_ctx_t*)_ctx;
+   uint32_t idx = (NUM_ELEMENTS - 1u) - _jobIdx;  // (note) jobs finish in reverse order
+
+   ctx->alg->add_with_key(ctx->sc, loc_get_element_size(idx), NULL, idx);
+}
+
+static uint32_t loc_test_algorithm(uint32_t _algIdx) {
+   samplechain_algorithm_t alg;
+   samplechain_t scRef;
+   add_ctx_t ctx;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+
+   samplechain_select_algorithm(_algIdx, &alg);
+
+   // Reference: sequential add in key order
+   alg.init(&scRef, 120);
+   alg.set_parameter_i(scRef, "chain_size", NUM_ELEMENTS);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      alg.add(scRef, loc_get_element_size(elementIdx), NULL);
+   }
+
+   alg.calc(scRef);
+
+   // Concurrent add with ordering keys
+   ctx.alg = &alg;
+   alg.init(&ctx.sc, 120);
+   alg.set_parameter_i(ctx.sc, "chain_size", NUM_ELEMENTS);
+
+   sc_parallel_for(NUM_ELEMENTS, &loc_add_job, &ctx, 8);
+
+   numErrors += (NUM_ELEMENTS != alg.query_num_elements(ctx.sc));
+
+   alg.calc(ctx.sc);
+
+   numErrors += (alg.query_total_size(scRef) != alg.query_total_size(ctx.sc));
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      numErrors += (loc_get_element_size(elementIdx) != alg.query_element_original_size(ctx.sc, elementIdx));
+      numErrors += (alg.query_element_offset(scRef, elementIdx) != alg.query_element_offset(ctx.sc, elementIdx));
+   }
+
+   alg.exit(&ctx.sc);
+   alg.exit(&scRef);
+
+   // Duplicates are remapped to the first element of their group in the final order
+   alg.init(&ctx.sc, 120);
+   alg.add_with_key(ctx.sc, 3000, NULL, 2);
+   alg.add_with_key(ctx.sc, 2000, NULL, 1);
+   alg.add_with_key(ctx.sc, 2000, NULL, 0);
+   alg.set_element_alias(ctx.sc, 2, 1);
+   alg.set_parameter_i(ctx.sc, "chain_size", 2);
+   alg.calc(ctx.sc);
+
+   numErrors += (3000 != alg.query_element_original_size(ctx.sc, 2));
+   numErrors += (alg.query_element_offset(ctx.sc, 0) != alg.query_element_offset(ctx.sc, 1));
+   numErrors += (alg.query_element_offset(ctx.sc, 0) == alg.query_element_offset(ctx.sc, 2));
+
+   alg.exit(&ctx.sc);
+
+   return numErrors;
+}
+
+void test_add(void) {
+   uint32_t numErrors = loc_test_algorithm(0) + loc_test_algorithm(1);
+
+   printf("[add] concurrent add: %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_add: FAILED\n");
+   }
+}
@@ -0,0 +1,278 @@
+/* ----
+ * ---- file   : test_archive.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../io/archive.h"
+
+#define NUM_ELEMENTS  6
+#define BLOCK_FRAMES  1024u
+#define TMP_PATHNAME  "test_archive.tmp.sca"
+
+
+// Compare the archive contents with the chain rendered into memory
+//  - Returns the number of mismatches
+static uint32_t loc_verify_archive(samplechain_algorithm_t *_alg, samplechain_t _sc, const int16_t *_expected, size_t _numFrames, size_t *_retNumBytes) {
+   uint32_t ret = 0;
+   samplechain_archive_t *ar = samplechain_archive_open(TMP_PATHNAME);
+   samplechain_archive_info_t info;
+   size_t offsets[NUM_ELEMENTS + 1];
+   size_t arOffsets[NUM_ELEMENTS + 1];
+   uint32_t sourceIndices[NUM_ELEMENTS + 1];
+   uint32_t arSourceIndices[NUM_ELEMENTS + 1];
+   samplechain_layout_t layout;
+   int16_t *frames = malloc(sizeof(int16_t) * 2u * (_numFrames + 1u));
+   uint32_t n;
+   int32_t value;
+
+   memset(&layout, 0, sizeof(layout));
+   layout.offsets        = offsets;
+   layout.source_indices = sourceIndices;
+   n = _alg->query_layout(_sc, &layout, NUM_ELEMENTS + 1);
+
+   if(NULL == ar)
+   {
+      ret++;
+   }
+   else
+   {
+      size_t numRead = 0;
+
+      samplechain_archive_get_info(ar, &info);
+
+      if( (2u != info.num_channels) || (44100u != info.sample_rate) || (_numFrames != info.num_frames) ||
+          (BLOCK_FRAMES != info.block_frames) || (n != info.num_elements) ||
+          (0 != strcmp(info.algorithm_name, _alg->query_algorithm_name()))
+          )
+      {
+         ret++;
+      }
+
+      // Layout / parameters
+      layout.offsets        = arOffsets;
+      layout.source_indices = arSourceIndices;
+
+      if( (n != samplechain_archive_get_layout(ar, &layout, NUM_ELEMENTS + 1)) ||
+          (0 != memcmp(offsets, arOffsets, sizeof(size_t) * n)) ||
+          (0 != memcmp(sourceIndices, arSourceIndices, sizeof(uint32_t) * n)) ||
+          !samplechain_archive_get_parameter_i(ar, "num_channels", &value) || (2 != value) ||
+          samplechain_archive_get_parameter_i(ar, "no_such_param", &value)
+          )
+      {
+         ret++;
+      }
+
+      // Sequential read (odd read sizes cross the block boundaries)
+      for(;;)
+      {
+         size_t num = samplechain_archive_read(ar, frames + (2u * numRead), 777u);
+
+         if(0u == num)
+         {
+            break;
+         }
+
+         numRead += num;
+      }
+
+      if((numRead != _numFrames) || (0 != memcmp(frames, _expected, sizeof(int16_t) * 2u * _numFrames)))
+      {
+         ret++;
+      }
+
+      // Random access
+      if( (0u == info.num_blocks) ||
+          (BLOCK_FRAMES != samplechain_archive_decode_block(ar, info.num_blocks / 2u, frames)) ||
+          (0 != memcmp(frames, _expected + (2u * BLOCK_FRAMES * (info.num_blocks / 2u)), sizeof(int16_t) * 2u * BLOCK_FRAMES)) ||
+          (0u != samplechain_archive_decode_block(ar, info.num_blocks, frames))
+          )
+      {
+         ret++;
+      }
+
+      *_retNumBytes = info.num_bytes;
+
+      samplechain_archive_close(ar);
+   }
+
+   free(frames);
+
+   return ret;
+}
+
+// Flip a byte in the last block and check that the checksum mismatch is detected
+static uint32_t loc_test_corrupt(void) {
+   uint32_t ret = 0;
+   samplechain_archive_info_t info;
+   samplechain_archive_t *ar;
+   FILE *fh = fopen(TMP_PATHNAME, "r+b");
+   int16_t *frames = malloc(sizeof(int16_t) * 2u * BLOCK_FRAMES);
+
+   if(NULL != fh)
+   {
+      int c;
+
+      fseek(fh, -2, SEEK_END);
+      c = fgetc(fh);
+      fseek(fh, -2, SEEK_END);
+      fputc(c ^ 0x10, fh);
+      fclose(fh);
+   }
+
+   ar = samplechain_archive_open(TMP_PATHNAME);
+
+   if((NULL == fh) || (NULL == ar))
+   {
+      ret++;
+   }
+   else
+   {
+      samplechain_archive_get_info(ar, &info);
+
+      if( (0u != samplechain_archive_decode_block(ar, info.num_blocks - 1u, frames)) ||
+          (0u == samplechain_archive_decode_block(ar, 0u, frames))
+          )
+      {
+         ret++;
+      }
+
+      samplechain_archive_close(ar);
+   }
+
+   free(frames);
+
+   return ret;
+}
+
+void test_archive(void) {
+
+   static const size_t sizes[NUM_ELEMENTS] = { 3000, 12000, 700, 12000, 5000, 9000 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_render_params_t params;
+   samplechain_t sc;
+   int16_t *expected;
+   size_t numFrames;
+   size_t numBytes = 0;
+   uint32_t numErrors = 0;
+   uint32_t elementIdx;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "num_channels", 2);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * 2u * sizes[elementIdx]);
+
+      // Decaying tone + some noise
+      for(i = 0; i < (2u * sizes[elementIdx]); i++)
+      {
+         elementFrames[elementIdx][i] =
+            sinf(i * 0.01f * (elementIdx + 1u)) * 0.5f * expf(-(float32_t)i / sizes[elementIdx]) +
+            ((rand() & 255) - 128) * (1.0f / 32768.0f);
+      }
+
+      alg.add(sc, sizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   // (note) element #3 shares the chain region of element #1
+   alg.set_element_alias(sc, 3, 1);
+
+   alg.calc(sc);
+
+   numFrames = alg.query_total_size(sc);
+   expected = malloc(sizeof(int16_t) * 2u * numFrames);
+
+   samplechain_render_init_params(&params);
+   params.num_threads = 4;
+
+   if(!samplechain_render(&alg, sc, &params, expected, numFrames))
+   {
+      printf("[---] test_archive: FAILED (render failed)\n");
+   }
+   else
+   {
+      // Rendered via stream
+      if(!samplechain_archive_save(TMP_PATHNAME, &alg, sc, &params, 44100u, BLOCK_FRAMES))
+      {
+         numErrors++;
+      }
+      else
+      {
+         numErrors += loc_verify_archive(&alg, sc, expected, numFrames, &numBytes);
+      }
+
+      // Pre-rendered frames
+      if(!samplechain_archive_save_frames(TMP_PATHNAME, &alg, sc, expected, 44100u, BLOCK_FRAMES))
+      {
+         numErrors++;
+      }
+      else
+      {
+         numErrors += loc_verify_archive(&alg, sc, expected, numFrames, &numBytes);
+         numErrors += loc_test_corrupt();
+      }
+
+      printf("[arc] compressed %u sample frames (%u bytes) to %u bytes (%.1f%%), %u errors\n",
+             (uint32_t)numFrames,
+             (uint32_t)(numFrames * 2u * sizeof(int16_t)),
+             (uint32_t)numBytes,
+             (100.0 * numBytes) / (numFrames * 2u * sizeof(int16_t)),
+             numErrors
+             );
+
+      if(numErrors > 0)
+      {
+         printf("[---] test_archive: FAILED\n");
+      }
+   }
+
+   remove(TMP_PATHNAME);
+
+   free(expected);
+
+   alg.exit(&sc);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+}
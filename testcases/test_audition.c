@@ -0,0 +1,190 @@
+/* ----
+ * ---- file   : test_audition.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../play/audition.h"
+
+#define NUM_ELEMENTS  3
+#define BLOCK_SIZE    64
+#define NUM_OUT_CH    2
+
+
+// Play until all voices have finished, compare left output channel with the chain region
+//  - Returns number of mismatching frames
+static uint32_t loc_play_and_compare(samplechain_audition_t *_a, const int16_t *_expected, size_t _numFrames) {
+   float32_t out[BLOCK_SIZE * NUM_OUT_CH];
+   uint32_t numErrors = 0;
+   size_t pos = 0;
+
+   do
+   {
+      uint32_t i;
+
+      samplechain_audition_process(_a, out, BLOCK_SIZE);
+
+      for(i = 0; i < BLOCK_SIZE; i++, pos++)
+      {
+         float32_t expected = (pos < _numFrames) ? (_expected[pos] / 32768.0f) : 0.0f;
+
+         if((fabsf(out[i * NUM_OUT_CH] - expected) > 1e-6f) || (out[i * NUM_OUT_CH] != out[i * NUM_OUT_CH + 1]))
+         {
+            numErrors++;
+         }
+      }
+   }
+   while(samplechain_audition_get_num_active_voices(_a) > 0u);
+
+   return numErrors + (pos < _numFrames);
+}
+
+void test_audition(void) {
+
+   static const size_t elementSizes[NUM_ELEMENTS] = { 1234, 3001, 777 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   size_t offsets[NUM_ELEMENTS];
+   size_t origSizes[NUM_ELEMENTS];
+   float32_t sta[NUM_ELEMENTS];
+   samplechain_layout_t layout;
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t renderParams;
+   samplechain_audition_t *a;
+   samplechain_audition_chain_t *chain;
+   int16_t *rendered;
+   size_t totalSz;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+   uint32_t numQueued = 0;
+   float32_t scratch[BLOCK_SIZE * NUM_OUT_CH];
+
+   samplechain_select_algorithm(1, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 100);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * elementSizes[elementIdx]);
+
+      for(i = 0; i < elementSizes[elementIdx]; i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * 0.03f * (elementIdx + 1)) * 0.9f;
+      }
+
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   alg.set_parameter_i(sc, "chain_size", NUM_ELEMENTS);
+
+   alg.calc(sc);
+
+   totalSz  = alg.query_total_size(sc);
+   rendered = malloc(sizeof(int16_t) * totalSz);
+
+   samplechain_render_init_params(&renderParams);
+   samplechain_render(&alg, sc, &renderParams, rendered, totalSz);
+
+   memset(&layout, 0, sizeof(layout));
+   layout.offsets    = offsets;
+   layout.orig_sizes = origSizes;
+   layout.sta        = sta;
+   alg.query_layout(sc, &layout, NUM_ELEMENTS);
+
+   a     = samplechain_audition_create(4, NUM_OUT_CH);
+   chain = samplechain_audition_chain_create(&alg, sc, rendered, totalSz);
+
+   samplechain_audition_set_chain(a, chain);
+
+   // Trigger by STA (slightly after the slice start)
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      samplechain_audition_trigger_sta(a, sta[elementIdx] + 0.5f, 1.0f);
+      numErrors += loc_play_and_compare(a, rendered + offsets[elementIdx], origSizes[elementIdx]);
+   }
+
+   // Trigger by element index
+   samplechain_audition_trigger(a, 1, 1.0f);
+   numErrors += loc_play_and_compare(a, rendered + offsets[1], origSizes[1]);
+
+   // Queue overflow must not block (commands are dropped)
+   while(samplechain_audition_trigger(a, 0, 0.1f))
+   {
+      numQueued++;
+   }
+
+   if(SC_AUDITION_QUEUE_SIZE != numQueued)
+   {
+      numErrors++;
+   }
+
+   samplechain_audition_process(a, scratch, BLOCK_SIZE);
+   samplechain_audition_stop_all(a);
+   samplechain_audition_process(a, scratch, BLOCK_SIZE);
+
+   if(0u != samplechain_audition_get_num_active_voices(a))
+   {
+      numErrors++;
+   }
+
+   // Replace chain while a voice is queued (voices of the previous chain are stopped)
+   samplechain_audition_trigger(a, 2, 1.0f);
+   samplechain_audition_set_chain(a, samplechain_audition_chain_create(&alg, sc, rendered, totalSz));
+   samplechain_audition_trigger(a, 0, 1.0f);
+   numErrors += loc_play_and_compare(a, rendered + offsets[0], origSizes[0]);
+   samplechain_audition_collect(a);
+
+   printf("[aud] %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_audition: FAILED\n");
+   }
+
+   samplechain_audition_destroy(a);
+
+   free(rendered);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
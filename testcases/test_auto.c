@@ -0,0 +1,200 @@
+/* ----
+ * ---- file   : test_auto.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+
+#define NUM_ELEMENTS  11
+
+
+static const size_t loc_sizes[NUM_ELEMENTS] = { 16980, 5878, 19156, 17850, 2395, 6531, 7401, 7619, 16980, 21551, 2830 };
+
+
+static void loc_init_chain(samplechain_algorithm_t *_alg, samplechain_t *_retSc, int32_t _chainSize) {
+   uint32_t elementIdx;
+
+   _alg->init(_retSc, 120);
+
+   _alg->set_parameter_i(*_retSc, "extra_padding", 2000);
+   _alg->set_parameter_i(*_retSc, "min_padding",   1000);
+   _alg->set_parameter_i(*_retSc, "chain_size",    _chainSize);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      _alg->add(*_retSc, loc_sizes[elementIdx], (void*)&loc_sizes[elementIdx]);
+   }
+
+   // (note) element #8 is a duplicate of element #0
+   _alg->set_element_alias(*_retSc, 8, 0);
+}
+
+// Returns the number of layout differences between the auto chain and a direct run of algorithm 'algIdx'
+static uint32_t loc_compare_layout(samplechain_algorithm_t *_autoAlg, samplechain_t _autoSc, uint32_t _algIdx, int32_t _chainSize) {
+   uint32_t ret = 0;
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   size_t offsetsA[128];
+   size_t offsetsB[128];
+   samplechain_layout_t layout;
+   uint32_t numA;
+   uint32_t numB;
+   uint32_t elementIdx;
+
+   samplechain_select_algorithm(_algIdx, &alg);
+
+   loc_init_chain(&alg, &sc, _chainSize);
+
+   alg.calc(sc);
+
+   memset(&layout, 0, sizeof(layout));
+
+   layout.offsets = offsetsA;
+   numA = _autoAlg->query_layout(_autoSc, &layout, 128);
+
+   layout.offsets = offsetsB;
+   numB = alg.query_layout(sc, &layout, 128);
+
+   if( (numA != numB) ||
+       (_autoAlg->query_total_size(_autoSc) != alg.query_total_size(sc)) ||
+       (_autoAlg->query_num_elements(_autoSc) != alg.query_num_elements(sc))
+       )
+   {
+      ret++;
+   }
+   else
+   {
+      for(elementIdx = 0; elementIdx < numA; elementIdx++)
+      {
+         ret += (offsetsA[elementIdx] != offsetsB[elementIdx]);
+         ret += (_autoAlg->query_element_user_data(_autoSc, elementIdx) != alg.query_element_user_data(sc, elementIdx));
+      }
+   }
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+static size_t loc_calc_total_size(uint32_t _algIdx, int32_t _chainSize) {
+   size_t ret;
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+
+   samplechain_select_algorithm(_algIdx, &alg);
+
+   loc_init_chain(&alg, &sc, _chainSize);
+
+   alg.calc(sc);
+
+   ret = alg.query_total_size(sc);
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+static uint32_t loc_test_objective(int32_t _objective, int32_t _chainSize, int32_t *_retSelIdx) {
+   uint32_t ret = 0;
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   int32_t selIdx = -1;
+
+   samplechain_select_auto(&alg);
+
+   loc_init_chain(&alg, &sc, _chainSize);
+
+   if(!alg.set_parameter_i(sc, "objective", _objective))
+   {
+      ret++;
+   }
+
+   alg.calc(sc);
+
+   alg.get_parameter_i(sc, "selected_algorithm", &selIdx);
+
+   if((selIdx < 0) || (selIdx >= (int32_t)samplechain_get_num_algorithms()))
+   {
+      ret++;
+   }
+   else
+   {
+      ret += loc_compare_layout(&alg, sc, (uint32_t)selIdx, _chainSize);
+   }
+
+   *_retSelIdx = selIdx;
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+
+void test_auto(void) {
+   uint32_t numErrors = 0;
+   int32_t selIdx;
+   uint32_t algIdx;
+
+   // Smallest total size
+   numErrors += loc_test_objective(SC_AUTO_OBJECTIVE_MIN_SIZE, 12, &selIdx);
+
+   for(algIdx = 0; (selIdx >= 0) && (algIdx < samplechain_get_num_algorithms()); algIdx++)
+   {
+      if(loc_calc_total_size(algIdx, 12) < loc_calc_total_size((uint32_t)selIdx, 12))
+      {
+         numErrors++;
+      }
+   }
+
+   printf("[aut] min size: selected algorithm %d\n", selIdx);
+
+   // Evenly dialable STA (fixed-size slices)
+   numErrors += loc_test_objective(SC_AUTO_OBJECTIVE_EVEN_STA, 12, &selIdx);
+
+   printf("[aut] even STA: selected algorithm %d\n", selIdx);
+
+   numErrors += (1 != selIdx);
+
+   // Largest minimum padding
+   numErrors += loc_test_objective(SC_AUTO_OBJECTIVE_MAX_PADDING, 12, &selIdx);
+
+   printf("[aut] max padding: selected algorithm %d\n", selIdx);
+
+   // (note) spanchain keeps the same minimum padding as the fixed-size slices at a smaller total size
+   numErrors += (2 != selIdx);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_auto: FAILED (%u errors)\n", numErrors);
+   }
+}
@@ -23,7 +23,7 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 25Mar2016
+ * ---- changed: 25Mar2016, 19Oct2026
  * ----
  * ----
  */
@@ -32,12 +32,30 @@
 #include <stdint.h>
 
 #include "../algorithm_interface_proposal.h"
+#include "test_util.h"
+
+
+static void loc_add_elements(samplechain_algorithm_t *_alg, samplechain_t _sc) {
+   _alg->add(_sc, 16980, NULL/*userData*/);
+   _alg->add(_sc,  5878, NULL/*userData*/);
+   _alg->add(_sc, 19156, NULL/*userData*/);
+   _alg->add(_sc, 17850, NULL/*userData*/);
+   _alg->add(_sc,  2395, NULL/*userData*/);
+   _alg->add(_sc,  6531, NULL/*userData*/);
+   _alg->add(_sc,  7401, NULL/*userData*/);
+   _alg->add(_sc,  7619, NULL/*userData*/);
+   _alg->add(_sc, 16980, NULL/*userData*/);
+   _alg->add(_sc, 21551, NULL/*userData*/);
+   _alg->add(_sc,  2830, NULL/*userData*/);
+}
 
 
 void test_bsp_samplechain(void) {
 
    samplechain_algorithm_t alg;
    samplechain_t sc;
+   uint32_t numErrors = 0;
+   uint32_t budgetIdx;
 
    samplechain_select_algorithm(1, &alg);
 
@@ -64,6 +82,33 @@ void test_bsp_samplechain(void) {
 
    printf("total samplechain size is %u sample frames\n", alg.query_total_size(sc));
 
+   numErrors += (282612u != alg.query_total_size(sc));
+   numErrors += test_util_verify_layout(&alg, sc);
+
    alg.exit(&sc);
 
+   // Budget (fits / does not fit)
+   for(budgetIdx = 0; budgetIdx < 2; budgetIdx++)
+   {
+      static const int32_t maxTotalBytes[2]           = { 1100000, 500000 };
+      static const size_t  expectedTotalSizes[2]      = {  274992,      0 };
+      static const size_t  expectedBytesOverBudget[2] = {       0, 534496 };
+
+      alg.init(&sc, 120);
+
+      alg.set_parameter_i(sc, "extra_padding", 2000);
+
+      loc_add_elements(&alg, sc);
+
+      alg.set_parameter_i(sc, "chain_size",  (int32_t)alg.query_num_elements(sc));
+
+      numErrors += test_util_budget(&alg, sc, maxTotalBytes[budgetIdx], expectedTotalSizes[budgetIdx], expectedBytesOverBudget[budgetIdx]);
+
+      alg.exit(&sc);
+   }
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_bsp_samplechain: FAILED (%u errors)\n", numErrors);
+   }
 }
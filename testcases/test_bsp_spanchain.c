@@ -0,0 +1,211 @@
+/* ----
+ * ---- file   : test_bsp_spanchain.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "test_util.h"
+
+#define NUM_HITS  15
+
+
+// One long loop followed by short hits
+static void loc_add_loop_kit(samplechain_algorithm_t *_alg, samplechain_t _sc) {
+   uint32_t hitIdx;
+
+   _alg->add(_sc, 200000, NULL/*userData*/);
+
+   for(hitIdx = 0; hitIdx < NUM_HITS; hitIdx++)
+   {
+      _alg->add(_sc, 2000 + (hitIdx * 317u) % 4000u, NULL/*userData*/);
+   }
+}
+
+// Check that all chain regions are aligned to the grid and keep the min. padding
+//  - Returns the number of errors
+static uint32_t loc_verify_grid(samplechain_algorithm_t *_alg, samplechain_t _sc, size_t _extraPadding) {
+   uint32_t ret = 0;
+   size_t offsets[121];
+   size_t totalSizes[121];
+   size_t padSizes[121];
+   float32_t sta[121];
+   uint32_t sourceIndices[121];
+   samplechain_layout_t layout;
+   uint32_t numElements;
+   uint32_t elementIdx;
+   int32_t numCells = 0;
+   size_t totalSz = _alg->query_total_size(_sc);
+   size_t cellSz;
+   size_t nextOffset = 0;
+
+   layout.offsets        = offsets;
+   layout.total_sizes    = totalSizes;
+   layout.orig_sizes     = NULL;
+   layout.pad_sizes      = padSizes;
+   layout.sta            = sta;
+   layout.end            = NULL;
+   layout.source_indices = sourceIndices;
+
+   numElements = _alg->query_layout(_sc, &layout, 121);
+
+   if(!_alg->get_parameter_i(_sc, "num_cells", &numCells) || (numCells <= 0) || (0u != (120u % (uint32_t)numCells)) || (0u == numElements))
+   {
+      numElements = 0;
+      ret++;
+   }
+   else
+   {
+      cellSz = totalSz / (uint32_t)numCells;
+
+      if((cellSz * (uint32_t)numCells) != totalSz)
+      {
+         ret++;
+      }
+   }
+
+   for(elementIdx = 0; elementIdx < numElements; elementIdx++)
+   {
+      float32_t staStep = 120.0f / numCells;
+
+      // (note) aliases share the region of their source element
+      if(sourceIndices[elementIdx] == elementIdx)
+      {
+         if( (offsets[elementIdx] != nextOffset) ||
+             (0u != (offsets[elementIdx] % cellSz)) ||
+             (0u != (totalSizes[elementIdx] % cellSz)) ||
+             (fabsf((sta[elementIdx] / staStep) - floorf((sta[elementIdx] / staStep) + 0.5f)) > 0.001f)
+             )
+         {
+            printf("[---] element #%u: offset=%u size=%u STA=%f is not on the grid (cellSz=%u)\n",
+                   elementIdx, (uint32_t)offsets[elementIdx], (uint32_t)totalSizes[elementIdx], sta[elementIdx], (uint32_t)cellSz
+                   );
+            ret++;
+         }
+
+         // (note) the trailing pad element has no waveform
+         if((padSizes[elementIdx] < _extraPadding) && (padSizes[elementIdx] != totalSizes[elementIdx]))
+         {
+            printf("[---] element #%u: padding %u < extra_padding\n", elementIdx, (uint32_t)padSizes[elementIdx]);
+            ret++;
+         }
+
+         nextOffset = offsets[elementIdx] + totalSizes[elementIdx];
+      }
+   }
+
+   if(nextOffset != totalSz)
+   {
+      ret++;
+   }
+
+   return ret;
+}
+
+void test_bsp_spanchain(void) {
+
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   size_t fixedSz;
+   size_t spanSz;
+   uint32_t numErrors;
+   uint32_t budgetIdx;
+
+   // Fixed-size slices (bsp_samplechain)
+   samplechain_select_algorithm(1, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 2000);
+
+   loc_add_loop_kit(&alg, sc);
+
+   alg.set_parameter_i(sc, "chain_size",  (int32_t)alg.query_num_elements(sc));
+
+   alg.calc(sc);
+
+   fixedSz = alg.query_total_size(sc);
+
+   alg.exit(&sc);
+
+   // Variable-span grid
+   samplechain_select_algorithm(2, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 2000);
+
+   loc_add_loop_kit(&alg, sc);
+
+   // (note) #3 is a duplicate of #1
+   alg.set_element_alias(sc, 3, 1);
+
+   alg.calc(sc);
+
+   spanSz = alg.query_total_size(sc);
+
+   numErrors = loc_verify_grid(&alg, sc, 2000u);
+   numErrors += test_util_verify_layout(&alg, sc);
+
+   printf("total spanchain size is %u sample frames (%u with fixed-size slices), %u errors\n",
+          (uint32_t)spanSz,
+          (uint32_t)fixedSz,
+          numErrors
+          );
+
+   numErrors += (299280u != spanSz);
+   numErrors += (4040000u != fixedSz);
+
+   alg.exit(&sc);
+
+   // Budget (fits / does not fit)
+   for(budgetIdx = 0; budgetIdx < 2; budgetIdx++)
+   {
+      static const int32_t maxTotalBytes[2]           = { 1150000, 1000000 };
+      static const size_t  expectedTotalSizes[2]      = {  287400,       0 };
+      static const size_t  expectedBytesOverBudget[2] = {       0,   91040 };
+
+      alg.init(&sc, 120);
+
+      alg.set_parameter_i(sc, "extra_padding", 2000);
+
+      loc_add_loop_kit(&alg, sc);
+
+      numErrors += test_util_budget(&alg, sc, maxTotalBytes[budgetIdx], expectedTotalSizes[budgetIdx], expectedBytesOverBudget[budgetIdx]);
+
+      alg.exit(&sc);
+   }
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_bsp_spanchain: FAILED (%u errors)\n", numErrors);
+   }
+}
@@ -23,21 +23,264 @@
  * ----
  * ---- info   : This is part of the "libsamplechain" package.
  * ----
- * ---- changed: 23Mar2016
+ * ---- changed: 23Mar2016, 19Oct2026
  * ----
  * ----
  */
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+#include <math.h>
 
 #include "../algorithm_interface_proposal.h"
+#include "test_util.h"
+
+
+static void loc_print_layout(samplechain_algorithm_t *_alg, samplechain_t _sc) {
+   size_t offsets[121];
+   size_t totalSizes[121];
+   size_t origSizes[121];
+   size_t padSizes[121];
+   float32_t sta[121];
+   float32_t end[121];
+   uint32_t sourceIndices[121];
+   samplechain_layout_t layout;
+   uint32_t numElements;
+   uint32_t elementIdx;
+
+   layout.offsets        = offsets;
+   layout.total_sizes    = totalSizes;
+   layout.orig_sizes     = origSizes;
+   layout.pad_sizes      = padSizes;
+   layout.sta            = sta;
+   layout.end            = end;
+   layout.source_indices = sourceIndices;
+
+   numElements = _alg->query_layout(_sc, &layout, 121);
+
+   for(elementIdx = 0; elementIdx < numElements; elementIdx++)
+   {
+      printf("[lay] #%3u src=%3u STA=%6.2f END=%6.2f offset=%8u totalSz=%8u origSz=%8u padSz=%8u\n",
+             elementIdx,
+             sourceIndices[elementIdx],
+             sta[elementIdx],
+             end[elementIdx],
+             (uint32_t)offsets[elementIdx],
+             (uint32_t)totalSizes[elementIdx],
+             (uint32_t)origSizes[elementIdx],
+             (uint32_t)padSizes[elementIdx]
+             );
+   }
+}
+
+static void loc_add_elements(samplechain_algorithm_t *_alg, samplechain_t _sc) {
+   _alg->add(_sc, 16980, NULL/*userData*/);
+   _alg->add(_sc,  5878, NULL/*userData*/);
+   _alg->add(_sc, 19156, NULL/*userData*/);
+   _alg->add(_sc, 17850, NULL/*userData*/);
+   _alg->add(_sc,  2395, NULL/*userData*/);
+   _alg->add(_sc,  6531, NULL/*userData*/);
+   _alg->add(_sc,  7401, NULL/*userData*/);
+   _alg->add(_sc,  7619, NULL/*userData*/);
+   _alg->add(_sc, 16980, NULL/*userData*/);
+   _alg->add(_sc, 21551, NULL/*userData*/);
+   _alg->add(_sc,  2830, NULL/*userData*/);
+}
+
+static size_t loc_calc_lead_silence_chain(bool_t _bUseLeadSilence, uint32_t *_retNumErrors) {
+
+   static const size_t sizes[11] = { 16980, 5878, 19156, 17850, 2395, 6531, 7401, 7619, 16980, 21551, 2830 };
+   static const int32_t leads[11] = {     0, 1500,   800,     0, 3000,  200, 1200,    0,  2500,   600,    0 };
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   size_t offsets[12];
+   size_t origSizes[12];
+   size_t padSizes[12];
+   float32_t sta[12];
+   samplechain_layout_t layout;
+   uint32_t numElements;
+   uint32_t elementIdx;
+   size_t ret;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 2000);
+   alg.set_parameter_i(sc, "min_padding",   1000);
+   alg.set_parameter_i(sc, "use_lead_silence", _bUseLeadSilence);
+
+   for(elementIdx = 0; elementIdx < 11; elementIdx++)
+   {
+      alg.add(sc, sizes[elementIdx], NULL/*userData*/);
+
+      if(!alg.set_element_attribute_i(sc, elementIdx, "lead_silence", leads[elementIdx]))
+      {
+         (*_retNumErrors)++;
+      }
+   }
+
+   alg.calc(sc);
+
+   ret = alg.query_total_size(sc);
+
+   layout.offsets        = offsets;
+   layout.total_sizes    = NULL;
+   layout.orig_sizes     = origSizes;
+   layout.pad_sizes      = padSizes;
+   layout.sta            = sta;
+   layout.end            = NULL;
+   layout.source_indices = NULL;
+
+   numElements = alg.query_layout(sc, &layout, 12);
+
+   for(elementIdx = 0; elementIdx < numElements; elementIdx++)
+   {
+      // Guard gap (padding + lead silence of the next element)
+      if((elementIdx + 1u) < 11u)
+      {
+         int32_t lead = _bUseLeadSilence ? leads[elementIdx + 1u] : 0;
+
+         if(((int32_t)padSizes[elementIdx] + lead) < 1000)
+         {
+            printf("[---] element #%u: guard gap %d < min_padding\n", elementIdx, (int32_t)padSizes[elementIdx] + lead);
+            (*_retNumErrors)++;
+         }
+      }
+
+      // STA grid
+      if(fabsf(sta[elementIdx] - floorf(sta[elementIdx] + 0.5f)) > 0.001f)
+      {
+         printf("[---] element #%u: STA %f is not on the slice grid\n", elementIdx, sta[elementIdx]);
+         (*_retNumErrors)++;
+      }
+   }
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+static void loc_test_lead_silence(void) {
+   uint32_t numErrors = 0;
+   size_t padOnlySz = loc_calc_lead_silence_chain(SC_FALSE, &numErrors);
+   size_t leadSz = loc_calc_lead_silence_chain(SC_TRUE, &numErrors);
+
+   printf("use_lead_silence: total samplechain size is %u sample frames (%u without)\n",
+          (uint32_t)leadSz,
+          (uint32_t)padOnlySz
+          );
+
+   if((0 != numErrors) || (leadSz >= padOnlySz))
+   {
+      printf("[---] test_bsp_varichain: lead silence FAILED (%u errors)\n", numErrors);
+   }
+}
+
+// Calculate chain (calc() if 'budgetUs' is < 0), store the element offsets in 'retOffsets'
+//  - Returns the total size (0 if a guard gap is smaller than min_padding)
+static size_t loc_calc_deadline_chain(int32_t _budgetUs, size_t *_retOffsets, bool_t *_retOptimal) {
+
+   static const size_t sizes[11] = { 16980, 5878, 19156, 17850, 2395, 6531, 7401, 7619, 16980, 21551, 2830 };
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   size_t padSizes[12];
+   uint32_t sourceIndices[12];
+   samplechain_layout_t layout;
+   uint32_t numElements;
+   uint32_t elementIdx;
+   size_t ret;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   // (note) zero nominal padding, i.e. the search has to increase the padding many times
+   alg.set_parameter_i(sc, "extra_padding", 0);
+   alg.set_parameter_i(sc, "min_padding",   5000);
+
+   for(elementIdx = 0; elementIdx < 11u; elementIdx++)
+   {
+      alg.add(sc, sizes[elementIdx], NULL/*userData*/);
+   }
+
+   if(_budgetUs < 0)
+   {
+      alg.calc(sc);
+      *_retOptimal = SC_TRUE;
+   }
+   else
+   {
+      *_retOptimal = alg.calc_with_deadline(sc, (uint32_t)_budgetUs);
+   }
+
+   ret = alg.query_total_size(sc);
+
+   layout.offsets        = _retOffsets;
+   layout.total_sizes    = NULL;
+   layout.orig_sizes     = NULL;
+   layout.pad_sizes      = padSizes;
+   layout.sta            = NULL;
+   layout.end            = NULL;
+   layout.source_indices = sourceIndices;
+
+   numElements = alg.query_layout(sc, &layout, 12);
+
+   for(elementIdx = 0; elementIdx < numElements; elementIdx++)
+   {
+      if((sourceIndices[elementIdx] == elementIdx) && (padSizes[elementIdx] < 5000u) && (elementIdx < 11u))
+      {
+         ret = 0;
+      }
+   }
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+static void loc_test_deadline(void) {
+   size_t optOffsets[12];
+   size_t offsets[12];
+   bool_t bOptimal;
+   size_t optSz = loc_calc_deadline_chain(-1, optOffsets, &bOptimal);
+   size_t sz = loc_calc_deadline_chain(10000000, offsets, &bOptimal);
+   uint32_t numErrors = 0;
+
+   // Sufficient budget: same result as calc()
+   if((0u == optSz) || (sz != optSz) || !bOptimal || (0 != memcmp(offsets, optOffsets, sizeof(offsets))))
+   {
+      numErrors++;
+   }
+
+   // No budget: first valid (fallback) layout
+   sz = loc_calc_deadline_chain(0, offsets, &bOptimal);
+
+   printf("calc_with_deadline: total samplechain size is %u sample frames (optimal=%d), %u with calc()\n",
+          (uint32_t)sz,
+          bOptimal,
+          (uint32_t)optSz
+          );
+
+   if((0u == sz) || (sz < optSz) || bOptimal)
+   {
+      numErrors++;
+   }
+
+   if(0 != numErrors)
+   {
+      printf("[---] test_bsp_varichain: deadline FAILED (%u errors)\n", numErrors);
+   }
+}
 
 
 void test_bsp_varichain(void) {
 
    samplechain_algorithm_t alg;
    samplechain_t sc;
+   uint32_t numErrors = 0;
+   uint32_t budgetIdx;
 
    samplechain_select_algorithm(0, &alg);
 
@@ -62,6 +305,38 @@ void test_bsp_varichain(void) {
 
    printf("total samplechain size is %u sample frames\n", alg.query_total_size(sc));
 
+   loc_print_layout(&alg, sc);
+
+   numErrors += (154920u != alg.query_total_size(sc));
+   numErrors += test_util_verify_layout(&alg, sc);
+
    alg.exit(&sc);
 
+   // Budget (fits / does not fit)
+   for(budgetIdx = 0; budgetIdx < 2; budgetIdx++)
+   {
+      static const int32_t maxTotalBytes[2]           = { 618000, 400000 };
+      static const size_t  expectedTotalSizes[2]      = { 154200,      0 };
+      static const size_t  expectedBytesOverBudget[2] = {      0, 144684 };
+
+      alg.init(&sc, 120);
+
+      alg.set_parameter_i(sc, "extra_padding", 2000);
+      alg.set_parameter_i(sc, "min_padding",   1000);
+
+      loc_add_elements(&alg, sc);
+
+      numErrors += test_util_budget(&alg, sc, maxTotalBytes[budgetIdx], expectedTotalSizes[budgetIdx], expectedBytesOverBudget[budgetIdx]);
+
+      alg.exit(&sc);
+   }
+
+   loc_test_lead_silence();
+
+   loc_test_deadline();
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_bsp_varichain: FAILED (%u errors)\n", numErrors);
+   }
 }
@@ -0,0 +1,249 @@
+/* ----
+ * ---- file   : test_cache.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../render/cache.h"
+#include "../util/thread.h"
+
+#define NUM_CHAIN_ELEMENTS  3
+#define NUM_ACQUIRE_JOBS    16
+
+
+typedef struct {
+   const char                *key;
+   samplechain_cache_entry_t *entry;
+} element_t;
+
+
+static uint32_t loc_num_loads;
+
+static size_t loc_get_num_frames(const char *_key) {
+   return 1000u + 100u * (size_t)(_key[0] - 'a');
+}
+
+static float32_t *loc_load(void *_loadCtx, const char *_key, uint32_t _numChannels, size_t *_retNumFrames) {
+   size_t numFrames = loc_get_num_frames(_key);
+   float32_t *ret = NULL;
+   (void)_loadCtx;
+
+   SC_ATOMIC_ADD(&loc_num_loads, 1u);
+
+   if(0 != strcmp(_key, "missing"))
+   {
+      ret = malloc(sizeof(float32_t) * numFrames * _numChannels);
+
+      if(NULL != ret)
+      {
+         size_t i;
+
+         for(i = 0; i < numFrames * _numChannels; i++)
+         {
+            ret[i] = (_key[0] - 'a') / 16.0f;
+         }
+
+         *_retNumFrames = numFrames;
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_fetch(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   element_t *el = (element_t*)_userData;
+   (void)_fetchCtx;
+   (void)_numFrames;
+
+   el->entry = samplechain_cache_acquire(el->key, 1u, 1u, &loc_load, NULL);
+   _retSource->frames = samplechain_cache_entry_get_frames(el->entry, &_retSource->num_frames);
+
+   return (NULL != _retSource->frames);
+}
+
+static void loc_release(void *_fetchCtx, void *_userData, const samplechain_source_t *_source) {
+   element_t *el = (element_t*)_userData;
+   (void)_fetchCtx;
+   (void)_source;
+
+   samplechain_cache_release(el->entry);
+   el->entry = NULL;
+}
+
+static void loc_acquire_job(void *_ctx, uint32_t _jobIdx) {
+   samplechain_cache_entry_t *entry = samplechain_cache_acquire("e", 1u, 1u, &loc_load, NULL);
+   size_t numFrames;
+   (void)_jobIdx;
+
+   if((NULL == samplechain_cache_entry_get_frames(entry, &numFrames)) || (loc_get_num_frames("e") != numFrames))
+   {
+      SC_ATOMIC_ADD((uint32_t*)_ctx, 1u);
+   }
+
+   samplechain_cache_release(entry);
+}
+
+// Render a chain whose elements are looked up in the cache (via user_data key)
+static uint32_t loc_render_chain(const char *const *_keys) {
+   element_t elements[NUM_CHAIN_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   int16_t *out;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+
+   samplechain_select_algorithm(0, &alg);
+   alg.init(&sc, 120);
+
+   for(elementIdx = 0; elementIdx < NUM_CHAIN_ELEMENTS; elementIdx++)
+   {
+      elements[elementIdx].key   = _keys[elementIdx];
+      elements[elementIdx].entry = NULL;
+      alg.add(sc, loc_get_num_frames(_keys[elementIdx]), &elements[elementIdx]);
+   }
+
+   alg.calc(sc);
+
+   samplechain_render_init_params(&params);
+   params.fetch   = &loc_fetch;
+   params.release = &loc_release;
+
+   out = malloc(sizeof(int16_t) * alg.query_total_size(sc));
+
+   numErrors += (NULL == out);
+
+   if(NULL != out)
+   {
+      numErrors += !samplechain_render(&alg, sc, &params, out, alg.query_total_size(sc));
+
+      for(elementIdx = 0; elementIdx < NUM_CHAIN_ELEMENTS; elementIdx++)
+      {
+         numErrors += (NULL != elements[elementIdx].entry);
+      }
+
+      free(out);
+   }
+
+   alg.exit(&sc);
+
+   return numErrors;
+}
+
+void test_cache(void) {
+   static const char *const keys1[NUM_CHAIN_ELEMENTS] = { "a", "b", "c" };
+   static const char *const keys2[NUM_CHAIN_ELEMENTS] = { "b", "c", "d" };
+   samplechain_cache_stats_t stats;
+   samplechain_cache_entry_t *entry;
+   samplechain_cache_entry_t *entry2;
+   size_t entrySz = sizeof(float32_t) * loc_get_num_frames("a");
+   uint64_t numEvictions;
+   uint64_t numStale;
+   uint32_t numErrors = 0;
+
+   samplechain_cache_clear();
+   samplechain_cache_get_stats(&stats);
+   numErrors += (0 != stats.num_entries);
+
+   // Shared elements are decoded once
+   loc_num_loads = 0;
+   numErrors += loc_render_chain(keys1);
+   numErrors += loc_render_chain(keys2);
+   numErrors += (4 != loc_num_loads);
+
+   samplechain_cache_get_stats(&stats);
+   numErrors += (4 != stats.num_entries);
+   numErrors += (0 != stats.num_pinned);
+
+   // Concurrent lookups of an entry that is being decoded
+   sc_parallel_for(NUM_ACQUIRE_JOBS, &loc_acquire_job, &numErrors, 8);
+   numErrors += (5 != loc_num_loads);
+
+   // Different format (channel count) is a separate entry
+   entry = samplechain_cache_acquire("a", 1u, 2u, &loc_load, NULL);
+   numErrors += (NULL == entry);
+   samplechain_cache_release(entry);
+   numErrors += (6 != loc_num_loads);
+
+   // Failed decodes are not cached
+   numErrors += (NULL != samplechain_cache_acquire("missing", 1u, 1u, &loc_load, NULL));
+   numErrors += (NULL != samplechain_cache_acquire("missing", 1u, 1u, &loc_load, NULL));
+   numErrors += (8 != loc_num_loads);
+
+   // LRU eviction: all entries but the pinned "b" exceed the cap
+   samplechain_cache_get_stats(&stats);
+   numEvictions = stats.num_evictions;
+   entry = samplechain_cache_acquire("b", 1u, 1u, &loc_load, NULL);
+   samplechain_cache_set_max_bytes(3 * entrySz);
+   samplechain_cache_get_stats(&stats);
+   numErrors += (stats.num_bytes > 3 * entrySz);
+   numErrors += (5 != (stats.num_evictions - numEvictions));
+
+   samplechain_cache_set_max_bytes(0);
+   samplechain_cache_get_stats(&stats);
+   numErrors += (1 != stats.num_entries);
+   numErrors += (NULL == samplechain_cache_entry_get_frames(entry, NULL));
+
+   samplechain_cache_release(entry);
+   samplechain_cache_get_stats(&stats);
+   numErrors += (0 != stats.num_entries);
+   numErrors += (0 != stats.num_bytes);
+
+   samplechain_cache_set_max_bytes(SC_CACHE_DEFAULT_MAX_BYTES);
+
+   // A changed source version replaces the stale entry (pinned users keep the stale audio)
+   samplechain_cache_get_stats(&stats);
+   numStale = stats.num_stale;
+   entry = samplechain_cache_acquire("a", 1u, 1u, &loc_load, NULL);
+   entry2 = samplechain_cache_acquire("a", 2u, 1u, &loc_load, NULL);
+   numErrors += (NULL == samplechain_cache_entry_get_frames(entry, NULL));
+   numErrors += (NULL == samplechain_cache_entry_get_frames(entry2, NULL));
+   samplechain_cache_release(entry);
+   samplechain_cache_release(entry2);
+   entry = samplechain_cache_acquire("a", 2u, 1u, &loc_load, NULL);
+   samplechain_cache_release(entry);
+   numErrors += (10 != loc_num_loads);
+   samplechain_cache_get_stats(&stats);
+   numErrors += (1 != (stats.num_stale - numStale));
+   numErrors += (1 != stats.num_entries);
+
+   samplechain_cache_clear();
+
+   printf("[cch] decoded sample cache: %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_cache: FAILED\n");
+   }
+}
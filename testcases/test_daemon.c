@@ -0,0 +1,364 @@
+/* ----
+ * ---- file   : test_daemon.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(SC_NO_THREADS) && !defined(SC_NO_MMAP)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../io/wav.h"
+#include "../io/daemon.h"
+
+#define NUM_FILES        4
+#define NUM_CLIENTS      4
+#define TMP_SOCKETNAME   "test_daemon.tmp.sock"
+
+
+#if !defined(SC_NO_THREADS) && !defined(SC_NO_MMAP)
+
+static const char *const loc_path_names[NUM_FILES] = {
+   "test_daemon.tmp.0.wav",
+   "test_daemon.tmp.1.wav",
+   "test_daemon.tmp.2.wav",
+   "test_daemon.tmp.3.wav"
+};
+
+static const char *const loc_bad_path_names[1] = { "test_daemon.tmp.bad.wav" };
+
+static uint32_t loc_num_extra_frames = 0u;  // changes the files when they are written again
+
+typedef struct {
+   samplechain_daemon_request_t  req;
+   samplechain_daemon_result_t  *result;
+} client_t;
+
+
+static size_t loc_get_num_frames(uint32_t _fileIdx) {
+   return 3000u + 1111u * _fileIdx + loc_num_extra_frames;
+}
+
+static bool_t loc_write_files(void) {
+   bool_t ret = SC_TRUE;
+   uint32_t fileIdx;
+
+   for(fileIdx = 0; ret && (fileIdx < NUM_FILES); fileIdx++)
+   {
+      size_t numFrames = loc_get_num_frames(fileIdx);
+      int16_t *frames = malloc(sizeof(int16_t) * numFrames);
+
+      ret = (NULL != frames);
+
+      if(ret)
+      {
+         size_t i;
+
+         for(i = 0; i < numFrames; i++)
+         {
+            frames[i] = (int16_t) ((int32_t)((i * (fileIdx + 3u + loc_num_extra_frames) * 97u) & 0x3FFFu) - 0x2000);
+         }
+
+         ret = samplechain_wav_save_s16(loc_path_names[fileIdx], frames, numFrames, 1u, 44100u);
+
+         free(frames);
+      }
+   }
+
+   return ret;
+}
+
+// Build + render the chain locally (reference)
+static int16_t *loc_build_local(uint32_t _algorithmIdx, int32_t _extraPadding, size_t *_retNumFrames) {
+   float32_t *sources[NUM_FILES];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   int16_t *ret = NULL;
+   uint32_t fileIdx;
+
+   samplechain_select_algorithm(_algorithmIdx, &alg);
+   alg.init(&sc, 120);
+   alg.set_parameter_i(sc, "bytes_per_sample", 2);
+   alg.set_parameter_i(sc, "num_channels", 1);
+   alg.set_parameter_i(sc, "extra_padding", _extraPadding);
+
+   for(fileIdx = 0; fileIdx < NUM_FILES; fileIdx++)
+   {
+      samplechain_wav_info_t info;
+
+      sources[fileIdx] = samplechain_wav_load(loc_path_names[fileIdx], 1u, &info);
+      alg.add(sc, info.num_frames, sources[fileIdx]);
+   }
+
+   alg.calc(sc);
+
+   *_retNumFrames = alg.query_total_size(sc);
+
+   samplechain_render_init_params(&params);
+
+   ret = malloc(sizeof(int16_t) * *_retNumFrames);
+
+   if((NULL != ret) && !samplechain_render(&alg, sc, &params, ret, *_retNumFrames))
+   {
+      free(ret);
+      ret = NULL;
+   }
+
+   alg.exit(&sc);
+
+   for(fileIdx = 0; fileIdx < NUM_FILES; fileIdx++)
+   {
+      free(sources[fileIdx]);
+   }
+
+   return ret;
+}
+
+static uint32_t loc_compare_result(const samplechain_daemon_result_t *_result, const int16_t *_frames, size_t _numFrames) {
+   uint32_t ret = 0u;
+
+   if(NULL != _result)
+   {
+      ret += (1u != _result->num_channels);
+      ret += (44100u != _result->sample_rate);
+      ret += (_numFrames != _result->num_frames);
+      ret += (_result->num_elements < NUM_FILES);
+      ret += (0u != _result->layout.offsets[0]);
+      ret += (loc_get_num_frames(1) != _result->layout.orig_sizes[1]);
+
+      if((0u == ret) && (NULL != _frames))
+      {
+         ret += (0 != memcmp(_result->frames, _frames, sizeof(int16_t) * _numFrames));
+      }
+   }
+   else
+   {
+      ret++;
+   }
+
+   return ret;
+}
+
+static void loc_init_request(samplechain_daemon_request_t *_req, uint32_t _algorithmIdx, int32_t _extraPadding) {
+   samplechain_daemon_init_request(_req);
+
+   _req->algorithm_idx   = _algorithmIdx;
+   _req->num_params      = 1u;
+   _req->param_names[0]  = "extra_padding";
+   _req->param_values[0] = _extraPadding;
+   _req->num_files       = NUM_FILES;
+   _req->path_names      = loc_path_names;
+}
+
+static void *loc_daemon_thread(void *_daemon) {
+   samplechain_daemon_run((samplechain_daemon_t*)_daemon);
+
+   return NULL;
+}
+
+static void *loc_client_thread(void *_client) {
+   client_t *client = (client_t*)_client;
+
+   client->result = samplechain_daemon_build(TMP_SOCKETNAME, &client->req);
+
+   return NULL;
+}
+
+void test_daemon(void) {
+   samplechain_daemon_t *daemon;
+   samplechain_daemon_stats_t stats;
+   samplechain_daemon_result_t *result;
+   samplechain_daemon_request_t req;
+   client_t clients[NUM_CLIENTS];
+   pthread_t threads[NUM_CLIENTS];
+   pthread_t daemonThread;
+   int16_t *frames;
+   size_t numFrames = 0u;
+   uint64_t numBuilds;
+   uint32_t numShared = 0u;
+   uint32_t numErrors = 0u;
+   uint32_t i;
+
+   numErrors += !loc_write_files();
+
+   frames = loc_build_local(0u, 100, &numFrames);
+   numErrors += (NULL == frames);
+
+   // (note) max 2 results
+   daemon = samplechain_daemon_create(TMP_SOCKETNAME, 2u);
+   numErrors += (NULL == daemon);
+
+   if((0u == numErrors) && (0 == pthread_create(&daemonThread, NULL, &loc_daemon_thread, daemon)))
+   {
+      // Concurrent identical requests are built once
+      for(i = 0; i < NUM_CLIENTS; i++)
+      {
+         loc_init_request(&clients[i].req, 0u, 100);
+         clients[i].result = NULL;
+         pthread_create(&threads[i], NULL, &loc_client_thread, &clients[i]);
+      }
+
+      for(i = 0; i < NUM_CLIENTS; i++)
+      {
+         pthread_join(threads[i], NULL);
+         numErrors += loc_compare_result(clients[i].result, frames, numFrames);
+         numShared += (NULL != clients[i].result) && clients[i].result->b_shared;
+      }
+
+      samplechain_daemon_get_stats(daemon, &stats);
+      numErrors += (NUM_CLIENTS != stats.num_requests);
+      numErrors += (1u != stats.num_builds);
+      numErrors += ((NUM_CLIENTS - 1u) != (stats.num_hits + stats.num_joins));
+      numErrors += ((NUM_CLIENTS - 1u) != numShared);
+
+      // Different parameters / algorithm are separate results (the least recently used result is dropped)
+      free(frames);
+      frames = loc_build_local(0u, 500, &numFrames);
+
+      loc_init_request(&req, 0u, 500);
+      result = samplechain_daemon_build(TMP_SOCKETNAME, &req);
+      numErrors += loc_compare_result(result, frames, numFrames);
+      numErrors += (NULL == result) || result->b_shared;
+      samplechain_daemon_result_free(result);
+
+      free(frames);
+      frames = loc_build_local(1u, 100, &numFrames);
+
+      loc_init_request(&req, 1u, 100);
+      result = samplechain_daemon_build(TMP_SOCKETNAME, &req);
+      numErrors += loc_compare_result(result, frames, numFrames);
+      samplechain_daemon_result_free(result);
+
+      samplechain_daemon_get_stats(daemon, &stats);
+      numErrors += (3u != stats.num_builds);
+      numErrors += (2u != stats.num_jobs);
+
+      // Mapped results stay valid after the daemon dropped them
+      free(frames);
+      frames = loc_build_local(0u, 100, &numFrames);
+
+      for(i = 0; i < NUM_CLIENTS; i++)
+      {
+         numErrors += loc_compare_result(clients[i].result, frames, numFrames);
+         samplechain_daemon_result_free(clients[i].result);
+      }
+
+      // Files that were edited in place are rebuilt (jobs and decoded audio are keyed on the file identity)
+      samplechain_daemon_get_stats(daemon, &stats);
+      numBuilds = stats.num_builds;
+
+      loc_num_extra_frames = 7u;
+      numErrors += !loc_write_files();
+
+      free(frames);
+      frames = loc_build_local(1u, 100, &numFrames);
+
+      loc_init_request(&req, 1u, 100);
+      result = samplechain_daemon_build(TMP_SOCKETNAME, &req);
+      numErrors += loc_compare_result(result, frames, numFrames);
+      numErrors += (NULL == result) || result->b_shared;
+      samplechain_daemon_result_free(result);
+
+      samplechain_daemon_get_stats(daemon, &stats);
+      numErrors += ((numBuilds + 1u) != stats.num_builds);
+
+      // Invalid files
+      loc_init_request(&req, 0u, 100);
+      req.num_files  = 1u;
+      req.path_names = loc_bad_path_names;
+      numErrors += (NULL != samplechain_daemon_build(TMP_SOCKETNAME, &req));
+
+      {
+         FILE *fh = fopen(loc_bad_path_names[0], "wb");
+
+         if(NULL != fh)
+         {
+            fputs("not a WAV file", fh);
+            fclose(fh);
+         }
+      }
+
+      numErrors += (NULL != samplechain_daemon_build(TMP_SOCKETNAME, &req));
+
+      samplechain_daemon_get_stats(daemon, &stats);
+      numErrors += (1u != stats.num_failed);
+      numErrors += (stats.num_jobs > 2u);
+
+      samplechain_daemon_stop(daemon);
+      pthread_join(daemonThread, NULL);
+
+      samplechain_daemon_get_stats(daemon, &stats);
+
+      printf("[dmn] build daemon: %u requests, %u builds, %u hits, %u joins\n",
+             (uint32_t)stats.num_requests, (uint32_t)stats.num_builds, (uint32_t)stats.num_hits, (uint32_t)stats.num_joins
+             );
+   }
+
+   samplechain_daemon_destroy(daemon);
+
+   numErrors += (0 == access(TMP_SOCKETNAME, F_OK));
+
+   free(frames);
+
+   for(i = 0; i < NUM_FILES; i++)
+   {
+      remove(loc_path_names[i]);
+   }
+
+   remove(loc_bad_path_names[0]);
+
+   printf("[dmn] build daemon: %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_daemon: FAILED\n");
+   }
+}
+
+#else
+
+void test_daemon(void) {
+   uint32_t numErrors = (NULL != samplechain_daemon_create(TMP_SOCKETNAME, 0u));
+
+   printf("[dmn] build daemon: not available (%u errors)\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_daemon: FAILED\n");
+   }
+}
+
+#endif
@@ -0,0 +1,306 @@
+/* ----
+ * ---- file   : test_dedup.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../analysis/dedup.h"
+#include "../util/thread.h"
+
+
+static size_t loc_calc_chain(uint32_t _algIdx, float32_t **_elementFrames, const size_t *_elementSizes, uint32_t _numElements, bool_t _bDedup) {
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   uint32_t elementIdx;
+   uint32_t numDuplicates = 0;
+   size_t ret;
+
+   samplechain_select_algorithm(_algIdx, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 300);
+   alg.set_parameter_i(sc, "min_padding",   100);
+
+   for(elementIdx = 0; elementIdx < _numElements; elementIdx++)
+   {
+      alg.add(sc, _elementSizes[elementIdx], _elementFrames[elementIdx]);
+   }
+
+   if(_bDedup)
+   {
+      samplechain_render_params_t params;
+
+      samplechain_render_init_params(&params);
+      params.num_threads = 2;
+
+      numDuplicates = samplechain_dedup(&alg, sc, &params);
+   }
+
+   if(1 == _algIdx)
+   {
+      // (note) duplicates count towards the chain size, i.e. they share the slot of their source element
+      alg.set_parameter_i(sc, "chain_size", (int32_t)_numElements);
+   }
+
+   alg.calc(sc);
+
+   ret = alg.query_total_size(sc);
+
+   printf("[dedup] alg=%u dedup=%d: %u duplicates, total size=%u, offsets:",
+          _algIdx, _bDedup, numDuplicates, (uint32_t)ret
+          );
+
+   for(elementIdx = 0; elementIdx < _numElements; elementIdx++)
+   {
+      printf(" %u", (uint32_t)alg.query_element_offset(sc, elementIdx));
+   }
+
+   printf("\n");
+
+   if(_bDedup)
+   {
+      int16_t *out = malloc(sizeof(int16_t) * ret);
+      samplechain_render_params_t params;
+
+      samplechain_render_init_params(&params);
+
+      if( (2 != numDuplicates) ||
+          (alg.query_element_offset(sc, 0) != alg.query_element_offset(sc, 2)) ||
+          (alg.query_element_offset(sc, 1) != alg.query_element_offset(sc, 4)) ||
+          (alg.query_element_total_size(sc, 0) != alg.query_element_total_size(sc, 2)) ||
+          !samplechain_render(&alg, sc, &params, out, ret) ||
+          (0 != out[alg.query_element_offset(sc, 2) + 10] - (int16_t)(_elementFrames[2][10] * 32767.0f + 0.5f))
+          )
+      {
+         printf("[---] test_dedup: FAILED (alg=%u)\n", _algIdx);
+      }
+
+      free(out);
+   }
+
+   alg.exit(&sc);
+
+   return ret;
+}
+
+// Duplicates with the default "chain_size" (= number of slices), i.e. calc() must not append silent elements for them
+static void loc_test_default_chain_size(float32_t **_elementFrames, const size_t *_elementSizes, uint32_t _numElements) {
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   uint32_t elementIdx;
+   uint32_t numDuplicates;
+   uint32_t numErrors = 0;
+
+   samplechain_render_init_params(&params);
+   params.num_threads = 2;
+
+   samplechain_select_algorithm(1, &alg);
+
+   alg.init(&sc, _numElements);
+
+   for(elementIdx = 0; elementIdx < _numElements; elementIdx++)
+   {
+      alg.add(sc, _elementSizes[elementIdx], _elementFrames[elementIdx]);
+   }
+
+   numDuplicates = samplechain_dedup(&alg, sc, &params);
+
+   alg.calc(sc);
+
+   numErrors += (2 != numDuplicates);
+   numErrors += (0 == alg.query_total_size(sc));
+   // (note) duplicates count towards the chain size (no silent filler slices)
+   numErrors += (_numElements != alg.query_num_elements(sc));
+   numErrors += (alg.query_element_offset(sc, 0) != alg.query_element_offset(sc, 2));
+   numErrors += (alg.query_element_offset(sc, 1) != alg.query_element_offset(sc, 4));
+
+   printf("[dedup] default chain_size: %u duplicates, %u elements, total size=%u\n",
+          numDuplicates, alg.query_num_elements(sc), (uint32_t)alg.query_total_size(sc)
+          );
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_dedup: FAILED (default chain_size)\n");
+   }
+
+   alg.exit(&sc);
+}
+
+static bool_t loc_fetch(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   // (note) 'fetchCtx' counts the fetched (pinned) elements
+   SC_ATOMIC_ADD((uint32_t*)_fetchCtx, 1u);
+
+   _retSource->frames     = (const float32_t*)_userData;
+   _retSource->num_frames = _numFrames;
+
+   return SC_TRUE;
+}
+
+static void loc_release(void *_fetchCtx, void *_userData, const samplechain_source_t *_source) {
+   SC_ATOMIC_SUB((uint32_t*)_fetchCtx, 1u);
+}
+
+// Every fetched element must be released
+static void loc_test_release(float32_t **_elementFrames, const size_t *_elementSizes, uint32_t _numElements) {
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   uint32_t numPinned = 0;
+   uint32_t numDuplicates;
+   uint32_t elementIdx;
+
+   samplechain_render_init_params(&params);
+   params.fetch       = &loc_fetch;
+   params.release     = &loc_release;
+   params.fetch_ctx   = &numPinned;
+   params.num_threads = 2;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   for(elementIdx = 0; elementIdx < _numElements; elementIdx++)
+   {
+      alg.add(sc, _elementSizes[elementIdx], _elementFrames[elementIdx]);
+   }
+
+   numDuplicates = samplechain_dedup(&alg, sc, &params);
+
+   printf("[dedup] fetch / release: %u duplicates, %u elements still pinned\n", numDuplicates, numPinned);
+
+   if((2 != numDuplicates) || (0 != numPinned))
+   {
+      printf("[---] test_dedup: FAILED (release)\n");
+   }
+
+   alg.exit(&sc);
+}
+
+static const samplechain_derived_t *loc_query_derived(void *_fetchCtx, void *_userData) {
+   // (note) 'fetchCtx' is the derived element descriptor
+   return (_userData == _fetchCtx) ? (const samplechain_derived_t*)_fetchCtx : NULL;
+}
+
+// A derived element with the same size as its source (e.g. the reversed variant) is not a duplicate
+static void loc_test_derived(float32_t *_frames, size_t _numFrames) {
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   samplechain_derived_t derived;
+   uint32_t numDuplicates;
+
+   samplechain_derived_init(&derived, _frames, _numFrames);
+   derived.flags = SC_DERIVED_REVERSE;
+
+   samplechain_render_init_params(&params);
+   params.fetch_ctx   = &derived;
+   params.derived     = &loc_query_derived;
+   params.num_threads = 2;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.add(sc, _numFrames, _frames);
+   alg.add(sc, samplechain_derived_calc_num_frames(&derived), &derived);
+   alg.add(sc, _numFrames, _frames);
+
+   numDuplicates = samplechain_dedup(&alg, sc, &params);
+
+   alg.calc(sc);
+
+   printf("[dedup] derived: %u duplicates\n", numDuplicates);
+
+   if( (1 != numDuplicates) ||
+       (alg.query_element_offset(sc, 1) == alg.query_element_offset(sc, 0)) ||
+       (alg.query_element_offset(sc, 2) != alg.query_element_offset(sc, 0))
+       )
+   {
+      printf("[---] test_dedup: FAILED (derived)\n");
+   }
+
+   alg.exit(&sc);
+}
+
+void test_dedup(void) {
+
+   static const size_t elementSizes[5] = { 4000, 2500, 4000, 6000, 2500 };
+   float32_t *elementFrames[5];
+   uint32_t elementIdx;
+   uint32_t algIdx;
+
+   // 0: A, 1: B, 2: copy of A, 3: C, 4: B (same buffer)
+   elementFrames[0] = malloc(sizeof(float32_t) * elementSizes[0]);
+   elementFrames[1] = malloc(sizeof(float32_t) * elementSizes[1]);
+   elementFrames[2] = malloc(sizeof(float32_t) * elementSizes[2]);
+   elementFrames[3] = malloc(sizeof(float32_t) * elementSizes[3]);
+   elementFrames[4] = elementFrames[1];
+
+   for(elementIdx = 0; elementIdx < 4; elementIdx++)
+   {
+      size_t i;
+
+      for(i = 0; i < elementSizes[elementIdx]; i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * (0.01f + 0.01f * elementIdx)) * 0.5f;
+      }
+   }
+
+   memcpy(elementFrames[2], elementFrames[0], sizeof(float32_t) * elementSizes[0]);
+
+   for(algIdx = 0; algIdx < 2; algIdx++)
+   {
+      size_t totalSz = loc_calc_chain(algIdx, elementFrames, elementSizes, 5, SC_FALSE);
+      size_t dedupTotalSz = loc_calc_chain(algIdx, elementFrames, elementSizes, 5, SC_TRUE);
+
+      if(dedupTotalSz >= totalSz)
+      {
+         printf("[---] test_dedup: FAILED (alg=%u, chain did not shrink)\n", algIdx);
+      }
+   }
+
+   loc_test_default_chain_size(elementFrames, elementSizes, 5);
+
+   loc_test_derived(elementFrames[0], elementSizes[0]);
+
+   loc_test_release(elementFrames, elementSizes, 5);
+
+   for(elementIdx = 0; elementIdx < 4; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+}
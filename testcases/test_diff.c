@@ -0,0 +1,164 @@
+/* ----
+ * ---- file   : test_diff.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../io/diff.h"
+#include "../util/kernels.h"
+
+#define NUM_ELEMENTS    6
+#define ELEMENT_FRAMES  3000
+#define BLOCK_FRAMES    512
+#define MAX_RANGES      64
+#define CHANGED_IDX     2   // element that is changed between the transfers
+#define CHANGED_FRAMES  100
+
+
+static uint32_t loc_render_manifest(const samplechain_algorithm_t *_alg, samplechain_t _sc, samplechain_diff_manifest_t *_retManifest) {
+   samplechain_render_params_t params;
+   size_t totalSz = _alg->query_total_size(_sc);
+   int16_t *out = malloc(sizeof(int16_t) * totalSz);
+   uint32_t numErrors = 1;
+
+   samplechain_render_init_params(&params);
+
+   if(NULL != out)
+   {
+      numErrors  = !samplechain_render(_alg, _sc, &params, out, totalSz);
+      numErrors += !samplechain_diff_manifest_calc(_alg, _sc, out, BLOCK_FRAMES, _retManifest);
+      free(out);
+   }
+
+   return numErrors;
+}
+
+void test_diff(void) {
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_diff_manifest_t m1;
+   samplechain_diff_manifest_t m2;
+   samplechain_diff_manifest_t mLoaded;
+   samplechain_diff_range_t ranges[MAX_RANGES];
+   size_t offsets[NUM_ELEMENTS + 1];
+   size_t totalSizes[NUM_ELEMENTS + 1];
+   samplechain_layout_t layout = { offsets, totalSizes, NULL, NULL, NULL, NULL };
+   uint32_t elementIdx;
+   uint32_t numRanges;
+   uint32_t rangeIdx;
+   uint32_t numErrors = 0;
+
+   // CRC32C check value
+   numErrors += (0xE3069283u != sc_kernel_crc32c("123456789", 9, 0u));
+   numErrors += (0xE3069283u != sc_kernel_crc32c("6789", 4, sc_kernel_crc32c("12345", 5, 0u)));
+
+   samplechain_select_algorithm(0, &alg);
+   alg.init(&sc, 120);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * ELEMENT_FRAMES);
+
+      for(i = 0; i < ELEMENT_FRAMES; i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * 0.01f * (elementIdx + 1)) * 0.5f;
+      }
+
+      alg.add(sc, ELEMENT_FRAMES, elementFrames[elementIdx]);
+   }
+
+   alg.calc(sc);
+   alg.query_layout(sc, &layout, NUM_ELEMENTS + 1);
+
+   numErrors += loc_render_manifest(&alg, sc, &m1);
+   numErrors += (NUM_ELEMENTS != m1.num_slices);
+
+   // Save / load roundtrip
+   numErrors += !samplechain_diff_manifest_save(&m1, "test_diff.tmp.txt");
+   numErrors += !samplechain_diff_manifest_load("test_diff.tmp.txt", &mLoaded);
+   numErrors += (0 != samplechain_diff_calc(&m1, &mLoaded, NULL, 0));
+   remove("test_diff.tmp.txt");
+
+   // No previous transfer: the whole chain changed
+   numRanges = samplechain_diff_calc(NULL, &m1, ranges, MAX_RANGES);
+   numErrors += (1 != numRanges) || (0 != ranges[0].offset) || (m1.num_frames != ranges[0].num_frames);
+
+   // Change the start of one element: only the changed block(s) of its slice are resent
+   for(elementIdx = 0; elementIdx < CHANGED_FRAMES; elementIdx++)
+   {
+      elementFrames[CHANGED_IDX][elementIdx] = 0.25f;
+   }
+
+   numErrors += loc_render_manifest(&alg, sc, &m2);
+
+   numRanges = samplechain_diff_calc(&mLoaded, &m2, ranges, MAX_RANGES);
+   numErrors += (0 == numRanges) || (numRanges > MAX_RANGES);
+
+   for(rangeIdx = 0; (rangeIdx < numRanges) && (rangeIdx < MAX_RANGES); rangeIdx++)
+   {
+      size_t end = ranges[rangeIdx].offset + ranges[rangeIdx].num_frames;
+
+      numErrors += (ranges[rangeIdx].offset < offsets[CHANGED_IDX]);
+      numErrors += (end > (offsets[CHANGED_IDX] + totalSizes[CHANGED_IDX]));
+      numErrors += (ranges[rangeIdx].num_frames > (2 * BLOCK_FRAMES));
+   }
+
+   numErrors += (1 != numRanges) || (offsets[CHANGED_IDX] != ranges[0].offset) || (ranges[0].num_frames < CHANGED_FRAMES);
+
+   printf("[dif] %u changed range(s), first at %u (%u frames), %u errors\n",
+          numRanges,
+          (uint32_t)ranges[0].offset,
+          (uint32_t)ranges[0].num_frames,
+          numErrors
+          );
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_diff: FAILED\n");
+   }
+
+   samplechain_diff_manifest_free(&m1);
+   samplechain_diff_manifest_free(&m2);
+   samplechain_diff_manifest_free(&mLoaded);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
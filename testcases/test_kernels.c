@@ -0,0 +1,245 @@
+/* ----
+ * ---- file   : test_kernels.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/kernels.h"
+
+#define NUM_SAMPLES  4099  // (note) not a multiple of the vector size
+#define NUM_LENGTHS  6
+#define BLOCK_SIZE   1000
+#define PEAK_BLOCK   64    // sc_kernel_analyze() block size (number of samples)
+
+
+// Kernel results of one instruction set
+typedef struct {
+   float32_t sum_squares[NUM_LENGTHS];
+   float32_t peak_sum_squares[NUM_LENGTHS];
+   float32_t peaks[NUM_LENGTHS];
+   int16_t   conv[NUM_SAMPLES];
+   int16_t   conv_reverse[3][NUM_SAMPLES];  // 1..3 channels
+   uint8_t   sds[3 * NUM_SAMPLES];
+   int16_t   min[NUM_LENGTHS];
+   int16_t   max[NUM_LENGTHS];
+   uint64_t  residual_sums[NUM_LENGTHS][4];
+   uint32_t  residuals[4][NUM_SAMPLES];
+   uint8_t   xor_u8[NUM_LENGTHS];
+   uint64_t  hash[NUM_LENGTHS];
+   uint32_t  crc[NUM_LENGTHS];
+   uint32_t  crc_blocks[(4 * NUM_SAMPLES + BLOCK_SIZE - 1) / BLOCK_SIZE];
+   sc_kernel_analysis_t analysis[NUM_LENGTHS][2];  // 1 / 3 channels
+   float32_t block_peaks[NUM_LENGTHS][2][(NUM_SAMPLES + PEAK_BLOCK - 1) / PEAK_BLOCK];
+} results_t;
+
+static const size_t loc_lengths[NUM_LENGTHS] = { 1, 7, 8, 33, 1000, NUM_SAMPLES - 3 };
+
+static float32_t loc_f32[NUM_SAMPLES];
+static int16_t   loc_s16[NUM_SAMPLES];
+static int32_t   loc_s32[NUM_SAMPLES];
+
+
+static void loc_init_input(void) {
+   uint32_t r = 0x12345678u;
+   uint32_t i;
+
+   for(i = 0; i < NUM_SAMPLES; i++)
+   {
+      r = (r * 1664525u) + 1013904223u;
+
+      // (note) exceeds -1..1 so that the conversion clips
+      loc_f32[i] = ((int32_t)(r >> 8) - 0x800000) / (float32_t)0x700000;
+      loc_s16[i] = (int16_t)(r >> 16);
+      loc_s32[i] = (int32_t)(r >> 16) - 32768;
+   }
+}
+
+static void loc_calc_results(results_t *_r) {
+   uint32_t lenIdx;
+   uint32_t order;
+   uint32_t numCh;
+
+   memset(_r, 0, sizeof(results_t));
+
+   // (note) odd offsets (unaligned input)
+   for(lenIdx = 0; lenIdx < NUM_LENGTHS; lenIdx++)
+   {
+      size_t num = loc_lengths[lenIdx];
+
+      _r->sum_squares[lenIdx]      = sc_kernel_sum_squares(loc_f32 + 1, num);
+      _r->peak_sum_squares[lenIdx] = sc_kernel_peak_sum_squares(loc_f32 + 1, num, &_r->peaks[lenIdx]);
+      sc_kernel_minmax_s16(loc_s16 + 1, num, &_r->min[lenIdx], &_r->max[lenIdx]);
+      sc_kernel_fixed_residual_sums(loc_s32 + 3, num, _r->residual_sums[lenIdx]);
+      _r->xor_u8[lenIdx] = sc_kernel_xor_u8((const uint8_t*)loc_s16 + 1, num);
+      _r->hash[lenIdx]   = sc_kernel_hash((const uint8_t*)loc_s16 + 1, num, 0x5EEDu);
+      _r->crc[lenIdx]    = sc_kernel_crc32c((const uint8_t*)loc_s16 + 1, num, 0u);
+
+      for(numCh = 1; numCh <= 3; numCh += 2)
+      {
+         sc_kernel_analyze(loc_f32 + 1, num, numCh, 0.5f, PEAK_BLOCK, _r->block_peaks[lenIdx][numCh >> 1], &_r->analysis[lenIdx][numCh >> 1]);
+      }
+   }
+
+   sc_kernel_convert_f32_s16(_r->conv, loc_f32, NUM_SAMPLES, 0.9f);
+
+   for(numCh = 1; numCh <= 3; numCh++)
+   {
+      size_t numFrames = NUM_SAMPLES / numCh;
+
+      sc_kernel_convert_f32_s16_reverse(_r->conv_reverse[numCh - 1u], loc_f32 + ((numFrames - 1u) * numCh), numFrames, numCh, 0.9f);
+   }
+   sc_kernel_sds_pack_s16(_r->sds, loc_s16, NUM_SAMPLES);
+
+   for(order = 0; order < 4; order++)
+   {
+      sc_kernel_fixed_residuals(loc_s32 + 3, NUM_SAMPLES - 3, order, _r->residuals[order]);
+   }
+
+   sc_kernel_crc32c_blocks(loc_s32, sizeof(loc_s32), BLOCK_SIZE, _r->crc_blocks);
+}
+
+// Compare the (vectorized) silence / zero crossing search of sc_kernel_analyze() with a plain loop
+static bool_t loc_check_analysis(const float32_t *_s, size_t _num, uint32_t _numCh, float32_t _silenceLevel, const sc_kernel_analysis_t *_a) {
+   size_t firstLoud = _num;
+   size_t endLoud = 0;
+   size_t zeroCross = 0;
+   size_t i;
+
+   for(i = 0; i < _num; i++)
+   {
+      if(fabsf(_s[i]) >= _silenceLevel)
+      {
+         firstLoud = (firstLoud < _num) ? firstLoud : i;
+         endLoud = i + 1u;
+      }
+
+      if((i >= _numCh) && ((_s[i] < 0.0f) != (_s[i - _numCh] < 0.0f)))
+      {
+         zeroCross = i;
+      }
+   }
+
+   return (firstLoud == _a->first_loud) && (endLoud == _a->end_loud) && (zeroCross == _a->last_zero_crossing);
+}
+
+void test_kernels(void) {
+   results_t *ref = malloc(sizeof(results_t));
+   results_t *r = malloc(sizeof(results_t));
+   uint32_t cpuIsa = sc_kernel_detect_isa();
+   uint32_t defIsa = sc_kernel_get_isa();
+   uint32_t numErrors = 0;
+   uint32_t isa;
+   uint32_t lenIdx;
+   uint32_t chIdx;
+
+   loc_init_input();
+
+   numErrors += (NULL == ref) || (NULL == r);
+   numErrors += (defIsa > cpuIsa);
+   numErrors += sc_kernel_set_isa(SC_KERNEL_NUM_ISAS);
+
+   // Scalar reference
+   numErrors += !sc_kernel_set_isa(SC_KERNEL_ISA_SCALAR);
+   numErrors += (SC_KERNEL_ISA_SCALAR != sc_kernel_get_isa());
+
+   if(0 == numErrors)
+   {
+      loc_calc_results(ref);
+
+      numErrors += (0xE3069283u != sc_kernel_crc32c("123456789", 9, 0u));
+
+      // Reverse conversion (stereo: frames are reversed, channels are not)
+      numErrors += (ref->conv_reverse[0][0] != ref->conv[NUM_SAMPLES - 1u]);
+      numErrors += (ref->conv_reverse[0][NUM_SAMPLES - 1u] != ref->conv[0]);
+      numErrors += (ref->conv_reverse[1][0] != ref->conv[NUM_SAMPLES - 3u]);
+      numErrors += (ref->conv_reverse[1][1] != ref->conv[NUM_SAMPLES - 2u]);
+
+      // Fused analysis must match the individual kernels
+      for(lenIdx = 0; lenIdx < NUM_LENGTHS; lenIdx++)
+      {
+         size_t num = loc_lengths[lenIdx];
+         uint32_t numBlocks = (uint32_t)((num + PEAK_BLOCK - 1u) / PEAK_BLOCK);
+
+         for(chIdx = 0; chIdx < 2; chIdx++)
+         {
+            const sc_kernel_analysis_t *a = &ref->analysis[lenIdx][chIdx];
+            float32_t maxBlockPeak = 0.0f;
+            uint32_t blockIdx;
+
+            for(blockIdx = 0; blockIdx < numBlocks; blockIdx++)
+            {
+               float32_t p = ref->block_peaks[lenIdx][chIdx][blockIdx];
+
+               maxBlockPeak = (p > maxBlockPeak) ? p : maxBlockPeak;
+            }
+
+            numErrors += (a->sum_squares != ref->peak_sum_squares[lenIdx]);
+            numErrors += (a->peak != ref->peaks[lenIdx]);
+            numErrors += (maxBlockPeak != a->peak);
+            numErrors += (a->hash != sc_kernel_hash(loc_f32 + 1, sizeof(float32_t) * num, 0u));
+            numErrors += !loc_check_analysis(loc_f32 + 1, num, (2u * chIdx) + 1u, 0.5f, a);
+         }
+      }
+
+      // All supported variants must be bit-exact
+      for(isa = SC_KERNEL_ISA_BASELINE; isa <= cpuIsa; isa++)
+      {
+         if(sc_kernel_set_isa(isa))
+         {
+            uint32_t numDiffs;
+
+            loc_calc_results(r);
+
+            numDiffs = (0 != memcmp(ref, r, sizeof(results_t)));
+            numDiffs += (0xE3069283u != sc_kernel_crc32c("123456789", 9, 0u));
+
+            printf("[krn] %-8s %s\n", sc_kernel_get_isa_name(isa), (0 == numDiffs) ? "ok" : "MISMATCH");
+
+            numErrors += numDiffs;
+         }
+      }
+   }
+
+   numErrors += !sc_kernel_set_isa(defIsa);
+
+   printf("[krn] kernel variants (cpu=%s): %u errors\n", sc_kernel_get_isa_name(cpuIsa), numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_kernels: FAILED\n");
+   }
+
+   free(ref);
+   free(r);
+}
@@ -0,0 +1,251 @@
+/* ----
+ * ---- file   : testcases/test_metadata.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../analysis/loudness.h"
+#include "../analysis/onset.h"
+#include "../analysis/metadata.h"
+#include "../analysis/dedup.h"
+#include "../util/kernels.h"
+#include "../util/thread.h"
+
+#define NUM_ELEMENTS  4
+
+
+// Stereo element: 300 silent frames, 2000 frames tone, 200 silent frames
+static uint32_t loc_test_element(void) {
+   size_t numFrames = 2500;
+   float32_t *frames = calloc(numFrames * 2u, sizeof(float32_t));
+   samplechain_element_metadata_t md;
+   samplechain_loudness_t loudness;
+   samplechain_onset_params_t onsetParams;
+   size_t trailSilence = 0;
+   size_t zeroCross = 0;
+   float32_t maxPeak = 0.0f;
+   uint32_t numErrors = 0;
+   size_t i;
+
+   for(i = 0; i < 2000; i++)
+   {
+      frames[(300 + i) * 2u + 0u] = cosf(i * 0.07f) * 0.5f;
+      frames[(300 + i) * 2u + 1u] = cosf(i * 0.03f) * 0.25f;
+   }
+
+   samplechain_metadata_analyze(frames, numFrames, 2, -50.0f, &md);
+
+   samplechain_loudness_analyze(frames, numFrames, 2, &loudness);
+
+   samplechain_onset_init_params(&onsetParams);
+   onsetParams.num_channels = 2;
+
+   for(i = numFrames; (i > 0) && (fabsf(frames[(i - 1u) * 2u]) < 0.003162f) && (fabsf(frames[(i - 1u) * 2u + 1u]) < 0.003162f); i--)
+   {
+      trailSilence++;
+   }
+
+   for(i = 2; i < (numFrames * 2u); i++)
+   {
+      if((frames[i] < 0.0f) != (frames[i - 2u] < 0.0f))
+      {
+         zeroCross = i / 2u;
+      }
+   }
+
+   for(i = 0; i < md.num_peaks; i++)
+   {
+      maxPeak = (md.peaks[i] > maxPeak) ? md.peaks[i] : maxPeak;
+   }
+
+   printf("[meta] element: peak=%f rms=%f lead=%u trail=%u zc=%u peaks=%u*%u\n",
+          md.peak, md.rms, (uint32_t)md.lead_silence, (uint32_t)md.trail_silence,
+          (uint32_t)md.last_zero_crossing, md.num_peaks, (uint32_t)md.peak_frames
+          );
+
+   numErrors += !md.b_valid;
+   numErrors += (numFrames != md.num_frames);
+   numErrors += (md.peak != loudness.peak);
+   numErrors += (md.rms != loudness.rms);
+   numErrors += (md.lead_silence != samplechain_onset_find_lead_silence(&onsetParams, frames, numFrames));
+   numErrors += (300 != md.lead_silence);
+   numErrors += (md.trail_silence != trailSilence);
+   numErrors += (md.trail_silence < 200);
+   numErrors += (md.last_zero_crossing != zeroCross);
+   numErrors += (md.hash != sc_kernel_hash(frames, sizeof(float32_t) * numFrames * 2u, 0u));
+   numErrors += (md.num_peaks > SC_METADATA_NUM_PEAKS);
+   numErrors += (((size_t)md.num_peaks * md.peak_frames) < numFrames);
+   numErrors += (maxPeak != md.peak);
+   numErrors += (0.0f != md.peaks[0]) || (0.0f != md.peaks[md.num_peaks - 1u]);
+
+   // Silent element
+   memset(frames, 0, sizeof(float32_t) * numFrames * 2u);
+   samplechain_metadata_analyze(frames, 1000, 2, -50.0f, &md);
+
+   numErrors += (1000 != md.lead_silence) || (1000 != md.trail_silence) || (0 != md.last_zero_crossing) || (0.0f != md.peak);
+
+   free(frames);
+
+   return numErrors;
+}
+
+static bool_t loc_fetch(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   // (note) 'fetchCtx' counts the fetched (pinned) elements
+   SC_ATOMIC_ADD((uint32_t*)_fetchCtx, 1u);
+
+   _retSource->frames     = (const float32_t*)_userData;
+   _retSource->num_frames = _numFrames;
+
+   return SC_TRUE;
+}
+
+static void loc_release(void *_fetchCtx, void *_userData, const samplechain_source_t *_source) {
+   SC_ATOMIC_SUB((uint32_t*)_fetchCtx, 1u);
+}
+
+static size_t loc_render_chain(const samplechain_algorithm_t *_alg, samplechain_t _sc, const samplechain_metadata_t *_md, int16_t **_retFrames) {
+   samplechain_render_params_t params;
+   size_t ret = _alg->query_total_size(_sc);
+
+   samplechain_render_init_params(&params);
+   params.normalize_mode = SC_NORMALIZE_RMS;
+   params.metadata       = _md;
+   params.num_threads    = 2;
+
+   *_retFrames = malloc(sizeof(int16_t) * ret);
+
+   if((NULL == *_retFrames) || !samplechain_render(_alg, _sc, &params, *_retFrames, ret))
+   {
+      ret = 0;
+   }
+
+   return ret;
+}
+
+void test_metadata(void) {
+   static const size_t elementSizes[NUM_ELEMENTS] = { 4000, 2500, 4000, 6000 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   samplechain_metadata_t *md;
+   int16_t *frames = NULL;
+   int16_t *refFrames = NULL;
+   size_t numFrames;
+   uint32_t numPinned = 0;
+   uint32_t numErrors = loc_test_element();
+   uint32_t elementIdx;
+
+   // 0: A (100 silent frames), 1: B, 2: copy of A, 3: C
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = calloc(elementSizes[elementIdx], sizeof(float32_t));
+
+      for(i = 100; i < elementSizes[elementIdx]; i++)
+      {
+         elementFrames[elementIdx][i] = cosf(i * (0.01f + 0.01f * elementIdx)) * (0.2f + 0.1f * elementIdx);
+      }
+   }
+
+   memcpy(elementFrames[2], elementFrames[0], sizeof(float32_t) * elementSizes[0]);
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+   alg.set_parameter_i(sc, "min_padding", 100);
+   alg.set_parameter_i(sc, "use_lead_silence", 1);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   samplechain_render_init_params(&params);
+   params.fetch       = &loc_fetch;
+   params.release     = &loc_release;
+   params.fetch_ctx   = &numPinned;
+   params.num_threads = 2;
+
+   // Analyze once, then deduplicate / lay out / normalize from the metadata
+   md = samplechain_metadata_create(&alg, sc, &params, -50.0f);
+
+   numErrors += (NULL == md);
+
+   if(NULL != md)
+   {
+      numErrors += (NUM_ELEMENTS != md->num_elements);
+      numErrors += (md->elements[0].hash != md->elements[2].hash);
+      numErrors += (md->elements[0].hash == md->elements[1].hash);
+      numErrors += (100 != md->elements[3].lead_silence);
+      numErrors += (1 != samplechain_dedup_metadata(&alg, sc, md, &params));
+      numErrors += (0 != numPinned);
+      numErrors += (NUM_ELEMENTS != samplechain_metadata_set_lead_silence(&alg, sc, md));
+
+      alg.calc(sc);
+
+      numErrors += (alg.query_element_offset(sc, 0) != alg.query_element_offset(sc, 2));
+
+      // Rendering with / without metadata must be identical
+      numFrames = loc_render_chain(&alg, sc, md, &frames);
+      numErrors += (0 == numFrames);
+      numErrors += (numFrames != loc_render_chain(&alg, sc, NULL, &refFrames));
+
+      if((NULL != frames) && (NULL != refFrames))
+      {
+         numErrors += (0 != memcmp(frames, refFrames, sizeof(int16_t) * numFrames));
+      }
+
+      samplechain_metadata_destroy(md);
+   }
+
+   printf("[meta] chain: %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_metadata: FAILED\n");
+   }
+
+   free(frames);
+   free(refFrames);
+
+   alg.exit(&sc);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+}
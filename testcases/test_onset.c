@@ -0,0 +1,123 @@
+/* ----
+ * ---- file   : test_onset.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../analysis/onset.h"
+
+#define NUM_HITS  8
+
+
+void test_onset(void) {
+
+   static const size_t hitOffsets[NUM_HITS] = { 1000, 30000, 41000, 70000, 98304, 120000, 150500, 171000 };
+   static const size_t hitSizes[NUM_HITS]   = { 9000,  6000, 20000, 12000, 10000, 24000,   3000,  15000 };
+   size_t numFrames = 192000;
+   float32_t *frames = calloc(numFrames, sizeof(float32_t));
+   size_t onsets[64];
+   uint32_t numOnsets;
+   uint32_t hitIdx;
+   uint32_t numErrors = 0;
+   samplechain_onset_params_t params;
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+
+   // Render decaying sine "hits" into the recording
+   for(hitIdx = 0; hitIdx < NUM_HITS; hitIdx++)
+   {
+      size_t i;
+
+      for(i = 0; i < hitSizes[hitIdx]; i++)
+      {
+         frames[hitOffsets[hitIdx] + i] = sinf(i * 0.05f) * expf(-5.0f * i / hitSizes[hitIdx]) * 0.8f;
+      }
+   }
+
+   samplechain_onset_init_params(&params);
+   params.num_threads = 2;
+
+   numOnsets = samplechain_onset_detect(&params, frames, numFrames, onsets, 64);
+
+   printf("[onset] detected %u onsets:\n", numOnsets);
+
+   for(hitIdx = 0; hitIdx < numOnsets; hitIdx++)
+   {
+      printf("[onset]   #%u at frame %u\n", hitIdx, (uint32_t)onsets[hitIdx]);
+
+      if( (hitIdx >= NUM_HITS) ||
+          (onsets[hitIdx] > hitOffsets[hitIdx]) ||
+          ((hitOffsets[hitIdx] - onsets[hitIdx]) >= params.block_size)
+          )
+      {
+         numErrors++;
+      }
+   }
+
+   if((NUM_HITS != numOnsets) || (0 != numErrors))
+   {
+      printf("[---] test_onset: FAILED (expected %u onsets, %u mismatches)\n", NUM_HITS, numErrors);
+   }
+
+   // Leading silence of the first slice (block-aligned onset before the hit)
+   //  - (note) the first sample of each hit is 0 (sin(0))
+   if(numOnsets > 0)
+   {
+      size_t leadSilence = samplechain_onset_find_lead_silence(&params, frames + onsets[0], numFrames - onsets[0]);
+
+      printf("[onset] slice #0 lead silence is %u frames\n", (uint32_t)leadSilence);
+
+      if(leadSilence != (hitOffsets[0] + 1u - onsets[0]))
+      {
+         printf("[---] test_onset: lead silence FAILED (expected %u frames)\n", (uint32_t)(hitOffsets[0] + 1u - onsets[0]));
+      }
+   }
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   printf("[onset] added %u slices\n", samplechain_onset_add_slices(&alg, sc, frames, numFrames, 1, onsets, numOnsets));
+
+   alg.calc(sc);
+
+   printf("[onset] slice #1 user_data is recording frame %u\n",
+          (uint32_t)(((const float32_t*)alg.query_element_user_data(sc, 1)) - frames)
+          );
+
+   printf("total samplechain size is %u sample frames\n", (uint32_t)alg.query_total_size(sc));
+
+   alg.exit(&sc);
+
+   free(frames);
+}
@@ -0,0 +1,210 @@
+/* ----
+ * ---- file   : test_overview.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../analysis/overview.h"
+
+#define NUM_ELEMENTS  8
+#define NUM_PIXELS    500
+#define CHANGED_IDX   3
+
+
+static void loc_minmax(const int16_t *_s, size_t _a, size_t _b, int16_t *_retMin, int16_t *_retMax) {
+   size_t i;
+
+   *_retMin = 32767;
+   *_retMax = -32768;
+
+   for(i = _a; i < _b; i++)
+   {
+      *_retMin = (_s[i] < *_retMin) ? _s[i] : *_retMin;
+      *_retMax = (_s[i] > *_retMax) ? _s[i] : *_retMax;
+   }
+}
+
+// Compare query result with the exact min / max of each pixel ('slack': max. number of neighbouring frames that may be included)
+static uint32_t loc_check_query(const samplechain_overview_t *_ov, const int16_t *_frames, const int16_t *_chain, size_t _totalSz,
+                                size_t _startFrame, size_t _numFrames, size_t _slack
+                                ) {
+   int16_t mn[NUM_PIXELS];
+   int16_t mx[NUM_PIXELS];
+   uint32_t pixelIdx;
+   uint32_t numErrors = 0;
+
+   samplechain_overview_query(_ov, _frames, _startFrame, _numFrames, NUM_PIXELS, mn, mx);
+
+   for(pixelIdx = 0; pixelIdx < NUM_PIXELS; pixelIdx++)
+   {
+      size_t a = _startFrame + (_numFrames * pixelIdx) / NUM_PIXELS;
+      size_t b = _startFrame + (_numFrames * (pixelIdx + 1u)) / NUM_PIXELS;
+      size_t ea = (a > _slack) ? (a - _slack) : 0;
+      size_t eb = ((b + _slack) < _totalSz) ? (b + _slack) : _totalSz;
+      int16_t exactMin, exactMax;
+      int16_t outerMin, outerMax;
+
+      b = (b > a) ? b : (a + 1u);
+
+      loc_minmax(_chain, a, b, &exactMin, &exactMax);
+      loc_minmax(_chain, ea, eb, &outerMin, &outerMax);
+
+      numErrors += (mn[pixelIdx] > exactMin) || (mx[pixelIdx] < exactMax);
+      numErrors += (mn[pixelIdx] < outerMin) || (mx[pixelIdx] > outerMax);
+   }
+
+   return numErrors;
+}
+
+static uint32_t loc_compare_queries(const samplechain_overview_t *_a, const samplechain_overview_t *_b, size_t _totalSz) {
+   int16_t mnA[NUM_PIXELS], mxA[NUM_PIXELS];
+   int16_t mnB[NUM_PIXELS], mxB[NUM_PIXELS];
+   size_t numFrames = _totalSz;
+   uint32_t numErrors = 0;
+
+   while(numFrames >= NUM_PIXELS)
+   {
+      uint32_t pixelIdx;
+
+      samplechain_overview_query(_a, NULL, 0, numFrames, NUM_PIXELS, mnA, mxA);
+      samplechain_overview_query(_b, NULL, 0, numFrames, NUM_PIXELS, mnB, mxB);
+
+      for(pixelIdx = 0; pixelIdx < NUM_PIXELS; pixelIdx++)
+      {
+         numErrors += (mnA[pixelIdx] != mnB[pixelIdx]) || (mxA[pixelIdx] != mxB[pixelIdx]);
+      }
+
+      numFrames /= 4;
+   }
+
+   return numErrors;
+}
+
+void test_overview(void) {
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   samplechain_overview_t *ov;
+   samplechain_overview_t *ovRef;
+   samplechain_overview_t *ovLoaded;
+   size_t elementSizes[NUM_ELEMENTS];
+   size_t totalSz;
+   int16_t *out;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+
+   samplechain_select_algorithm(0, &alg);
+   alg.init(&sc, 120);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementSizes[elementIdx]  = 20000 + (elementIdx * 13331) % 70000;
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * elementSizes[elementIdx]);
+
+      for(i = 0; i < elementSizes[elementIdx]; i++)
+      {
+         // (note) decaying noise-like signal
+         elementFrames[elementIdx][i] = sinf(i * 0.37f * (elementIdx + 1)) * sinf(i * 0.0011f) * expf(-(float32_t)i / elementSizes[elementIdx]);
+      }
+
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   alg.calc(sc);
+
+   totalSz = alg.query_total_size(sc);
+   out = malloc(sizeof(int16_t) * totalSz);
+
+   samplechain_render_init_params(&params);
+   numErrors += !samplechain_render(&alg, sc, &params, out, totalSz);
+
+   ov = samplechain_overview_create(&alg, sc, out);
+   numErrors += (NULL == ov);
+
+   if(NULL != ov)
+   {
+      // Pyramid size vs. audio
+      numErrors += (samplechain_overview_get_num_bytes(ov) > (sizeof(int16_t) * totalSz / 64));
+
+      // Whole chain (coarsest levels), zoomed in (finest level / chain frames)
+      numErrors += loc_check_query(ov, NULL, out, totalSz, 0, totalSz, 65536);
+      numErrors += loc_check_query(ov, NULL, out, totalSz, 1000, totalSz / 8, 4096);
+      numErrors += loc_check_query(ov, NULL, out, totalSz, 12345, 80000, 256);
+      numErrors += loc_check_query(ov, out, out, totalSz, 12345, 20000, 0);
+
+      // Incremental update of one element
+      for(elementIdx = 0; elementIdx < elementSizes[CHANGED_IDX]; elementIdx += 3)
+      {
+         elementFrames[CHANGED_IDX][elementIdx] = -1.0f;
+      }
+
+      numErrors += !samplechain_render(&alg, sc, &params, out, totalSz);
+      numErrors += !samplechain_overview_update_element(ov, &alg, sc, CHANGED_IDX, out);
+
+      ovRef = samplechain_overview_create(&alg, sc, out);
+      numErrors += (NULL == ovRef);
+      numErrors += loc_compare_queries(ov, ovRef, totalSz);
+      numErrors += loc_check_query(ov, NULL, out, totalSz, 0, totalSz, 65536);
+
+      // Cache file roundtrip
+      numErrors += !samplechain_overview_save(ov, "test_overview.tmp.bin");
+      ovLoaded = samplechain_overview_load("test_overview.tmp.bin");
+      numErrors += (NULL == ovLoaded);
+      numErrors += loc_compare_queries(ov, ovLoaded, totalSz);
+      remove("test_overview.tmp.bin");
+
+      printf("[ovw] %u frames, pyramid %u bytes, %u errors\n", (uint32_t)totalSz, (uint32_t)samplechain_overview_get_num_bytes(ov), numErrors);
+
+      samplechain_overview_destroy(ovLoaded);
+      samplechain_overview_destroy(ovRef);
+      samplechain_overview_destroy(ov);
+   }
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_overview: FAILED\n");
+   }
+
+   free(out);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
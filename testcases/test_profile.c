@@ -0,0 +1,143 @@
+/* ----
+ * ---- file   : test_profile.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../util/profile.h"
+
+#define NUM_ELEMENTS  4
+#define TMP_PATHNAME  "test_profile.tmp.json"
+
+
+void test_profile(void) {
+
+   static const size_t elementSizes[NUM_ELEMENTS] = { 2000, 5000, 1200, 3333 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t renderParams;
+   samplechain_profile_t prof;
+   int16_t *rendered;
+   size_t totalSz;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+   bool_t bEnabled;
+
+   samplechain_profile_reset();
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      elementFrames[elementIdx] = calloc(elementSizes[elementIdx], sizeof(float32_t));
+
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   alg.calc(sc);
+
+   totalSz  = alg.query_total_size(sc);
+   rendered = malloc(sizeof(int16_t) * totalSz);
+
+   samplechain_render_init_params(&renderParams);
+   samplechain_render(&alg, sc, &renderParams, rendered, totalSz);
+
+   bEnabled = samplechain_profile_query(&prof);
+
+   if(bEnabled)
+   {
+      uint32_t idx;
+
+      for(idx = 0; idx < SC_PROFILE_NUM_PHASES; idx++)
+      {
+         printf("[prf] %-8s calls=%4u total=%8.3fms max=%8.3fms\n",
+                samplechain_profile_get_phase_name(idx),
+                (uint32_t)prof.phases[idx].num_calls,
+                prof.phases[idx].total_ns / 1000000.0,
+                prof.phases[idx].max_ns / 1000000.0
+                );
+      }
+
+      for(idx = 0; idx < SC_PROFILE_NUM_COUNTERS; idx++)
+      {
+         printf("[prf] %-13s %llu\n", samplechain_profile_get_counter_name(idx), (unsigned long long)prof.counters[idx]);
+      }
+
+      numErrors += (1u != prof.phases[SC_PROFILE_PHASE_CALC].num_calls);
+      numErrors += (1u != prof.phases[SC_PROFILE_PHASE_RENDER].num_calls);
+      numErrors += (prof.counters[SC_PROFILE_COUNTER_ITERATIONS] != prof.phases[SC_PROFILE_PHASE_LAYOUT].num_calls);
+      numErrors += (prof.counters[SC_PROFILE_COUNTER_ALIGN_PASSES] != (2u * prof.counters[SC_PROFILE_COUNTER_ITERATIONS]));
+      numErrors += ((prof.counters[SC_PROFILE_COUNTER_BYTES_COPIED] + prof.counters[SC_PROFILE_COUNTER_BYTES_ZEROED]) != (totalSz * sizeof(int16_t)));
+      numErrors += (0u == prof.num_events);
+
+      if(samplechain_profile_write_trace(TMP_PATHNAME))
+      {
+         char buf[16];
+         FILE *fh = fopen(TMP_PATHNAME, "r");
+
+         numErrors += (NULL == fh) || (14 != fread(buf, 1, 14, fh)) || (0 != memcmp(buf, "{\"traceEvents\"", 14));
+
+         if(NULL != fh)
+         {
+            fclose(fh);
+         }
+
+         remove(TMP_PATHNAME);
+      }
+      else
+      {
+         numErrors++;
+      }
+   }
+
+   printf("[prf] profiling %s, %u errors\n", bEnabled ? "enabled" : "disabled", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_profile: FAILED\n");
+   }
+
+   free(rendered);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
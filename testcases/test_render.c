@@ -0,0 +1,318 @@
+/* ----
+ * ---- file   : test_render.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../analysis/loudness.h"
+#include "../render/render.h"
+#include "../util/thread.h"
+
+#define NUM_ELEMENTS          4
+#define NUM_DERIVED_ELEMENTS  5
+#define DERIVED_SOURCE_SIZE   1000
+
+
+typedef struct {
+   const float32_t             *frames;
+   size_t                       num_frames;
+   const samplechain_derived_t *derived;
+} element_t;
+
+static uint32_t loc_num_fetches;
+
+
+static bool_t loc_fetch(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   const element_t *el = (const element_t*)_userData;
+   (void)_fetchCtx;
+   (void)_numFrames;
+
+   SC_ATOMIC_ADD(&loc_num_fetches, 1u);
+
+   _retSource->frames     = el->frames;
+   _retSource->num_frames = el->num_frames;
+
+   return SC_TRUE;
+}
+
+static const samplechain_derived_t *loc_query_derived(void *_fetchCtx, void *_userData) {
+   (void)_fetchCtx;
+
+   return ((const element_t*)_userData)->derived;
+}
+
+// Reference: derived element sample (see samplechain_derived_t)
+static float32_t loc_calc_derived_sample(const samplechain_derived_t *_d, const float32_t *_src, size_t _frameIdx) {
+   size_t len = (0 != _d->num_frames) ? _d->num_frames : (_d->source_num_frames - _d->start);
+   float64_t pos = _frameIdx * (float64_t)_d->pitch;
+   size_t k0 = (size_t)pos;
+   size_t k1 = k0 + 1u;
+   float32_t frac = (float32_t)(pos - k0);
+
+   k0 = (k0 < len) ? k0 : (len - 1u);
+   k1 = (k1 < len) ? k1 : (len - 1u);
+
+   if(_d->flags & SC_DERIVED_REVERSE)
+   {
+      k0 = len - 1u - k0;
+      k1 = len - 1u - k1;
+   }
+
+   return _src[_d->start + k0] + ((_src[_d->start + k1] - _src[_d->start + k0]) * frac);
+}
+
+// Reversed / attenuated / trimmed / pitched variants of one source
+static uint32_t loc_test_derived(void) {
+   static const size_t expectedSizes[NUM_DERIVED_ELEMENTS] = { DERIVED_SOURCE_SIZE, DERIVED_SOURCE_SIZE, 300, 500, 800 };
+   float32_t *src = malloc(sizeof(float32_t) * DERIVED_SOURCE_SIZE);
+   samplechain_derived_t derived[NUM_DERIVED_ELEMENTS];
+   element_t elements[NUM_DERIVED_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   samplechain_render_stream_t *stream;
+   size_t offsets[NUM_DERIVED_ELEMENTS + 1];
+   size_t origSizes[NUM_DERIVED_ELEMENTS + 1];
+   samplechain_layout_t layout = { offsets, NULL, origSizes, NULL, NULL, NULL, NULL };
+   size_t totalSz;
+   int16_t *out;
+   int16_t *streamOut;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+   size_t i;
+
+   for(i = 0; i < DERIVED_SOURCE_SIZE; i++)
+   {
+      src[i] = sinf(i * 0.05f) * 0.5f + (i * 0.0002f);
+   }
+
+   for(elementIdx = 0; elementIdx < NUM_DERIVED_ELEMENTS; elementIdx++)
+   {
+      samplechain_derived_init(&derived[elementIdx], &elements[0], DERIVED_SOURCE_SIZE);
+
+      elements[elementIdx].frames     = src;
+      elements[elementIdx].num_frames = DERIVED_SOURCE_SIZE;
+      elements[elementIdx].derived    = (0u != elementIdx) ? &derived[elementIdx] : NULL;
+   }
+
+   derived[1].flags      = SC_DERIVED_REVERSE;
+   derived[2].gain       = 0.5f;
+   derived[2].start      = 100;
+   derived[2].num_frames = 300;
+   derived[3].pitch      = 2.0f;
+   derived[4].flags      = SC_DERIVED_REVERSE;
+   derived[4].pitch      = 0.5f;
+   derived[4].start      = 200;
+   derived[4].num_frames = 400;
+
+   samplechain_select_algorithm(0, &alg);
+   alg.init(&sc, 120);
+   alg.set_parameter_i(sc, "extra_padding", 50);
+
+   for(elementIdx = 0; elementIdx < NUM_DERIVED_ELEMENTS; elementIdx++)
+   {
+      size_t numFrames = (0u != elementIdx) ? samplechain_derived_calc_num_frames(&derived[elementIdx]) : DERIVED_SOURCE_SIZE;
+
+      numErrors += (expectedSizes[elementIdx] != numFrames);
+
+      alg.add(sc, numFrames, &elements[elementIdx]);
+   }
+
+   alg.calc(sc);
+
+   totalSz = alg.query_total_size(sc);
+   out = malloc(sizeof(int16_t) * totalSz);
+   streamOut = malloc(sizeof(int16_t) * totalSz);
+
+   samplechain_render_init_params(&params);
+   params.fetch   = &loc_fetch;
+   params.derived = &loc_query_derived;
+
+   loc_num_fetches = 0;
+   numErrors += !samplechain_render(&alg, sc, &params, out, totalSz);
+   numErrors += (NUM_DERIVED_ELEMENTS != loc_num_fetches);
+
+   alg.query_layout(sc, &layout, NUM_DERIVED_ELEMENTS + 1);
+
+   for(elementIdx = 0; elementIdx < NUM_DERIVED_ELEMENTS; elementIdx++)
+   {
+      const int16_t *s = out + offsets[elementIdx];
+
+      numErrors += (expectedSizes[elementIdx] != origSizes[elementIdx]);
+
+      for(i = 0; i < origSizes[elementIdx]; i++)
+      {
+         float32_t f = (0u != elementIdx) ? (loc_calc_derived_sample(&derived[elementIdx], src, i) * derived[elementIdx].gain) : src[i];
+
+         if(abs((int32_t)lrintf(f * 32767.0f) - s[i]) > 1)
+         {
+            numErrors++;
+            break;
+         }
+      }
+   }
+
+   // Render stream (small blocks, i.e. transforms start mid-element)
+   stream = samplechain_render_stream_open(&alg, sc, &params);
+   numErrors += (NULL == stream);
+
+   if(NULL != stream)
+   {
+      size_t num;
+
+      i = 0;
+
+      while((num = samplechain_render_stream_read(stream, streamOut + i, 97)) > 0)
+      {
+         i += num;
+      }
+
+      numErrors += (totalSz != i);
+      numErrors += (0 != memcmp(out, streamOut, sizeof(int16_t) * totalSz));
+
+      samplechain_render_stream_close(stream);
+   }
+
+   printf("[render] derived elements: %u errors\n", numErrors);
+
+   free(streamOut);
+   free(out);
+   free(src);
+
+   alg.exit(&sc);
+
+   return numErrors;
+}
+
+
+void test_render(void) {
+
+   static const size_t elementSizes[NUM_ELEMENTS]    = { 3000, 7000, 1200, 5000 };
+   static const float32_t elementLevels[NUM_ELEMENTS] = { 0.1f, 0.5f, 1.0f, 0.02f };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t params;
+   size_t offsets[NUM_ELEMENTS + 1];
+   size_t totalSizes[NUM_ELEMENTS + 1];
+   samplechain_layout_t layout = { offsets, totalSizes, NULL, NULL, NULL, NULL };
+   size_t totalSz;
+   int16_t *out;
+   uint32_t elementIdx;
+   uint32_t numErrors = 0;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 200);
+   alg.set_parameter_i(sc, "min_padding",   100);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * elementSizes[elementIdx]);
+
+      for(i = 0; i < elementSizes[elementIdx]; i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * 0.01f) * elementLevels[elementIdx];
+      }
+
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   alg.calc(sc);
+
+   totalSz = alg.query_total_size(sc);
+   out = malloc(sizeof(int16_t) * totalSz);
+
+   samplechain_render_init_params(&params);
+   params.normalize_mode     = SC_NORMALIZE_PEAK;
+   params.normalize_level_db = -6.0f;
+   params.num_threads        = 2;
+
+   if(!samplechain_render(&alg, sc, &params, out, totalSz))
+   {
+      printf("[---] test_render: FAILED (render failed)\n");
+   }
+
+   alg.query_layout(sc, &layout, NUM_ELEMENTS + 1);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      const int16_t *s = out + offsets[elementIdx];
+      int32_t peak = 0;
+      int32_t padPeak = 0;
+      size_t i;
+
+      for(i = 0; i < totalSizes[elementIdx]; i++)
+      {
+         int32_t a = abs(s[i]);
+
+         if(i < elementSizes[elementIdx])
+         {
+            peak = (a > peak) ? a : peak;
+         }
+         else
+         {
+            padPeak = (a > padPeak) ? a : padPeak;
+         }
+      }
+
+      printf("[render] element #%u: peak=%d pad peak=%d\n", elementIdx, peak, padPeak);
+
+      // -6dB => 16423
+      if((abs(peak - 16423) > 2) || (0 != padPeak))
+      {
+         numErrors++;
+      }
+   }
+
+   numErrors += loc_test_derived();
+
+   if(0 != numErrors)
+   {
+      printf("[---] test_render: FAILED (%u mismatches)\n", numErrors);
+   }
+
+   free(out);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
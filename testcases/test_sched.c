@@ -0,0 +1,316 @@
+/* ----
+ * ---- file   : test_sched.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../util/thread.h"
+#include "../util/sched.h"
+
+#define NUM_CHAIN_TASKS  100
+#define NUM_MEM_TASKS    32
+#define NUM_SUM_JOBS     1000
+
+
+typedef struct {
+   uint32_t *next_seq;
+   uint32_t *ret_seq;
+} order_task_t;
+
+typedef struct {
+   samplechain_sched_t *sched;
+   uint32_t             sum;
+} nested_t;
+
+
+static void loc_order_task(void *_ctx) {
+   order_task_t *ctx = (order_task_t*)_ctx;
+
+   *ctx->ret_seq = SC_ATOMIC_ADD(ctx->next_seq, 1u);
+}
+
+static void loc_nop_task(void *_ctx) {
+   (void)_ctx;
+}
+
+static void loc_sum_job(void *_ctx, uint32_t _jobIdx) {
+   SC_ATOMIC_ADD((uint32_t*)_ctx, _jobIdx);
+}
+
+// Task that holds its memory reservation until it is released by the test (flags[1])
+static void loc_hold_task(void *_ctx) {
+   uint32_t *flags = (uint32_t*)_ctx;
+
+   SC_ATOMIC_STORE(&flags[0], 1u);
+
+   while(0u == SC_ATOMIC_LOAD(&flags[1]))
+   {
+   }
+}
+
+static void loc_inc_task(void *_ctx) {
+   SC_ATOMIC_ADD((uint32_t*)_ctx, 1u);
+}
+
+// Task that adds (and waits for) sub tasks on the same scheduler
+static void loc_nested_task(void *_ctx) {
+   nested_t *ctx = (nested_t*)_ctx;
+   samplechain_sched_task_t *tasks[8];
+   uint32_t i;
+
+   for(i = 0; i < 8; i++)
+   {
+      tasks[i] = samplechain_sched_add(ctx->sched, &loc_inc_task, &ctx->sum, 0u, NULL, 0u);
+   }
+
+   for(i = 0; i < 8; i++)
+   {
+      samplechain_sched_wait(ctx->sched, tasks[i]);
+   }
+}
+
+static uint32_t loc_test_dependencies(samplechain_sched_t *_sched) {
+   samplechain_sched_task_t *tasks[NUM_CHAIN_TASKS];
+   order_task_t ctx[NUM_CHAIN_TASKS];
+   uint32_t seq[NUM_CHAIN_TASKS];
+   uint32_t nextSeq = 0;
+   uint32_t numErrors = 0;
+   uint32_t i;
+
+   // Chain: each task depends on its predecessor
+   for(i = 0; i < NUM_CHAIN_TASKS; i++)
+   {
+      ctx[i].next_seq = &nextSeq;
+      ctx[i].ret_seq  = &seq[i];
+      tasks[i] = samplechain_sched_add(_sched, &loc_order_task, &ctx[i], 0u, (i > 0) ? &tasks[i - 1] : NULL, (i > 0) ? 1u : 0u);
+      numErrors += (NULL == tasks[i]);
+   }
+
+   for(i = NUM_CHAIN_TASKS; i > 0; i--)
+   {
+      samplechain_sched_wait(_sched, tasks[i - 1]);
+   }
+
+   for(i = 0; i < NUM_CHAIN_TASKS; i++)
+   {
+      numErrors += (i != seq[i]);
+   }
+
+   // Diamond: 0 -> (1, 2) -> 3, then 4 depends on an already completed task
+   nextSeq = 0;
+
+   for(i = 0; i < 5; i++)
+   {
+      ctx[i].ret_seq = &seq[i];
+   }
+
+   tasks[0] = samplechain_sched_add(_sched, &loc_order_task, &ctx[0], 0u, NULL, 0u);
+   tasks[1] = samplechain_sched_add(_sched, &loc_order_task, &ctx[1], 0u, &tasks[0], 1u);
+   tasks[2] = samplechain_sched_add(_sched, &loc_order_task, &ctx[2], 0u, &tasks[0], 1u);
+   tasks[3] = samplechain_sched_add(_sched, &loc_order_task, &ctx[3], 0u, &tasks[1], 2u);
+   samplechain_sched_wait(_sched, tasks[3]);
+
+   tasks[4] = samplechain_sched_add(_sched, &loc_order_task, &ctx[4], 0u, &tasks[0], 1u);
+   samplechain_sched_wait(_sched, tasks[4]);
+
+   for(i = 0; i < 3; i++)
+   {
+      samplechain_sched_wait(_sched, tasks[i]);
+   }
+
+   numErrors += (0 != seq[0]);
+   numErrors += (seq[1] < 1 || seq[1] > 2);
+   numErrors += (seq[2] < 1 || seq[2] > 2);
+   numErrors += (3 != seq[3]);
+   numErrors += (4 != seq[4]);
+
+   return numErrors;
+}
+
+static uint32_t loc_test_memory_cap(void) {
+   samplechain_sched_t *sched = samplechain_sched_create(4, 1000);
+   samplechain_sched_task_t *tasks[NUM_MEM_TASKS];
+   samplechain_sched_task_t *groupTasks[2][4];
+   samplechain_sched_stats_t stats;
+   uint32_t numErrors = 0;
+   uint32_t i;
+   uint32_t groupIdx;
+
+   if(NULL == sched)
+   {
+      return 1;
+   }
+
+   // Independent tasks: each reservation lasts until the task has completed
+   for(i = 0; i < NUM_MEM_TASKS; i++)
+   {
+      tasks[i] = samplechain_sched_add(sched, &loc_nop_task, NULL, 300, NULL, 0u);
+      numErrors += (NULL == tasks[i]);
+   }
+
+   for(i = 0; i < NUM_MEM_TASKS; i++)
+   {
+      samplechain_sched_wait(sched, tasks[i]);
+   }
+
+   // Two groups that do not fit into the cap at the same time (gate task + producers + consumer)
+   for(groupIdx = 0; groupIdx < 2; groupIdx++)
+   {
+      groupTasks[groupIdx][0] = samplechain_sched_add(sched, &loc_nop_task, NULL, 800, NULL, 0u);
+
+      for(i = 1; i < 3; i++)
+      {
+         groupTasks[groupIdx][i] = samplechain_sched_add(sched, &loc_nop_task, NULL, 0u, &groupTasks[groupIdx][0], 1u);
+      }
+
+      groupTasks[groupIdx][3] = samplechain_sched_add(sched, &loc_nop_task, NULL, 0u, &groupTasks[groupIdx][0], 3u);
+
+      for(i = 0; i < 3; i++)
+      {
+         samplechain_sched_release(sched, groupTasks[groupIdx][i]);
+      }
+   }
+
+   samplechain_sched_wait(sched, groupTasks[0][3]);
+   samplechain_sched_wait(sched, groupTasks[1][3]);
+
+#ifndef SC_NO_THREADS
+   // A waiting task that is admitted when another task releases its memory counts towards the peak
+   //  - (note) the earlier tasks reserve at most 900 bytes at the same time
+   {
+      uint32_t flags[2] = { 0u, 0u };
+
+      tasks[0] = samplechain_sched_add(sched, &loc_hold_task, flags, 100, NULL, 0u);
+
+      while(0u == SC_ATOMIC_LOAD(&flags[0]))
+      {
+      }
+
+      tasks[1] = samplechain_sched_add(sched, &loc_nop_task, NULL, 1000, NULL, 0u);
+
+      SC_ATOMIC_STORE(&flags[1], 1u);
+
+      samplechain_sched_wait(sched, tasks[0]);
+      samplechain_sched_wait(sched, tasks[1]);
+   }
+#endif
+
+   samplechain_sched_get_stats(sched, &stats);
+
+#ifndef SC_NO_THREADS
+   numErrors += (4 != stats.num_threads);
+   numErrors += (NUM_MEM_TASKS + 10 != stats.num_tasks_run);
+   numErrors += (1000 != stats.mem_peak);
+#else
+   numErrors += (NUM_MEM_TASKS + 8 != stats.num_tasks_run);
+   numErrors += (stats.mem_peak > 1000);
+#endif
+   numErrors += (0 != stats.mem_in_use);
+
+   printf("[sch] memory cap: peak=%u waits=%u steals=%u\n",
+          (uint32_t)stats.mem_peak, (uint32_t)stats.num_mem_waits, (uint32_t)stats.num_steals
+          );
+
+   samplechain_sched_destroy(sched);
+
+   return numErrors;
+}
+
+void test_sched(void) {
+   samplechain_sched_t *sched = samplechain_sched_create(4, 0);
+   uint32_t numErrors = 0;
+   uint32_t sum = 0;
+
+   if(NULL != sched)
+   {
+      nested_t nested;
+      samplechain_sched_task_t *task;
+
+      numErrors += loc_test_dependencies(sched);
+
+      nested.sched = sched;
+      nested.sum   = 0;
+      task = samplechain_sched_add(sched, &loc_nested_task, &nested, 0u, NULL, 0u);
+      samplechain_sched_wait(sched, task);
+      numErrors += (8 != nested.sum);
+
+      samplechain_sched_destroy(sched);
+   }
+   else
+   {
+      numErrors++;
+   }
+
+   numErrors += loc_test_memory_cap();
+
+   // sc_parallel_for() runs on the default scheduler
+   sc_parallel_for(NUM_SUM_JOBS, &loc_sum_job, &sum, 8);
+   numErrors += (((NUM_SUM_JOBS - 1) * NUM_SUM_JOBS / 2) != sum);
+
+   // .. or on the scheduler of the application
+   sched = samplechain_sched_create(2, 0);
+
+   if(NULL != sched)
+   {
+      samplechain_sched_stats_t stats;
+      samplechain_sched_t *defaultSched = samplechain_sched_get_default();
+
+      samplechain_sched_set_default(sched);
+      numErrors += (sched != samplechain_sched_get_default());
+
+      sum = 0;
+      sc_parallel_for(NUM_SUM_JOBS, &loc_sum_job, &sum, 8);
+      numErrors += (((NUM_SUM_JOBS - 1) * NUM_SUM_JOBS / 2) != sum);
+
+      samplechain_sched_set_default(NULL);
+      numErrors += (defaultSched != samplechain_sched_get_default());
+
+      samplechain_sched_get_stats(sched, &stats);
+#ifndef SC_NO_THREADS
+      numErrors += (0u == stats.num_tasks_run);
+#endif
+
+      samplechain_sched_destroy(sched);
+   }
+   else
+   {
+      numErrors++;
+   }
+
+   printf("[sch] scheduler: %u errors\n", numErrors);
+
+   if(numErrors > 0)
+   {
+      printf("[---] test_sched: FAILED\n");
+   }
+}
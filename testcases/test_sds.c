@@ -0,0 +1,203 @@
+/* ----
+ * ---- file   : test_sds.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../io/sds.h"
+
+#define NUM_ELEMENTS  3
+
+
+typedef struct {
+   uint8_t *data;
+   size_t   size;
+   size_t   max_size;
+} membuf_t;
+
+
+static bool_t loc_write_membuf(void *_mb, const void *_data, size_t _numBytes) {
+   membuf_t *mb = (membuf_t*)_mb;
+
+   if((mb->size + _numBytes) > mb->max_size)
+   {
+      return SC_FALSE;
+   }
+
+   memcpy(mb->data + mb->size, _data, _numBytes);
+   mb->size += _numBytes;
+
+   return SC_TRUE;
+}
+
+// Reference decoder
+//  - Returns number of decoded samples, or 0 if the dump is invalid
+static size_t loc_decode_sds(const uint8_t *_d, size_t _numBytes, int16_t *_retSamples, size_t _maxSamples) {
+   size_t numSamples;
+   size_t smpIdx = 0;
+   size_t off = SC_SDS_HEADER_SIZE;
+   uint32_t packetNr = 0;
+
+   if( (_numBytes < SC_SDS_HEADER_SIZE) || (0xF0 != _d[0]) || (0x7E != _d[1]) || (0x01 != _d[3]) || (16 != _d[6]) || (0xF7 != _d[20]) )
+   {
+      return 0;
+   }
+
+   numSamples = _d[10] | (_d[11] << 7) | (_d[12] << 14);
+
+   if(numSamples > _maxSamples)
+   {
+      return 0;
+   }
+
+   while(smpIdx < numSamples)
+   {
+      const uint8_t *p = _d + off;
+      uint8_t chk = 0;
+      uint32_t i;
+
+      if( ((off + SC_SDS_PACKET_SIZE) > _numBytes) || (0xF0 != p[0]) || (0x02 != p[3]) || ((packetNr & 127u) != p[4]) || (0xF7 != p[126]) )
+      {
+         return 0;
+      }
+
+      for(i = 1; i < 125; i++)
+      {
+         chk ^= p[i];
+      }
+
+      if((chk & 127u) != p[125])
+      {
+         return 0;
+      }
+
+      for(i = 0; (i < SC_SDS_SAMPLES_PER_PACKET) && (smpIdx < numSamples); i++)
+      {
+         uint32_t v = (p[5 + 3*i] << 9) | (p[6 + 3*i] << 2) | (p[7 + 3*i] >> 5);
+
+         _retSamples[smpIdx++] = (int16_t)((int32_t)v - 32768);
+      }
+
+      off += SC_SDS_PACKET_SIZE;
+      packetNr++;
+   }
+
+   return (off == _numBytes) ? numSamples : 0;
+}
+
+void test_sds(void) {
+
+   static const size_t elementSizes[NUM_ELEMENTS] = { 1234, 3001, 777 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_t sc;
+   samplechain_render_params_t renderParams;
+   samplechain_sds_params_t sdsParams;
+   membuf_t mb;
+   int16_t *rendered;
+   int16_t *decoded;
+   size_t totalSz;
+   size_t numDecoded;
+   uint32_t elementIdx;
+
+   // (note) use fixed size slices so that the chain size is not a multiple of the packet size
+   samplechain_select_algorithm(1, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "extra_padding", 100);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * elementSizes[elementIdx]);
+
+      for(i = 0; i < elementSizes[elementIdx]; i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * 0.03f * (elementIdx + 1)) * 0.9f;
+      }
+
+      alg.add(sc, elementSizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   alg.set_parameter_i(sc, "chain_size", NUM_ELEMENTS);
+
+   alg.calc(sc);
+
+   totalSz = alg.query_total_size(sc);
+
+   rendered = malloc(sizeof(int16_t) * totalSz);
+   decoded  = malloc(sizeof(int16_t) * totalSz);
+
+   mb.max_size = SC_SDS_HEADER_SIZE + ((totalSz / SC_SDS_SAMPLES_PER_PACKET) + 1) * SC_SDS_PACKET_SIZE;
+   mb.data     = malloc(mb.max_size);
+   mb.size     = 0;
+
+   samplechain_render_init_params(&renderParams);
+   samplechain_render(&alg, sc, &renderParams, rendered, totalSz);
+
+   samplechain_sds_init_params(&sdsParams);
+   sdsParams.packets_per_block = 3; // (note) exercise block boundaries
+
+   if(!samplechain_sds_encode(&alg, sc, &renderParams, &sdsParams, &loc_write_membuf, &mb))
+   {
+      printf("[---] test_sds: FAILED (encode failed)\n");
+   }
+   else
+   {
+      numDecoded = loc_decode_sds(mb.data, mb.size, decoded, totalSz);
+
+      printf("[sds] encoded %u frames to %u bytes, decoded %u frames\n",
+             (uint32_t)totalSz, (uint32_t)mb.size, (uint32_t)numDecoded
+             );
+
+      if((numDecoded != totalSz) || (0 != memcmp(rendered, decoded, sizeof(int16_t) * totalSz)))
+      {
+         printf("[---] test_sds: FAILED (decoded data mismatch)\n");
+      }
+   }
+
+   free(mb.data);
+   free(decoded);
+   free(rendered);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+
+   alg.exit(&sc);
+}
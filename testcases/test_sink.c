@@ -0,0 +1,324 @@
+/* ----
+ * ---- file   : test_sink.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../render/render.h"
+#include "../io/wav.h"
+#include "../io/sink.h"
+
+#define NUM_ELEMENTS  6
+#define TMP_PATHNAME  "test_sink.tmp.wav"
+
+
+static uint32_t loc_get_u32(const uint8_t *_s) {
+   return (uint32_t)_s[0] | ((uint32_t)_s[1] << 8) | ((uint32_t)_s[2] << 16) | ((uint32_t)_s[3] << 24);
+}
+
+static uint8_t *loc_load_file(const char *_pathName, size_t *_retSize) {
+   uint8_t *ret = NULL;
+   FILE *fh = fopen(_pathName, "rb");
+
+   if(NULL != fh)
+   {
+      long sz;
+
+      fseek(fh, 0, SEEK_END);
+      sz = ftell(fh);
+      fseek(fh, 0, SEEK_SET);
+
+      ret = malloc((size_t)sz);
+
+      if((NULL != ret) && ((size_t)sz == fread(ret, 1, (size_t)sz, fh)))
+      {
+         *_retSize = (size_t)sz;
+      }
+      else
+      {
+         free(ret);
+         ret = NULL;
+      }
+
+      fclose(fh);
+   }
+
+   return ret;
+}
+
+// Compare the file written by the sink with the chain rendered into memory
+//  - Returns the number of mismatches
+static uint32_t loc_verify_file(samplechain_algorithm_t *_alg, samplechain_t _sc, const int16_t *_expected, size_t _numFrames) {
+   uint32_t ret = 0;
+   samplechain_wav_info_t info;
+   size_t fileSz;
+   uint8_t *file = loc_load_file(TMP_PATHNAME, &fileSz);
+   size_t offsets[NUM_ELEMENTS + 1];
+   uint32_t sourceIndices[NUM_ELEMENTS + 1];
+   size_t origSizes[NUM_ELEMENTS + 1];
+   samplechain_layout_t layout;
+   uint32_t n;
+   uint32_t elementIdx;
+   uint32_t numCues = 0;
+
+   memset(&layout, 0, sizeof(layout));
+   layout.offsets        = offsets;
+   layout.orig_sizes     = origSizes;
+   layout.source_indices = sourceIndices;
+
+   n = _alg->query_layout(_sc, &layout, NUM_ELEMENTS + 1);
+
+   if( (NULL == file) ||
+       !samplechain_wav_read_info(TMP_PATHNAME, &info) ||
+       (2u != info.num_channels) || (44100u != info.sample_rate) || (_numFrames != info.num_frames) ||
+       (fileSz != (info.data_offset + (_numFrames * 2u * sizeof(int16_t))))
+       )
+   {
+      ret++;
+   }
+   else
+   {
+      // Sample data
+      if(0 != memcmp(file + info.data_offset, _expected, _numFrames * 2u * sizeof(int16_t)))
+      {
+         ret++;
+      }
+
+      // Cue points (one per chain region, no duplicates / pad elements)
+      if(0 != memcmp(file + 36, "cue ", 4))
+      {
+         ret++;
+      }
+      else
+      {
+         for(elementIdx = 0; elementIdx < n; elementIdx++)
+         {
+            if((sourceIndices[elementIdx] == elementIdx) && (origSizes[elementIdx] > 0u))
+            {
+               const uint8_t *cue = file + 48 + (24u * numCues);
+
+               if((loc_get_u32(cue) != (numCues + 1u)) || (loc_get_u32(cue + 20) != (uint32_t)offsets[elementIdx]))
+               {
+                  ret++;
+               }
+
+               numCues++;
+            }
+         }
+
+         if(loc_get_u32(file + 44) != numCues)
+         {
+            ret++;
+         }
+      }
+   }
+
+   free(file);
+
+   return ret;
+}
+
+// Update the file written for the original chain in place with a changed chain (elements in reverse order)
+//  - The sample frames move, the number of sample frames and cue points stays the same
+//  - Returns the number of errors
+static uint32_t loc_test_update(samplechain_algorithm_t *_alg, const size_t *_sizes, float32_t *const *_elementFrames,
+                                const samplechain_render_params_t *_params, size_t _numFrames
+                                ) {
+   uint32_t ret = 0;
+   samplechain_t sc;
+   samplechain_t scNoAlias;
+   int16_t *expected = NULL;
+   size_t regions[2];
+   uint32_t elementIdx;
+
+   _alg->init(&sc, 120);
+   _alg->init(&scNoAlias, 120);
+
+   _alg->set_parameter_i(sc, "num_channels", 2);
+   _alg->set_parameter_i(scNoAlias, "num_channels", 2);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      _alg->add(sc, _sizes[NUM_ELEMENTS - 1u - elementIdx], _elementFrames[NUM_ELEMENTS - 1u - elementIdx]);
+      _alg->add(scNoAlias, _sizes[NUM_ELEMENTS - 1u - elementIdx], _elementFrames[NUM_ELEMENTS - 1u - elementIdx]);
+   }
+
+   _alg->set_element_alias(sc, 4, 2);
+
+   _alg->calc(sc);
+   _alg->calc(scNoAlias);
+
+   regions[0] = 0u;
+   regions[1] = _alg->query_total_size(sc);
+
+   if(_numFrames == regions[1])
+   {
+      expected = malloc(sizeof(int16_t) * 2u * _numFrames);
+   }
+
+   if( (NULL == expected) ||
+       !samplechain_render(_alg, sc, _params, expected, _numFrames) ||
+       !samplechain_wav_update_s16(TMP_PATHNAME, expected, _numFrames, 2u, 44100u, regions, 1u) ||
+       !samplechain_wav_sink_update_header(TMP_PATHNAME, _alg, sc, 44100u)
+       )
+   {
+      ret++;
+   }
+   else
+   {
+      // Cue points were rewritten
+      ret += loc_verify_file(_alg, sc, expected, _numFrames);
+
+      // (note) a different number of cue points moves the sample frames, i.e. the file must be rewritten from scratch
+      ret += samplechain_wav_sink_update_header(TMP_PATHNAME, _alg, scNoAlias, 44100u);
+      ret += loc_verify_file(_alg, sc, expected, _numFrames);
+   }
+
+   free(expected);
+
+   _alg->exit(&sc);
+   _alg->exit(&scNoAlias);
+
+   return ret;
+}
+
+void test_sink(void) {
+
+   static const size_t sizes[NUM_ELEMENTS] = { 3000, 12000, 700, 12000, 5000, 9000 };
+   float32_t *elementFrames[NUM_ELEMENTS];
+   samplechain_algorithm_t alg;
+   samplechain_render_params_t params;
+   samplechain_wav_sink_t *sink;
+   samplechain_t sc;
+   int16_t *expected;
+   size_t numFrames;
+   uint32_t numErrors = 0;
+   uint32_t elementIdx;
+
+   samplechain_select_algorithm(0, &alg);
+
+   alg.init(&sc, 120);
+
+   alg.set_parameter_i(sc, "num_channels", 2);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      size_t i;
+
+      elementFrames[elementIdx] = malloc(sizeof(float32_t) * 2u * sizes[elementIdx]);
+
+      for(i = 0; i < (2u * sizes[elementIdx]); i++)
+      {
+         elementFrames[elementIdx][i] = sinf(i * 0.01f * (elementIdx + 1u)) * 0.5f;
+      }
+
+      alg.add(sc, sizes[elementIdx], elementFrames[elementIdx]);
+   }
+
+   // (note) element #3 shares the chain region of element #1
+   alg.set_element_alias(sc, 3, 1);
+
+   alg.calc(sc);
+
+   numFrames = alg.query_total_size(sc);
+   expected = malloc(sizeof(int16_t) * 2u * numFrames);
+
+   samplechain_render_init_params(&params);
+   params.num_threads = 4;
+
+   if(!samplechain_render(&alg, sc, &params, expected, numFrames))
+   {
+      printf("[---] test_sink: FAILED (render failed)\n");
+   }
+   else
+   {
+      // Render into the (mapped) file
+      sink = samplechain_wav_sink_open(TMP_PATHNAME, &alg, sc, 44100);
+
+      if( (NULL == sink) ||
+          !samplechain_wav_sink_render(sink, &alg, sc, &params) ||
+          !samplechain_wav_sink_close(sink)
+          )
+      {
+         numErrors++;
+      }
+      else
+      {
+         numErrors += loc_verify_file(&alg, sc, expected, numFrames);
+      }
+
+      // Positioned writes (out of order)
+      sink = samplechain_wav_sink_open(TMP_PATHNAME, &alg, sc, 44100);
+
+      if( (NULL == sink) ||
+          !samplechain_wav_sink_write(sink, expected + (2u * 1000u), 1000u, numFrames - 1000u) ||
+          !samplechain_wav_sink_write(sink, expected, 0u, 1000u) ||
+          samplechain_wav_sink_write(sink, expected, numFrames - 10u, 11u)
+          )
+      {
+         numErrors++;
+      }
+
+      // (note) the failed out of range write is reported by close()
+      if((NULL == sink) || samplechain_wav_sink_close(sink))
+      {
+         numErrors++;
+      }
+      else
+      {
+         numErrors += loc_verify_file(&alg, sc, expected, numFrames);
+      }
+
+      // Update in place (changed layout)
+      numErrors += loc_test_update(&alg, sizes, elementFrames, &params, numFrames);
+
+      printf("[snk] wrote %u sample frames, %u errors\n", (uint32_t)numFrames, numErrors);
+
+      if(numErrors > 0)
+      {
+         printf("[---] test_sink: FAILED\n");
+      }
+   }
+
+   remove(TMP_PATHNAME);
+
+   free(expected);
+
+   alg.exit(&sc);
+
+   for(elementIdx = 0; elementIdx < NUM_ELEMENTS; elementIdx++)
+   {
+      free(elementFrames[elementIdx]);
+   }
+}
@@ -0,0 +1,123 @@
+/* ----
+ * ---- file   : test_util.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "test_util.h"
+
+#define MAX_LAYOUT_ELEMENTS  121
+
+
+uint32_t test_util_verify_layout(const samplechain_algorithm_t *_alg, samplechain_t _sc) {
+   uint32_t ret = 0;
+   size_t offsets[MAX_LAYOUT_ELEMENTS];
+   size_t totalSizes[MAX_LAYOUT_ELEMENTS];
+   size_t origSizes[MAX_LAYOUT_ELEMENTS];
+   uint32_t sourceIndices[MAX_LAYOUT_ELEMENTS];
+   samplechain_layout_t layout;
+   uint32_t numElements;
+   uint32_t elementIdx;
+   size_t nextOffset = 0;
+
+   layout.offsets        = offsets;
+   layout.total_sizes    = totalSizes;
+   layout.orig_sizes     = origSizes;
+   layout.pad_sizes      = NULL;
+   layout.sta            = NULL;
+   layout.end            = NULL;
+   layout.source_indices = sourceIndices;
+
+   numElements = _alg->query_layout(_sc, &layout, MAX_LAYOUT_ELEMENTS);
+
+   ret += (0u == numElements);
+   ret += (numElements < _alg->query_num_elements(_sc));
+
+   for(elementIdx = 0; elementIdx < numElements; elementIdx++)
+   {
+      uint32_t srcIdx = sourceIndices[elementIdx];
+
+      if(srcIdx == elementIdx)
+      {
+         ret += (offsets[elementIdx] != nextOffset);
+         ret += (origSizes[elementIdx] > totalSizes[elementIdx]);
+
+         nextOffset = offsets[elementIdx] + totalSizes[elementIdx];
+      }
+      else
+      {
+         ret += (srcIdx > elementIdx);
+         ret += (srcIdx < elementIdx) && (offsets[elementIdx] != offsets[srcIdx]);
+      }
+   }
+
+   ret += (nextOffset != _alg->query_total_size(_sc));
+
+   if(ret > 0u)
+   {
+      printf("[---] test_util_verify_layout: %u errors in layout of %u elements\n", ret, numElements);
+   }
+
+   return ret;
+}
+
+uint32_t test_util_budget(const samplechain_algorithm_t *_alg, samplechain_t _sc, int32_t _maxTotalBytes,
+                          size_t _expectedTotalSize, size_t _expectedBytesOverBudget
+                          ) {
+   uint32_t ret = 0;
+   size_t totalSz;
+
+   _alg->set_parameter_i(_sc, "bytes_per_sample", 2);
+   _alg->set_parameter_i(_sc, "num_channels",     2);
+   _alg->set_parameter_i(_sc, "max_total_bytes",  _maxTotalBytes);
+
+   _alg->calc(_sc);
+
+   totalSz = _alg->query_total_size(_sc);
+
+   printf("max_total_bytes=%d: total chain size is %u sample frames (%u bytes), %u bytes over budget\n",
+          _maxTotalBytes,
+          (uint32_t)totalSz,
+          (uint32_t)(totalSz * 4u),
+          (uint32_t)_alg->query_bytes_over_budget(_sc)
+          );
+
+   ret += (_expectedTotalSize != totalSz);
+   ret += (_expectedBytesOverBudget != _alg->query_bytes_over_budget(_sc));
+   ret += ((totalSz * 4u) > (size_t)_maxTotalBytes);
+
+   if(totalSz > 0u)
+   {
+      ret += test_util_verify_layout(_alg, _sc);
+   }
+
+   return ret;
+}
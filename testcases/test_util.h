@@ -0,0 +1,52 @@
+/* ----
+ * ---- file   : test_util.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_TEST_UTIL_H_INCLUDED
+#define SAMPLECHAIN_TEST_UTIL_H_INCLUDED
+
+
+// Check the layout returned by query_layout()
+//  - Chain regions (elements that are not aliases) are contiguous, start at 0 and end at the total size
+//  - Aliases share the region of their source element
+//  - The original size of each element fits into its region
+//  - Returns the number of errors
+uint32_t test_util_verify_layout (const samplechain_algorithm_t *_alg, samplechain_t _sc);
+
+// Calculate a 16bit stereo chain with a memory budget (see "max_total_bytes") and check the result
+//  - 'sc' must have been initialized, configured and its elements must have been added
+//  - 'expectedTotalSize' is the total chain size in sample frames (0=the chain does not fit into the budget)
+//  - 'expectedBytesOverBudget' is the number of bytes the smallest valid chain exceeds the budget by
+//  - Returns the number of errors
+uint32_t test_util_budget (const samplechain_algorithm_t *_alg, samplechain_t _sc, int32_t _maxTotalBytes,
+                           size_t _expectedTotalSize, size_t _expectedBytesOverBudget
+                           );
+
+
+#endif // SAMPLECHAIN_TEST_UTIL_H_INCLUDED
@@ -0,0 +1,157 @@
+/* ----
+ * ---- file   : test_wav.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../io/wav.h"
+
+#define NUM_FRAMES   1000
+#define TMP_PATHNAME "test_wav.tmp.wav"
+
+
+void test_wav(void) {
+   int16_t *frames = malloc(sizeof(int16_t) * NUM_FRAMES * 2);
+   samplechain_wav_info_t info;
+   float32_t *loaded;
+   uint32_t numErrors = 0;
+   size_t i;
+
+   for(i = 0; i < NUM_FRAMES; i++)
+   {
+      frames[i * 2 + 0] = (int16_t)(sinf(i * 0.05f) * 30000.0f);
+      frames[i * 2 + 1] = (int16_t)(i * 7 - 3500);
+   }
+
+   if(!samplechain_wav_save_s16(TMP_PATHNAME, frames, NUM_FRAMES, 2, 44100))
+   {
+      printf("[---] test_wav: FAILED (save failed)\n");
+   }
+   else if( !samplechain_wav_read_info(TMP_PATHNAME, &info) ||
+            (1 != info.format) || (2 != info.num_channels) || (44100 != info.sample_rate) ||
+            (16 != info.bits_per_sample) || (NUM_FRAMES != info.num_frames) || (SC_WAV_HEADER_SIZE != info.data_offset)
+            )
+   {
+      printf("[---] test_wav: FAILED (header mismatch)\n");
+   }
+   else
+   {
+      // Stereo roundtrip
+      loaded = samplechain_wav_load(TMP_PATHNAME, 2, &info);
+
+      if(NULL == loaded)
+      {
+         numErrors++;
+      }
+      else
+      {
+         for(i = 0; i < (NUM_FRAMES * 2); i++)
+         {
+            if((int16_t)lrintf(loaded[i] * 32768.0f) != frames[i])
+            {
+               numErrors++;
+            }
+         }
+
+         free(loaded);
+      }
+
+      // Downmix to mono
+      loaded = samplechain_wav_load(TMP_PATHNAME, 1, &info);
+
+      if(NULL == loaded)
+      {
+         numErrors++;
+      }
+      else
+      {
+         for(i = 0; i < NUM_FRAMES; i++)
+         {
+            float32_t expected = (frames[i * 2 + 0] + frames[i * 2 + 1]) * (0.5f / 32768.0f);
+
+            if(fabsf(loaded[i] - expected) > 1e-6f)
+            {
+               numErrors++;
+            }
+         }
+
+         free(loaded);
+      }
+
+      // Partial in-place update
+      {
+         static const size_t regions[4] = { 100, 50, 900, 100 };
+
+         for(i = 0; i < (NUM_FRAMES * 2); i++)
+         {
+            frames[i] = (int16_t)~frames[i];
+         }
+
+         if(!samplechain_wav_update_s16(TMP_PATHNAME, frames, NUM_FRAMES, 2, 44100, regions, 2))
+         {
+            numErrors++;
+         }
+         else if(NULL == (loaded = samplechain_wav_load(TMP_PATHNAME, 2, &info)))
+         {
+            numErrors++;
+         }
+         else
+         {
+            for(i = 0; i < NUM_FRAMES; i++)
+            {
+               bool_t bUpdated = ((i >= 100) && (i < 150)) || (i >= 900);
+               int16_t expected = bUpdated ? frames[i * 2] : (int16_t)~frames[i * 2];
+
+               if((int16_t)lrintf(loaded[i * 2] * 32768.0f) != expected)
+               {
+                  numErrors++;
+               }
+            }
+
+            free(loaded);
+         }
+      }
+
+      printf("[wav] roundtrip %u frames, %u errors\n", NUM_FRAMES, numErrors);
+
+      if(numErrors > 0)
+      {
+         printf("[---] test_wav: FAILED (sample data mismatch)\n");
+      }
+   }
+
+   remove(TMP_PATHNAME);
+
+   free(frames);
+}
@@ -0,0 +1,1466 @@
+/* ----
+ * ---- file   : samplechain.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <sys/stat.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "../analysis/loudness.h"
+#include "../render/render.h"
+#include "../render/cache.h"
+#include "../io/archive.h"
+#include "../io/daemon.h"
+#include "../io/wav.h"
+#include "../io/sink.h"
+#include "../util/kernels.h"
+#include "../util/profile.h"
+#include "../util/sched.h"
+
+#define MAX_PARAMS     32
+#define MAX_PATH_LEN   1024
+
+#define ALGORITHM_AUTO  (~0u)  // see samplechain_select_auto()
+
+
+struct app_s;
+struct kit_s;
+
+typedef struct {
+   char *path_name;
+
+   samplechain_wav_info_t info;
+
+   bool_t b_valid;
+
+   // Variant of the file (manifest "<path> | <transform> ..")
+   //  - (note) the source is the file itself (decoded once via the sample cache)
+   bool_t                b_derived;
+   samplechain_derived_t derived;
+
+   struct kit_s              *kit;    // set when the kit layout has been calculated
+   samplechain_cache_entry_t *entry;  // pinned decoded audio (until the kit has been rendered)
+
+} file_t;
+
+typedef struct kit_s {
+   char name[256];
+
+   uint32_t first_file_idx;
+   uint32_t num_files;
+
+   bool_t b_ok;
+
+   // Build state (see loc_layout_kit_task())
+   struct app_s             *app;
+   samplechain_algorithm_t   alg;
+   samplechain_t             sc;
+   int32_t                   num_channels;
+   uint32_t                  sample_rate;
+   samplechain_sched_task_t *write_task;
+
+} kit_t;
+
+typedef struct app_s {
+   // Options
+   uint32_t    algorithm_idx;
+   uint32_t    num_slices;
+   uint32_t    num_threads;
+   uint32_t    max_mem_mb;
+   uint32_t    max_cache_mb;
+   uint32_t    normalize_mode;
+   float32_t   normalize_level_db;
+   const char *out_dir;
+   const char *trace_path_name;
+   const char *daemon_socket_name;
+   bool_t      b_update;
+   bool_t      b_archive;
+   const char *param_names[MAX_PARAMS];
+   const char *param_values[MAX_PARAMS];
+   uint32_t    num_params;
+
+   // Input
+   file_t  *files;
+   uint32_t num_files;
+   uint32_t max_files;
+
+   kit_t   *kits;
+   uint32_t num_kits;
+   uint32_t max_kits;
+
+   samplechain_sched_t *sched;
+
+} app_t;
+
+
+static void loc_usage(void) {
+   uint32_t algIdx;
+
+   printf("usage: samplechain [options] <kit> [<kit> ..]\n"
+          "  <kit>             directory (all .wav files, sorted by name) or manifest file (one .wav file per line)\n"
+          "                    manifest lines may add a variant transform: <file> | [reverse] [gain=<dB>] [start=<frame>]\n"
+          "                    [length=<frames>] [pitch=<semitones>]\n"
+          "  -a <algorithm>    algorithm index or (partial) name, or \"auto\" (default: 0)\n"
+          "  -p <name>=<value> set algorithm parameter (e.g. -p extra_padding=2000)\n"
+          "  -s <num_slices>   number of slices (default: 120)\n"
+          "  -n <peak|rms>     normalize elements\n"
+          "  -l <dB>           normalization level (default: -1)\n"
+          "  -j <num_threads>  number of worker threads (default: number of CPU cores)\n"
+          "  -c <MB>           decoded sample cache size (default: 256)\n"
+          "  -m <MB>           memory cap for decoded / rendered audio of kits in flight (default: unlimited)\n"
+          "  -o <dir>          output directory (default: .)\n"
+          "  -t <file>         print per-phase timers / counters and write Chrome trace JSON (requires SC_PROFILE build)\n"
+          "  -u                update mode: only rewrite the parts of existing chain files that changed\n"
+          "  -z                also write a compressed chain archive (<kit>.sca, see io/archive.h)\n"
+          "  -D <socket>       run as build daemon on a Unix domain socket until interrupted (see io/daemon.h)\n"
+          "algorithms:\n"
+          );
+
+   for(algIdx = 0; algIdx < samplechain_get_num_algorithms(); algIdx++)
+   {
+      samplechain_algorithm_t alg;
+
+      if(samplechain_select_algorithm(algIdx, &alg))
+      {
+         printf("  %u: %s\n", algIdx, alg.query_algorithm_name());
+      }
+   }
+
+   printf("  auto: run all algorithms, pick the winner by -p objective=<0=min size, 1=max padding, 2=even STA>\n");
+}
+
+static bool_t loc_find_algorithm(const char *_s, uint32_t *_retAlgIdx) {
+   char *endp;
+   uint32_t algIdx = (uint32_t)strtoul(_s, &endp, 10);
+
+   if(0 == strcasecmp(_s, "auto"))
+   {
+      *_retAlgIdx = ALGORITHM_AUTO;
+      return SC_TRUE;
+   }
+
+   if(('\0' != _s[0]) && ('\0' == *endp))
+   {
+      *_retAlgIdx = algIdx;
+      return (algIdx < samplechain_get_num_algorithms());
+   }
+
+   for(algIdx = 0; algIdx < samplechain_get_num_algorithms(); algIdx++)
+   {
+      samplechain_algorithm_t alg;
+
+      if(samplechain_select_algorithm(algIdx, &alg))
+      {
+         const char *name = alg.query_algorithm_name();
+         size_t len = strlen(_s);
+
+         for(; '\0' != *name; name++)
+         {
+            if(0 == strncasecmp(name, _s, len))
+            {
+               *_retAlgIdx = algIdx;
+               return SC_TRUE;
+            }
+         }
+      }
+   }
+
+   return SC_FALSE;
+}
+
+static bool_t loc_add_file(app_t *_app, const char *_pathName) {
+
+   if(_app->num_files == _app->max_files)
+   {
+      file_t *files;
+
+      _app->max_files = (0 == _app->max_files) ? 256 : (_app->max_files * 2);
+      files = realloc(_app->files, sizeof(file_t) * _app->max_files);
+
+      if(NULL == files)
+      {
+         return SC_FALSE;
+      }
+
+      _app->files = files;
+   }
+
+   _app->files[_app->num_files].path_name = strdup(_pathName);
+   _app->files[_app->num_files].b_valid   = SC_FALSE;
+   _app->files[_app->num_files].b_derived = SC_FALSE;
+   _app->num_files++;
+
+   return SC_TRUE;
+}
+
+static kit_t *loc_add_kit(app_t *_app, const char *_pathName) {
+   kit_t *kit;
+   const char *baseName = strrchr(_pathName, '/');
+   char *ext;
+
+   if(_app->num_kits == _app->max_kits)
+   {
+      kit_t *kits;
+
+      _app->max_kits = (0 == _app->max_kits) ? 16 : (_app->max_kits * 2);
+      kits = realloc(_app->kits, sizeof(kit_t) * _app->max_kits);
+
+      if(NULL == kits)
+      {
+         return NULL;
+      }
+
+      _app->kits = kits;
+   }
+
+   kit = &_app->kits[_app->num_kits++];
+
+   // Kit name is the directory / manifest name without extension
+   baseName = (NULL != baseName) && ('\0' != baseName[1]) ? (baseName + 1) : _pathName;
+   snprintf(kit->name, sizeof(kit->name), "%s", baseName);
+
+   if(NULL != (ext = strrchr(kit->name, '.')))
+   {
+      *ext = '\0';
+   }
+
+   if(NULL != (ext = strrchr(kit->name, '/')))
+   {
+      *ext = '\0';
+   }
+
+   kit->first_file_idx = _app->num_files;
+   kit->num_files      = 0;
+   kit->b_ok           = SC_FALSE;
+
+   // (note) stay NULL when the layout task fails before the kit's tasks are added
+   kit->sc             = NULL;
+   kit->write_task     = NULL;
+
+   return kit;
+}
+
+static int loc_cmp_file_names(const void *_a, const void *_b) {
+   return strcmp(((const file_t*)_a)->path_name, ((const file_t*)_b)->path_name);
+}
+
+static bool_t loc_is_wav_file_name(const char *_name) {
+   size_t len = strlen(_name);
+
+   return (len > 4) && (0 == strcasecmp(_name + len - 4, ".wav"));
+}
+
+static bool_t loc_scan_dir(app_t *_app, const char *_dirName) {
+   DIR *dir = opendir(_dirName);
+   kit_t *kit;
+   struct dirent *de;
+
+   if(NULL == dir)
+   {
+      return SC_FALSE;
+   }
+
+   if(NULL == (kit = loc_add_kit(_app, _dirName)))
+   {
+      closedir(dir);
+      return SC_FALSE;
+   }
+
+   while(NULL != (de = readdir(dir)))
+   {
+      if(loc_is_wav_file_name(de->d_name))
+      {
+         char pathName[MAX_PATH_LEN];
+
+         snprintf(pathName, sizeof(pathName), "%s/%s", _dirName, de->d_name);
+
+         if(loc_add_file(_app, pathName))
+         {
+            kit->num_files++;
+         }
+      }
+   }
+
+   closedir(dir);
+
+   // (note) 'files' is still NULL when the first kit directory has no WAV files
+   if(kit->num_files > 1u)
+   {
+      qsort(_app->files + kit->first_file_idx, kit->num_files, sizeof(file_t), &loc_cmp_file_names);
+   }
+
+   return SC_TRUE;
+}
+
+// Parse manifest variant transforms, e.g. "reverse gain=-6 start=100 length=4000 pitch=12"
+//  - gain: dB, start / length: sample frames, pitch: semitones
+static bool_t loc_parse_transforms(file_t *_file, char *_s) {
+   bool_t ret = SC_TRUE;
+   char *tok;
+
+   // (note) the source user_data / size are set when the chain is initialized (see loc_init_chain())
+   samplechain_derived_init(&_file->derived, NULL, 0u);
+   _file->b_derived = SC_TRUE;
+
+   for(tok = strtok(_s, " \t"); (NULL != tok) && ret; tok = strtok(NULL, " \t"))
+   {
+      char *val = strchr(tok, '=');
+
+      if(NULL != val)
+      {
+         *val++ = '\0';
+      }
+
+      if(0 == strcmp(tok, "reverse"))
+      {
+         _file->derived.flags |= SC_DERIVED_REVERSE;
+      }
+      else if(NULL == val)
+      {
+         ret = SC_FALSE;
+      }
+      else if(0 == strcmp(tok, "gain"))
+      {
+         _file->derived.gain = powf(10.0f, (float32_t)strtod(val, NULL) / 20.0f);
+      }
+      else if(0 == strcmp(tok, "start"))
+      {
+         _file->derived.start = (size_t)strtoul(val, NULL, 10);
+      }
+      else if(0 == strcmp(tok, "length"))
+      {
+         _file->derived.num_frames = (size_t)strtoul(val, NULL, 10);
+      }
+      else if(0 == strcmp(tok, "pitch"))
+      {
+         _file->derived.pitch = powf(2.0f, (float32_t)strtod(val, NULL) / 12.0f);
+      }
+      else
+      {
+         ret = SC_FALSE;
+      }
+   }
+
+   return ret;
+}
+
+static bool_t loc_scan_manifest(app_t *_app, const char *_manifestName) {
+   FILE *fh = fopen(_manifestName, "r");
+   kit_t *kit;
+   char line[MAX_PATH_LEN];
+   char baseDir[MAX_PATH_LEN];
+   char *slash;
+
+   if(NULL == fh)
+   {
+      return SC_FALSE;
+   }
+
+   if(NULL == (kit = loc_add_kit(_app, _manifestName)))
+   {
+      fclose(fh);
+      return SC_FALSE;
+   }
+
+   // (note) relative paths are relative to the manifest directory
+   snprintf(baseDir, sizeof(baseDir), "%s", _manifestName);
+   slash = strrchr(baseDir, '/');
+
+   if(NULL != slash)
+   {
+      slash[0] = '\0';
+   }
+   else
+   {
+      strcpy(baseDir, ".");
+   }
+
+   while(NULL != fgets(line, sizeof(line), fh))
+   {
+      char *s = line;
+      size_t len;
+
+      while((' ' == *s) || ('\t' == *s))
+      {
+         s++;
+      }
+
+      len = strlen(s);
+
+      while((len > 0) && (('\n' == s[len - 1]) || ('\r' == s[len - 1]) || (' ' == s[len - 1])))
+      {
+         s[--len] = '\0';
+      }
+
+      if((len > 0) && ('#' != s[0]))
+      {
+         char pathName[MAX_PATH_LEN];
+         char *transforms = strchr(s, '|');
+
+         if(NULL != transforms)
+         {
+            char *e = transforms;
+
+            *transforms++ = '\0';
+
+            while((e > s) && ((' ' == e[-1]) || ('\t' == e[-1])))
+            {
+               *--e = '\0';
+            }
+
+            while((' ' == *transforms) || ('\t' == *transforms))
+            {
+               transforms++;
+            }
+         }
+
+         if('/' == s[0])
+         {
+            snprintf(pathName, sizeof(pathName), "%s", s);
+         }
+         else
+         {
+            snprintf(pathName, sizeof(pathName), "%s/%s", baseDir, s);
+         }
+
+         if(loc_add_file(_app, pathName))
+         {
+            kit->num_files++;
+
+            if((NULL != transforms) && !loc_parse_transforms(&_app->files[_app->num_files - 1u], transforms))
+            {
+               printf("[~~~] warning: \"%s\": invalid transform \"%s\"\n", _manifestName, transforms);
+            }
+         }
+      }
+   }
+
+   fclose(fh);
+
+   return SC_TRUE;
+}
+
+// Stage 1: scan WAV header
+static void loc_scan_file_task(void *_file) {
+   file_t *file = (file_t*)_file;
+
+   file->b_valid = samplechain_wav_read_info(file->path_name, &file->info);
+
+   if(!file->b_valid)
+   {
+      printf("[---] failed to read WAV header of \"%s\"\n", file->path_name);
+   }
+}
+
+static bool_t loc_init_chain(app_t *_app, kit_t *_kit, samplechain_algorithm_t *_alg, samplechain_t *_retSc) {
+   uint32_t paramIdx;
+   uint32_t fileIdx;
+
+   if(ALGORITHM_AUTO == _app->algorithm_idx)
+   {
+      samplechain_select_auto(_alg);
+   }
+   else
+   {
+      samplechain_select_algorithm(_app->algorithm_idx, _alg);
+   }
+
+   _alg->init(_retSc, _app->num_slices);
+
+   if(NULL == *_retSc)
+   {
+      return SC_FALSE;
+   }
+
+   for(paramIdx = 0; paramIdx < _app->num_params; paramIdx++)
+   {
+      const char *name = _app->param_names[paramIdx];
+      const char *value = _app->param_values[paramIdx];
+
+      if(!_alg->set_parameter_i(*_retSc, name, (int32_t)strtol(value, NULL, 10)))
+      {
+         if(!_alg->set_parameter_f(*_retSc, name, (float32_t)strtod(value, NULL)))
+         {
+            printf("[~~~] warning: kit \"%s\": failed to set parameter \"%s\" to \"%s\"\n", _kit->name, name, value);
+         }
+      }
+   }
+
+   for(fileIdx = 0; fileIdx < _kit->num_files; fileIdx++)
+   {
+      file_t *file = &_app->files[_kit->first_file_idx + fileIdx];
+
+      if(file->b_valid)
+      {
+         size_t numFrames = file->info.num_frames;
+
+         if(file->b_derived)
+         {
+            file->derived.source_user_data  = file;
+            file->derived.source_num_frames = numFrames;
+            numFrames = samplechain_derived_calc_num_frames(&file->derived);
+         }
+
+         if(!_alg->add(*_retSc, numFrames, file))
+         {
+            printf("[~~~] warning: kit \"%s\": too many elements, skipping \"%s\"\n", _kit->name, file->path_name);
+         }
+      }
+   }
+
+   return SC_TRUE;
+}
+
+// Chain layout + content hash of each element region (stored alongside the chain in "<kit>.txt")
+typedef struct {
+   uint32_t   num_elements;
+   size_t    *offsets;
+   size_t    *total_sizes;
+   size_t    *orig_sizes;
+   float32_t *sta;
+   float32_t *end;
+   uint64_t  *hashes;
+} slice_table_t;
+
+static bool_t loc_slice_table_alloc(slice_table_t *_t, uint32_t _numElements) {
+   _t->num_elements = _numElements;
+   _t->offsets      = malloc((_numElements + 1u) * (3 * sizeof(size_t) + 2 * sizeof(float32_t) + sizeof(uint64_t)));
+
+   if(NULL != _t->offsets)
+   {
+      // (note) hashes before the float32 arrays to keep them 8 byte aligned
+      _t->hashes      = (uint64_t*) (_t->offsets + (3 * (_numElements + 1u)));
+      _t->total_sizes = _t->offsets + (_numElements + 1u);
+      _t->orig_sizes  = _t->total_sizes + (_numElements + 1u);
+      _t->sta         = (float32_t*) (_t->hashes + (_numElements + 1u));
+      _t->end         = _t->sta + (_numElements + 1u);
+      return SC_TRUE;
+   }
+
+   return SC_FALSE;
+}
+
+static void loc_slice_table_free(slice_table_t *_t) {
+   free(_t->offsets);
+   _t->offsets      = NULL;
+   _t->num_elements = 0;
+}
+
+static bool_t loc_query_slice_table(samplechain_algorithm_t *_alg, samplechain_t _sc, const int16_t *_frames, uint32_t _numChannels, slice_table_t *_retT) {
+
+   if(loc_slice_table_alloc(_retT, _alg->query_num_elements(_sc)))
+   {
+      samplechain_layout_t layout;
+      uint32_t elementIdx;
+
+      memset(&layout, 0, sizeof(layout));
+
+      layout.offsets     = _retT->offsets;
+      layout.total_sizes = _retT->total_sizes;
+      layout.orig_sizes  = _retT->orig_sizes;
+      layout.sta         = _retT->sta;
+      layout.end         = _retT->end;
+
+      _retT->num_elements = _alg->query_layout(_sc, &layout, _retT->num_elements);
+
+      for(elementIdx = 0; elementIdx < _retT->num_elements; elementIdx++)
+      {
+         _retT->hashes[elementIdx] = sc_kernel_hash(_frames + (_retT->offsets[elementIdx] * _numChannels),
+                                                    _retT->total_sizes[elementIdx] * _numChannels * sizeof(int16_t),
+                                                    0u
+                                                    );
+      }
+
+      return SC_TRUE;
+   }
+
+   return SC_FALSE;
+}
+
+static void loc_write_slice_table(app_t *_app, kit_t *_kit, samplechain_algorithm_t *_alg, samplechain_t _sc, const slice_table_t *_t) {
+   char pathName[MAX_PATH_LEN];
+   FILE *fh;
+
+   snprintf(pathName, sizeof(pathName), "%s/%s.txt", _app->out_dir, _kit->name);
+
+   if(NULL != (fh = fopen(pathName, "w")))
+   {
+      uint32_t elementIdx;
+
+      fprintf(fh, "# idx     STA     END     offset  totalSz   origSz              hash  file\n");
+
+      for(elementIdx = 0; elementIdx < _t->num_elements; elementIdx++)
+      {
+         const file_t *file = (const file_t*)_alg->query_element_user_data(_sc, elementIdx);
+
+         fprintf(fh, "%5u %7.2f %7.2f %10u %8u %8u  %016llx  %s\n",
+                 elementIdx,
+                 _t->sta[elementIdx],
+                 _t->end[elementIdx],
+                 (uint32_t)_t->offsets[elementIdx],
+                 (uint32_t)_t->total_sizes[elementIdx],
+                 (uint32_t)_t->orig_sizes[elementIdx],
+                 (unsigned long long)_t->hashes[elementIdx],
+                 (NULL != file) ? file->path_name : "-"
+                 );
+      }
+
+      fclose(fh);
+   }
+   else
+   {
+      printf("[---] kit \"%s\": failed to write slice table \"%s\"\n", _kit->name, pathName);
+   }
+}
+
+// Read slice table written by a previous run (see loc_write_slice_table())
+static bool_t loc_read_slice_table(app_t *_app, kit_t *_kit, slice_table_t *_retT) {
+   char pathName[MAX_PATH_LEN];
+   char line[MAX_PATH_LEN + 128];
+   FILE *fh;
+   bool_t ret = SC_FALSE;
+
+   snprintf(pathName, sizeof(pathName), "%s/%s.txt", _app->out_dir, _kit->name);
+
+   if(NULL != (fh = fopen(pathName, "r")))
+   {
+      uint32_t numElements = 0;
+
+      while(NULL != fgets(line, sizeof(line), fh))
+      {
+         numElements += ('#' != line[0]);
+      }
+
+      if(loc_slice_table_alloc(_retT, numElements))
+      {
+         uint32_t elementIdx = 0;
+
+         ret = SC_TRUE;
+         rewind(fh);
+
+         while(ret && (elementIdx < numElements) && (NULL != fgets(line, sizeof(line), fh)))
+         {
+            if('#' != line[0])
+            {
+               unsigned int idx, offset, totalSz, origSz;
+               unsigned long long hash;
+
+               ret = (7 == sscanf(line, "%u %f %f %u %u %u %llx",
+                                  &idx, &_retT->sta[elementIdx], &_retT->end[elementIdx], &offset, &totalSz, &origSz, &hash
+                                  ));
+
+               _retT->offsets[elementIdx]     = offset;
+               _retT->total_sizes[elementIdx] = totalSz;
+               _retT->orig_sizes[elementIdx]  = origSz;
+               _retT->hashes[elementIdx]      = (uint64_t)hash;
+               elementIdx++;
+            }
+         }
+
+         if(!ret)
+         {
+            loc_slice_table_free(_retT);
+         }
+      }
+
+      fclose(fh);
+   }
+
+   return ret;
+}
+
+// Compare new layout with the stored one and collect the (merged) sample frame ranges that need to be rewritten
+//  - 'retRegions' receives (offset, numFrames) pairs
+//  - Returns number of regions
+static uint32_t loc_calc_changed_regions(const slice_table_t *_old, const slice_table_t *_new, size_t *_retRegions) {
+   uint32_t numRegions = 0;
+   uint32_t elementIdx;
+
+   for(elementIdx = 0; elementIdx < _new->num_elements; elementIdx++)
+   {
+      bool_t bChanged = (elementIdx >= _old->num_elements) ||
+         (_old->offsets[elementIdx]     != _new->offsets[elementIdx])     ||
+         (_old->total_sizes[elementIdx] != _new->total_sizes[elementIdx]) ||
+         (_old->hashes[elementIdx]      != _new->hashes[elementIdx])      ;
+
+      if(bChanged && (_new->total_sizes[elementIdx] > 0u))
+      {
+         size_t off = _new->offsets[elementIdx];
+
+         if( (numRegions > 0u) && ((_retRegions[2 * numRegions - 2] + _retRegions[2 * numRegions - 1]) == off) )
+         {
+            // Merge with previous region
+            _retRegions[2 * numRegions - 1] += _new->total_sizes[elementIdx];
+         }
+         else
+         {
+            _retRegions[2 * numRegions + 0] = off;
+            _retRegions[2 * numRegions + 1] = _new->total_sizes[elementIdx];
+            numRegions++;
+         }
+      }
+   }
+
+   return numRegions;
+}
+
+// Write chain (update mode: rewrite only the header and the regions that changed since the last run)
+//  - 'sink' is the chain file opened by the caller (NULL=open when the file is (re-)written from scratch)
+//  - (note) the frames have already been rendered into the file if they are the sink's mapped frames
+//  - Closes the sink
+static bool_t loc_write_chain(app_t *_app, kit_t *_kit, samplechain_wav_sink_t *_sink, const int16_t *_frames, size_t _numFrames, uint32_t _numChannels, uint32_t _sampleRate, const slice_table_t *_t) {
+   char pathName[MAX_PATH_LEN];
+   slice_table_t old;
+   samplechain_wav_info_t info;
+   bool_t ret = SC_FALSE;
+   bool_t bFullWrite = SC_TRUE;
+
+   snprintf(pathName, sizeof(pathName), "%s/%s.wav", _app->out_dir, _kit->name);
+
+   if((NULL == _sink) && _app->b_update && loc_read_slice_table(_app, _kit, &old))
+   {
+      // (note) an existing file with a different size or format is rewritten from scratch
+      if( samplechain_wav_read_info(pathName, &info) &&
+          (_numFrames == info.num_frames) && (_numChannels == info.num_channels) && (_sampleRate == info.sample_rate)
+          )
+      {
+         size_t *regions = malloc(sizeof(size_t) * 2u * (_t->num_elements + 1u));
+
+         if(NULL != regions)
+         {
+            uint32_t numRegions = loc_calc_changed_regions(&old, _t, regions);
+            size_t numFramesWritten = 0;
+            uint32_t regionIdx;
+
+            for(regionIdx = 0; regionIdx < numRegions; regionIdx++)
+            {
+               numFramesWritten += regions[2 * regionIdx + 1];
+            }
+
+            // (note) the cue points move with the element offsets (a different number of cue points moves the sample frames,
+            //         i.e. the file is rewritten from scratch)
+            ret = samplechain_wav_sink_update_header(pathName, &_kit->alg, _kit->sc, _sampleRate) &&
+                  samplechain_wav_update_s16(pathName, _frames, _numFrames, _numChannels, _sampleRate, regions, numRegions);
+
+            if(ret)
+            {
+               bFullWrite = SC_FALSE;
+
+               printf("[...] kit \"%s\": updated %u region(s), %u of %u sample frames in \"%s\"\n",
+                      _kit->name, numRegions, (uint32_t)numFramesWritten, (uint32_t)_numFrames, pathName
+                      );
+            }
+
+            free(regions);
+         }
+      }
+
+      loc_slice_table_free(&old);
+   }
+
+   if(bFullWrite)
+   {
+      if(NULL == _sink)
+      {
+         _sink = samplechain_wav_sink_open(pathName, &_kit->alg, _kit->sc, _sampleRate);
+      }
+
+      ret = (NULL != _sink);
+
+      if(ret && (_frames != samplechain_wav_sink_get_frames(_sink)))
+      {
+         ret = samplechain_wav_sink_write(_sink, _frames, 0u, _numFrames);
+      }
+
+      ret = samplechain_wav_sink_close(_sink) && ret;
+
+      if(ret)
+      {
+         printf("[...] kit \"%s\": wrote %u elements, %u sample frames to \"%s\"\n", _kit->name, _t->num_elements, (uint32_t)_numFrames, pathName);
+      }
+   }
+
+   if(!ret)
+   {
+      printf("[---] kit \"%s\": failed to write \"%s\"\n", _kit->name, pathName);
+   }
+
+   return ret;
+}
+
+// Write compressed chain archive ("<kit>.sca")
+//  - (note) must be called before loc_write_chain() closes the sink (which unmaps the frames)
+static bool_t loc_write_archive(app_t *_app, kit_t *_kit, const int16_t *_frames, uint32_t _sampleRate) {
+   char pathName[MAX_PATH_LEN];
+   bool_t ret;
+
+   snprintf(pathName, sizeof(pathName), "%s/%s.sca", _app->out_dir, _kit->name);
+
+   ret = samplechain_archive_save_frames(pathName, &_kit->alg, _kit->sc, _frames, _sampleRate, 0u);
+
+   if(ret)
+   {
+      samplechain_archive_t *ar = samplechain_archive_open(pathName);
+
+      if(NULL != ar)
+      {
+         samplechain_archive_info_t info;
+
+         samplechain_archive_get_info(ar, &info);
+
+         printf("[...] kit \"%s\": wrote %u bytes to \"%s\"\n", _kit->name, (uint32_t)info.num_bytes, pathName);
+
+         samplechain_archive_close(ar);
+      }
+   }
+   else
+   {
+      printf("[---] kit \"%s\": failed to write \"%s\"\n", _kit->name, pathName);
+   }
+
+   return ret;
+}
+
+// Resolve element user_data (file_t) to the decoded audio (see loc_decode_file_task())
+static bool_t loc_fetch_element(void *_fetchCtx, void *_userData, size_t _numFrames, samplechain_source_t *_retSource) {
+   const file_t *file = (const file_t*)_userData;
+   (void)_fetchCtx;
+   (void)_numFrames;
+
+   _retSource->frames = samplechain_cache_entry_get_frames(file->entry, &_retSource->num_frames);
+
+   return (NULL != _retSource->frames);
+}
+
+static const samplechain_derived_t *loc_query_derived(void *_fetchCtx, void *_userData) {
+   const file_t *file = (const file_t*)_userData;
+   (void)_fetchCtx;
+
+   return file->b_derived ? &file->derived : NULL;
+}
+
+static void loc_nop_task(void *_ctx) {
+   (void)_ctx;
+}
+
+static float32_t *loc_load_wav(void *_loadCtx, const char *_pathName, uint32_t _numChannels, size_t *_retNumFrames) {
+   samplechain_wav_info_t info;
+   float32_t *ret = samplechain_wav_load(_pathName, _numChannels, &info);
+   (void)_loadCtx;
+
+   *_retNumFrames = (NULL != ret) ? info.num_frames : 0u;
+
+   return ret;
+}
+
+// Stage 3: decode one element
+//  - (note) samples that are used by several kits are decoded once (process-wide cache, keyed by real path + channel count,
+//           a file that changed on disk is decoded again)
+static void loc_decode_file_task(void *_file) {
+   file_t *file = (file_t*)_file;
+   char key[PATH_MAX];
+
+   if(NULL == realpath(file->path_name, key))
+   {
+      snprintf(key, sizeof(key), "%s", file->path_name);
+   }
+
+   file->entry = samplechain_cache_acquire(key, samplechain_cache_get_file_version(key),
+                                           (uint32_t)file->kit->num_channels, &loc_load_wav, NULL
+                                           );
+
+   if(NULL == file->entry)
+   {
+      printf("[---] kit \"%s\": failed to load \"%s\"\n", file->kit->name, file->path_name);
+   }
+}
+
+static void loc_free_kit(kit_t *_kit) {
+   uint32_t elementIdx;
+   uint32_t n = _kit->alg.query_num_elements(_kit->sc);
+
+   for(elementIdx = 0; elementIdx < n; elementIdx++)
+   {
+      file_t *file = (file_t*)_kit->alg.query_element_user_data(_kit->sc, elementIdx);
+
+      if(NULL != file)
+      {
+         samplechain_cache_release(file->entry);
+         file->entry = NULL;
+      }
+   }
+
+   _kit->alg.exit(&_kit->sc);
+}
+
+// Stage 4..5: render and write (after all elements have been decoded)
+static void loc_write_kit_task(void *_kit) {
+   kit_t *kit = (kit_t*)_kit;
+   app_t *app = kit->app;
+   size_t totalSz = kit->alg.query_total_size(kit->sc);
+   uint32_t numChannels = (uint32_t)kit->num_channels;
+   char pathName[MAX_PATH_LEN];
+   samplechain_wav_sink_t *sink = NULL;
+   int16_t *buf = NULL;
+   int16_t *out = NULL;
+
+   snprintf(pathName, sizeof(pathName), "%s/%s.wav", app->out_dir, kit->name);
+
+   // Render straight into the (preallocated, mapped) chain file
+   //  - (note) the update mode compares the rendered chain with the previous run before anything is written
+   if(!app->b_update)
+   {
+      sink = samplechain_wav_sink_open(pathName, &kit->alg, kit->sc, kit->sample_rate);
+      out = samplechain_wav_sink_get_frames(sink);
+   }
+
+   if(NULL == out)
+   {
+      out = buf = malloc(sizeof(int16_t) * totalSz * numChannels);
+   }
+
+   if(NULL != out)
+   {
+      samplechain_render_params_t renderParams;
+      bool_t bOk;
+
+      samplechain_render_init_params(&renderParams);
+      renderParams.fetch              = &loc_fetch_element;
+      renderParams.derived            = &loc_query_derived;
+      renderParams.normalize_mode     = app->normalize_mode;
+      renderParams.normalize_level_db = app->normalize_level_db;
+      renderParams.num_threads        = 1; // (note) kits are built in parallel
+
+      bOk = samplechain_render(&kit->alg, kit->sc, &renderParams, out, totalSz);
+
+      if(!bOk)
+      {
+         printf("[---] kit \"%s\": failed to render sample chain\n", kit->name);
+      }
+      else
+      {
+         slice_table_t t;
+
+         bOk = loc_query_slice_table(&kit->alg, kit->sc, out, numChannels, &t);
+
+         if(bOk && app->b_archive)
+         {
+            bOk = loc_write_archive(app, kit, out, kit->sample_rate);
+         }
+
+         if(bOk)
+         {
+            bOk = loc_write_chain(app, kit, sink, out, totalSz, numChannels, kit->sample_rate, &t);
+            sink = NULL;
+
+            if(bOk)
+            {
+               loc_write_slice_table(app, kit, &kit->alg, kit->sc, &t);
+            }
+
+            loc_slice_table_free(&t);
+         }
+      }
+
+      kit->b_ok = bOk;
+   }
+   else
+   {
+      printf("[---] kit \"%s\": failed to allocate %u sample frames\n", kit->name, (uint32_t)totalSz);
+   }
+
+   if(NULL != sink)
+   {
+      // (note) the chain file is incomplete
+      samplechain_wav_sink_close(sink);
+      remove(pathName);
+   }
+
+   free(buf);
+
+   loc_free_kit(kit);
+}
+
+// Stage 2: calculate layout, then add the kit's decode / render+write tasks
+//  - (note) the memory for the decoded elements and the rendered chain is reserved by one (gate) task
+//            so that kits start as a whole when a memory cap is set (see samplechain_sched_add())
+static void loc_layout_kit_task(void *_kit) {
+   kit_t *kit = (kit_t*)_kit;
+   app_t *app = kit->app;
+   samplechain_sched_task_t **tasks;
+   uint32_t n;
+   uint32_t numTasks = 1;
+   uint32_t elementIdx;
+   size_t memBytes;
+
+   if(!loc_init_chain(app, kit, &kit->alg, &kit->sc))
+   {
+      printf("[---] kit \"%s\": failed to initialize sample chain\n", kit->name);
+      return;
+   }
+
+   kit->alg.calc(kit->sc);
+
+   if(0 == kit->alg.query_total_size(kit->sc))
+   {
+      printf("[---] kit \"%s\": failed to calculate sample chain\n", kit->name);
+      kit->alg.exit(&kit->sc);
+      return;
+   }
+
+   kit->num_channels = 1;
+   kit->alg.get_parameter_i(kit->sc, "num_channels", &kit->num_channels);
+
+   n = kit->alg.query_num_elements(kit->sc);
+   memBytes = sizeof(int16_t) * kit->alg.query_total_size(kit->sc) * kit->num_channels;
+   kit->sample_rate = 0;
+
+   for(elementIdx = 0; elementIdx < n; elementIdx++)
+   {
+      file_t *file = (file_t*)kit->alg.query_element_user_data(kit->sc, elementIdx);
+
+      // (note) skip filler elements
+      if(NULL != file)
+      {
+         file->kit = kit;
+         memBytes += sizeof(float32_t) * file->info.num_frames * kit->num_channels;
+
+         if(0 == kit->sample_rate)
+         {
+            kit->sample_rate = file->info.sample_rate;
+         }
+         else if(file->info.sample_rate != kit->sample_rate)
+         {
+            printf("[~~~] warning: kit \"%s\": sample rate of \"%s\" (%u) differs from %u\n", kit->name, file->path_name, file->info.sample_rate, kit->sample_rate);
+         }
+      }
+   }
+
+   if(0 == kit->sample_rate)
+   {
+      kit->sample_rate = 48000u;
+   }
+
+   // Gate + one decode task per element
+   tasks = malloc(sizeof(samplechain_sched_task_t*) * (n + 1u));
+
+   if(NULL != tasks)
+   {
+      tasks[0] = samplechain_sched_add(app->sched, &loc_nop_task, NULL, memBytes, NULL, 0u);
+   }
+
+   if((NULL == tasks) || (NULL == tasks[0]))
+   {
+      printf("[---] kit \"%s\": failed to add tasks\n", kit->name);
+      free(tasks);
+      kit->alg.exit(&kit->sc);
+      return;
+   }
+
+   for(elementIdx = 0; elementIdx < n; elementIdx++)
+   {
+      file_t *file = (file_t*)kit->alg.query_element_user_data(kit->sc, elementIdx);
+
+      if(NULL != file)
+      {
+         tasks[numTasks] = samplechain_sched_add(app->sched, &loc_decode_file_task, file, 0u, &tasks[0], 1u);
+
+         // (note) elements that could not be queued fail to fetch while rendering
+         numTasks += (NULL != tasks[numTasks]);
+      }
+   }
+
+   kit->write_task = samplechain_sched_add(app->sched, &loc_write_kit_task, kit, 0u, tasks, numTasks);
+
+   if(NULL == kit->write_task)
+   {
+      printf("[---] kit \"%s\": failed to add tasks\n", kit->name);
+
+      for(elementIdx = 0; elementIdx < numTasks; elementIdx++)
+      {
+         samplechain_sched_wait(app->sched, tasks[elementIdx]);
+      }
+
+      loc_free_kit(kit);
+   }
+   else
+   {
+      for(elementIdx = 0; elementIdx < numTasks; elementIdx++)
+      {
+         samplechain_sched_release(app->sched, tasks[elementIdx]);
+      }
+   }
+
+   free(tasks);
+}
+
+// Add one task per array element and wait until all of them have completed
+static void loc_run_tasks(samplechain_sched_t *_sched, samplechain_task_fxn_t _fxn, void *_ctxs, size_t _ctxSize, uint32_t _numTasks) {
+   samplechain_sched_task_t **tasks = malloc(sizeof(samplechain_sched_task_t*) * _numTasks);
+   uint32_t taskIdx;
+
+   for(taskIdx = 0; taskIdx < _numTasks; taskIdx++)
+   {
+      void *ctx = ((char*)_ctxs) + (_ctxSize * taskIdx);
+
+      if(NULL != tasks)
+      {
+         tasks[taskIdx] = samplechain_sched_add(_sched, _fxn, ctx, 0u, NULL, 0u);
+      }
+
+      if((NULL == tasks) || (NULL == tasks[taskIdx]))
+      {
+         // (note) out of memory, run on the calling thread
+         _fxn(ctx);
+      }
+   }
+
+   if(NULL != tasks)
+   {
+      for(taskIdx = 0; taskIdx < _numTasks; taskIdx++)
+      {
+         samplechain_sched_wait(_sched, tasks[taskIdx]);
+      }
+
+      free(tasks);
+   }
+}
+
+static void loc_print_sched_stats(app_t *_app) {
+   samplechain_sched_stats_t stats;
+
+   samplechain_sched_get_stats(_app->sched, &stats);
+
+   printf("[prf] sched    threads=%u tasks=%llu steals=%llu mem_waits=%llu mem_peak=%.1fMB\n",
+          stats.num_threads,
+          (unsigned long long)stats.num_tasks_run,
+          (unsigned long long)stats.num_steals,
+          (unsigned long long)stats.num_mem_waits,
+          stats.mem_peak / (1024.0 * 1024.0)
+          );
+}
+
+static void loc_print_cache_stats(void) {
+   samplechain_cache_stats_t stats;
+
+   samplechain_cache_get_stats(&stats);
+
+   printf("[prf] cache    entries=%u hits=%llu misses=%llu evictions=%llu size=%.1fMB\n",
+          stats.num_entries,
+          (unsigned long long)stats.num_hits,
+          (unsigned long long)stats.num_misses,
+          (unsigned long long)stats.num_evictions,
+          stats.num_bytes / (1024.0 * 1024.0)
+          );
+}
+
+static void loc_print_profile(app_t *_app) {
+   samplechain_profile_t prof;
+   uint32_t idx;
+
+   if(samplechain_profile_query(&prof))
+   {
+      for(idx = 0; idx < SC_PROFILE_NUM_PHASES; idx++)
+      {
+         printf("[prf] %-8s calls=%8llu total=%10.3fms max=%10.3fms\n",
+                samplechain_profile_get_phase_name(idx),
+                (unsigned long long)prof.phases[idx].num_calls,
+                prof.phases[idx].total_ns / 1000000.0,
+                prof.phases[idx].max_ns / 1000000.0
+                );
+      }
+
+      for(idx = 0; idx < SC_PROFILE_NUM_COUNTERS; idx++)
+      {
+         printf("[prf] %-13s %llu\n", samplechain_profile_get_counter_name(idx), (unsigned long long)prof.counters[idx]);
+      }
+
+      printf("[prf] kernels       %s\n", sc_kernel_get_isa_name(sc_kernel_get_isa()));
+
+      loc_print_sched_stats(_app);
+      loc_print_cache_stats();
+
+      if(!samplechain_profile_write_trace(_app->trace_path_name))
+      {
+         printf("[---] failed to write trace \"%s\"\n", _app->trace_path_name);
+      }
+   }
+   else
+   {
+      printf("[~~~] warning: profiling is not available (compiled without SC_PROFILE)\n");
+   }
+}
+
+static samplechain_daemon_t *loc_daemon;
+
+static void loc_daemon_signal_handler(int _sig) {
+   (void)_sig;
+
+   samplechain_daemon_stop(loc_daemon);
+}
+
+static int loc_run_daemon(app_t *_app) {
+   int ret = 2;
+
+   samplechain_cache_set_max_bytes((size_t)_app->max_cache_mb << 20);
+
+   loc_daemon = samplechain_daemon_create(_app->daemon_socket_name, 0u);
+
+   if(NULL != loc_daemon)
+   {
+      samplechain_daemon_stats_t stats;
+
+      signal(SIGINT, &loc_daemon_signal_handler);
+      signal(SIGTERM, &loc_daemon_signal_handler);
+
+      printf("[...] serving build requests on \"%s\"\n", _app->daemon_socket_name);
+
+      samplechain_daemon_run(loc_daemon);
+
+      samplechain_daemon_get_stats(loc_daemon, &stats);
+
+      printf("[...] %llu requests, %llu builds, %llu hits, %llu joins, %llu failed\n",
+             (unsigned long long)stats.num_requests, (unsigned long long)stats.num_builds,
+             (unsigned long long)stats.num_hits, (unsigned long long)stats.num_joins,
+             (unsigned long long)stats.num_failed
+             );
+
+      samplechain_daemon_destroy(loc_daemon);
+      loc_daemon = NULL;
+
+      ret = 0;
+   }
+   else
+   {
+      printf("[---] failed to create build daemon on \"%s\"\n", _app->daemon_socket_name);
+   }
+
+   return ret;
+}
+
+int main(int argc, char **argv) {
+   app_t app;
+   int argIdx;
+   uint32_t kitIdx;
+   uint32_t numFailed = 0;
+
+   memset(&app, 0, sizeof(app));
+
+   app.num_slices         = 120;
+   app.normalize_mode     = SC_NORMALIZE_NONE;
+   app.normalize_level_db = -1.0f;
+   app.out_dir            = ".";
+   app.max_cache_mb       = (uint32_t)(SC_CACHE_DEFAULT_MAX_BYTES >> 20);
+
+   for(argIdx = 1; argIdx < argc; argIdx++)
+   {
+      const char *arg = argv[argIdx];
+      const char *val = ((argIdx + 1) < argc) ? argv[argIdx + 1] : NULL;
+
+      if(0 == strcmp(arg, "-u"))
+      {
+         app.b_update = SC_TRUE;
+      }
+      else if(0 == strcmp(arg, "-z"))
+      {
+         app.b_archive = SC_TRUE;
+      }
+      else if(('-' == arg[0]) && ('\0' != arg[1]) && ('\0' == arg[2]))
+      {
+         if(NULL == val)
+         {
+            loc_usage();
+            return 1;
+         }
+
+         argIdx++;
+
+         switch(arg[1])
+         {
+            case 'a':
+               if(!loc_find_algorithm(val, &app.algorithm_idx))
+               {
+                  printf("[---] unknown algorithm \"%s\"\n", val);
+                  return 1;
+               }
+               break;
+
+            case 'p':
+               {
+                  char *eq = strchr(val, '=');
+
+                  if((NULL == eq) || (MAX_PARAMS == app.num_params))
+                  {
+                     loc_usage();
+                     return 1;
+                  }
+
+                  *eq = '\0';
+                  app.param_names[app.num_params]  = val;
+                  app.param_values[app.num_params] = eq + 1;
+                  app.num_params++;
+               }
+               break;
+
+            case 's':
+               app.num_slices = (uint32_t)strtoul(val, NULL, 10);
+               break;
+
+            case 'n':
+               app.normalize_mode = (0 == strcasecmp(val, "rms")) ? SC_NORMALIZE_RMS : SC_NORMALIZE_PEAK;
+               break;
+
+            case 'l':
+               app.normalize_level_db = (float32_t)strtod(val, NULL);
+               break;
+
+            case 'j':
+               app.num_threads = (uint32_t)strtoul(val, NULL, 10);
+               break;
+
+            case 'c':
+               app.max_cache_mb = (uint32_t)strtoul(val, NULL, 10);
+               break;
+
+            case 'm':
+               app.max_mem_mb = (uint32_t)strtoul(val, NULL, 10);
+               break;
+
+            case 'o':
+               app.out_dir = val;
+               break;
+
+            case 't':
+               app.trace_path_name = val;
+               break;
+
+            case 'D':
+               app.daemon_socket_name = val;
+               break;
+
+            default:
+               loc_usage();
+               return 1;
+         }
+      }
+      else
+      {
+         struct stat st;
+
+         if((0 == stat(arg, &st)) && S_ISDIR(st.st_mode))
+         {
+            if(!loc_scan_dir(&app, arg))
+            {
+               printf("[---] failed to scan directory \"%s\"\n", arg);
+            }
+         }
+         else if(!loc_scan_manifest(&app, arg))
+         {
+            printf("[---] failed to read manifest \"%s\"\n", arg);
+         }
+      }
+   }
+
+   if(NULL != app.daemon_socket_name)
+   {
+      return loc_run_daemon(&app);
+   }
+
+   if(0 == app.num_kits)
+   {
+      loc_usage();
+      return 1;
+   }
+
+   app.sched = samplechain_sched_create(app.num_threads, (size_t)app.max_mem_mb << 20);
+
+   if(NULL == app.sched)
+   {
+      printf("[---] failed to create task scheduler\n");
+      return 2;
+   }
+
+   // (note) sc_parallel_for() (e.g. in the algorithms) shares the worker threads of the pipeline (no second thread pool)
+   samplechain_sched_set_default(app.sched);
+
+   samplechain_cache_set_max_bytes((size_t)app.max_cache_mb << 20);
+   samplechain_profile_reset();
+
+   // Stage 1: scan all WAV headers (across all kits)
+   loc_run_tasks(app.sched, &loc_scan_file_task, app.files, sizeof(file_t), app.num_files);
+
+   // Stage 2..5: per-kit layout, then per-element decode and per-kit render + write tasks
+   //  - (note) different kits run through the stages concurrently
+   for(kitIdx = 0; kitIdx < app.num_kits; kitIdx++)
+   {
+      app.kits[kitIdx].app = &app;
+   }
+
+   loc_run_tasks(app.sched, &loc_layout_kit_task, app.kits, sizeof(kit_t), app.num_kits);
+
+   // (note) samplechain_sched_wait() releases the task handles (required by samplechain_sched_destroy())
+   for(kitIdx = 0; kitIdx < app.num_kits; kitIdx++)
+   {
+      samplechain_sched_wait(app.sched, app.kits[kitIdx].write_task);
+      app.kits[kitIdx].write_task = NULL;
+
+      if(!app.kits[kitIdx].b_ok)
+      {
+         numFailed++;
+      }
+   }
+
+   printf("[...] built %u of %u kits\n", app.num_kits - numFailed, app.num_kits);
+
+   if(NULL != app.trace_path_name)
+   {
+      loc_print_profile(&app);
+   }
+
+   samplechain_sched_set_default(NULL);
+   samplechain_sched_destroy(app.sched);
+
+   for(argIdx = 0; argIdx < (int)app.num_files; argIdx++)
+   {
+      free(app.files[argIdx].path_name);
+   }
+
+   free(app.files);
+   free(app.kits);
+
+   return (0 == numFailed) ? 0 : 2;
+}
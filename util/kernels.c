@@ -0,0 +1,1061 @@
+/* ----
+ * ---- file   : kernels.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "thread.h"
+#include "kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define SC_KERNEL_X86
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SC_CRC32C_ARM
+#endif
+
+// Kernel bodies are inlined into one wrapper per instruction set (see SC_KERNEL_VARIANTS())
+#if defined(__GNUC__) || defined(__clang__)
+#define SC_KERNEL_INLINE  static inline __attribute__((always_inline))
+#else
+#define SC_KERNEL_INLINE  static
+#endif
+
+// (note) no FMA contraction (e.g. AVX-512), i.e. all variants round like the scalar reference
+//  - The scalar reference is compiled without auto-vectorization (gcc)
+#if defined(__GNUC__) && !defined(__clang__)
+#define SC_KERNEL_ATTR_EXACT   __attribute__((optimize("fp-contract=off")))
+#define SC_KERNEL_ATTR_SCALAR  __attribute__((optimize("no-tree-vectorize", "fp-contract=off")))
+#else
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+#define SC_KERNEL_ATTR_EXACT
+#define SC_KERNEL_ATTR_SCALAR
+#endif
+
+#define SC_KERNEL_LANES  8
+
+#define SC_S16_MIN  -32768.0f
+#define SC_S16_MAX   32767.0f
+
+#define SC_HASH_PRIME32_1  0x9E3779B1u
+#define SC_HASH_PRIME32_2  0x85EBCA77u
+#define SC_HASH_PRIME64_1  0x9E3779B97F4A7C15ull
+#define SC_HASH_PRIME64_2  0xC2B2AE3D27D4EB4Full
+
+#define SC_CRC32C_STREAMS  3u  // independent blocks in flight (crc32 instruction latency / throughput)
+
+
+// CRC32C (Castagnoli, reflected polynomial 0x82F63B78) lookup table
+static const uint32_t loc_crc32c_table[256] = {
+   0x00000000u, 0xF26B8303u, 0xE13B70F7u, 0x1350F3F4u, 0xC79A971Fu, 0x35F1141Cu,
+   0x26A1E7E8u, 0xD4CA64EBu, 0x8AD958CFu, 0x78B2DBCCu, 0x6BE22838u, 0x9989AB3Bu,
+   0x4D43CFD0u, 0xBF284CD3u, 0xAC78BF27u, 0x5E133C24u, 0x105EC76Fu, 0xE235446Cu,
+   0xF165B798u, 0x030E349Bu, 0xD7C45070u, 0x25AFD373u, 0x36FF2087u, 0xC494A384u,
+   0x9A879FA0u, 0x68EC1CA3u, 0x7BBCEF57u, 0x89D76C54u, 0x5D1D08BFu, 0xAF768BBCu,
+   0xBC267848u, 0x4E4DFB4Bu, 0x20BD8EDEu, 0xD2D60DDDu, 0xC186FE29u, 0x33ED7D2Au,
+   0xE72719C1u, 0x154C9AC2u, 0x061C6936u, 0xF477EA35u, 0xAA64D611u, 0x580F5512u,
+   0x4B5FA6E6u, 0xB93425E5u, 0x6DFE410Eu, 0x9F95C20Du, 0x8CC531F9u, 0x7EAEB2FAu,
+   0x30E349B1u, 0xC288CAB2u, 0xD1D83946u, 0x23B3BA45u, 0xF779DEAEu, 0x05125DADu,
+   0x1642AE59u, 0xE4292D5Au, 0xBA3A117Eu, 0x4851927Du, 0x5B016189u, 0xA96AE28Au,
+   0x7DA08661u, 0x8FCB0562u, 0x9C9BF696u, 0x6EF07595u, 0x417B1DBCu, 0xB3109EBFu,
+   0xA0406D4Bu, 0x522BEE48u, 0x86E18AA3u, 0x748A09A0u, 0x67DAFA54u, 0x95B17957u,
+   0xCBA24573u, 0x39C9C670u, 0x2A993584u, 0xD8F2B687u, 0x0C38D26Cu, 0xFE53516Fu,
+   0xED03A29Bu, 0x1F682198u, 0x5125DAD3u, 0xA34E59D0u, 0xB01EAA24u, 0x42752927u,
+   0x96BF4DCCu, 0x64D4CECFu, 0x77843D3Bu, 0x85EFBE38u, 0xDBFC821Cu, 0x2997011Fu,
+   0x3AC7F2EBu, 0xC8AC71E8u, 0x1C661503u, 0xEE0D9600u, 0xFD5D65F4u, 0x0F36E6F7u,
+   0x61C69362u, 0x93AD1061u, 0x80FDE395u, 0x72966096u, 0xA65C047Du, 0x5437877Eu,
+   0x4767748Au, 0xB50CF789u, 0xEB1FCBADu, 0x197448AEu, 0x0A24BB5Au, 0xF84F3859u,
+   0x2C855CB2u, 0xDEEEDFB1u, 0xCDBE2C45u, 0x3FD5AF46u, 0x7198540Du, 0x83F3D70Eu,
+   0x90A324FAu, 0x62C8A7F9u, 0xB602C312u, 0x44694011u, 0x5739B3E5u, 0xA55230E6u,
+   0xFB410CC2u, 0x092A8FC1u, 0x1A7A7C35u, 0xE811FF36u, 0x3CDB9BDDu, 0xCEB018DEu,
+   0xDDE0EB2Au, 0x2F8B6829u, 0x82F63B78u, 0x709DB87Bu, 0x63CD4B8Fu, 0x91A6C88Cu,
+   0x456CAC67u, 0xB7072F64u, 0xA457DC90u, 0x563C5F93u, 0x082F63B7u, 0xFA44E0B4u,
+   0xE9141340u, 0x1B7F9043u, 0xCFB5F4A8u, 0x3DDE77ABu, 0x2E8E845Fu, 0xDCE5075Cu,
+   0x92A8FC17u, 0x60C37F14u, 0x73938CE0u, 0x81F80FE3u, 0x55326B08u, 0xA759E80Bu,
+   0xB4091BFFu, 0x466298FCu, 0x1871A4D8u, 0xEA1A27DBu, 0xF94AD42Fu, 0x0B21572Cu,
+   0xDFEB33C7u, 0x2D80B0C4u, 0x3ED04330u, 0xCCBBC033u, 0xA24BB5A6u, 0x502036A5u,
+   0x4370C551u, 0xB11B4652u, 0x65D122B9u, 0x97BAA1BAu, 0x84EA524Eu, 0x7681D14Du,
+   0x2892ED69u, 0xDAF96E6Au, 0xC9A99D9Eu, 0x3BC21E9Du, 0xEF087A76u, 0x1D63F975u,
+   0x0E330A81u, 0xFC588982u, 0xB21572C9u, 0x407EF1CAu, 0x532E023Eu, 0xA145813Du,
+   0x758FE5D6u, 0x87E466D5u, 0x94B49521u, 0x66DF1622u, 0x38CC2A06u, 0xCAA7A905u,
+   0xD9F75AF1u, 0x2B9CD9F2u, 0xFF56BD19u, 0x0D3D3E1Au, 0x1E6DCDEEu, 0xEC064EEDu,
+   0xC38D26C4u, 0x31E6A5C7u, 0x22B65633u, 0xD0DDD530u, 0x0417B1DBu, 0xF67C32D8u,
+   0xE52CC12Cu, 0x1747422Fu, 0x49547E0Bu, 0xBB3FFD08u, 0xA86F0EFCu, 0x5A048DFFu,
+   0x8ECEE914u, 0x7CA56A17u, 0x6FF599E3u, 0x9D9E1AE0u, 0xD3D3E1ABu, 0x21B862A8u,
+   0x32E8915Cu, 0xC083125Fu, 0x144976B4u, 0xE622F5B7u, 0xF5720643u, 0x07198540u,
+   0x590AB964u, 0xAB613A67u, 0xB831C993u, 0x4A5A4A90u, 0x9E902E7Bu, 0x6CFBAD78u,
+   0x7FAB5E8Cu, 0x8DC0DD8Fu, 0xE330A81Au, 0x115B2B19u, 0x020BD8EDu, 0xF0605BEEu,
+   0x24AA3F05u, 0xD6C1BC06u, 0xC5914FF2u, 0x37FACCF1u, 0x69E9F0D5u, 0x9B8273D6u,
+   0x88D28022u, 0x7AB90321u, 0xAE7367CAu, 0x5C18E4C9u, 0x4F48173Du, 0xBD23943Eu,
+   0xF36E6F75u, 0x0105EC76u, 0x12551F82u, 0xE03E9C81u, 0x34F4F86Au, 0xC69F7B69u,
+   0xD5CF889Du, 0x27A40B9Eu, 0x79B737BAu, 0x8BDCB4B9u, 0x988C474Du, 0x6AE7C44Eu,
+   0xBE2DA0A5u, 0x4C4623A6u, 0x5F16D052u, 0xAD7D5351u
+};
+
+
+SC_KERNEL_INLINE float32_t loc_sum_squares(const float32_t *_s, size_t _num) {
+   float32_t acc[SC_KERNEL_LANES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+   float32_t ret = 0.0f;
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+   {
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         acc[k] += _s[i + k] * _s[i + k];
+      }
+   }
+
+   for(; i < _num; i++)
+   {
+      ret += _s[i] * _s[i];
+   }
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      ret += acc[k];
+   }
+
+   return ret;
+}
+
+SC_KERNEL_INLINE float32_t loc_peak_sum_squares(const float32_t *_s, size_t _num, float32_t *_retPeak) {
+   float32_t acc[SC_KERNEL_LANES]  = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+   float32_t peak[SC_KERNEL_LANES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+   float32_t ret = 0.0f;
+   float32_t retPeak = 0.0f;
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+   {
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         float32_t f = _s[i + k];
+         float32_t a = (f < 0.0f) ? -f : f;
+
+         acc[k] += f * f;
+         peak[k] = (a > peak[k]) ? a : peak[k];
+      }
+   }
+
+   for(; i < _num; i++)
+   {
+      float32_t f = _s[i];
+      float32_t a = (f < 0.0f) ? -f : f;
+
+      ret += f * f;
+      retPeak = (a > retPeak) ? a : retPeak;
+   }
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      ret += acc[k];
+      retPeak = (peak[k] > retPeak) ? peak[k] : retPeak;
+   }
+
+   *_retPeak = retPeak;
+
+   return ret;
+}
+
+SC_KERNEL_INLINE int16_t loc_convert_sample(float32_t _f, float32_t _scl) {
+   float32_t f = _f * _scl;
+
+   f += (f < 0.0f) ? -0.5f : 0.5f;
+   f = (f < SC_S16_MIN) ? SC_S16_MIN : f;
+   f = (f > SC_S16_MAX) ? SC_S16_MAX : f;
+
+   return (int16_t)f;
+}
+
+SC_KERNEL_INLINE void loc_convert_f32_s16(int16_t *_d, const float32_t *_s, size_t _num, float32_t _gain) {
+   float32_t scl = _gain * SC_S16_MAX;
+   size_t i;
+
+   for(i = 0; i < _num; i++)
+   {
+      _d[i] = loc_convert_sample(_s[i], scl);
+   }
+}
+
+SC_KERNEL_INLINE void loc_convert_f32_s16_reverse(int16_t *_d, const float32_t *_s, size_t _numFrames, uint32_t _numChannels, float32_t _gain) {
+   float32_t scl = _gain * SC_S16_MAX;
+   size_t i;
+
+   // (note) mono / stereo: blocks of SC_KERNEL_LANES frames are loaded in ascending order and stored reversed (vector shuffle)
+   if(1u == _numChannels)
+   {
+      size_t numVec = _numFrames & ~(size_t)(SC_KERNEL_LANES - 1u);
+      uint32_t k;
+
+      for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+      {
+         const float32_t *s = _s - i - (SC_KERNEL_LANES - 1u);
+
+         for(k = 0; k < SC_KERNEL_LANES; k++)
+         {
+            _d[i + k] = loc_convert_sample(s[SC_KERNEL_LANES - 1u - k], scl);
+         }
+      }
+
+      for(; i < _numFrames; i++)
+      {
+         _d[i] = loc_convert_sample(*(_s - i), scl);
+      }
+   }
+   else if(2u == _numChannels)
+   {
+      size_t numVec = _numFrames & ~(size_t)(SC_KERNEL_LANES - 1u);
+      uint32_t k;
+
+      for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+      {
+         const float32_t *s = _s - (2u * (i + SC_KERNEL_LANES - 1u));
+
+         for(k = 0; k < SC_KERNEL_LANES; k++)
+         {
+            _d[(2u * (i + k)) + 0u] = loc_convert_sample(s[(2u * (SC_KERNEL_LANES - 1u - k)) + 0u], scl);
+            _d[(2u * (i + k)) + 1u] = loc_convert_sample(s[(2u * (SC_KERNEL_LANES - 1u - k)) + 1u], scl);
+         }
+      }
+
+      for(; i < _numFrames; i++)
+      {
+         _d[(2u * i) + 0u] = loc_convert_sample(*(_s - (2u * i)), scl);
+         _d[(2u * i) + 1u] = loc_convert_sample(*(_s - (2u * i) + 1u), scl);
+      }
+   }
+   else
+   {
+      uint32_t ch;
+
+      for(i = 0; i < _numFrames; i++)
+      {
+         const float32_t *s = _s - (i * _numChannels);
+
+         for(ch = 0; ch < _numChannels; ch++)
+         {
+            _d[(i * _numChannels) + ch] = loc_convert_sample(s[ch], scl);
+         }
+      }
+   }
+}
+
+SC_KERNEL_INLINE void loc_sds_pack_s16(uint8_t *_d, const int16_t *_s, size_t _num) {
+   size_t i;
+
+   for(i = 0; i < _num; i++)
+   {
+      // (note) SDS samples are unsigned (0=full negative)
+      uint32_t v = (uint32_t)(_s[i] + 32768);
+
+      _d[(3u * i) + 0u] = (uint8_t) ((v >> 9) & 127u);
+      _d[(3u * i) + 1u] = (uint8_t) ((v >> 2) & 127u);
+      _d[(3u * i) + 2u] = (uint8_t) ((v << 5) & 96u);
+   }
+}
+
+SC_KERNEL_INLINE void loc_minmax_s16(const int16_t *_s, size_t _num, int16_t *_retMin, int16_t *_retMax) {
+   int16_t mn[SC_KERNEL_LANES];
+   int16_t mx[SC_KERNEL_LANES];
+   int16_t retMin = 32767;
+   int16_t retMax = -32768;
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      mn[k] = 32767;
+      mx[k] = -32768;
+   }
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+   {
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         int16_t v = _s[i + k];
+
+         mn[k] = (v < mn[k]) ? v : mn[k];
+         mx[k] = (v > mx[k]) ? v : mx[k];
+      }
+   }
+
+   for(; i < _num; i++)
+   {
+      retMin = (_s[i] < retMin) ? _s[i] : retMin;
+      retMax = (_s[i] > retMax) ? _s[i] : retMax;
+   }
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      retMin = (mn[k] < retMin) ? mn[k] : retMin;
+      retMax = (mx[k] > retMax) ? mx[k] : retMax;
+   }
+
+   *_retMin = retMin;
+   *_retMax = retMax;
+}
+
+SC_KERNEL_INLINE void loc_fixed_residual_sums(const int32_t *_s, size_t _num, uint64_t *_retSums) {
+   uint64_t acc0[SC_KERNEL_LANES];
+   uint64_t acc1[SC_KERNEL_LANES];
+   uint64_t acc2[SC_KERNEL_LANES];
+   uint64_t acc3[SC_KERNEL_LANES];
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      acc0[k] = 0u;
+      acc1[k] = 0u;
+      acc2[k] = 0u;
+      acc3[k] = 0u;
+   }
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+   {
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         const int32_t *x = _s + i + k;
+         int32_t r0 = x[0];
+         int32_t r1 = r0 - x[-1];
+         int32_t r2 = r1 - (x[-1] - x[-2]);
+         int32_t r3 = r2 - ((x[-1] - x[-2]) - (x[-2] - x[-3]));
+
+         acc0[k] += (uint32_t) ((r0 < 0) ? -r0 : r0);
+         acc1[k] += (uint32_t) ((r1 < 0) ? -r1 : r1);
+         acc2[k] += (uint32_t) ((r2 < 0) ? -r2 : r2);
+         acc3[k] += (uint32_t) ((r3 < 0) ? -r3 : r3);
+      }
+   }
+
+   _retSums[0] = 0u;
+   _retSums[1] = 0u;
+   _retSums[2] = 0u;
+   _retSums[3] = 0u;
+
+   for(; i < _num; i++)
+   {
+      const int32_t *x = _s + i;
+      int32_t r0 = x[0];
+      int32_t r1 = r0 - x[-1];
+      int32_t r2 = r1 - (x[-1] - x[-2]);
+      int32_t r3 = r2 - ((x[-1] - x[-2]) - (x[-2] - x[-3]));
+
+      _retSums[0] += (uint32_t) ((r0 < 0) ? -r0 : r0);
+      _retSums[1] += (uint32_t) ((r1 < 0) ? -r1 : r1);
+      _retSums[2] += (uint32_t) ((r2 < 0) ? -r2 : r2);
+      _retSums[3] += (uint32_t) ((r3 < 0) ? -r3 : r3);
+   }
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      _retSums[0] += acc0[k];
+      _retSums[1] += acc1[k];
+      _retSums[2] += acc2[k];
+      _retSums[3] += acc3[k];
+   }
+}
+
+SC_KERNEL_INLINE void loc_fixed_residuals(const int32_t *_s, size_t _num, uint32_t _order, uint32_t *_retRes) {
+   size_t i;
+
+   // (note) one loop per order so that each one vectorizes
+   switch(_order)
+   {
+      default:
+      case 0:
+         for(i = 0; i < _num; i++)
+         {
+            int32_t r = _s[i];
+
+            _retRes[i] = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+         }
+         break;
+
+      case 1:
+         for(i = 0; i < _num; i++)
+         {
+            int32_t r = _s[i] - (_s + i)[-1];
+
+            _retRes[i] = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+         }
+         break;
+
+      case 2:
+         for(i = 0; i < _num; i++)
+         {
+            int32_t r = _s[i] - 2 * (_s + i)[-1] + (_s + i)[-2];
+
+            _retRes[i] = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+         }
+         break;
+
+      case 3:
+         for(i = 0; i < _num; i++)
+         {
+            int32_t r = _s[i] - 3 * (_s + i)[-1] + 3 * (_s + i)[-2] - (_s + i)[-3];
+
+            _retRes[i] = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+         }
+         break;
+   }
+}
+
+SC_KERNEL_INLINE uint8_t loc_xor_u8(const uint8_t *_s, size_t _num) {
+   uint8_t acc[SC_KERNEL_LANES] = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u };
+   uint8_t ret = 0u;
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES)
+   {
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         acc[k] ^= _s[i + k];
+      }
+   }
+
+   for(; i < _num; i++)
+   {
+      ret ^= _s[i];
+   }
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      ret ^= acc[k];
+   }
+
+   return ret;
+}
+
+// Hash 32 bytes (one 32bit word per lane)
+SC_KERNEL_INLINE void loc_hash_lanes(uint32_t *_h, const void *_s) {
+   uint32_t w[SC_KERNEL_LANES];
+   uint32_t k;
+
+   memcpy(w, _s, sizeof(w));
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      uint32_t x = _h[k] ^ (w[k] * SC_HASH_PRIME32_1);
+
+      _h[k] = ((x << 15) | (x >> 17)) * SC_HASH_PRIME32_2;
+   }
+}
+
+// Combine the lane states and hash the remaining (< 32) bytes
+SC_KERNEL_INLINE uint64_t loc_hash_final(const uint32_t *_h, const uint8_t *_tail, size_t _numTail, size_t _numBytes, uint64_t _seed) {
+   uint64_t ret = _seed ^ ((uint64_t)_numBytes * SC_HASH_PRIME64_1);
+   size_t i;
+   uint32_t k;
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      ret = (ret ^ _h[k]) * SC_HASH_PRIME64_2;
+      ret ^= ret >> 29;
+   }
+
+   for(i = 0; i < _numTail; i++)
+   {
+      ret = (ret ^ _tail[i]) * SC_HASH_PRIME64_1;
+   }
+
+   // Final avalanche
+   ret ^= ret >> 33;
+   ret *= SC_HASH_PRIME64_2;
+   ret ^= ret >> 29;
+   ret *= SC_HASH_PRIME64_1;
+   ret ^= ret >> 32;
+
+   return ret;
+}
+
+SC_KERNEL_INLINE uint64_t loc_hash(const void *_data, size_t _numBytes, uint64_t _seed) {
+   const uint8_t *s = (const uint8_t*)_data;
+   uint32_t h[SC_KERNEL_LANES];
+   size_t numVec = _numBytes & ~(size_t)(SC_KERNEL_LANES * sizeof(uint32_t) - 1u);
+   size_t i;
+   uint32_t k;
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      h[k] = (uint32_t)_seed + (k * SC_HASH_PRIME32_1);
+   }
+
+   for(i = 0; i < numVec; i += SC_KERNEL_LANES * sizeof(uint32_t))
+   {
+      loc_hash_lanes(h, s + i);
+   }
+
+   return loc_hash_final(h, s + i, _numBytes - i, _numBytes, _seed);
+}
+
+// Lane states of the fused analysis kernel
+typedef struct {
+   float32_t sum_sq[SC_KERNEL_LANES];
+   float32_t peak[SC_KERNEL_LANES];        // peak of the current block
+   size_t    first_loud[SC_KERNEL_LANES];  // SIZE_MAX=none
+   size_t    end_loud[SC_KERNEL_LANES];
+   size_t    zero_cross[SC_KERNEL_LANES];
+   uint32_t  h[SC_KERNEL_LANES];
+} analysis_lanes_t;
+
+// Analyze samples [i, i+SC_KERNEL_LANES[
+//  - 'bZeroCross' must be false for the first 'numCh' samples (no preceding sample in the channel)
+SC_KERNEL_INLINE void loc_analyze_lanes(analysis_lanes_t *_l, const float32_t *_s, size_t _i, size_t _numCh,
+                                        float32_t _silenceLevel, bool_t _bZeroCross
+                                        ) {
+   uint32_t k;
+
+   loc_hash_lanes(_l->h, _s + _i);
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      size_t idx = _i + k;
+      float32_t f = _s[idx];
+      float32_t a = (f < 0.0f) ? -f : f;
+      bool_t bLoud = (a >= _silenceLevel);
+
+      _l->sum_sq[k]     += f * f;
+      _l->peak[k]        = (a > _l->peak[k]) ? a : _l->peak[k];
+      _l->first_loud[k]  = (bLoud && (idx < _l->first_loud[k])) ? idx : _l->first_loud[k];
+      _l->end_loud[k]    = bLoud ? (idx + 1u) : _l->end_loud[k];
+
+      if(_bZeroCross)
+      {
+         _l->zero_cross[k] = ((f < 0.0f) != (_s[idx - _numCh] < 0.0f)) ? idx : _l->zero_cross[k];
+      }
+   }
+}
+
+SC_KERNEL_INLINE void loc_analyze(const float32_t *_s, size_t _num, uint32_t _numChannels, float32_t _silenceLevel,
+                                  size_t _blockSize, float32_t *_retBlockPeaks, sc_kernel_analysis_t *_ret
+                                  ) {
+   analysis_lanes_t l;
+   size_t numVec = _num & ~(size_t)(SC_KERNEL_LANES - 1u);
+   size_t numCh = _numChannels;
+   size_t zeroCrossStart = (numCh + SC_KERNEL_LANES - 1u) & ~(size_t)(SC_KERNEL_LANES - 1u);
+   float32_t sumSq = 0.0f;
+   float32_t peak = 0.0f;
+   size_t firstLoud = _num;
+   size_t endLoud = 0;
+   size_t zeroCross = 0;
+   size_t blockIdx = 0;
+   size_t i = 0;
+   uint32_t k;
+
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      l.sum_sq[k]     = 0.0f;
+      l.peak[k]       = 0.0f;
+      l.first_loud[k] = SIZE_MAX;
+      l.end_loud[k]   = 0;
+      l.zero_cross[k] = 0;
+      l.h[k]          = k * SC_HASH_PRIME32_1;  // (note) seed 0, see loc_hash()
+   }
+
+   while(i < numVec)
+   {
+      size_t blockEnd = ((numVec - i) < _blockSize) ? numVec : (i + _blockSize);
+      float32_t blockPeak = 0.0f;
+
+      for(; (i < blockEnd) && (i < zeroCrossStart); i += SC_KERNEL_LANES)
+      {
+         loc_analyze_lanes(&l, _s, i, numCh, _silenceLevel, SC_FALSE);
+      }
+
+      for(; i < blockEnd; i += SC_KERNEL_LANES)
+      {
+         loc_analyze_lanes(&l, _s, i, numCh, _silenceLevel, SC_TRUE);
+      }
+
+      for(k = 0; k < SC_KERNEL_LANES; k++)
+      {
+         blockPeak = (l.peak[k] > blockPeak) ? l.peak[k] : blockPeak;
+         l.peak[k] = 0.0f;
+      }
+
+      _retBlockPeaks[blockIdx++] = blockPeak;
+      peak = (blockPeak > peak) ? blockPeak : peak;
+   }
+
+   // Zero crossings within the first vectors
+   for(i = numCh; (i < zeroCrossStart) && (i < numVec); i++)
+   {
+      zeroCross = ((_s[i] < 0.0f) != (_s[i - numCh] < 0.0f)) ? i : zeroCross;
+   }
+
+   // Remaining samples (part of the last block)
+   if(numVec < _num)
+   {
+      float32_t blockPeak = 0.0f;
+
+      if(0 != (numVec % _blockSize))
+      {
+         blockPeak = _retBlockPeaks[--blockIdx];
+      }
+
+      for(i = numVec; i < _num; i++)
+      {
+         float32_t f = _s[i];
+         float32_t a = (f < 0.0f) ? -f : f;
+
+         sumSq += f * f;
+         blockPeak = (a > blockPeak) ? a : blockPeak;
+
+         if(a >= _silenceLevel)
+         {
+            firstLoud = (i < firstLoud) ? i : firstLoud;
+            endLoud = i + 1u;
+         }
+
+         if((i >= numCh) && ((f < 0.0f) != (_s[i - numCh] < 0.0f)))
+         {
+            zeroCross = i;
+         }
+      }
+
+      _retBlockPeaks[blockIdx] = blockPeak;
+      peak = (blockPeak > peak) ? blockPeak : peak;
+   }
+
+   // (note) same summation order as loc_peak_sum_squares()
+   for(k = 0; k < SC_KERNEL_LANES; k++)
+   {
+      sumSq    += l.sum_sq[k];
+      firstLoud = (l.first_loud[k] < firstLoud) ? l.first_loud[k] : firstLoud;
+      endLoud   = (l.end_loud[k] > endLoud) ? l.end_loud[k] : endLoud;
+      zeroCross = (l.zero_cross[k] > zeroCross) ? l.zero_cross[k] : zeroCross;
+   }
+
+   _ret->peak               = peak;
+   _ret->sum_squares        = sumSq;
+   _ret->first_loud         = firstLoud;
+   _ret->end_loud           = endLoud;
+   _ret->last_zero_crossing = zeroCross;
+   _ret->hash               = loc_hash_final(l.h, (const uint8_t*)(_s + numVec), sizeof(float32_t) * (_num - numVec),
+                                             sizeof(float32_t) * _num, 0u
+                                             );
+}
+
+// (note) '_c' is the non-inverted CRC state in all loc_crc32c_xxx() functions
+static uint32_t loc_crc32c_sw(const uint8_t *_s, size_t _num, uint32_t _c) {
+   size_t i;
+
+   for(i = 0; i < _num; i++)
+   {
+      _c = loc_crc32c_table[(_c ^ _s[i]) & 255u] ^ (_c >> 8);
+   }
+
+   return _c;
+}
+
+#if defined(SC_KERNEL_X86)
+__attribute__((target("sse4.2")))
+static uint32_t loc_crc32c_hw(const uint8_t *_s, size_t _num, uint32_t _c) {
+   uint64_t c = _c;
+   size_t i;
+
+   for(i = 0; (i + 8u) <= _num; i += 8u)
+   {
+      uint64_t w;
+
+      memcpy(&w, _s + i, sizeof(w));
+      c = _mm_crc32_u64(c, w);
+   }
+
+   for(; i < _num; i++)
+   {
+      c = _mm_crc32_u8((uint32_t)c, _s[i]);
+   }
+
+   return (uint32_t)c;
+}
+
+// Checksum three equally sized blocks (independent dependency chains)
+__attribute__((target("sse4.2")))
+static void loc_crc32c_hw3(const uint8_t *_s, size_t _blockSize, uint32_t *_retC) {
+   uint64_t c0 = _retC[0];
+   uint64_t c1 = _retC[1];
+   uint64_t c2 = _retC[2];
+   size_t i;
+
+   for(i = 0; (i + 8u) <= _blockSize; i += 8u)
+   {
+      uint64_t w[SC_CRC32C_STREAMS];
+
+      memcpy(&w[0], _s + i, sizeof(uint64_t));
+      memcpy(&w[1], _s + _blockSize + i, sizeof(uint64_t));
+      memcpy(&w[2], _s + (2u * _blockSize) + i, sizeof(uint64_t));
+
+      c0 = _mm_crc32_u64(c0, w[0]);
+      c1 = _mm_crc32_u64(c1, w[1]);
+      c2 = _mm_crc32_u64(c2, w[2]);
+   }
+
+   _retC[0] = loc_crc32c_hw(_s + i,                      _blockSize - i, (uint32_t)c0);
+   _retC[1] = loc_crc32c_hw(_s + _blockSize + i,         _blockSize - i, (uint32_t)c1);
+   _retC[2] = loc_crc32c_hw(_s + (2u * _blockSize) + i,  _blockSize - i, (uint32_t)c2);
+}
+
+#elif defined(SC_CRC32C_ARM)
+static uint32_t loc_crc32c_hw(const uint8_t *_s, size_t _num, uint32_t _c) {
+   size_t i;
+
+   for(i = 0; (i + 8u) <= _num; i += 8u)
+   {
+      uint64_t w;
+
+      memcpy(&w, _s + i, sizeof(w));
+      _c = __crc32cd(_c, w);
+   }
+
+   for(; i < _num; i++)
+   {
+      _c = __crc32cb(_c, _s[i]);
+   }
+
+   return _c;
+}
+
+static void loc_crc32c_hw3(const uint8_t *_s, size_t _blockSize, uint32_t *_retC) {
+   uint32_t k;
+
+   // (note) the compiler interleaves the three (inlined) loops
+   for(k = 0; k < SC_CRC32C_STREAMS; k++)
+   {
+      _retC[k] = loc_crc32c_hw(_s + (k * _blockSize), _blockSize, _retC[k]);
+   }
+}
+
+#endif
+
+// Kernel variants of one instruction set
+typedef struct {
+   float32_t (*sum_squares)             (const float32_t *_s, size_t _num);
+   float32_t (*peak_sum_squares)        (const float32_t *_s, size_t _num, float32_t *_retPeak);
+   void      (*convert_f32_s16)         (int16_t *_d, const float32_t *_s, size_t _num, float32_t _gain);
+   void      (*convert_f32_s16_reverse) (int16_t *_d, const float32_t *_s, size_t _numFrames, uint32_t _numChannels, float32_t _gain);
+   void      (*sds_pack_s16)            (uint8_t *_d, const int16_t *_s, size_t _num);
+   void      (*minmax_s16)              (const int16_t *_s, size_t _num, int16_t *_retMin, int16_t *_retMax);
+   void      (*fixed_residual_sums)     (const int32_t *_s, size_t _num, uint64_t *_retSums);
+   void      (*fixed_residuals)         (const int32_t *_s, size_t _num, uint32_t _order, uint32_t *_retRes);
+   uint8_t   (*xor_u8)                  (const uint8_t *_s, size_t _num);
+   uint64_t  (*hash)                    (const void *_data, size_t _numBytes, uint64_t _seed);
+   void      (*analyze)                 (const float32_t *_s, size_t _num, uint32_t _numChannels, float32_t _silenceLevel,
+                                         size_t _blockSize, float32_t *_retBlockPeaks, sc_kernel_analysis_t *_ret);
+   uint32_t  (*crc32c)                  (const uint8_t *_s, size_t _num, uint32_t _c);
+   void      (*crc32c_3)                (const uint8_t *_s, size_t _blockSize, uint32_t *_retC);  // NULL=no crc32 instruction
+} kernel_table_t;
+
+// Instantiate the kernels, compiled with the code generation attributes 'attr'
+#define SC_KERNEL_VARIANTS(isa, attr)                                                                             \
+   attr static float32_t loc_sum_squares_##isa(const float32_t *_s, size_t _num) {                                \
+      return loc_sum_squares(_s, _num);                                                                           \
+   }                                                                                                              \
+   attr static float32_t loc_peak_sum_squares_##isa(const float32_t *_s, size_t _num, float32_t *_retPeak) {      \
+      return loc_peak_sum_squares(_s, _num, _retPeak);                                                            \
+   }                                                                                                              \
+   attr static void loc_convert_f32_s16_##isa(int16_t *_d, const float32_t *_s, size_t _num, float32_t _gain) {   \
+      loc_convert_f32_s16(_d, _s, _num, _gain);                                                                   \
+   }                                                                                                              \
+   attr static void loc_convert_f32_s16_reverse_##isa(int16_t *_d, const float32_t *_s, size_t _numFrames,                 \
+                                                      uint32_t _numChannels, float32_t _gain) {                        \
+      loc_convert_f32_s16_reverse(_d, _s, _numFrames, _numChannels, _gain);                                       \
+   }                                                                                                              \
+   attr static void loc_sds_pack_s16_##isa(uint8_t *_d, const int16_t *_s, size_t _num) {                         \
+      loc_sds_pack_s16(_d, _s, _num);                                                                             \
+   }                                                                                                              \
+   attr static void loc_minmax_s16_##isa(const int16_t *_s, size_t _num, int16_t *_retMin, int16_t *_retMax) {    \
+      loc_minmax_s16(_s, _num, _retMin, _retMax);                                                                 \
+   }                                                                                                              \
+   attr static void loc_fixed_residual_sums_##isa(const int32_t *_s, size_t _num, uint64_t *_retSums) {           \
+      loc_fixed_residual_sums(_s, _num, _retSums);                                                                \
+   }                                                                                                              \
+   attr static void loc_fixed_residuals_##isa(const int32_t *_s, size_t _num, uint32_t _order, uint32_t *_retRes) { \
+      loc_fixed_residuals(_s, _num, _order, _retRes);                                                             \
+   }                                                                                                              \
+   attr static uint8_t loc_xor_u8_##isa(const uint8_t *_s, size_t _num) {                                         \
+      return loc_xor_u8(_s, _num);                                                                                \
+   }                                                                                                              \
+   attr static uint64_t loc_hash_##isa(const void *_data, size_t _numBytes, uint64_t _seed) {                     \
+      return loc_hash(_data, _numBytes, _seed);                                                                   \
+   }                                                                                                              \
+   attr static void loc_analyze_##isa(const float32_t *_s, size_t _num, uint32_t _numChannels, float32_t _silenceLevel, \
+                                      size_t _blockSize, float32_t *_retBlockPeaks, sc_kernel_analysis_t *_ret) {     \
+      loc_analyze(_s, _num, _numChannels, _silenceLevel, _blockSize, _retBlockPeaks, _ret);                      \
+   }
+
+#define SC_KERNEL_TABLE(isa, crc32c, crc32c_3) {                                        \
+      &loc_sum_squares_##isa, &loc_peak_sum_squares_##isa, &loc_convert_f32_s16_##isa,  \
+      &loc_convert_f32_s16_reverse_##isa,                                               \
+      &loc_sds_pack_s16_##isa, &loc_minmax_s16_##isa, &loc_fixed_residual_sums_##isa,   \
+      &loc_fixed_residuals_##isa, &loc_xor_u8_##isa, &loc_hash_##isa,                  \
+      &loc_analyze_##isa,                                                               \
+      (crc32c), (crc32c_3)                                                              \
+   }
+
+SC_KERNEL_VARIANTS(scalar, SC_KERNEL_ATTR_SCALAR)
+SC_KERNEL_VARIANTS(baseline, SC_KERNEL_ATTR_EXACT)
+
+static const kernel_table_t loc_kernels_scalar = SC_KERNEL_TABLE(scalar, &loc_crc32c_sw, NULL);
+
+#if defined(SC_CRC32C_ARM)
+static const kernel_table_t loc_kernels_baseline = SC_KERNEL_TABLE(baseline, &loc_crc32c_hw, &loc_crc32c_hw3);
+#else
+static const kernel_table_t loc_kernels_baseline = SC_KERNEL_TABLE(baseline, &loc_crc32c_sw, NULL);
+#endif
+
+#if defined(SC_KERNEL_X86)
+SC_KERNEL_VARIANTS(sse42,  SC_KERNEL_ATTR_EXACT __attribute__((target("sse4.2"))))
+SC_KERNEL_VARIANTS(avx2,   SC_KERNEL_ATTR_EXACT __attribute__((target("avx2"))))
+SC_KERNEL_VARIANTS(avx512, SC_KERNEL_ATTR_EXACT __attribute__((target("avx512f,avx512bw,avx512vl"))))
+
+static const kernel_table_t loc_kernels_sse42  = SC_KERNEL_TABLE(sse42,  &loc_crc32c_hw, &loc_crc32c_hw3);
+static const kernel_table_t loc_kernels_avx2   = SC_KERNEL_TABLE(avx2,   &loc_crc32c_hw, &loc_crc32c_hw3);
+static const kernel_table_t loc_kernels_avx512 = SC_KERNEL_TABLE(avx512, &loc_crc32c_hw, &loc_crc32c_hw3);
+
+static const kernel_table_t *const loc_kernel_tables[SC_KERNEL_NUM_ISAS] = {
+   &loc_kernels_scalar, &loc_kernels_baseline, &loc_kernels_sse42, &loc_kernels_avx2, &loc_kernels_avx512
+};
+#else
+static const kernel_table_t *const loc_kernel_tables[SC_KERNEL_NUM_ISAS] = {
+   &loc_kernels_scalar, &loc_kernels_baseline, NULL, NULL, NULL
+};
+#endif
+
+static const char *const loc_isa_names[SC_KERNEL_NUM_ISAS] = {
+   "scalar", "baseline", "sse4.2", "avx2", "avx512"
+};
+
+static uint32_t loc_cpu_isa = ~0u;                 // detected once (see sc_kernel_detect_isa())
+static uint32_t loc_isa = ~0u;                     // bound instruction set
+static const kernel_table_t *loc_kernels = NULL;   // bound variants (NULL=not bound yet)
+
+// Bind the best supported variants (or the ones selected via the "SC_KERNEL_ISA" environment variable)
+static const kernel_table_t *loc_bind_default(void) {
+   uint32_t isa = sc_kernel_detect_isa();
+   const char *env = getenv("SC_KERNEL_ISA");
+
+   if(NULL != env)
+   {
+      uint32_t envIsa;
+
+      for(envIsa = 0; envIsa < SC_KERNEL_NUM_ISAS; envIsa++)
+      {
+         if(0 == strcmp(env, loc_isa_names[envIsa]))
+         {
+            break;
+         }
+      }
+
+      if(envIsa <= isa)
+      {
+         isa = envIsa;
+      }
+   }
+
+   sc_kernel_set_isa(isa);
+
+   return SC_ATOMIC_LOAD(&loc_kernels);
+}
+
+static const kernel_table_t *loc_get_kernels(void) {
+   const kernel_table_t *ret = SC_ATOMIC_LOAD(&loc_kernels);
+
+   if(NULL == ret)
+   {
+      // (note) concurrent first calls bind the same variants
+      ret = loc_bind_default();
+   }
+
+   return ret;
+}
+
+uint32_t sc_kernel_detect_isa(void) {
+   uint32_t ret = SC_ATOMIC_LOAD(&loc_cpu_isa);
+
+   if(~0u == ret)
+   {
+      ret = SC_KERNEL_ISA_BASELINE;
+
+#if defined(SC_KERNEL_X86)
+      __builtin_cpu_init();
+
+      if(__builtin_cpu_supports("sse4.2"))
+      {
+         ret = SC_KERNEL_ISA_SSE42;
+
+         if(__builtin_cpu_supports("avx2"))
+         {
+            ret = SC_KERNEL_ISA_AVX2;
+
+            if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+            {
+               ret = SC_KERNEL_ISA_AVX512;
+            }
+         }
+      }
+#endif
+
+      SC_ATOMIC_STORE(&loc_cpu_isa, ret);
+   }
+
+   return ret;
+}
+
+bool_t sc_kernel_set_isa(uint32_t _isa) {
+   bool_t ret = (_isa <= sc_kernel_detect_isa()) && (NULL != loc_kernel_tables[_isa]);
+
+   if(ret)
+   {
+      SC_ATOMIC_STORE(&loc_isa, _isa);
+      SC_ATOMIC_STORE(&loc_kernels, loc_kernel_tables[_isa]);
+   }
+
+   return ret;
+}
+
+uint32_t sc_kernel_get_isa(void) {
+   loc_get_kernels();
+
+   return SC_ATOMIC_LOAD(&loc_isa);
+}
+
+const char *sc_kernel_get_isa_name(uint32_t _isa) {
+   return (_isa < SC_KERNEL_NUM_ISAS) ? loc_isa_names[_isa] : "?";
+}
+
+float32_t sc_kernel_sum_squares(const float32_t *_s, size_t _num) {
+   return loc_get_kernels()->sum_squares(_s, _num);
+}
+
+float32_t sc_kernel_peak_sum_squares(const float32_t *_s, size_t _num, float32_t *_retPeak) {
+   return loc_get_kernels()->peak_sum_squares(_s, _num, _retPeak);
+}
+
+void sc_kernel_convert_f32_s16(int16_t *_d, const float32_t *_s, size_t _num, float32_t _gain) {
+   loc_get_kernels()->convert_f32_s16(_d, _s, _num, _gain);
+}
+
+void sc_kernel_convert_f32_s16_reverse(int16_t *_d, const float32_t *_s, size_t _numFrames, uint32_t _numChannels, float32_t _gain) {
+   loc_get_kernels()->convert_f32_s16_reverse(_d, _s, _numFrames, _numChannels, _gain);
+}
+
+void sc_kernel_sds_pack_s16(uint8_t *_d, const int16_t *_s, size_t _num) {
+   loc_get_kernels()->sds_pack_s16(_d, _s, _num);
+}
+
+void sc_kernel_minmax_s16(const int16_t *_s, size_t _num, int16_t *_retMin, int16_t *_retMax) {
+   loc_get_kernels()->minmax_s16(_s, _num, _retMin, _retMax);
+}
+
+void sc_kernel_fixed_residual_sums(const int32_t *_s, size_t _num, uint64_t *_retSums) {
+   loc_get_kernels()->fixed_residual_sums(_s, _num, _retSums);
+}
+
+void sc_kernel_fixed_residuals(const int32_t *_s, size_t _num, uint32_t _order, uint32_t *_retRes) {
+   loc_get_kernels()->fixed_residuals(_s, _num, _order, _retRes);
+}
+
+uint8_t sc_kernel_xor_u8(const uint8_t *_s, size_t _num) {
+   return loc_get_kernels()->xor_u8(_s, _num);
+}
+
+uint64_t sc_kernel_hash(const void *_data, size_t _numBytes, uint64_t _seed) {
+   return loc_get_kernels()->hash(_data, _numBytes, _seed);
+}
+
+void sc_kernel_analyze(const float32_t *_s, size_t _num, uint32_t _numChannels, float32_t _silenceLevel,
+                       size_t _blockSize, float32_t *_retBlockPeaks, sc_kernel_analysis_t *_ret
+                       ) {
+   loc_get_kernels()->analyze(_s, _num, _numChannels, _silenceLevel, _blockSize, _retBlockPeaks, _ret);
+}
+
+uint32_t sc_kernel_crc32c(const void *_data, size_t _numBytes, uint32_t _crc) {
+   return ~loc_get_kernels()->crc32c((const uint8_t*)_data, _numBytes, ~_crc);
+}
+
+void sc_kernel_crc32c_blocks(const void *_data, size_t _numBytes, size_t _blockSize, uint32_t *_retCrcs) {
+   const kernel_table_t *kernels = loc_get_kernels();
+   const uint8_t *s = (const uint8_t*)_data;
+   size_t off = 0;
+   uint32_t blockIdx = 0;
+
+   if(0 == _blockSize)
+   {
+      return;
+   }
+
+   if(NULL != kernels->crc32c_3)
+   {
+      while((off + (SC_CRC32C_STREAMS * _blockSize)) <= _numBytes)
+      {
+         uint32_t k;
+
+         for(k = 0; k < SC_CRC32C_STREAMS; k++)
+         {
+            _retCrcs[blockIdx + k] = ~0u;
+         }
+
+         kernels->crc32c_3(s + off, _blockSize, _retCrcs + blockIdx);
+
+         for(k = 0; k < SC_CRC32C_STREAMS; k++)
+         {
+            _retCrcs[blockIdx + k] = ~_retCrcs[blockIdx + k];
+         }
+
+         off      += SC_CRC32C_STREAMS * _blockSize;
+         blockIdx += SC_CRC32C_STREAMS;
+      }
+   }
+
+   // Remaining blocks (incl. the last, partial block)
+   while(off < _numBytes)
+   {
+      size_t num = ((_numBytes - off) < _blockSize) ? (_numBytes - off) : _blockSize;
+
+      _retCrcs[blockIdx++] = ~kernels->crc32c(s + off, num, ~0u);
+      off += num;
+   }
+}
@@ -0,0 +1,136 @@
+/* ----
+ * ---- file   : kernels.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_KERNELS_H_INCLUDED
+#define SAMPLECHAIN_KERNELS_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Inner loops shared by the analysis / render modules
+//  - Written as independent multi-lane accumulations so that the compiler can vectorize them
+//  - Each kernel is compiled once per instruction set, the variants of the best instruction set supported
+//     by the CPU are bound before the first kernel call (see sc_kernel_set_isa())
+//  - 'num' is the number of samples (not frames)
+
+
+// Kernel instruction sets
+#define SC_KERNEL_ISA_SCALAR    0u  // no SIMD (reference)
+#define SC_KERNEL_ISA_BASELINE  1u  // compiler default (SSE2 on x86-64, NEON on AArch64)
+#define SC_KERNEL_ISA_SSE42     2u  // SSE4.1 + SSE4.2 (incl. crc32 instruction)
+#define SC_KERNEL_ISA_AVX2      3u
+#define SC_KERNEL_ISA_AVX512    4u  // AVX-512 F / BW / VL
+#define SC_KERNEL_NUM_ISAS      5u
+
+// Query the best instruction set supported by the CPU (detected once)
+uint32_t sc_kernel_detect_isa (void);
+
+// Bind the kernel variants of an instruction set (SC_KERNEL_ISA_xxx), e.g. SC_KERNEL_ISA_SCALAR for testing
+//  - By default, the variants of sc_kernel_detect_isa() are bound before the first kernel call.
+//     The "SC_KERNEL_ISA" environment variable (e.g. SC_KERNEL_ISA=scalar) selects a lower instruction set
+//  - Thread-safe (kernel calls that are already running finish with the previous variants)
+//  - Returns false if the instruction set is not supported by the CPU (or not compiled in)
+bool_t sc_kernel_set_isa (uint32_t _isa);
+
+// Query the bound instruction set
+uint32_t sc_kernel_get_isa (void);
+
+// Query the name of an instruction set (e.g. "avx2")
+const char *sc_kernel_get_isa_name (uint32_t _isa);
+
+
+// Returns the sum of squared sample values
+float32_t sc_kernel_sum_squares (const float32_t *_s, size_t _num);
+
+// Returns the sum of squared sample values and stores the absolute peak value in 'retPeak'
+float32_t sc_kernel_peak_sum_squares (const float32_t *_s, size_t _num, float32_t *_retPeak);
+
+// Convert float samples to signed 16bit (with gain, rounding and clipping)
+void sc_kernel_convert_f32_s16 (int16_t *_d, const float32_t *_s, size_t _num, float32_t _gain);
+
+// Convert float sample frames to signed 16bit in reverse frame order (same rounding / clipping as sc_kernel_convert_f32_s16())
+//  - 's' points to the last source frame, i.e. 'd' receives s[0], s[-1], .. (the channel order within a frame is kept)
+void sc_kernel_convert_f32_s16_reverse (int16_t *_d, const float32_t *_s, size_t _numFrames, uint32_t _numChannels, float32_t _gain);
+
+// Pack signed 16bit samples into MIDI sample dump 7bit data bytes (3 bytes per sample, left-justified)
+void sc_kernel_sds_pack_s16 (uint8_t *_d, const int16_t *_s, size_t _num);
+
+// Calculate the min / max of 'num' signed 16bit samples ('num' > 0)
+void sc_kernel_minmax_s16 (const int16_t *_s, size_t _num, int16_t *_retMin, int16_t *_retMax);
+
+// Calculate the sums of the absolute fixed polynomial prediction residuals (orders 0..3) of 'num' samples
+//  - 's' must be preceded by 3 valid samples (s[-3..-1])
+//  - Stores 4 sums in 'retSums'
+void sc_kernel_fixed_residual_sums (const int32_t *_s, size_t _num, uint64_t *_retSums);
+
+// Calculate zigzag-mapped fixed polynomial prediction residuals of order 'order' (0..3) of 'num' samples
+//  - 's' must be preceded by 'order' valid samples
+void sc_kernel_fixed_residuals (const int32_t *_s, size_t _num, uint32_t _order, uint32_t *_retRes);
+
+// Returns the XOR of 'num' bytes
+uint8_t sc_kernel_xor_u8 (const uint8_t *_s, size_t _num);
+
+// Calculate 64bit (non-cryptographic) content hash of 'numBytes' bytes
+//  - Processes 32 bytes per iteration in 8 independent 32bit lanes
+uint64_t sc_kernel_hash (const void *_data, size_t _numBytes, uint64_t _seed);
+
+// Results of sc_kernel_analyze() (sample indices)
+typedef struct {
+   float32_t peak;                // absolute peak sample value
+   float32_t sum_squares;         // same as sc_kernel_peak_sum_squares()
+   size_t    first_loud;          // first sample whose magnitude is >= 'silenceLevel' ('num' if there is none)
+   size_t    end_loud;            // index after the last such sample (0 if there is none)
+   size_t    last_zero_crossing;  // last sample whose sign differs from the preceding sample of its channel (0 if there is none)
+   uint64_t  hash;                // same as sc_kernel_hash(s, num * sizeof(float32_t), 0)
+} sc_kernel_analysis_t;
+
+// Fused analysis of 'num' interleaved float samples (see sc_kernel_analysis_t), reads each sample once
+//  - Also stores the absolute peak of each consecutive 'blockSize' sample block in 'retBlockPeaks' (the last block may be shorter)
+//  - 'blockSize' must be a (non-zero) multiple of 8
+//  - 'retBlockPeaks' must provide room for ceil(num / blockSize) values
+void sc_kernel_analyze (const float32_t *_s, size_t _num, uint32_t _numChannels, float32_t _silenceLevel,
+                        size_t _blockSize, float32_t *_retBlockPeaks, sc_kernel_analysis_t *_ret
+                        );
+
+// Calculate CRC32C (Castagnoli) checksum of 'numBytes' bytes
+//  - 'crc' is the checksum of the preceding data (0 for the first call)
+//  - Uses the crc32 instruction when available (SSE4.2, detected at runtime / ARMv8 CRC extension), table lookups otherwise
+uint32_t sc_kernel_crc32c (const void *_data, size_t _numBytes, uint32_t _crc);
+
+// Calculate CRC32C checksums of consecutive 'blockSize' byte blocks (the last block may be shorter)
+//  - 'retCrcs' must provide room for ceil(numBytes / blockSize) checksums
+//  - Checksums three blocks at a time (independent dependency chains hide the crc32 instruction latency)
+void sc_kernel_crc32c_blocks (const void *_data, size_t _numBytes, size_t _blockSize, uint32_t *_retCrcs);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_KERNELS_H_INCLUDED
@@ -0,0 +1,233 @@
+/* ----
+ * ---- file   : profile.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../algorithm_interface_proposal.h"
+#include "thread.h"
+#include "profile.h"
+
+
+static const char *const loc_phase_names[SC_PROFILE_NUM_PHASES] = {
+   "calc",
+   "layout",
+   "align",
+   "render",
+   "fetch",
+   "analyze",
+   "convert",
+   "io"
+};
+
+static const char *const loc_counter_names[SC_PROFILE_NUM_COUNTERS] = {
+   "iterations",
+   "align_passes",
+   "bytes_copied",
+   "bytes_zeroed",
+   "bytes_written",
+   "cache_hits"
+};
+
+
+const char *samplechain_profile_get_phase_name(uint32_t _phaseIdx) {
+   return (_phaseIdx < SC_PROFILE_NUM_PHASES) ? loc_phase_names[_phaseIdx] : NULL;
+}
+
+const char *samplechain_profile_get_counter_name(uint32_t _counterIdx) {
+   return (_counterIdx < SC_PROFILE_NUM_COUNTERS) ? loc_counter_names[_counterIdx] : NULL;
+}
+
+
+#ifdef SC_PROFILE
+
+typedef struct {
+   uint64_t t_begin;   // ns since reset
+   uint64_t dur;       // ns
+   uint32_t phase_idx;
+   uint32_t thread_id;
+} event_t;
+
+static samplechain_profile_phase_t loc_phases[SC_PROFILE_NUM_PHASES];
+static uint64_t loc_counters[SC_PROFILE_NUM_COUNTERS];
+
+static event_t  loc_events[SC_PROFILE_MAX_EVENTS];
+static uint32_t loc_num_events;
+
+static uint64_t loc_t_start;
+static uint32_t loc_next_thread_id;
+
+static __thread uint32_t loc_thread_id;  // 0=not assigned, yet
+
+
+static uint64_t loc_get_time_ns(void) {
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t sc_profile_begin(void) {
+   return loc_get_time_ns();
+}
+
+void sc_profile_end(uint32_t _phaseIdx, uint64_t _t0) {
+   uint64_t dur = loc_get_time_ns() - _t0;
+   samplechain_profile_phase_t *phase = &loc_phases[_phaseIdx];
+   uint64_t maxNs = SC_ATOMIC_LOAD(&phase->max_ns);
+   uint32_t eventIdx;
+
+   SC_ATOMIC_ADD(&phase->num_calls, 1u);
+   SC_ATOMIC_ADD(&phase->total_ns, dur);
+
+   while((dur > maxNs) && !__atomic_compare_exchange_n(&phase->max_ns, &maxNs, dur, SC_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+   {
+      // 'maxNs' has been updated by another thread
+   }
+
+   eventIdx = SC_ATOMIC_ADD(&loc_num_events, 1u);
+
+   if(eventIdx < SC_PROFILE_MAX_EVENTS)
+   {
+      event_t *ev = &loc_events[eventIdx];
+
+      if(0u == loc_thread_id)
+      {
+         loc_thread_id = SC_ATOMIC_ADD(&loc_next_thread_id, 1u) + 1u;
+      }
+
+      ev->t_begin   = _t0 - SC_ATOMIC_LOAD(&loc_t_start);
+      ev->dur       = dur;
+      ev->phase_idx = _phaseIdx;
+      ev->thread_id = loc_thread_id;
+   }
+}
+
+void sc_profile_count(uint32_t _counterIdx, uint64_t _n) {
+   SC_ATOMIC_ADD(&loc_counters[_counterIdx], _n);
+}
+
+bool_t samplechain_profile_query(samplechain_profile_t *_ret) {
+   uint32_t idx;
+   uint32_t numEvents = SC_ATOMIC_LOAD(&loc_num_events);
+
+   for(idx = 0; idx < SC_PROFILE_NUM_PHASES; idx++)
+   {
+      _ret->phases[idx].num_calls = SC_ATOMIC_LOAD(&loc_phases[idx].num_calls);
+      _ret->phases[idx].total_ns  = SC_ATOMIC_LOAD(&loc_phases[idx].total_ns);
+      _ret->phases[idx].max_ns    = SC_ATOMIC_LOAD(&loc_phases[idx].max_ns);
+   }
+
+   for(idx = 0; idx < SC_PROFILE_NUM_COUNTERS; idx++)
+   {
+      _ret->counters[idx] = SC_ATOMIC_LOAD(&loc_counters[idx]);
+   }
+
+   _ret->num_events  = (numEvents < SC_PROFILE_MAX_EVENTS) ? numEvents : SC_PROFILE_MAX_EVENTS;
+   _ret->num_dropped = numEvents - _ret->num_events;
+
+   return SC_TRUE;
+}
+
+void samplechain_profile_reset(void) {
+   memset(loc_phases, 0, sizeof(loc_phases));
+   memset(loc_counters, 0, sizeof(loc_counters));
+
+   SC_ATOMIC_STORE(&loc_num_events, 0u);
+   SC_ATOMIC_STORE(&loc_t_start, loc_get_time_ns());
+}
+
+bool_t samplechain_profile_write_trace(const char *_pathName) {
+   bool_t ret = SC_FALSE;
+   FILE *fh = fopen(_pathName, "w");
+
+   if(NULL != fh)
+   {
+      samplechain_profile_t prof;
+      uint64_t tEnd = 0u;
+      uint32_t idx;
+
+      samplechain_profile_query(&prof);
+
+      fprintf(fh, "{\"traceEvents\":[\n");
+
+      for(idx = 0; idx < prof.num_events; idx++)
+      {
+         const event_t *ev = &loc_events[idx];
+
+         fprintf(fh, "{\"name\":\"%s\",\"cat\":\"samplechain\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u},\n",
+                 loc_phase_names[ev->phase_idx],
+                 ev->t_begin / 1000.0,
+                 ev->dur / 1000.0,
+                 ev->thread_id
+                 );
+
+         if((ev->t_begin + ev->dur) > tEnd)
+         {
+            tEnd = ev->t_begin + ev->dur;
+         }
+      }
+
+      // Counter totals
+      fprintf(fh, "{\"name\":\"counters\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{", tEnd / 1000.0);
+
+      for(idx = 0; idx < SC_PROFILE_NUM_COUNTERS; idx++)
+      {
+         fprintf(fh, "%s\"%s\":%llu", (idx > 0u) ? "," : "", loc_counter_names[idx], (unsigned long long)prof.counters[idx]);
+      }
+
+      fprintf(fh, "}}\n]}\n");
+
+      ret = (0 == fclose(fh));
+   }
+
+   return ret;
+}
+
+#else
+
+bool_t samplechain_profile_query(samplechain_profile_t *_ret) {
+   memset(_ret, 0, sizeof(samplechain_profile_t));
+   return SC_FALSE;
+}
+
+void samplechain_profile_reset(void) {
+}
+
+bool_t samplechain_profile_write_trace(const char *_pathName) {
+   (void)_pathName;
+   return SC_FALSE;
+}
+
+#endif // SC_PROFILE
@@ -0,0 +1,112 @@
+/* ----
+ * ---- file   : profile.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_PROFILE_H_INCLUDED
+#define SAMPLECHAIN_PROFILE_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Timed phases
+#define SC_PROFILE_PHASE_CALC      0u  // algorithm calc()
+#define SC_PROFILE_PHASE_LAYOUT    1u  // one layout attempt (varichain retry loop)
+#define SC_PROFILE_PHASE_ALIGN     2u  // one align pass
+#define SC_PROFILE_PHASE_RENDER    3u  // samplechain_render() / render stream
+#define SC_PROFILE_PHASE_FETCH     4u  // element fetch callback
+#define SC_PROFILE_PHASE_ANALYZE   5u  // loudness analysis
+#define SC_PROFILE_PHASE_CONVERT   6u  // float to 16bit conversion + zero-fill
+#define SC_PROFILE_PHASE_IO        7u  // file / stream output
+#define SC_PROFILE_NUM_PHASES      8u
+
+// Counters
+#define SC_PROFILE_COUNTER_ITERATIONS     0u  // layout attempts
+#define SC_PROFILE_COUNTER_ALIGN_PASSES   1u
+#define SC_PROFILE_COUNTER_BYTES_COPIED   2u  // sample bytes converted into the chain
+#define SC_PROFILE_COUNTER_BYTES_ZEROED   3u  // padding bytes
+#define SC_PROFILE_COUNTER_BYTES_WRITTEN  4u  // bytes written to files / streams
+#define SC_PROFILE_COUNTER_CACHE_HITS     5u
+#define SC_PROFILE_NUM_COUNTERS           6u
+
+#define SC_PROFILE_MAX_EVENTS  65536u  // max. number of trace events (further events are only accumulated)
+
+
+// Instrumentation macros (compile to nothing unless SC_PROFILE is defined)
+//  - SC_PROFILE_BEGIN() declares a variable, i.e. it must be placed after the declarations of a block
+#ifdef SC_PROFILE
+#define SC_PROFILE_BEGIN(phase)       uint64_t sc_profile_t0_##phase = sc_profile_begin()
+#define SC_PROFILE_END(phase)         sc_profile_end(SC_PROFILE_PHASE_##phase, sc_profile_t0_##phase)
+#define SC_PROFILE_COUNT(counter, n)  sc_profile_count(SC_PROFILE_COUNTER_##counter, (uint64_t)(n))
+#else
+#define SC_PROFILE_BEGIN(phase)
+#define SC_PROFILE_END(phase)
+#define SC_PROFILE_COUNT(counter, n)
+#endif // SC_PROFILE
+
+
+typedef struct {
+   uint64_t num_calls;
+   uint64_t total_ns;
+   uint64_t max_ns;
+} samplechain_profile_phase_t;
+
+typedef struct {
+   samplechain_profile_phase_t phases[SC_PROFILE_NUM_PHASES];
+   uint64_t                    counters[SC_PROFILE_NUM_COUNTERS];
+   uint32_t                    num_events;    // number of recorded trace events
+   uint32_t                    num_dropped;   // number of events that did not fit into the trace buffer
+} samplechain_profile_t;
+
+
+// Query accumulated (process-wide) timers and counters
+//  - Returns false if the library has been compiled without SC_PROFILE
+bool_t samplechain_profile_query (samplechain_profile_t *_ret);
+
+// Reset timers, counters and trace events (must not be called while instrumented code is running)
+void samplechain_profile_reset (void);
+
+// Query phase / counter names
+const char *samplechain_profile_get_phase_name (uint32_t _phaseIdx);
+const char *samplechain_profile_get_counter_name (uint32_t _counterIdx);
+
+// Write trace events (since the last reset) as Chrome trace JSON (chrome://tracing, Perfetto)
+//  - Returns false if the file could not be written or if the library has been compiled without SC_PROFILE
+bool_t samplechain_profile_write_trace (const char *_pathName);
+
+
+// Internal
+uint64_t sc_profile_begin (void);
+void sc_profile_end (uint32_t _phaseIdx, uint64_t _t0);
+void sc_profile_count (uint32_t _counterIdx, uint64_t _n);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_PROFILE_H_INCLUDED
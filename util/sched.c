@@ -0,0 +1,789 @@
+/* ----
+ * ---- file   : sched.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef SC_NO_THREADS
+#include <pthread.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "thread.h"
+#include "sched.h"
+
+#define SC_SCHED_MAX_THREADS     64
+#define SC_SCHED_DEQUE_CAPACITY  256u  // initial capacity (power of two, grows on demand)
+
+// (note) sleep / wake-up bookkeeping requires sequentially consistent ordering
+#define SC_ATOMIC_ADD_SEQ(p, v)  __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#define SC_ATOMIC_LOAD_SEQ(p)    __atomic_load_n((p), __ATOMIC_SEQ_CST)
+
+
+// Dependency edge (allocated together with the dependent task)
+typedef struct edge_s {
+   samplechain_sched_task_t *dep;        // task that must complete first
+   samplechain_sched_task_t *dependent;  // task that owns this edge
+   struct edge_s            *next;       // next edge in dep->dependents
+   bool_t                    b_pending;  // true if 'dep' had not completed when the edge was added
+} edge_t;
+
+struct samplechain_sched_task_s {
+   samplechain_task_fxn_t fxn;
+   void                  *ctx;
+
+   size_t   mem_bytes;
+   bool_t   b_mem_reserved;
+
+   uint32_t num_refs;     // caller handle + scheduler (until completed) + dependents (until they completed)
+   uint32_t num_users;    // task itself (until completed) + pending dependents (until they completed)
+   uint32_t num_pending;  // number of unfinished dependencies (+1 while the task is being added)
+   bool_t   b_done;
+
+   edge_t  *dependents;   // guarded by the scheduler mutex
+   edge_t  *edges;        // 'num_deps' edges
+   uint32_t num_deps;
+
+   samplechain_sched_task_t *next_mem_wait;
+};
+
+typedef struct {
+#ifndef SC_NO_THREADS
+   pthread_mutex_t mutex;
+#endif
+   samplechain_sched_task_t **tasks;
+   uint32_t capacity;
+   uint32_t head;  // oldest task (stolen by other threads)
+   uint32_t tail;  // newest task (popped by the owner)
+} deque_t;
+
+typedef struct {
+   samplechain_sched_t *sched;
+   uint32_t             worker_idx;
+} worker_t;
+
+struct samplechain_sched_s {
+#ifndef SC_NO_THREADS
+   pthread_mutex_t mutex;  // sleep, dependency and memory state
+   pthread_cond_t  cond;
+   pthread_t       threads[SC_SCHED_MAX_THREADS];
+#endif
+   worker_t workers[SC_SCHED_MAX_THREADS];
+   uint32_t num_threads;
+
+   deque_t *deques;        // one per worker + one for tasks added by other threads
+   uint32_t num_ready;     // number of queued tasks
+   uint32_t num_sleeping;  // number of threads waiting on 'cond'
+   bool_t   b_shutdown;
+
+   size_t   max_mem_bytes;
+   size_t   mem_in_use;
+   size_t   mem_peak;
+   samplechain_sched_task_t *mem_wait_head;
+   samplechain_sched_task_t *mem_wait_tail;
+
+   uint64_t num_tasks_run;
+   uint64_t num_steals;
+   uint64_t num_mem_waits;
+};
+
+
+static __thread samplechain_sched_t *loc_cur_sched;  // set in worker threads
+static __thread uint32_t             loc_cur_worker_idx;
+
+static samplechain_sched_t *loc_default_sched;
+static samplechain_sched_t *loc_app_default_sched;  // see samplechain_sched_set_default()
+
+
+#ifndef SC_NO_THREADS
+#define loc_lock(m)          pthread_mutex_lock(m)
+#define loc_unlock(m)        pthread_mutex_unlock(m)
+#define loc_wait(c, m)       pthread_cond_wait(c, m)
+#define loc_broadcast(c)     pthread_cond_broadcast(c)
+#else
+#define loc_lock(m)          (void)0
+#define loc_unlock(m)        (void)0
+#define loc_wait(c, m)       (void)0
+#define loc_broadcast(c)     (void)0
+#endif
+
+
+static bool_t loc_deque_init(deque_t *_dq) {
+   _dq->tasks    = malloc(sizeof(samplechain_sched_task_t*) * SC_SCHED_DEQUE_CAPACITY);
+   _dq->capacity = SC_SCHED_DEQUE_CAPACITY;
+   _dq->head     = 0u;
+   _dq->tail     = 0u;
+
+#ifndef SC_NO_THREADS
+   pthread_mutex_init(&_dq->mutex, NULL);
+#endif
+
+   return (NULL != _dq->tasks);
+}
+
+static void loc_deque_exit(deque_t *_dq) {
+#ifndef SC_NO_THREADS
+   pthread_mutex_destroy(&_dq->mutex);
+#endif
+
+   free(_dq->tasks);
+   _dq->tasks = NULL;
+}
+
+static bool_t loc_deque_push(deque_t *_dq, samplechain_sched_task_t *_task) {
+   bool_t ret = SC_TRUE;
+
+   loc_lock(&_dq->mutex);
+
+   if((_dq->tail - _dq->head) == _dq->capacity)
+   {
+      samplechain_sched_task_t **tasks = malloc(sizeof(samplechain_sched_task_t*) * _dq->capacity * 2u);
+
+      if(NULL != tasks)
+      {
+         uint32_t i;
+
+         for(i = 0u; i < _dq->capacity; i++)
+         {
+            tasks[i] = _dq->tasks[(_dq->head + i) & (_dq->capacity - 1u)];
+         }
+
+         free(_dq->tasks);
+
+         _dq->tasks     = tasks;
+         _dq->tail      = _dq->capacity;
+         _dq->head      = 0u;
+         _dq->capacity *= 2u;
+      }
+      else
+      {
+         ret = SC_FALSE;
+      }
+   }
+
+   if(ret)
+   {
+      _dq->tasks[_dq->tail & (_dq->capacity - 1u)] = _task;
+      _dq->tail++;
+   }
+
+   loc_unlock(&_dq->mutex);
+
+   return ret;
+}
+
+static samplechain_sched_task_t *loc_deque_pop(deque_t *_dq) {
+   samplechain_sched_task_t *ret = NULL;
+
+   loc_lock(&_dq->mutex);
+
+   if(_dq->tail != _dq->head)
+   {
+      _dq->tail--;
+      ret = _dq->tasks[_dq->tail & (_dq->capacity - 1u)];
+   }
+
+   loc_unlock(&_dq->mutex);
+
+   return ret;
+}
+
+static samplechain_sched_task_t *loc_deque_steal(deque_t *_dq) {
+   samplechain_sched_task_t *ret = NULL;
+
+   loc_lock(&_dq->mutex);
+
+   if(_dq->tail != _dq->head)
+   {
+      ret = _dq->tasks[_dq->head & (_dq->capacity - 1u)];
+      _dq->head++;
+   }
+
+   loc_unlock(&_dq->mutex);
+
+   return ret;
+}
+
+// Index of the calling thread's deque (the shared deque for non-worker threads)
+static uint32_t loc_get_deque_idx(samplechain_sched_t *_sched) {
+   return (loc_cur_sched == _sched) ? loc_cur_worker_idx : _sched->num_threads;
+}
+
+static void loc_wake_up(samplechain_sched_t *_sched) {
+
+   if(SC_ATOMIC_LOAD_SEQ(&_sched->num_sleeping) > 0u)
+   {
+      loc_lock(&_sched->mutex);
+      loc_broadcast(&_sched->cond);
+      loc_unlock(&_sched->mutex);
+   }
+}
+
+static void loc_run_task(samplechain_sched_t *_sched, samplechain_sched_task_t *_task);
+
+static void loc_push(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+
+   if(loc_deque_push(&_sched->deques[loc_get_deque_idx(_sched)], _task))
+   {
+      SC_ATOMIC_ADD_SEQ(&_sched->num_ready, 1u);
+      loc_wake_up(_sched);
+   }
+   else
+   {
+      // (note) out of memory, run task on the calling thread
+      loc_run_task(_sched, _task);
+   }
+}
+
+static samplechain_sched_task_t *loc_find_task(samplechain_sched_t *_sched, uint32_t _dequeIdx) {
+   samplechain_sched_task_t *ret = NULL;
+   uint32_t numDeques = _sched->num_threads + 1u;
+   uint32_t i;
+
+   if(_dequeIdx < _sched->num_threads)
+   {
+      // Own deque: newest task first (depth first, i.e. consumers run right after their producers)
+      ret = loc_deque_pop(&_sched->deques[_dequeIdx]);
+   }
+
+   for(i = 1u; (NULL == ret) && (i <= numDeques); i++)
+   {
+      // Steal oldest task from the other deques (incl. the shared deque)
+      uint32_t victimIdx = (_dequeIdx + i) % numDeques;
+
+      if(victimIdx != _dequeIdx || (_dequeIdx == _sched->num_threads))
+      {
+         ret = loc_deque_steal(&_sched->deques[victimIdx]);
+
+         if((NULL != ret) && (victimIdx != _dequeIdx))
+         {
+            SC_ATOMIC_ADD(&_sched->num_steals, 1u);
+         }
+      }
+   }
+
+   if(NULL != ret)
+   {
+      SC_ATOMIC_SUB(&_sched->num_ready, 1u);
+   }
+
+   return ret;
+}
+
+static void loc_release_memory(samplechain_sched_t *_sched, size_t _numBytes) {
+   samplechain_sched_task_t *admitted = NULL;
+   samplechain_sched_task_t *task;
+
+   loc_lock(&_sched->mutex);
+
+   _sched->mem_in_use -= _numBytes;
+
+   // Re-queue waiting tasks (in order) as long as they fit into the cap
+   while( (NULL != (task = _sched->mem_wait_head)) &&
+          ((0u == _sched->mem_in_use) || ((_sched->mem_in_use + task->mem_bytes) <= _sched->max_mem_bytes))
+          )
+   {
+      _sched->mem_wait_head = task->next_mem_wait;
+
+      _sched->mem_in_use += task->mem_bytes;
+      task->b_mem_reserved = SC_TRUE;
+
+      if(_sched->mem_in_use > _sched->mem_peak)
+      {
+         _sched->mem_peak = _sched->mem_in_use;
+      }
+
+      task->next_mem_wait = admitted;
+      admitted = task;
+   }
+
+   if(NULL == _sched->mem_wait_head)
+   {
+      _sched->mem_wait_tail = NULL;
+   }
+
+   loc_unlock(&_sched->mutex);
+
+   while(NULL != admitted)
+   {
+      task = admitted;
+      admitted = task->next_mem_wait;
+      loc_push(_sched, task);
+   }
+}
+
+static void loc_unref(samplechain_sched_task_t *_task) {
+
+   if(1u == SC_ATOMIC_SUB(&_task->num_refs, 1u))
+   {
+      free(_task);
+   }
+}
+
+// Release memory reservation after the task and all of its (pending) dependents have completed
+static void loc_unuse(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+
+   if( (1u == SC_ATOMIC_SUB(&_task->num_users, 1u)) && _task->b_mem_reserved )
+   {
+      loc_release_memory(_sched, _task->mem_bytes);
+   }
+}
+
+// Reserve task memory
+//  - Returns false if the task has been queued until enough memory is available
+static bool_t loc_admit(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+   bool_t ret = SC_TRUE;
+
+   if((_task->mem_bytes > 0u) && !_task->b_mem_reserved)
+   {
+      loc_lock(&_sched->mutex);
+
+      // (note) consumers always start (they release memory)
+      if( (_task->num_deps > 0u) || (0u == _sched->max_mem_bytes) ||
+          (0u == _sched->mem_in_use) || ((_sched->mem_in_use + _task->mem_bytes) <= _sched->max_mem_bytes)
+          )
+      {
+         _sched->mem_in_use += _task->mem_bytes;
+         _task->b_mem_reserved = SC_TRUE;
+
+         if(_sched->mem_in_use > _sched->mem_peak)
+         {
+            _sched->mem_peak = _sched->mem_in_use;
+         }
+      }
+      else
+      {
+         _task->next_mem_wait = NULL;
+
+         if(NULL != _sched->mem_wait_tail)
+         {
+            _sched->mem_wait_tail->next_mem_wait = _task;
+         }
+         else
+         {
+            _sched->mem_wait_head = _task;
+         }
+
+         _sched->mem_wait_tail = _task;
+
+         SC_ATOMIC_ADD(&_sched->num_mem_waits, 1u);
+
+         ret = SC_FALSE;
+      }
+
+      loc_unlock(&_sched->mutex);
+   }
+
+   return ret;
+}
+
+static void loc_complete_task(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+   edge_t *edge;
+   uint32_t depIdx;
+
+   loc_lock(&_sched->mutex);
+
+   SC_ATOMIC_STORE(&_task->b_done, SC_TRUE);
+
+   edge = _task->dependents;
+   _task->dependents = NULL;
+
+   // Wake up threads waiting for this task
+   loc_broadcast(&_sched->cond);
+
+   loc_unlock(&_sched->mutex);
+
+   while(NULL != edge)
+   {
+      // (note) the dependent may run (and be freed) as soon as it has been queued
+      edge_t *next = edge->next;
+
+      if(1u == SC_ATOMIC_SUB(&edge->dependent->num_pending, 1u))
+      {
+         loc_push(_sched, edge->dependent);
+      }
+
+      edge = next;
+   }
+
+   // Release references to the dependencies (and their memory reservations)
+   for(depIdx = 0u; depIdx < _task->num_deps; depIdx++)
+   {
+      if(_task->edges[depIdx].b_pending)
+      {
+         loc_unuse(_sched, _task->edges[depIdx].dep);
+      }
+
+      loc_unref(_task->edges[depIdx].dep);
+   }
+
+   loc_unuse(_sched, _task);
+   loc_unref(_task);
+}
+
+static void loc_run_task(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+
+   if(loc_admit(_sched, _task))
+   {
+      _task->fxn(_task->ctx);
+
+      SC_ATOMIC_ADD(&_sched->num_tasks_run, 1u);
+
+      loc_complete_task(_sched, _task);
+   }
+}
+
+#ifndef SC_NO_THREADS
+static void *loc_worker_entry(void *_worker) {
+   worker_t *worker = (worker_t*)_worker;
+   samplechain_sched_t *sched = worker->sched;
+
+   loc_cur_sched      = sched;
+   loc_cur_worker_idx = worker->worker_idx;
+
+   for(;;)
+   {
+      samplechain_sched_task_t *task = loc_find_task(sched, worker->worker_idx);
+
+      if(NULL != task)
+      {
+         loc_run_task(sched, task);
+      }
+      else
+      {
+         bool_t bShutdown;
+
+         loc_lock(&sched->mutex);
+
+         SC_ATOMIC_ADD_SEQ(&sched->num_sleeping, 1u);
+
+         while((0u == SC_ATOMIC_LOAD_SEQ(&sched->num_ready)) && !sched->b_shutdown)
+         {
+            loc_wait(&sched->cond, &sched->mutex);
+         }
+
+         SC_ATOMIC_SUB(&sched->num_sleeping, 1u);
+
+         bShutdown = sched->b_shutdown;
+
+         loc_unlock(&sched->mutex);
+
+         if(bShutdown)
+         {
+            break;
+         }
+      }
+   }
+
+   return NULL;
+}
+#endif // SC_NO_THREADS
+
+samplechain_sched_t *samplechain_sched_create(uint32_t _numThreads, size_t _maxMemBytes) {
+   samplechain_sched_t *ret = malloc(sizeof(samplechain_sched_t));
+
+   if(NULL != ret)
+   {
+      uint32_t numThreads = (0u == _numThreads) ? sc_get_num_cpus() : _numThreads;
+      uint32_t i;
+      bool_t bOk = SC_TRUE;
+
+      memset(ret, 0, sizeof(samplechain_sched_t));
+
+#ifdef SC_NO_THREADS
+      numThreads = 0u;
+#endif
+
+      if(numThreads > SC_SCHED_MAX_THREADS)
+      {
+         numThreads = SC_SCHED_MAX_THREADS;
+      }
+
+      ret->max_mem_bytes = _maxMemBytes;
+      ret->deques        = malloc(sizeof(deque_t) * (numThreads + 1u));
+
+      if(NULL == ret->deques)
+      {
+         free(ret);
+         return NULL;
+      }
+
+      for(i = 0u; i <= numThreads; i++)
+      {
+         bOk = loc_deque_init(&ret->deques[i]) && bOk;
+      }
+
+      if(!bOk)
+      {
+         for(i = 0u; i <= numThreads; i++)
+         {
+            loc_deque_exit(&ret->deques[i]);
+         }
+
+         free(ret->deques);
+         free(ret);
+         return NULL;
+      }
+
+#ifndef SC_NO_THREADS
+      pthread_mutex_init(&ret->mutex, NULL);
+      pthread_cond_init(&ret->cond, NULL);
+
+      // (note) 'num_threads' must be final before the first worker starts (deque indices)
+      ret->num_threads = numThreads;
+
+      for(i = 0u; i < numThreads; i++)
+      {
+         ret->workers[i].sched      = ret;
+         ret->workers[i].worker_idx = i;
+
+         if(0 != pthread_create(&ret->threads[i], NULL, &loc_worker_entry, &ret->workers[i]))
+         {
+            // (note) remaining deques are drained by the other workers (work stealing)
+            break;
+         }
+      }
+
+      if(i < numThreads)
+      {
+         // Could not start all threads
+         loc_lock(&ret->mutex);
+         ret->b_shutdown = SC_TRUE;
+         loc_broadcast(&ret->cond);
+         loc_unlock(&ret->mutex);
+
+         while(i > 0u)
+         {
+            pthread_join(ret->threads[--i], NULL);
+         }
+
+         samplechain_sched_destroy(ret);
+         ret = NULL;
+      }
+#endif
+   }
+
+   return ret;
+}
+
+void samplechain_sched_destroy(samplechain_sched_t *_sched) {
+
+   if(NULL != _sched)
+   {
+      uint32_t i;
+
+#ifndef SC_NO_THREADS
+      if(!_sched->b_shutdown)
+      {
+         loc_lock(&_sched->mutex);
+         _sched->b_shutdown = SC_TRUE;
+         loc_broadcast(&_sched->cond);
+         loc_unlock(&_sched->mutex);
+
+         for(i = 0u; i < _sched->num_threads; i++)
+         {
+            pthread_join(_sched->threads[i], NULL);
+         }
+      }
+
+      pthread_cond_destroy(&_sched->cond);
+      pthread_mutex_destroy(&_sched->mutex);
+#endif
+
+      for(i = 0u; i <= _sched->num_threads; i++)
+      {
+         loc_deque_exit(&_sched->deques[i]);
+      }
+
+      free(_sched->deques);
+      free(_sched);
+   }
+}
+
+#ifndef SC_NO_THREADS
+static pthread_once_t loc_default_sched_once = PTHREAD_ONCE_INIT;
+
+static void loc_create_default_sched(void) {
+   loc_default_sched = samplechain_sched_create(0u, 0u);
+}
+#endif
+
+samplechain_sched_t *samplechain_sched_get_default(void) {
+   samplechain_sched_t *ret = loc_app_default_sched;
+
+   if(NULL == ret)
+   {
+#ifndef SC_NO_THREADS
+      pthread_once(&loc_default_sched_once, &loc_create_default_sched);
+#else
+      if(NULL == loc_default_sched)
+      {
+         loc_default_sched = samplechain_sched_create(0u, 0u);
+      }
+#endif
+
+      ret = loc_default_sched;
+   }
+
+   return ret;
+}
+
+void samplechain_sched_set_default(samplechain_sched_t *_sched) {
+   loc_app_default_sched = _sched;
+}
+
+samplechain_sched_task_t *samplechain_sched_add(samplechain_sched_t *_sched,
+                                                samplechain_task_fxn_t _fxn, void *_ctx,
+                                                size_t _memBytes,
+                                                samplechain_sched_task_t *const *_deps, uint32_t _numDeps
+                                                ) {
+   samplechain_sched_task_t *ret = NULL;
+
+   if((NULL != _sched) && (NULL != _fxn))
+   {
+      ret = malloc(sizeof(samplechain_sched_task_t) + sizeof(edge_t) * _numDeps);
+
+      if(NULL != ret)
+      {
+         uint32_t depIdx;
+
+         ret->fxn            = _fxn;
+         ret->ctx            = _ctx;
+         ret->mem_bytes      = _memBytes;
+         ret->b_mem_reserved = SC_FALSE;
+         ret->num_refs       = 2u;  // caller + scheduler
+         ret->num_users      = 1u;
+         ret->num_pending    = 1u;
+         ret->b_done         = SC_FALSE;
+         ret->dependents     = NULL;
+         ret->edges          = (edge_t*) (ret + 1);
+         ret->num_deps       = _numDeps;
+         ret->next_mem_wait  = NULL;
+
+         loc_lock(&_sched->mutex);
+
+         for(depIdx = 0u; depIdx < _numDeps; depIdx++)
+         {
+            edge_t *edge = &ret->edges[depIdx];
+
+            edge->dep       = _deps[depIdx];
+            edge->dependent = ret;
+            edge->next      = NULL;
+            edge->b_pending = SC_FALSE;
+
+            // (note) released when this task has completed
+            SC_ATOMIC_ADD(&edge->dep->num_refs, 1u);
+
+            if(!edge->dep->b_done)
+            {
+               SC_ATOMIC_ADD(&edge->dep->num_users, 1u);
+               edge->b_pending = SC_TRUE;
+               edge->next = edge->dep->dependents;
+               edge->dep->dependents = edge;
+               ret->num_pending++;
+            }
+         }
+
+         loc_unlock(&_sched->mutex);
+
+         if(1u == SC_ATOMIC_SUB(&ret->num_pending, 1u))
+         {
+            loc_push(_sched, ret);
+         }
+      }
+   }
+
+   return ret;
+}
+
+void samplechain_sched_wait(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+
+   if(NULL != _task)
+   {
+      // (note) worker threads must keep running tasks (nested waits), other threads just block
+      bool_t bHelp = (loc_cur_sched == _sched) || (0u == _sched->num_threads);
+      uint32_t dequeIdx = loc_get_deque_idx(_sched);
+
+      while(!SC_ATOMIC_LOAD(&_task->b_done))
+      {
+         samplechain_sched_task_t *task = bHelp ? loc_find_task(_sched, dequeIdx) : NULL;
+
+         if(NULL != task)
+         {
+            loc_run_task(_sched, task);
+         }
+         else
+         {
+#ifndef SC_NO_THREADS
+            loc_lock(&_sched->mutex);
+
+            SC_ATOMIC_ADD_SEQ(&_sched->num_sleeping, 1u);
+
+            while(!_task->b_done && !(bHelp && (SC_ATOMIC_LOAD_SEQ(&_sched->num_ready) > 0u)))
+            {
+               loc_wait(&_sched->cond, &_sched->mutex);
+            }
+
+            SC_ATOMIC_SUB(&_sched->num_sleeping, 1u);
+
+            loc_unlock(&_sched->mutex);
+#else
+            // (note) cannot happen (all tasks run on the calling thread)
+            break;
+#endif
+         }
+      }
+
+      samplechain_sched_release(_sched, _task);
+   }
+}
+
+void samplechain_sched_release(samplechain_sched_t *_sched, samplechain_sched_task_t *_task) {
+
+   if(NULL != _task)
+   {
+      loc_unref(_task);
+   }
+}
+
+void samplechain_sched_get_stats(samplechain_sched_t *_sched, samplechain_sched_stats_t *_retStats) {
+
+   loc_lock(&_sched->mutex);
+
+   _retStats->num_threads   = _sched->num_threads;
+   _retStats->num_tasks_run = SC_ATOMIC_LOAD(&_sched->num_tasks_run);
+   _retStats->num_steals    = SC_ATOMIC_LOAD(&_sched->num_steals);
+   _retStats->num_mem_waits = SC_ATOMIC_LOAD(&_sched->num_mem_waits);
+   _retStats->mem_in_use    = _sched->mem_in_use;
+   _retStats->mem_peak      = _sched->mem_peak;
+
+   loc_unlock(&_sched->mutex);
+}
@@ -0,0 +1,109 @@
+/* ----
+ * ---- file   : sched.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_SCHED_H_INCLUDED
+#define SAMPLECHAIN_SCHED_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Opaque work-stealing task scheduler
+typedef struct samplechain_sched_s samplechain_sched_t;
+
+// Opaque task handle
+typedef struct samplechain_sched_task_s samplechain_sched_task_t;
+
+// Task callback
+typedef void (*samplechain_task_fxn_t) (void *_ctx);
+
+typedef struct {
+   uint32_t num_threads;     // number of worker threads
+   uint64_t num_tasks_run;
+   uint64_t num_steals;      // tasks taken from another worker's (or the submission) queue
+   uint64_t num_mem_waits;   // number of times a task had to wait for memory
+   size_t   mem_in_use;      // currently reserved bytes
+   size_t   mem_peak;        // max. reserved bytes
+} samplechain_sched_stats_t;
+
+
+// Create scheduler
+//  - Starts 'numThreads' worker threads (0=one per CPU core). Each worker owns a task deque and
+//     steals from the other workers' deques when it runs out of work
+//  - 'maxMemBytes' is the memory cap for tasks that reserve memory (0=unlimited), see samplechain_sched_add()
+//  - Returns NULL if the scheduler could not be created
+samplechain_sched_t *samplechain_sched_create (uint32_t _numThreads, size_t _maxMemBytes);
+
+// Stop worker threads and free scheduler
+//  - All tasks must have completed and all task handles must have been released
+void samplechain_sched_destroy (samplechain_sched_t *_sched);
+
+// Query process-wide scheduler (one worker thread per CPU core, no memory cap)
+//  - Created on first use, used by sc_parallel_for()
+//  - Returns the scheduler passed to samplechain_sched_set_default(), if any
+samplechain_sched_t *samplechain_sched_get_default (void);
+
+// Replace the process-wide scheduler (NULL=restore the built-in one)
+//  - Lets an application that runs its own scheduler share its worker threads with sc_parallel_for(),
+//     i.e. there is only one pool of worker threads
+//  - Must not be called while sc_parallel_for() is running. Restore the default before destroying the scheduler
+void samplechain_sched_set_default (samplechain_sched_t *_sched);
+
+// Add task
+//  - The task runs after all 'deps' have completed (deps may already have completed)
+//  - 'memBytes' is reserved when the task starts and stays reserved until the task and all dependents that were
+//     added before it completed have completed. I.e. the reservation models the task output (e.g. decoded audio)
+//     that is consumed by its dependents
+//  - Tasks without dependencies only start while the reservation fits into the memory cap (backpressure),
+//     tasks with dependencies always start (they usually consume, and then release, memory)
+//  - When several independent groups of producers compete for the cap, let each group depend on a
+//     (no-op) gate task that reserves the memory for the whole group (otherwise partially admitted groups may deadlock)
+//  - May be called from any thread, including from within tasks
+//  - Returns task handle (must be released with samplechain_sched_wait() or samplechain_sched_release()), or NULL
+samplechain_sched_task_t *samplechain_sched_add (samplechain_sched_t *_sched,
+                                                 samplechain_task_fxn_t _fxn, void *_ctx,
+                                                 size_t _memBytes,
+                                                 samplechain_sched_task_t *const *_deps, uint32_t _numDeps
+                                                 );
+
+// Wait until the task has completed, then release the handle
+//  - Worker threads (i.e. tasks) run other tasks while waiting, other threads block
+void samplechain_sched_wait (samplechain_sched_t *_sched, samplechain_sched_task_t *_task);
+
+// Release task handle without waiting
+void samplechain_sched_release (samplechain_sched_t *_sched, samplechain_sched_task_t *_task);
+
+// Query statistics
+void samplechain_sched_get_stats (samplechain_sched_t *_sched, samplechain_sched_stats_t *_retStats);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_SCHED_H_INCLUDED
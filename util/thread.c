@@ -0,0 +1,151 @@
+/* ----
+ * ---- file   : thread.c
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef SC_NO_THREADS
+#include <unistd.h>
+#endif
+
+#include "../algorithm_interface_proposal.h"
+#include "thread.h"
+#include "sched.h"
+
+#define SC_MAX_THREADS  64
+
+
+typedef struct {
+   sc_job_fxn_t fxn;
+   void *ctx;
+
+   uint32_t num_jobs;
+   uint32_t next_job_idx;
+
+} parallel_for_t;
+
+
+static void loc_run_jobs(parallel_for_t *_pf) {
+
+   for(;;)
+   {
+      uint32_t jobIdx = SC_ATOMIC_ADD(&_pf->next_job_idx, 1u);
+
+      if(jobIdx >= _pf->num_jobs)
+      {
+         break;
+      }
+
+      _pf->fxn(_pf->ctx, jobIdx);
+   }
+}
+
+static void loc_run_jobs_task(void *_pf) {
+
+   loc_run_jobs((parallel_for_t*)_pf);
+}
+
+uint32_t sc_get_num_cpus(void) {
+   uint32_t ret = 1;
+
+#ifndef SC_NO_THREADS
+   long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+   if(numCpus > 1)
+   {
+      ret = (uint32_t)numCpus;
+   }
+#endif
+
+   return ret;
+}
+
+uint64_t sc_get_time_us(void) {
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u);
+}
+
+void sc_parallel_for(uint32_t _numJobs, sc_job_fxn_t _fxn, void *_ctx, uint32_t _numThreads) {
+   parallel_for_t pf;
+
+   pf.fxn          = _fxn;
+   pf.ctx          = _ctx;
+   pf.num_jobs     = _numJobs;
+   pf.next_job_idx = 0;
+
+   {
+      samplechain_sched_task_t *tasks[SC_MAX_THREADS];
+      uint32_t numThreads = (0 == _numThreads) ? sc_get_num_cpus() : _numThreads;
+      uint32_t taskIdx;
+      uint32_t numTasks = 0;
+
+      if(numThreads > _numJobs)
+      {
+         numThreads = _numJobs;
+      }
+
+      if(numThreads > SC_MAX_THREADS)
+      {
+         numThreads = SC_MAX_THREADS;
+      }
+
+      if(numThreads > 1)
+      {
+         // (note) runs on the default scheduler's worker threads (no per-call thread creation)
+         samplechain_sched_t *sched = samplechain_sched_get_default();
+
+         // (note) the calling thread is one of the workers
+         for(taskIdx = 1; (NULL != sched) && (taskIdx < numThreads); taskIdx++)
+         {
+            tasks[numTasks] = samplechain_sched_add(sched, &loc_run_jobs_task, &pf, 0u, NULL, 0u);
+
+            if(NULL != tasks[numTasks])
+            {
+               numTasks++;
+            }
+         }
+
+         loc_run_jobs(&pf);
+
+         for(taskIdx = 0; taskIdx < numTasks; taskIdx++)
+         {
+            samplechain_sched_wait(sched, tasks[taskIdx]);
+         }
+      }
+      else
+      {
+         loc_run_jobs(&pf);
+      }
+   }
+}
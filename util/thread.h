@@ -0,0 +1,65 @@
+/* ----
+ * ---- file   : thread.h
+ * ---- author : bsp
+ * ---- legal  : Distributed under terms of the MIT LICENSE (MIT).
+ * ----
+ * ---- Permission is hereby granted, free of charge, to any person obtaining a copy
+ * ---- of this software and associated documentation files (the "Software"), to deal
+ * ---- in the Software without restriction, including without limitation the rights
+ * ---- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * ---- copies of the Software, and to permit persons to whom the Software is
+ * ---- furnished to do so, subject to the following conditions:
+ * ----
+ * ---- The above copyright notice and this permission notice shall be included in
+ * ---- all copies or substantial portions of the Software.
+ * ----
+ * ---- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * ---- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * ---- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * ---- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * ---- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * ---- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * ---- THE SOFTWARE.
+ * ----
+ * ---- info   : This is part of the "libsamplechain" package.
+ * ----
+ * ---- changed: 19Oct2026
+ * ----
+ * ----
+ */
+
+#ifndef SAMPLECHAIN_THREAD_H_INCLUDED
+#define SAMPLECHAIN_THREAD_H_INCLUDED
+
+#include "../cplusplus_begin.h"
+
+
+// Atomic helpers (gcc / clang builtins)
+#define SC_ATOMIC_LOAD(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SC_ATOMIC_STORE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define SC_ATOMIC_ADD(p, v)     __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define SC_ATOMIC_SUB(p, v)     __atomic_fetch_sub((p), (v), __ATOMIC_ACQ_REL)
+
+
+// Job callback for sc_parallel_for()
+typedef void (*sc_job_fxn_t) (void *_ctx, uint32_t _jobIdx);
+
+
+// Query the number of online CPU cores (>= 1)
+uint32_t sc_get_num_cpus (void);
+
+// Query a monotonic timestamp (microseconds, arbitrary origin)
+//  - Used for calc deadlines (see calc_with_deadline())
+uint64_t sc_get_time_us (void);
+
+// Run jobs 0..numJobs-1 on up to 'numThreads' threads (0=one thread per CPU core)
+//  - Runs on the calling thread and the worker threads of samplechain_sched_get_default()
+//  - Returns after all jobs have finished
+//  - Runs all jobs on the calling thread when compiled with SC_NO_THREADS
+void sc_parallel_for (uint32_t _numJobs, sc_job_fxn_t _fxn, void *_ctx, uint32_t _numThreads);
+
+
+#include "../cplusplus_end.h"
+
+
+#endif // SAMPLECHAIN_THREAD_H_INCLUDED